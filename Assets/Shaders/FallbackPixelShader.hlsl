@@ -0,0 +1,61 @@
+// Simplified version of PixelShader.hlsl, used while it's being compiled.
+// It has the same resources, so objects are drawn with the same bindings.
+
+struct PixelIn
+{
+    float4 position : SV_Position;
+    float2 uv : TEXCOORD0;
+    float3 normal : TEXCOORD1;
+    float3 tangent : TEXCOORD2;
+    float3 binormal : TEXCOORD3;
+    float3 viewDir : TEXCOORD4;
+};
+
+struct PixelOut
+{
+    float4 color : SV_Target;
+};
+
+cbuffer LightConstantBuffer : register(b0)
+{
+    float4 LightDir;
+    float4 LightColor;
+};
+
+cbuffer WorldMatrixConstantBuffer : register(b1)
+{
+    float4x4 worldMatrix;
+    float4x4 inverseTransposeWorldMatrix;
+};
+
+cbuffer MaterialConstantBuffer : register(b2)
+{
+    uint diffuseSlice;
+    uint emissiveSlice;
+    uint normalSlice;
+};
+
+Texture2DArray diffuseTexture : register(t0);
+Texture2DArray emissiveTexture : register(t1);
+Texture2DArray normalTexture : register(t2);
+
+SamplerState texSampler : register(s0);
+
+static const float BaseDiffuseAmount = 0.05f;
+
+PixelOut main(PixelIn pixelIn)
+{
+    const float3 lightDir = -normalize(LightDir.xyz);
+
+    const float4 diffuseColor = diffuseTexture.Sample(texSampler, float3(pixelIn.uv, diffuseSlice));
+    const float3 emissiveColor = emissiveTexture.Sample(texSampler, float3(pixelIn.uv, emissiveSlice)).xyz;
+    const float3 normalColor = normalTexture.Sample(texSampler, float3(pixelIn.uv, normalSlice)).xyz;
+
+    // Vertex normal only, the normal map just darkens the bumps of the surface.
+    const float3 normal = normalize(mul((float3x3) inverseTransposeWorldMatrix, pixelIn.normal));
+    const float diffuseAmount = saturate(dot(lightDir, normal)) * saturate(normalColor.z * 2.0f - 1.0f);
+
+    PixelOut pixelOut;
+    pixelOut.color = float4(saturate(diffuseColor.rgb * LightColor.rgb * max(diffuseAmount, BaseDiffuseAmount) + emissiveColor), diffuseColor.a);
+    return pixelOut;
+}
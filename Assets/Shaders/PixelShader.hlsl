@@ -1,3 +1,12 @@
+// Features compiled in or out of the variants of the shader (see MaterialFeatures.h),
+// defined as 1 or 0 by the shader compiler.
+#ifndef EMISSIVE_MAP
+#define EMISSIVE_MAP 1
+#endif
+#ifndef NORMAL_MAP
+#define NORMAL_MAP 1
+#endif
+
 struct PixelIn
 {
     float4 position : SV_Position;
@@ -25,9 +34,17 @@ cbuffer WorldMatrixConstantBuffer : register(b1)
     float4x4 inverseTransposeWorldMatrix;
 };
 
-Texture2D diffuseTexture : register(t0);
-Texture2D emissiveTexture : register(t1);
-Texture2D normalTexture : register(t2);
+cbuffer MaterialConstantBuffer : register(b2)
+{
+    uint diffuseSlice;
+    uint emissiveSlice;
+    uint normalSlice;
+};
+
+// Textures are arrays, small textures are packed as slices of the same array.
+Texture2DArray diffuseTexture : register(t0);
+Texture2DArray emissiveTexture : register(t1);
+Texture2DArray normalTexture : register(t2);
 
 SamplerState texSampler : register(s0);
 
@@ -45,10 +62,9 @@ PixelOut main(PixelIn pixelIn)
     const float3 lightDir = -normalize(LightDir.xyz);
     
     const float3 halfDir = normalize(normalize(pixelIn.viewDir) + lightDir.xyz);
-    const float4 diffuleColor = diffuseTexture.Sample(texSampler, pixelIn.uv);
-    const float3 emissiveColor = emissiveTexture.Sample(texSampler, pixelIn.uv).xyz;
-    const float3 normalColor = normalTexture.Sample(texSampler, pixelIn.uv).xyz;
+    const float4 diffuleColor = diffuseTexture.Sample(texSampler, float3(pixelIn.uv, diffuseSlice));
     
+#if NORMAL_MAP
     // Normal map
     // NOTE: transpose because in HLSL matrix constructors take rows as input
     //       and we're working in column-major (as the layout expected by HLSL uniform matrices).
@@ -56,8 +72,12 @@ PixelOut main(PixelIn pixelIn)
         normalize(pixelIn.tangent), 
         normalize(pixelIn.binormal),
         normalize(pixelIn.normal)));
+    const float3 normalColor = normalTexture.Sample(texSampler, float3(pixelIn.uv, normalSlice)).xyz;
     const float3 normalTangentSpace = normalize(normalColor * 2.0f - 1.0f);
     float3 normal = mul(tangentToLocal, normalTangentSpace);
+#else
+    float3 normal = normalize(pixelIn.normal);
+#endif
     normal = normalize(mul((float3x3) inverseTransposeWorldMatrix, normal));
     
     // Diffuse Color
@@ -71,7 +91,12 @@ PixelOut main(PixelIn pixelIn)
     const float3 specular = SpecularColor * specularAmount;
     
     // Emissive Color
+#if EMISSIVE_MAP
+    const float3 emissiveColor = emissiveTexture.Sample(texSampler, float3(pixelIn.uv, emissiveSlice)).xyz;
     const float3 emissiveColorLinear = pow(emissiveColor, Gamma);
+#else
+    const float3 emissiveColorLinear = float3(0.0f, 0.0f, 0.0f);
+#endif
     
     // Final Color and Gamma
     const float3 colorLinear = LightColor.rgb * (specular + diffuse) + AmbientColor + emissiveColorLinear;
@@ -40,12 +40,7 @@ RWTexture3D<float4> texRW3D : register(u3);
 RWTexture1DArray<float4> texRW1DArray : register(u4);
 RWTexture2DArray<float4> texRW2DArray : register(u5);
 
-struct MySB
-{
-    float4x4 viewMatrix;
-    float4x4 projMatrix;
-    float4x4 worldMatrix;
-};
+#include "PixelShaderTestTypes.hlsli"
 
 Buffer<float4> bufferTyped : register(t8);
 StructuredBuffer<MySB> structuredBuffer : register(t9);
@@ -0,0 +1,12 @@
+#ifndef PIXEL_SHADER_TEST_TYPES_HLSLI
+#define PIXEL_SHADER_TEST_TYPES_HLSLI
+
+// Included by PixelShaderTest.hlsl to test the shader include dependencies.
+struct MySB
+{
+    float4x4 viewMatrix;
+    float4x4 projMatrix;
+    float4x4 worldMatrix;
+};
+
+#endif // PIXEL_SHADER_TEST_TYPES_HLSLI
@@ -130,3 +130,37 @@ set_target_properties(UpdateAssimpLibsDebugSymbolsAndDLLs PROPERTIES FOLDER ${as
 
 set(zlib_folder "${3rdparty_folder}/zlib")
 set_target_properties(zlibstatic PROPERTIES FOLDER ${zlib_folder})
+
+# ---------------------------------------------------------------------
+# DirectX Shader Compiler (DXC) & DirectX-Headers
+#
+# Compiles HLSL to DXIL and SPIR-V. Used by the shader compiler on
+# platforms other than Windows, where d3dcompiler is not available.
+# DirectX-Headers provides d3d12shader.h for the reflection of DXIL.
+# ---------------------------------------------------------------------
+
+if (NOT WIN32)
+    FetchContent_Declare(
+        dxc
+        URL https://github.com/microsoft/DirectXShaderCompiler/releases/download/v1.8.2407/linux_dxc_2024_07_31.x86_64.tar.gz
+        DOWNLOAD_EXTRACT_TIMESTAMP TRUE
+    )
+
+    FetchContent_MakeAvailable(dxc)
+
+    FetchContent_Declare(
+        directx_headers
+        GIT_REPOSITORY https://github.com/microsoft/DirectX-Headers.git
+        GIT_TAG v1.614.1
+        SOURCE_SUBDIR include # Only the headers, without its CMake project and WSL stubs that clash with DXC's WinAdapter.h
+    )
+
+    FetchContent_MakeAvailable(directx_headers)
+
+    add_library(dxcompiler SHARED IMPORTED GLOBAL)
+    set_target_properties(dxcompiler PROPERTIES
+        IMPORTED_LOCATION "${dxc_SOURCE_DIR}/lib/libdxcompiler.so")
+    target_include_directories(dxcompiler INTERFACE
+        "${dxc_SOURCE_DIR}/include"
+        "${directx_headers_SOURCE_DIR}/include/directx")
+endif()
@@ -0,0 +1,397 @@
+#include <AssetCooker.h>
+
+#include <Assets/CookedAsset.h>
+#include <Assets/MeshAsset.h>
+#include <Renderer/TextureStreamer.h>
+#include <Compression/LZ4.h>
+#include <File/FileUtils.h>
+#include <File/MappedFile.h>
+#include <Hash/Hash.h>
+#include <Thread/ThreadPool.h>
+#include <Log/Log.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <ranges>
+#include <set>
+#include <sstream>
+#include <utility>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static const char* ManifestFileName = "CookManifest.txt";
+        static const char* ManifestHeader = "DXCookManifest";
+        static const uint32_t ManifestVersion = 1;
+
+        static const char* PackFileName = "Assets.pak";
+
+        // Separates the filename and dependencies in the manifest, it's not valid in paths.
+        static const char ManifestPathSeparator = '|';
+
+        static std::string NormalizeFileName(const std::string& fileName)
+        {
+            return std::filesystem::path(fileName).lexically_normal().generic_string();
+        }
+    } // namespace Internal
+
+    AssetCooker::AssetCooker(const AssetCookerDesc& desc)
+        : m_desc(desc)
+        , m_cachePath(desc.m_outputPath / "CookedCache")
+    {
+    }
+
+    bool AssetCooker::Cook()
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+
+        const std::filesystem::path& assetPath = GetAssetPath();
+
+        DX_LOG(Info, "AssetCooker", "Cooking %s into %s...",
+            assetPath.generic_string().c_str(), m_desc.m_outputPath.generic_string().c_str());
+
+        std::vector<std::string> fileNames;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(assetPath))
+        {
+            if (entry.is_regular_file() && entry.path().extension() != ".cooked")
+            {
+                fileNames.push_back(entry.path().lexically_relative(assetPath).generic_string());
+            }
+        }
+
+        const CookManifest manifest = LoadManifest();
+
+        std::vector<std::future<CookResult>> cookResults;
+        cookResults.reserve(fileNames.size());
+        {
+            ThreadPool threadPool(m_desc.m_threadCount);
+
+            for (const auto& fileName : fileNames)
+            {
+                auto manifestIt = manifest.find(fileName);
+                const CookRecord* manifestRecord = (manifestIt != manifest.end()) ? &manifestIt->second : nullptr;
+
+                cookResults.push_back(threadPool.Submit([this, &fileName, manifestRecord]()
+                    {
+                        return CookFile(fileName, GetCookType(fileName), manifestRecord);
+                    }));
+            }
+        }
+
+        CookManifest newManifest;
+        int cookedCount = 0;
+        int upToDateCount = 0;
+        int failedCount = 0;
+        for (size_t i = 0; i < fileNames.size(); ++i)
+        {
+            CookResult cookResult = cookResults[i].get();
+            switch (cookResult.m_status)
+            {
+            case CookResult::Status::Cooked:   ++cookedCount;   break;
+            case CookResult::Status::UpToDate: ++upToDateCount; break;
+            case CookResult::Status::Failed:   ++failedCount;   continue;
+            }
+
+            newManifest.emplace(fileNames[i], std::move(cookResult.m_record));
+        }
+
+        // Remove the cached data of files no longer in the Assets folder.
+        bool filesRemoved = false;
+        for (const auto& fileName : manifest | std::views::keys)
+        {
+            if (!newManifest.contains(fileName))
+            {
+                std::error_code errorCode;
+                std::filesystem::remove(GetCachedFilePath(fileName, GetCookType(fileName)), errorCode);
+                filesRemoved = true;
+            }
+        }
+
+        bool success = (failedCount == 0) && SaveManifest(newManifest);
+
+        // The pack file only needs to be written again when its content changed.
+        if (cookedCount > 0 || filesRemoved || failedCount > 0 ||
+            !std::filesystem::exists(m_desc.m_outputPath / Internal::PackFileName))
+        {
+            success = WritePackFile(newManifest) && success;
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        DX_LOG(Info, "AssetCooker", "%d files cooked, %d up to date and %d failed in %.3f seconds.",
+            cookedCount, upToDateCount, failedCount, elapsed.count());
+
+        return success;
+    }
+
+    AssetCooker::CookType AssetCooker::GetCookType(const std::filesystem::path& filePath)
+    {
+        std::string extension = filePath.extension().string();
+        std::ranges::transform(extension, extension.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+
+        // Formats supported by MeshAsset and by stb_image in TextureStreamer.
+        static const std::set<std::string> MeshExtensions = { ".fbx", ".gltf", ".glb", ".obj" };
+        static const std::set<std::string> TextureExtensions = { ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".psd", ".gif", ".hdr", ".pic", ".pnm" };
+
+        if (MeshExtensions.contains(extension))
+        {
+            return CookType::Mesh;
+        }
+        if (TextureExtensions.contains(extension))
+        {
+            return CookType::Texture;
+        }
+        return CookType::Copy;
+    }
+
+    uint32_t AssetCooker::GetImporterFlags(CookType cookType)
+    {
+        return (cookType == CookType::Mesh) ? MeshAsset::GetImporterFlags() : 0;
+    }
+
+    AssetCooker::CookResult AssetCooker::CookFile(const std::string& fileName, CookType cookType, const CookRecord* manifestRecord) const
+    {
+        const uint32_t importerFlags = GetImporterFlags(cookType);
+        const std::filesystem::path cachedFilePath = GetCachedFilePath(fileName, cookType);
+
+        // Up to date when neither the sources, importer nor cooked format have changed.
+        if (manifestRecord &&
+            !m_desc.m_forceCook &&
+            manifestRecord->m_version == CookedAssetVersion &&
+            manifestRecord->m_importerFlags == importerFlags &&
+            std::filesystem::exists(cachedFilePath) &&
+            HashSourceFiles(fileName, manifestRecord->m_dependencies) == manifestRecord->m_sourceHash)
+        {
+            return { CookResult::Status::UpToDate, *manifestRecord };
+        }
+
+        const auto startTime = std::chrono::steady_clock::now();
+
+        CookRecord record;
+        record.m_importerFlags = importerFlags;
+        record.m_version = CookedAssetVersion;
+
+        std::optional<std::vector<uint8_t>> cookedData;
+        switch (cookType)
+        {
+        case CookType::Mesh:
+            if (auto meshData = MeshAsset::ImportMesh(fileName, &record.m_dependencies))
+            {
+                cookedData = SerializeMeshData(*meshData);
+            }
+            break;
+
+        case CookType::Texture:
+            if (auto mipChain = TextureStreamer::ImportTexture(fileName))
+            {
+                cookedData = SerializeTextureMipChain(*mipChain);
+            }
+            break;
+
+        case CookType::Copy:
+            if (auto file = OpenAssetFile(fileName, FileAccessPattern::Sequential))
+            {
+                cookedData.emplace(file->GetData().begin(), file->GetData().end());
+            }
+            break;
+        }
+
+        if (!cookedData)
+        {
+            DX_LOG(Error, "AssetCooker", "Failed to cook %s.", fileName.c_str());
+            return {};
+        }
+
+        // The importer also reads the file itself, only other files are dependencies.
+        std::ranges::transform(record.m_dependencies, record.m_dependencies.begin(), Internal::NormalizeFileName);
+        std::erase(record.m_dependencies, Internal::NormalizeFileName(fileName));
+        std::ranges::sort(record.m_dependencies);
+        record.m_dependencies.erase(std::ranges::unique(record.m_dependencies).begin(), record.m_dependencies.end());
+
+        const std::optional<uint64_t> sourceHash = HashSourceFiles(fileName, record.m_dependencies);
+        if (!sourceHash)
+        {
+            DX_LOG(Error, "AssetCooker", "Failed to hash %s.", fileName.c_str());
+            return {};
+        }
+        record.m_sourceHash = *sourceHash;
+
+        // Compressed once here, so the pack file is written without compressing it again.
+        record.m_uncompressedSize = cookedData->size();
+        record.m_compression = PackFileCompression::None;
+        if (std::vector<uint8_t> compressedData = CompressLZ4(*cookedData);
+            compressedData.size() < cookedData->size())
+        {
+            cookedData = std::move(compressedData);
+            record.m_compression = PackFileCompression::LZ4;
+        }
+
+        if (!WriteFileAtomically(cachedFilePath, *cookedData))
+        {
+            return {};
+        }
+
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+        DX_LOG(Info, "AssetCooker", "%s %s in %.2f ms.",
+            (cookType == CookType::Copy) ? "Copied" : "Cooked", fileName.c_str(), elapsed.count());
+
+        return { CookResult::Status::Cooked, std::move(record) };
+    }
+
+    std::optional<uint64_t> AssetCooker::HashSourceFiles(const std::string& fileName, const std::vector<std::string>& dependencies) const
+    {
+        uint64_t hash = 0;
+
+        auto hashFile = [&hash](const std::string& fileToHash)
+            {
+                const auto file = OpenAssetFile(fileToHash, FileAccessPattern::Sequential);
+                if (!file)
+                {
+                    return false;
+                }
+
+                // Each file is seeded with the hash of the previous ones.
+                hash = Hash64(file->GetData().data(), file->GetSize(), hash);
+                return true;
+            };
+
+        if (!hashFile(fileName) ||
+            !std::ranges::all_of(dependencies, hashFile))
+        {
+            return std::nullopt;
+        }
+        return hash;
+    }
+
+    std::string AssetCooker::GetPackedFileName(const std::string& fileName, CookType cookType)
+    {
+        return (cookType == CookType::Copy) ? fileName : GetCookedAssetFileName(fileName);
+    }
+
+    std::filesystem::path AssetCooker::GetCachedFilePath(const std::string& fileName, CookType cookType) const
+    {
+        return m_cachePath / GetPackedFileName(fileName, cookType);
+    }
+
+    AssetCooker::CookManifest AssetCooker::LoadManifest() const
+    {
+        std::ifstream file(m_cachePath / Internal::ManifestFileName);
+        if (!file.is_open())
+        {
+            return {};
+        }
+
+        std::string header;
+        uint32_t version = 0;
+        if (!(file >> header >> version) ||
+            header != Internal::ManifestHeader ||
+            version != Internal::ManifestVersion)
+        {
+            DX_LOG(Warning, "AssetCooker", "Manifest has an old version, cooking all files.");
+            return {};
+        }
+
+        CookManifest manifest;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+
+            // Line format: sourceHash importerFlags version compression uncompressedSize fileName|dependency|...
+            std::istringstream lineStream(line);
+            CookRecord record;
+            uint32_t compression = 0;
+            std::string paths;
+            if (!(lineStream >> std::hex >> record.m_sourceHash >> record.m_importerFlags >> std::dec
+                    >> record.m_version >> compression >> record.m_uncompressedSize) ||
+                !std::getline(lineStream >> std::ws, paths))
+            {
+                DX_LOG(Warning, "AssetCooker", "Ignoring invalid manifest line: %s", line.c_str());
+                continue;
+            }
+            record.m_compression = static_cast<PackFileCompression>(compression);
+
+            std::vector<std::string> fileNames;
+            for (auto path : paths | std::views::split(Internal::ManifestPathSeparator))
+            {
+                fileNames.emplace_back(path.begin(), path.end());
+            }
+
+            record.m_dependencies.assign(fileNames.begin() + 1, fileNames.end());
+            manifest.emplace(std::move(fileNames.front()), std::move(record));
+        }
+
+        return manifest;
+    }
+
+    bool AssetCooker::SaveManifest(const CookManifest& manifest) const
+    {
+        std::ostringstream stream;
+        stream << Internal::ManifestHeader << " " << Internal::ManifestVersion << "\n";
+
+        for (const auto& [fileName, record] : manifest)
+        {
+            stream << std::hex << record.m_sourceHash << " " << record.m_importerFlags << " " << std::dec
+                << record.m_version << " " << static_cast<uint32_t>(record.m_compression) << " " << record.m_uncompressedSize << " "
+                << fileName;
+            for (const auto& dependency : record.m_dependencies)
+            {
+                stream << Internal::ManifestPathSeparator << dependency;
+            }
+            stream << "\n";
+        }
+
+        const std::string manifestText = stream.str();
+        return WriteFileAtomically(m_cachePath / Internal::ManifestFileName,
+            { reinterpret_cast<const uint8_t*>(manifestText.data()), manifestText.size() });
+    }
+
+    bool AssetCooker::WritePackFile(const CookManifest& manifest) const
+    {
+        // Files read by the importers, like gltf buffers, are only needed to cook.
+        std::set<std::string> dependencies;
+        for (const auto& record : manifest | std::views::values)
+        {
+            dependencies.insert(record.m_dependencies.begin(), record.m_dependencies.end());
+        }
+
+        PackFileWriter packFileWriter;
+        for (const auto& [fileName, record] : manifest)
+        {
+            const CookType cookType = GetCookType(fileName);
+            if (cookType == CookType::Copy && dependencies.contains(fileName))
+            {
+                continue;
+            }
+
+            MappedFile cachedFile(GetCachedFilePath(fileName, cookType), FileAccessPattern::Sequential);
+            if (!cachedFile.IsValid())
+            {
+                DX_LOG(Error, "AssetCooker", "Failed to read cached data of %s.", fileName.c_str());
+                return false;
+            }
+
+            packFileWriter.AddStoredEntry(
+                GetPackedFileName(fileName, cookType),
+                std::vector<uint8_t>(cachedFile.GetData().begin(), cachedFile.GetData().end()),
+                record.m_compression,
+                record.m_uncompressedSize);
+        }
+
+        const std::filesystem::path packFilePath = m_desc.m_outputPath / Internal::PackFileName;
+        if (!packFileWriter.Write(packFilePath))
+        {
+            DX_LOG(Error, "AssetCooker", "Failed to write %s.", packFilePath.generic_string().c_str());
+            return false;
+        }
+
+        DX_LOG(Info, "AssetCooker", "Written %s.", packFilePath.generic_string().c_str());
+        return true;
+    }
+} // namespace DX
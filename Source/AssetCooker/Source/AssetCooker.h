@@ -0,0 +1,110 @@
+#pragma once
+
+#include <File/PackFile.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace DX
+{
+    struct AssetCookerDesc
+    {
+        // Folder where Assets.pak and the cooked files cache are written.
+        std::filesystem::path m_outputPath;
+
+        // Cooks all assets, even the ones up to date.
+        bool m_forceCook = false;
+
+        // Thread count 0 uses the number of hardware threads.
+        uint32_t m_threadCount = 0;
+    };
+
+    // Cooks the files in the Assets folder and packs them in Assets.pak.
+    //
+    // Meshes are imported with assimp and textures are decoded with their mip chain
+    // generated, then stored in their cooked format (see CookedAsset.h), so the
+    // runtime loads them without running any importer. Other files, like shaders,
+    // are packed as they are.
+    //
+    // Cooking is incremental. The manifest in the cache keeps, for each file, the hash
+    // of its source and of the files the importer read (like gltf buffers), the importer
+    // flags and the version of the cooked formats. Only the files where any of them
+    // changed are cooked again, in parallel, and the rest reuse their cached cooked
+    // data, already compressed for the pack file.
+    class AssetCooker
+    {
+    public:
+        explicit AssetCooker(const AssetCookerDesc& desc);
+
+        AssetCooker(const AssetCooker&) = delete;
+        AssetCooker& operator=(const AssetCooker&) = delete;
+
+        // Returns false if any file failed to cook.
+        bool Cook();
+
+    private:
+        enum class CookType
+        {
+            Mesh,
+            Texture,
+            Copy // Packed as it is
+        };
+
+        struct CookRecord
+        {
+            // Hash of the source file and its dependencies.
+            uint64_t m_sourceHash = 0;
+            uint32_t m_importerFlags = 0;
+            uint32_t m_version = 0;
+
+            // How the cached data is stored in the pack file.
+            PackFileCompression m_compression = PackFileCompression::None;
+            uint64_t m_uncompressedSize = 0;
+
+            // Other files read when cooking, relative to the Assets folder.
+            std::vector<std::string> m_dependencies;
+        };
+
+        // Ordered by filename so the manifest and pack file are deterministic.
+        using CookManifest = std::map<std::string, CookRecord>;
+
+        struct CookResult
+        {
+            enum class Status
+            {
+                UpToDate,
+                Cooked,
+                Failed
+            };
+
+            Status m_status = Status::Failed;
+            CookRecord m_record;
+        };
+
+        static CookType GetCookType(const std::filesystem::path& filePath);
+        static uint32_t GetImporterFlags(CookType cookType);
+
+        // Cooks the file if it's not up to date with its record in the manifest.
+        CookResult CookFile(const std::string& fileName, CookType cookType, const CookRecord* manifestRecord) const;
+
+        std::optional<uint64_t> HashSourceFiles(const std::string& fileName, const std::vector<std::string>& dependencies) const;
+
+        // Filename of a file in the pack file, the cooked filename for cooked files.
+        static std::string GetPackedFileName(const std::string& fileName, CookType cookType);
+
+        // Path in the cache of the data to pack for a file.
+        std::filesystem::path GetCachedFilePath(const std::string& fileName, CookType cookType) const;
+
+        CookManifest LoadManifest() const;
+        bool SaveManifest(const CookManifest& manifest) const;
+
+        bool WritePackFile(const CookManifest& manifest) const;
+
+        AssetCookerDesc m_desc;
+        std::filesystem::path m_cachePath;
+    };
+} // namespace DX
@@ -0,0 +1,43 @@
+#include <AssetCooker.h>
+#include <File/FileUtils.h>
+#include <Log/Log.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+int main(int argc, char* argv[])
+{
+    // Assets.pak is written next to the executable unless another folder is given,
+    // usually the folder of the application that mounts it.
+    DX::AssetCookerDesc desc;
+    desc.m_outputPath = DX::GetExecutablePath();
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        if (argument == "--force")
+        {
+            desc.m_forceCook = true;
+        }
+        else if (argument == "--threads" && i + 1 < argc)
+        {
+            desc.m_threadCount = static_cast<uint32_t>(std::atoi(argv[++i]));
+        }
+        else if (argument.starts_with("--"))
+        {
+            std::printf("Usage: AssetCooker [OutputFolder] [--force] [--threads Count]\n");
+            return (argument == "--help") ? 0 : 1;
+        }
+        else
+        {
+            desc.m_outputPath = argument;
+        }
+    }
+
+    DX::AssetCooker assetCooker(desc);
+    const bool success = assetCooker.Cook();
+
+    DX_LOG(Info, "Main", "Done!");
+    return success ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+#include <Compression/LZ4.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr size_t MinMatch = 4;
+        static constexpr size_t LastLiterals = 5; // The last 5 bytes are always literals
+        static constexpr size_t MatchSearchLimit = 12; // The last match must start at least 12 bytes before the end
+        static constexpr size_t MaxOffset = 65535;
+        static constexpr int HashBits = 12;
+
+        static uint32_t Read32(const uint8_t* data)
+        {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        static uint32_t HashSequence(uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - HashBits);
+        }
+
+        // Lengths over 15 continue in extra bytes of 255 until a byte smaller than 255.
+        static void WriteLength(std::vector<uint8_t>& output, size_t length)
+        {
+            for (; length >= 255; length -= 255)
+            {
+                output.push_back(255);
+            }
+            output.push_back(static_cast<uint8_t>(length));
+        }
+
+        static bool ReadLength(const uint8_t*& input, const uint8_t* inputEnd, size_t& length)
+        {
+            uint8_t value = 0;
+            do
+            {
+                if (input >= inputEnd)
+                {
+                    return false;
+                }
+                value = *input++;
+                length += value;
+            } while (value == 255);
+            return true;
+        }
+
+        static void WriteSequence(std::vector<uint8_t>& output, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+        {
+            const size_t matchLengthCode = (matchLength > 0) ? matchLength - MinMatch : 0;
+
+            const uint8_t token = static_cast<uint8_t>(
+                (std::min<size_t>(literalLength, 15) << 4) |
+                std::min<size_t>(matchLengthCode, 15));
+            output.push_back(token);
+
+            if (literalLength >= 15)
+            {
+                WriteLength(output, literalLength - 15);
+            }
+            output.insert(output.end(), literals, literals + literalLength);
+
+            // Last sequence has only literals
+            if (matchLength == 0)
+            {
+                return;
+            }
+
+            output.push_back(static_cast<uint8_t>(offset & 0xFF));
+            output.push_back(static_cast<uint8_t>(offset >> 8));
+
+            if (matchLengthCode >= 15)
+            {
+                WriteLength(output, matchLengthCode - 15);
+            }
+        }
+    } // namespace Internal
+
+    std::vector<uint8_t> CompressLZ4(std::span<const uint8_t> data)
+    {
+        using namespace Internal;
+
+        std::vector<uint8_t> output;
+        output.reserve(data.size() + data.size() / 255 + 16);
+
+        const uint8_t* const begin = data.data();
+        const uint8_t* const end = begin + data.size();
+        const uint8_t* literals = begin;
+
+        if (data.size() > MatchSearchLimit)
+        {
+            // Position + 1 of the last occurrence of each hashed 4 byte sequence, 0 when empty.
+            std::array<uint32_t, 1 << HashBits> hashTable = {};
+
+            const uint8_t* const matchLimit = end - LastLiterals;
+            const uint8_t* const searchLimit = end - MatchSearchLimit;
+
+            const uint8_t* current = begin;
+            while (current < searchLimit)
+            {
+                const uint32_t sequence = Read32(current);
+                const uint32_t hash = HashSequence(sequence);
+                const uint32_t candidatePosition = hashTable[hash];
+                hashTable[hash] = static_cast<uint32_t>(current - begin) + 1;
+
+                const uint8_t* match = (candidatePosition > 0) ? begin + candidatePosition - 1 : nullptr;
+                if (!match ||
+                    static_cast<size_t>(current - match) > MaxOffset ||
+                    Read32(match) != sequence)
+                {
+                    ++current;
+                    continue;
+                }
+
+                // Extend the match forward, stopping before the last literals.
+                size_t matchLength = MinMatch;
+                while (current + matchLength < matchLimit && current[matchLength] == match[matchLength])
+                {
+                    ++matchLength;
+                }
+
+                WriteSequence(output, literals, current - literals, current - match, matchLength);
+
+                current += matchLength;
+                literals = current;
+            }
+        }
+
+        WriteSequence(output, literals, end - literals, 0, 0);
+
+        return output;
+    }
+
+    bool DecompressLZ4(std::span<const uint8_t> compressedData, std::span<uint8_t> data)
+    {
+        using namespace Internal;
+
+        const uint8_t* input = compressedData.data();
+        const uint8_t* const inputEnd = input + compressedData.size();
+
+        uint8_t* output = data.data();
+        uint8_t* const outputBegin = output;
+        uint8_t* const outputEnd = output + data.size();
+
+        while (input < inputEnd)
+        {
+            const uint8_t token = *input++;
+
+            // Literals
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !ReadLength(input, inputEnd, literalLength))
+            {
+                return false;
+            }
+            if (literalLength > static_cast<size_t>(inputEnd - input) ||
+                literalLength > static_cast<size_t>(outputEnd - output))
+            {
+                return false;
+            }
+            std::memcpy(output, input, literalLength);
+            input += literalLength;
+            output += literalLength;
+
+            // Last sequence has no match
+            if (input == inputEnd)
+            {
+                break;
+            }
+
+            // Match
+            if (inputEnd - input < 2)
+            {
+                return false;
+            }
+            const size_t offset = input[0] | (input[1] << 8);
+            input += 2;
+
+            size_t matchLength = token & 0x0F;
+            if (matchLength == 15 && !ReadLength(input, inputEnd, matchLength))
+            {
+                return false;
+            }
+            matchLength += MinMatch;
+
+            if (offset == 0 ||
+                offset > static_cast<size_t>(output - outputBegin) ||
+                matchLength > static_cast<size_t>(outputEnd - output))
+            {
+                return false;
+            }
+
+            // Byte by byte copy, the match can overlap with the output being written.
+            const uint8_t* match = output - offset;
+            for (size_t i = 0; i < matchLength; ++i)
+            {
+                output[i] = match[i];
+            }
+            output += matchLength;
+        }
+
+        return output == outputEnd;
+    }
+} // namespace DX
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace DX
+{
+    // Compression and decompression using the LZ4 block format.
+    // It favours decompression speed over compression ratio,
+    // decompressing at several GB/s, which makes it a good fit
+    // for data compressed once offline and read many times.
+
+    // Returns the compressed data.
+    std::vector<uint8_t> CompressLZ4(std::span<const uint8_t> data);
+
+    // Decompresses the data into the destination, which must have the exact size
+    // of the uncompressed data. Returns false if the compressed data is corrupt.
+    bool DecompressLZ4(std::span<const uint8_t> compressedData, std::span<uint8_t> data);
+} // namespace DX
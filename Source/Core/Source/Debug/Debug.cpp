@@ -8,7 +8,7 @@
 #include <Windows.h>
 #endif
 
-#pragma DX_DISABLE_WARNING(4996, "")
+DX_DISABLE_WARNING(4996, "-Wdeprecated-declarations")
 
 namespace DX::Internal
 {
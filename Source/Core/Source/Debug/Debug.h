@@ -3,16 +3,19 @@
 // -------------------------------------------------------
 // Usage:
 // 
-// #pragma DX_IGNORE_WARNING(4101, "-Wunused-variable")
+// DX_DISABLE_WARNING(4101, "-Wunused-variable")
 // -------------------------------------------------------
 
+// Pragmas are emitted with _Pragma and __pragma, GCC doesn't expand macros in #pragma directives.
+#define DX_PRAGMA(pragma) _Pragma(#pragma)
+
 #if defined(__GNUC__)
 
-#define DX_DISABLE_WARNING(msvc_warning_number, gcc_clang_warning_string)    GCC diagnostic ignored gcc_clang_warning_string
+#define DX_DISABLE_WARNING(msvc_warning_number, gcc_clang_warning_string)    DX_PRAGMA(GCC diagnostic ignored gcc_clang_warning_string)
 
 #elif defined(_MSC_VER)
 
-#define DX_DISABLE_WARNING(msvc_warning_number, gcc_clang_warning_string)    warning(disable : msvc_warning_number)
+#define DX_DISABLE_WARNING(msvc_warning_number, gcc_clang_warning_string)    __pragma(warning(disable : msvc_warning_number))
 
 #else
 
@@ -38,7 +41,7 @@
 
 // Disable warning 4189: local variable is initialized but not referenced
 // This happens often in release configuration when using DX_ASSERT()
-#pragma DX_DISABLE_WARNING(4189, "")
+DX_DISABLE_WARNING(4189, "-Wunused-variable")
 
 #endif // NDEBUG
 
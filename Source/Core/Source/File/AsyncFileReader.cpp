@@ -0,0 +1,595 @@
+#include <File/AsyncFileReader.h>
+#include <Log/Log.h>
+
+#include <algorithm>
+#include <fstream>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace DX
+{
+    namespace Internal
+    {
+        static FileReadResult ReadWholeFile(const std::filesystem::path& filePath)
+        {
+            std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+            if (!file.is_open())
+            {
+                DX_LOG(Error, "AsyncFileReader", "Filename path %s failed to open.", filePath.generic_string().c_str());
+                return {};
+            }
+
+            FileReadResult result;
+            result.m_data.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(std::streamoff(0), std::ios_base::beg);
+            if (!file.read(reinterpret_cast<char*>(result.m_data.data()), result.m_data.size()))
+            {
+                DX_LOG(Error, "AsyncFileReader", "Filename path %s failed to read.", filePath.generic_string().c_str());
+                return {};
+            }
+
+            result.m_status = FileReadStatus::Success;
+            return result;
+        }
+    } // namespace Internal
+
+#ifdef __linux__
+    // io_uring is used directly through its system calls, which avoids depending on liburing.
+    struct AsyncFileReader::IoUring
+    {
+        ~IoUring()
+        {
+            if (m_sqes)
+            {
+                munmap(m_sqes, m_sqesSize);
+            }
+            if (m_cqRing && m_cqRing != m_sqRing)
+            {
+                munmap(m_cqRing, m_cqRingSize);
+            }
+            if (m_sqRing)
+            {
+                munmap(m_sqRing, m_sqRingSize);
+            }
+            if (m_ringFd >= 0)
+            {
+                close(m_ringFd);
+            }
+        }
+
+        // Read in flight, its index in m_reads is the user data of the submission.
+        struct Read
+        {
+            std::shared_ptr<Request> m_request;
+            int m_fileFd = -1;
+            std::vector<uint8_t> m_data;
+            size_t m_offset = 0;
+        };
+
+        void PrepareRead(uint32_t readIndex)
+        {
+            // Reads of a single submission are limited to 32 bits, bigger files take several submissions.
+            static constexpr size_t MaxReadSize = 1u << 30;
+
+            Read& read = m_reads[readIndex];
+
+            // Only this thread writes the tail of the submission queue.
+            const unsigned tail = *m_sqTail;
+            const unsigned index = tail & *m_sqMask;
+
+            io_uring_sqe& sqe = m_sqes[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_READ;
+            sqe.fd = read.m_fileFd;
+            sqe.addr = reinterpret_cast<uint64_t>(read.m_data.data() + read.m_offset);
+            sqe.len = static_cast<uint32_t>(std::min(read.m_data.size() - read.m_offset, MaxReadSize));
+            sqe.off = read.m_offset;
+            sqe.user_data = readIndex;
+
+            m_sqArray[index] = index;
+            std::atomic_ref<unsigned>(*m_sqTail).store(tail + 1, std::memory_order_release);
+
+            ++m_toSubmit;
+        }
+
+        int m_ringFd = -1;
+        uint32_t m_entries = 0;
+
+        void* m_sqRing = nullptr;
+        size_t m_sqRingSize = 0;
+        void* m_cqRing = nullptr;
+        size_t m_cqRingSize = 0;
+        io_uring_sqe* m_sqes = nullptr;
+        size_t m_sqesSize = 0;
+
+        unsigned* m_sqTail = nullptr;
+        unsigned* m_sqMask = nullptr;
+        unsigned* m_sqArray = nullptr;
+        unsigned* m_cqHead = nullptr;
+        unsigned* m_cqTail = nullptr;
+        unsigned* m_cqMask = nullptr;
+        io_uring_cqe* m_cqes = nullptr;
+
+        std::vector<Read> m_reads;
+        std::vector<uint32_t> m_freeReads;
+        uint32_t m_toSubmit = 0;
+    };
+
+    bool AsyncFileReader::CreateIoUring(uint32_t queueDepth)
+    {
+        auto ioUring = std::make_unique<IoUring>();
+
+        io_uring_params params = {};
+        ioUring->m_ringFd = static_cast<int>(syscall(__NR_io_uring_setup, queueDepth, &params));
+        if (ioUring->m_ringFd < 0)
+        {
+            DX_LOG(Verbose, "AsyncFileReader", "io_uring is not available: %s.", std::strerror(errno));
+            return false;
+        }
+
+        // Kernels before 5.6 have io_uring without IORING_OP_READ, every read would fail.
+        // Probing was added in the same version, so failing to probe means reads are not supported.
+        {
+            static constexpr uint32_t ProbeOpCount = 256;
+            std::vector<uint8_t> probeData(sizeof(io_uring_probe) + ProbeOpCount * sizeof(io_uring_probe_op), 0);
+            io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(probeData.data());
+            if (syscall(__NR_io_uring_register, ioUring->m_ringFd, IORING_REGISTER_PROBE, probe, ProbeOpCount) < 0 ||
+                probe->last_op < IORING_OP_READ ||
+                (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) == 0)
+            {
+                DX_LOG(Verbose, "AsyncFileReader", "io_uring is not available: reads are not supported by the kernel.");
+                return false;
+            }
+        }
+
+        ioUring->m_entries = params.sq_entries;
+        ioUring->m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        ioUring->m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        ioUring->m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+        // Newer kernels map both rings with a single mapping.
+        const bool singleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMapping)
+        {
+            ioUring->m_sqRingSize = ioUring->m_cqRingSize = std::max(ioUring->m_sqRingSize, ioUring->m_cqRingSize);
+        }
+
+        auto mapRing = [&](size_t size, uint64_t offset) -> void*
+            {
+                void* ring = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ioUring->m_ringFd, offset);
+                return (ring == MAP_FAILED) ? nullptr : ring;
+            };
+
+        ioUring->m_sqRing = mapRing(ioUring->m_sqRingSize, IORING_OFF_SQ_RING);
+        ioUring->m_cqRing = singleMapping ? ioUring->m_sqRing : mapRing(ioUring->m_cqRingSize, IORING_OFF_CQ_RING);
+        ioUring->m_sqes = static_cast<io_uring_sqe*>(mapRing(ioUring->m_sqesSize, IORING_OFF_SQES));
+        if (!ioUring->m_sqRing || !ioUring->m_cqRing || !ioUring->m_sqes)
+        {
+            DX_LOG(Error, "AsyncFileReader", "Failed to map io_uring rings.");
+            return false;
+        }
+
+        uint8_t* sqRing = static_cast<uint8_t*>(ioUring->m_sqRing);
+        ioUring->m_sqTail = reinterpret_cast<unsigned*>(sqRing + params.sq_off.tail);
+        ioUring->m_sqMask = reinterpret_cast<unsigned*>(sqRing + params.sq_off.ring_mask);
+        ioUring->m_sqArray = reinterpret_cast<unsigned*>(sqRing + params.sq_off.array);
+
+        uint8_t* cqRing = static_cast<uint8_t*>(ioUring->m_cqRing);
+        ioUring->m_cqHead = reinterpret_cast<unsigned*>(cqRing + params.cq_off.head);
+        ioUring->m_cqTail = reinterpret_cast<unsigned*>(cqRing + params.cq_off.tail);
+        ioUring->m_cqMask = reinterpret_cast<unsigned*>(cqRing + params.cq_off.ring_mask);
+        ioUring->m_cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+
+        ioUring->m_reads.resize(ioUring->m_entries);
+        for (uint32_t i = ioUring->m_entries; i > 0; --i)
+        {
+            ioUring->m_freeReads.push_back(i - 1);
+        }
+
+        m_ioUring = std::move(ioUring);
+        return true;
+    }
+
+    void AsyncFileReader::IoUringLoop()
+    {
+        IoUring& ioUring = *m_ioUring;
+        uint32_t readsInFlight = 0;
+
+        // Set when io_uring_enter keeps failing. Reads in flight are failed and the
+        // next requests are read with blocking reads from this thread.
+        bool ringFailed = false;
+
+        auto finishRead = [&](uint32_t readIndex, FileReadStatus status)
+            {
+                IoUring::Read& read = ioUring.m_reads[readIndex];
+                close(read.m_fileFd);
+
+                FileReadResult result;
+                result.m_status = status;
+                if (status == FileReadStatus::Success)
+                {
+                    result.m_data = std::move(read.m_data);
+                }
+                CompleteRequest(*read.m_request, std::move(result));
+
+                read = {};
+                ioUring.m_freeReads.push_back(readIndex);
+                --readsInFlight;
+            };
+
+        while (true)
+        {
+            // Take as many requests as free reads there are.
+            std::vector<std::shared_ptr<Request>> requests;
+            {
+                std::unique_lock lock(m_mutex);
+                if (readsInFlight == 0)
+                {
+                    m_condition.wait(lock, [this]()
+                        {
+                            return m_stop || std::ranges::any_of(m_pendingRequests, [](const auto& pending) { return !pending.empty(); });
+                        });
+                }
+
+                const size_t maxRequests = ringFailed ? 1 : ioUring.m_freeReads.size();
+                while (requests.size() < maxRequests)
+                {
+                    auto request = PopRequest();
+                    if (!request)
+                    {
+                        break;
+                    }
+                    requests.push_back(std::move(request));
+                }
+
+                if (m_stop && requests.empty() && readsInFlight == 0)
+                {
+                    return;
+                }
+            }
+
+            for (auto& request : requests)
+            {
+                if (request->m_cancelled)
+                {
+                    CompleteRequest(*request, { FileReadStatus::Cancelled, {} });
+                    continue;
+                }
+
+                if (ringFailed)
+                {
+                    CompleteRequest(*request, Internal::ReadWholeFile(request->m_filePath));
+                    continue;
+                }
+
+                const int fileFd = open(request->m_filePath.c_str(), O_RDONLY | O_CLOEXEC);
+                struct stat fileStat = {};
+                if (fileFd < 0 || fstat(fileFd, &fileStat) != 0)
+                {
+                    DX_LOG(Error, "AsyncFileReader", "Filename path %s failed to open.", request->m_filePath.generic_string().c_str());
+                    if (fileFd >= 0)
+                    {
+                        close(fileFd);
+                    }
+                    CompleteRequest(*request, {});
+                    continue;
+                }
+
+                const uint32_t readIndex = ioUring.m_freeReads.back();
+                ioUring.m_freeReads.pop_back();
+                ++readsInFlight;
+
+                IoUring::Read& read = ioUring.m_reads[readIndex];
+                read.m_request = std::move(request);
+                read.m_fileFd = fileFd;
+                read.m_data.resize(static_cast<size_t>(fileStat.st_size));
+
+                if (read.m_data.empty())
+                {
+                    finishRead(readIndex, FileReadStatus::Success);
+                    continue;
+                }
+
+                ioUring.PrepareRead(readIndex);
+            }
+
+            if (readsInFlight == 0)
+            {
+                continue;
+            }
+
+            // Submit all the reads prepared and wait for at least one to complete.
+            const int submitted = static_cast<int>(syscall(__NR_io_uring_enter, ioUring.m_ringFd, ioUring.m_toSubmit, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+            if (submitted >= 0)
+            {
+                ioUring.m_toSubmit -= submitted;
+            }
+            else if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+            {
+                // Other errors don't go away by trying again, reads would never complete.
+                DX_LOG(Error, "AsyncFileReader", "io_uring failed to submit reads, using blocking reads: %s.", std::strerror(errno));
+
+                // The kernel could still write to the data of reads already submitted,
+                // so it's kept until the ring is destroyed and the reads are not reused.
+                for (IoUring::Read& read : ioUring.m_reads)
+                {
+                    if (read.m_request)
+                    {
+                        close(read.m_fileFd);
+                        CompleteRequest(*read.m_request, {});
+                        read.m_request.reset();
+                    }
+                }
+                readsInFlight = 0;
+                ringFailed = true;
+                continue;
+            }
+
+            unsigned head = *ioUring.m_cqHead;
+            const unsigned tail = std::atomic_ref<unsigned>(*ioUring.m_cqTail).load(std::memory_order_acquire);
+            for (; head != tail; ++head)
+            {
+                const io_uring_cqe& cqe = ioUring.m_cqes[head & *ioUring.m_cqMask];
+                const uint32_t readIndex = static_cast<uint32_t>(cqe.user_data);
+                IoUring::Read& read = ioUring.m_reads[readIndex];
+
+                if (cqe.res == -EINTR || cqe.res == -EAGAIN)
+                {
+                    ioUring.PrepareRead(readIndex);
+                }
+                else if (cqe.res < 0)
+                {
+                    DX_LOG(Error, "AsyncFileReader", "Filename path %s failed to read: %s.",
+                        read.m_request->m_filePath.generic_string().c_str(), std::strerror(-cqe.res));
+                    finishRead(readIndex, FileReadStatus::Failed);
+                }
+                else if (cqe.res == 0)
+                {
+                    // File got smaller after opening it
+                    read.m_data.resize(read.m_offset);
+                    finishRead(readIndex, FileReadStatus::Success);
+                }
+                else
+                {
+                    // Short reads continue where they left.
+                    read.m_offset += cqe.res;
+                    if (read.m_offset < read.m_data.size())
+                    {
+                        ioUring.PrepareRead(readIndex);
+                    }
+                    else
+                    {
+                        finishRead(readIndex, FileReadStatus::Success);
+                    }
+                }
+            }
+            std::atomic_ref<unsigned>(*ioUring.m_cqHead).store(head, std::memory_order_release);
+        }
+    }
+#else
+    struct AsyncFileReader::IoUring
+    {
+    };
+
+    bool AsyncFileReader::CreateIoUring([[maybe_unused]] uint32_t queueDepth)
+    {
+        return false;
+    }
+
+    void AsyncFileReader::IoUringLoop()
+    {
+    }
+#endif
+
+    AsyncFileReader::AsyncFileReader(Backend backend, uint32_t queueDepth)
+    {
+        queueDepth = std::max(queueDepth, 1u);
+
+        if (backend != Backend::ThreadPool && CreateIoUring(queueDepth))
+        {
+            m_backend = Backend::IoUring;
+            m_threads.emplace_back(&AsyncFileReader::IoUringLoop, this);
+        }
+        else
+        {
+            if (backend == Backend::IoUring)
+            {
+                DX_LOG(Warning, "AsyncFileReader", "io_uring not available, using thread pool.");
+            }
+
+            // Blocking reads, each thread keeps one read in flight.
+            const uint32_t threadCount = std::min(queueDepth, std::max(4u, std::thread::hardware_concurrency()));
+
+            m_backend = Backend::ThreadPool;
+            m_threads.reserve(threadCount);
+            for (uint32_t i = 0; i < threadCount; ++i)
+            {
+                m_threads.emplace_back(&AsyncFileReader::ThreadPoolWorkerLoop, this);
+            }
+        }
+    }
+
+    AsyncFileReader::~AsyncFileReader()
+    {
+        std::vector<std::shared_ptr<Request>> cancelledRequests;
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+            for (auto& pendingRequests : m_pendingRequests)
+            {
+                cancelledRequests.insert(cancelledRequests.end(), pendingRequests.begin(), pendingRequests.end());
+                pendingRequests.clear();
+            }
+        }
+        m_condition.notify_all();
+
+        for (auto& request : cancelledRequests)
+        {
+            CompleteRequest(*request, { FileReadStatus::Cancelled, {} });
+        }
+
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    FileReadHandle AsyncFileReader::Read(FileReadRequest request)
+    {
+        FileReadHandle handle;
+        {
+            std::lock_guard lock(m_mutex);
+            handle = QueueRequest(std::move(request));
+        }
+        m_condition.notify_one();
+        return handle;
+    }
+
+    std::vector<FileReadHandle> AsyncFileReader::ReadBatch(std::vector<FileReadRequest> requests)
+    {
+        std::vector<FileReadHandle> handles;
+        handles.reserve(requests.size());
+        {
+            std::lock_guard lock(m_mutex);
+            for (auto& request : requests)
+            {
+                handles.push_back(QueueRequest(std::move(request)));
+            }
+        }
+        m_condition.notify_all();
+        return handles;
+    }
+
+    bool AsyncFileReader::Cancel(FileReadRequestId requestId)
+    {
+        std::shared_ptr<Request> cancelledRequest;
+        {
+            std::lock_guard lock(m_mutex);
+            for (auto& pendingRequests : m_pendingRequests)
+            {
+                if (auto it = std::ranges::find(pendingRequests, requestId, &Request::m_requestId);
+                    it != pendingRequests.end())
+                {
+                    cancelledRequest = std::move(*it);
+                    pendingRequests.erase(it);
+                    break;
+                }
+            }
+
+            if (!cancelledRequest)
+            {
+                // Requests in flight complete as cancelled.
+                if (auto it = m_inFlightRequests.find(requestId);
+                    it != m_inFlightRequests.end())
+                {
+                    it->second->m_cancelled = true;
+                    return true;
+                }
+                return false;
+            }
+        }
+
+        CompleteRequest(*cancelledRequest, { FileReadStatus::Cancelled, {} });
+        return true;
+    }
+
+    const char* AsyncFileReader::GetBackendName() const
+    {
+        return (m_backend == Backend::IoUring) ? "io_uring" : "thread pool";
+    }
+
+    FileReadHandle AsyncFileReader::QueueRequest(FileReadRequest request)
+    {
+        auto newRequest = std::make_shared<Request>();
+        newRequest->m_requestId = FileReadRequestId(m_nextRequestId++);
+        newRequest->m_filePath = std::move(request.m_filePath);
+        newRequest->m_callback = std::move(request.m_callback);
+
+        FileReadHandle handle;
+        handle.m_requestId = newRequest->m_requestId;
+        if (!newRequest->m_callback)
+        {
+            handle.m_future = newRequest->m_promise.get_future();
+        }
+
+        m_pendingRequests[static_cast<size_t>(request.m_priority)].push_back(std::move(newRequest));
+        return handle;
+    }
+
+    std::shared_ptr<AsyncFileReader::Request> AsyncFileReader::PopRequest()
+    {
+        // Highest priority first, in the order they were requested.
+        for (auto it = m_pendingRequests.rbegin(); it != m_pendingRequests.rend(); ++it)
+        {
+            if (!it->empty())
+            {
+                auto request = std::move(it->front());
+                it->pop_front();
+                m_inFlightRequests.emplace(request->m_requestId, request);
+                return request;
+            }
+        }
+        return nullptr;
+    }
+
+    void AsyncFileReader::CompleteRequest(Request& request, FileReadResult result)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_inFlightRequests.erase(request.m_requestId);
+        }
+
+        if (request.m_cancelled)
+        {
+            result = { FileReadStatus::Cancelled, {} };
+        }
+
+        if (request.m_callback)
+        {
+            request.m_callback(std::move(result));
+        }
+        else
+        {
+            request.m_promise.set_value(std::move(result));
+        }
+    }
+
+    void AsyncFileReader::ThreadPoolWorkerLoop()
+    {
+        while (true)
+        {
+            std::shared_ptr<Request> request;
+            {
+                std::unique_lock lock(m_mutex);
+                m_condition.wait(lock, [this]()
+                    {
+                        return m_stop || std::ranges::any_of(m_pendingRequests, [](const auto& pending) { return !pending.empty(); });
+                    });
+
+                // Pending requests are cancelled when stopping, the queue is empty.
+                request = PopRequest();
+                if (!request)
+                {
+                    return;
+                }
+            }
+
+            if (request->m_cancelled)
+            {
+                CompleteRequest(*request, { FileReadStatus::Cancelled, {} });
+                continue;
+            }
+
+            CompleteRequest(*request, Internal::ReadWholeFile(request->m_filePath));
+        }
+    }
+} // namespace DX
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <GenericId/GenericId.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace DX
+{
+    // -------------------------------------------------------
+    // Usage:
+    //
+    // AsyncFileReader fileReader;
+    //
+    // // Reading with a future
+    // FileReadHandle handle = fileReader.Read({ "Data.bin" });
+    // FileReadResult result = handle.m_future.get(); // Blocks until the file is read.
+    //
+    // // Reading with a callback, called from an I/O thread.
+    // fileReader.Read({ "Data.bin", FileReadPriority::High, [](FileReadResult result) { ... } });
+    // -------------------------------------------------------
+
+    enum class FileReadPriority
+    {
+        Low,
+        Normal,
+        High,
+
+        Count
+    };
+
+    enum class FileReadStatus
+    {
+        Success,
+        Failed,
+        Cancelled
+    };
+
+    struct FileReadResult
+    {
+        FileReadStatus m_status = FileReadStatus::Failed;
+        std::vector<uint8_t> m_data;
+    };
+
+    using FileReadCallback = std::function<void(FileReadResult result)>;
+
+    using FileReadRequestId = GenericId<struct FileReadRequestIdTag>;
+
+    struct FileReadRequest
+    {
+        FileReadRequest() = default;
+        FileReadRequest(std::filesystem::path filePath, FileReadPriority priority = FileReadPriority::Normal, FileReadCallback callback = {})
+            : m_filePath(std::move(filePath))
+            , m_priority(priority)
+            , m_callback(std::move(callback))
+        {
+        }
+
+        std::filesystem::path m_filePath;
+        FileReadPriority m_priority = FileReadPriority::Normal;
+
+        // When provided, the result is passed to the callback instead of the future.
+        // It's called from an I/O thread.
+        FileReadCallback m_callback;
+    };
+
+    struct FileReadHandle
+    {
+        FileReadRequestId m_requestId;
+        std::future<FileReadResult> m_future; // Not valid when the request has a callback.
+    };
+
+    // Reads whole files asynchronously.
+    //
+    // Requests are queued by priority and many reads are kept in flight at
+    // the same time, so the disk queue is kept full. On Linux it uses io_uring,
+    // submitting all reads of a batch with a single system call. Otherwise,
+    // or when io_uring or its reads are not available, reads are done by a pool
+    // of threads. If submitting to io_uring keeps failing, the reads in flight
+    // fail and the next ones are blocking reads from the io_uring thread.
+    class AsyncFileReader
+    {
+    public:
+        enum class Backend
+        {
+            Auto, // io_uring when available, thread pool otherwise.
+            IoUring,
+            ThreadPool
+        };
+
+        // Queue depth is the maximum number of reads in flight.
+        explicit AsyncFileReader(Backend backend = Backend::Auto, uint32_t queueDepth = 64);
+
+        // Pending requests are cancelled and reads in flight are finished.
+        ~AsyncFileReader();
+
+        AsyncFileReader(const AsyncFileReader&) = delete;
+        AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+        FileReadHandle Read(FileReadRequest request);
+
+        // Queues all the requests at once, they are submitted together.
+        std::vector<FileReadHandle> ReadBatch(std::vector<FileReadRequest> requests);
+
+        // Cancels a request. Requests not started yet are not read, requests in flight
+        // complete as cancelled and their data is discarded. Returns false if the
+        // request has already completed.
+        bool Cancel(FileReadRequestId requestId);
+
+        Backend GetBackend() const { return m_backend; }
+        const char* GetBackendName() const;
+
+    private:
+        struct Request
+        {
+            FileReadRequestId m_requestId;
+            std::filesystem::path m_filePath;
+            FileReadCallback m_callback;
+            std::promise<FileReadResult> m_promise;
+            std::atomic<bool> m_cancelled = false;
+        };
+
+        FileReadHandle QueueRequest(FileReadRequest request); // Requires m_mutex locked.
+        std::shared_ptr<Request> PopRequest(); // Requires m_mutex locked.
+        void CompleteRequest(Request& request, FileReadResult result);
+
+        void ThreadPoolWorkerLoop();
+
+        struct IoUring;
+        bool CreateIoUring(uint32_t queueDepth);
+        void IoUringLoop();
+
+        Backend m_backend = Backend::ThreadPool;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::array<std::deque<std::shared_ptr<Request>>, static_cast<size_t>(FileReadPriority::Count)> m_pendingRequests;
+        std::unordered_map<FileReadRequestId, std::shared_ptr<Request>> m_inFlightRequests;
+        uint64_t m_nextRequestId = 1;
+        bool m_stop = false;
+
+        std::unique_ptr<IoUring> m_ioUring;
+        std::vector<std::thread> m_threads;
+    };
+} // namespace DX
@@ -1,103 +1,237 @@
 #include <File/FileUtils.h>
+#include <File/PackFile.h>
 #include <Log/Log.h>
 
-#include <array>
+#include <atomic>
 #include <fstream>
-#include <sstream>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
+#else
+#include <unistd.h>
 #endif
 
 namespace DX
 {
-    std::optional<std::string> ReadAssetTextFile(const std::string& fileName)
+    namespace Internal
     {
-        auto fileNamePath = GetAssetPath() / fileName;
-        if (!std::filesystem::exists(fileNamePath))
+        struct MountedPackFiles
         {
-            DX_LOG(Error, "FileUtils", "Filename path % s does not exist.", fileNamePath.generic_string().c_str());
-            return std::nullopt;
+            std::shared_mutex m_mutex;
+            std::vector<std::shared_ptr<const PackFile>> m_packFiles;
+        };
+
+        // Unique per process, thread and call, so writers of the same file never share the temporary file.
+        static std::filesystem::path MakeTempFilePath(const std::filesystem::path& filePath)
+        {
+            static std::atomic<uint32_t> tempFileCount = 0;
+
+#ifdef _WIN32
+            const unsigned long processId = GetCurrentProcessId();
+#else
+            const unsigned long processId = static_cast<unsigned long>(getpid());
+#endif
+            const size_t threadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+            std::filesystem::path tempFilePath = filePath;
+            for (const std::string& part : { std::to_string(processId), std::to_string(threadId), std::to_string(tempFileCount++) })
+            {
+                tempFilePath += ".";
+                tempFilePath += part;
+            }
+            tempFilePath += ".tmp";
+            return tempFilePath;
         }
 
-        if (std::ifstream file(fileNamePath);
-            file.is_open())
+        static MountedPackFiles& GetMountedPackFiles()
         {
-            std::ostringstream stringBuffer;
-            stringBuffer << file.rdbuf();
+            static MountedPackFiles mountedPackFiles;
+            return mountedPackFiles;
+        }
 
-            file.close();
-            return stringBuffer.str();
+        // Finds the last mounted pack file with the entry.
+        static std::pair<std::shared_ptr<const PackFile>, const PackFileEntry*> FindPackFileEntry(const std::string& fileName)
+        {
+            MountedPackFiles& mountedPackFiles = GetMountedPackFiles();
+
+            std::shared_lock lock(mountedPackFiles.m_mutex);
+            for (auto it = mountedPackFiles.m_packFiles.rbegin(); it != mountedPackFiles.m_packFiles.rend(); ++it)
+            {
+                if (const PackFileEntry* entry = (*it)->FindEntry(fileName))
+                {
+                    return { *it, entry };
+                }
+            }
+            return { nullptr, nullptr };
         }
-        else
+
+        static std::filesystem::path FindAssetPath()
         {
-            DX_LOG(Error, "FileUtils", "Filename path %s failed to open.", fileNamePath.generic_string().c_str());
-            return std::nullopt;
+            auto execPath = GetExecutablePath();
+            execPath /= "Assets";
+            if (std::filesystem::exists(execPath))
+            {
+                return execPath;
+            }
+
+            // If the Assets folder is not in the same location as the executable,
+            // that could be because the executable is being run from a build folder
+            // (for example from Visual Studio). Try to find the 'build' folder to
+            // extract the project path and use that to look for the Assets folder.
+            if (auto it = execPath.generic_string().find("build");
+                it != std::string::npos)
+            {
+                std::filesystem::path projectPath = execPath.generic_string().substr(0, it);
+                projectPath /= "Assets";
+                if (std::filesystem::exists(projectPath))
+                {
+                    return projectPath;
+                }
+            }
+
+            DX_LOG(Error, "FileUtils", "Assets path not found.");
+            return {};
         }
-    }
+    } // namespace Internal
 
-    std::optional<std::vector<uint8_t>> ReadAssetBinaryFile(const std::string& fileName)
+    bool MountPackFile(const std::filesystem::path& packFilePath)
     {
-        auto fileNamePath = GetAssetPath() / fileName;
-        if (!std::filesystem::exists(fileNamePath))
+        auto packFile = std::make_shared<const PackFile>(packFilePath);
+        if (!packFile->IsValid())
         {
-            DX_LOG(Error, "FileUtils", "Filename path % s does not exist.", fileNamePath.generic_string().c_str());
-            return std::nullopt;
+            return false;
         }
 
-        // Open binary file seeking to the end of the stream immediately
-        if (std::ifstream file(fileNamePath, std::ios::binary | std::ios::ate);
-            file.is_open())
-        {
-            // Get file size and seek to the beginning of the file
-            const std::streamsize fileSize = file.tellg();
-            file.seekg(std::streamoff(0), std::ios_base::beg);
+        Internal::MountedPackFiles& mountedPackFiles = Internal::GetMountedPackFiles();
+
+        std::unique_lock lock(mountedPackFiles.m_mutex);
+        mountedPackFiles.m_packFiles.push_back(std::move(packFile));
+        return true;
+    }
+
+    void UnmountPackFiles()
+    {
+        Internal::MountedPackFiles& mountedPackFiles = Internal::GetMountedPackFiles();
 
-            // Read entire file
-            std::vector<uint8_t> buffer(fileSize);
-            if (!file.read(reinterpret_cast<char*>(buffer.data()), fileSize))
+        // Asset files still open keep their pack file alive.
+        std::unique_lock lock(mountedPackFiles.m_mutex);
+        mountedPackFiles.m_packFiles.clear();
+    }
+
+    std::optional<AssetFile> OpenAssetFile(const std::string& fileName, FileAccessPattern accessPattern)
+    {
+        if (auto [packFile, entry] = Internal::FindPackFileEntry(fileName);
+            packFile)
+        {
+            AssetFile assetFile;
+            if (entry->m_compression == PackFileCompression::None)
             {
-                file.close();
-                DX_LOG(Error, "FileUtils", "Filename path %s failed to read.", fileNamePath.generic_string().c_str());
-                return std::nullopt;
+                assetFile.m_data = packFile->GetEntryData(*entry);
+                assetFile.m_packFile = std::move(packFile);
             }
+            else
+            {
+                auto data = packFile->ReadEntry(*entry);
+                if (!data)
+                {
+                    return std::nullopt;
+                }
+                assetFile.m_decompressedData = std::move(*data);
+                assetFile.m_data = assetFile.m_decompressedData;
+            }
+            return assetFile;
+        }
 
-            file.close();
-            return buffer;
+        AssetFile assetFile;
+        assetFile.m_mappedFile = MappedFile(GetAssetPath() / fileName, accessPattern);
+        if (!assetFile.m_mappedFile.IsValid())
+        {
+            return std::nullopt;
         }
-        else
+        assetFile.m_data = assetFile.m_mappedFile.GetData();
+        return assetFile;
+    }
+
+    bool AssetFileExists(const std::string& fileName)
+    {
+        return Internal::FindPackFileEntry(fileName).second != nullptr ||
+            std::filesystem::exists(GetAssetPath() / fileName);
+    }
+
+    bool IsAssetFilePacked(const std::string& fileName)
+    {
+        return Internal::FindPackFileEntry(fileName).second != nullptr;
+    }
+
+    std::optional<std::string> ReadAssetTextFile(const std::string& fileName)
+    {
+        auto file = OpenAssetFile(fileName, FileAccessPattern::Sequential);
+        if (!file)
         {
-            DX_LOG(Error, "FileUtils", "Filename path %s failed to open.", fileNamePath.generic_string().c_str());
             return std::nullopt;
         }
+
+        return std::string(file->GetText());
     }
 
-    std::filesystem::path GetAssetPath()
+    std::optional<std::vector<uint8_t>> ReadAssetBinaryFile(const std::string& fileName)
     {
-        auto execPath = GetExecutablePath();
-        execPath /= "Assets";
-        if (std::filesystem::exists(execPath))
+        auto file = OpenAssetFile(fileName, FileAccessPattern::Sequential);
+        if (!file)
         {
-            return execPath;
+            return std::nullopt;
         }
 
-        // If the Assets folder is not in the same location as the executable,
-        // that could be because the executable is being run from a build folder
-        // (for example from Visual Studio). Try to find the 'build' folder to
-        // extract the project path and use that to look for the Assets folder.
-        if (auto it = execPath.generic_string().find("build");
-            it != std::string::npos)
+        return std::vector<uint8_t>(file->GetData().begin(), file->GetData().end());
+    }
+
+    bool WriteFileAtomically(const std::filesystem::path& filePath, std::span<const uint8_t> data)
+    {
+        return WriteFileAtomically(filePath, [data](std::ostream& file)
+            {
+                file.write(reinterpret_cast<const char*>(data.data()), data.size());
+            });
+    }
+
+    bool WriteFileAtomically(const std::filesystem::path& filePath, const std::function<void(std::ostream& file)>& writeFile)
+    {
+        std::error_code errorCode;
+        std::filesystem::create_directories(filePath.parent_path(), errorCode);
+
+        const std::filesystem::path tempFilePath = Internal::MakeTempFilePath(filePath);
         {
-            std::filesystem::path projectPath = execPath.generic_string().substr(0, it);
-            projectPath /= "Assets";
-            if (std::filesystem::exists(projectPath))
+            // Closed explicitly to check the data buffered was written too.
+            std::ofstream file(tempFilePath, std::ios::binary | std::ios::trunc);
+            writeFile(file);
+            file.close();
+            if (!file)
             {
-                return projectPath;
+                DX_LOG(Error, "FileUtils", "Failed to write file %s.", tempFilePath.generic_string().c_str());
+                std::filesystem::remove(tempFilePath, errorCode);
+                return false;
             }
         }
 
-        DX_LOG(Error, "FileUtils", "Assets path not found.");
-        return {};
+        std::filesystem::rename(tempFilePath, filePath, errorCode);
+        if (errorCode)
+        {
+            DX_LOG(Error, "FileUtils", "Failed to rename file %s: %s.", tempFilePath.generic_string().c_str(), errorCode.message().c_str());
+            std::filesystem::remove(tempFilePath, errorCode);
+            return false;
+        }
+        return true;
+    }
+
+    const std::filesystem::path& GetAssetPath()
+    {
+        // The assets folder doesn't move while running, resolve it only once.
+        static const std::filesystem::path assetPath = Internal::FindAssetPath();
+        return assetPath;
     }
 
     std::filesystem::path GetExecutablePath()
@@ -107,6 +241,15 @@ namespace DX
         GetModuleFileName(NULL, path, MAX_PATH);
         std::filesystem::path execPath(path);
         return execPath.remove_filename();
+#elif defined(__linux__)
+        std::error_code errorCode;
+        std::filesystem::path execPath = std::filesystem::read_symlink("/proc/self/exe", errorCode);
+        if (errorCode)
+        {
+            DX_LOG(Error, "FileUtils", "Failed to read executable path: %s.", errorCode.message().c_str());
+            return {};
+        }
+        return execPath.remove_filename();
 #else
         #error "Renderer::GetExecutablePath: Unsupported platform."
         return {};
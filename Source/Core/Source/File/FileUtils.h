@@ -1,12 +1,57 @@
 #pragma once
 
+#include <File/MappedFile.h>
+
 #include <vector>
 #include <string>
 #include <filesystem>
+#include <functional>
 #include <optional>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <string_view>
 
 namespace DX
 {
+    class PackFile;
+
+    // Content of an asset file, read from a mounted pack file or mapped
+    // from the assets folder. The content is valid while the object is alive.
+    class AssetFile
+    {
+    public:
+        std::span<const uint8_t> GetData() const { return m_data; }
+        std::string_view GetText() const { return { reinterpret_cast<const char*>(m_data.data()), m_data.size() }; }
+        size_t GetSize() const { return m_data.size(); }
+
+    private:
+        friend std::optional<AssetFile> OpenAssetFile(const std::string& fileName, FileAccessPattern accessPattern);
+
+        // Only one of them holds the content, depending where the file is read from.
+        std::shared_ptr<const PackFile> m_packFile; // Uncompressed entries point directly to the mapped pack file.
+        std::vector<uint8_t> m_decompressedData;
+        MappedFile m_mappedFile;
+
+        std::span<const uint8_t> m_data;
+    };
+
+    // Mounts a pack file. Asset files are looked up in the mounted pack files,
+    // the last one mounted first, before looking in the assets folder.
+    bool MountPackFile(const std::filesystem::path& packFilePath);
+    void UnmountPackFiles();
+
+    // Opens an asset file to read its content without copies.
+    // The filename is relative to the assets folder.
+    std::optional<AssetFile> OpenAssetFile(const std::string& fileName, FileAccessPattern accessPattern = FileAccessPattern::Normal);
+
+    // Checks if an asset file exists in the mounted pack files or in the assets folder.
+    // The filename is relative to the assets folder.
+    bool AssetFileExists(const std::string& fileName);
+
+    // Checks if an asset file is read from a mounted pack file instead of the assets folder.
+    bool IsAssetFilePacked(const std::string& fileName);
+
     // Reads the content of a text file.
     // The filename is relative to the assets folder.
     std::optional<std::string> ReadAssetTextFile(const std::string& fileName);
@@ -15,8 +60,17 @@ namespace DX
     // The filename is relative to the assets folder.
     std::optional<std::vector<uint8_t>> ReadAssetBinaryFile(const std::string& fileName);
 
+    // Writes a file through a temporary file renamed once fully written,
+    // so the file is never seen half written, even if the process stops.
+    bool WriteFileAtomically(const std::filesystem::path& filePath, std::span<const uint8_t> data);
+
+    // Same as above, with the content streamed to the temporary file by writeFile,
+    // so it doesn't need to be in memory all at once.
+    bool WriteFileAtomically(const std::filesystem::path& filePath, const std::function<void(std::ostream& file)>& writeFile);
+
     // Returns the path to the assets folder.
-    std::filesystem::path GetAssetPath();
+    // It's resolved the first time it's called.
+    const std::filesystem::path& GetAssetPath();
 
     // Returns the path to the executable folder.
     std::filesystem::path GetExecutablePath();
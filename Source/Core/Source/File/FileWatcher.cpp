@@ -0,0 +1,260 @@
+#include <File/FileWatcher.h>
+#include <Log/Log.h>
+
+#include <algorithm>
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#elif defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace DX
+{
+#ifdef _WIN32
+    FileWatcher::FileWatcher(const std::filesystem::path& folder)
+        : m_folder(folder)
+    {
+        // Overlapped, so the thread can wait for changes and for the stop event at the same time.
+        HANDLE directory = CreateFileW(folder.c_str(), FILE_LIST_DIRECTORY,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+            FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (directory == INVALID_HANDLE_VALUE)
+        {
+            DX_LOG(Error, "FileWatcher", "Failed to watch folder %s.", folder.generic_string().c_str());
+            return;
+        }
+
+        m_directoryHandle = directory;
+        m_stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        m_isWatching = true;
+
+        m_thread = std::thread(&FileWatcher::WatchThread, this);
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+        m_stop = true;
+        if (m_thread.joinable())
+        {
+            SetEvent(m_stopEvent);
+            m_thread.join();
+        }
+
+        if (m_directoryHandle)
+        {
+            CloseHandle(m_directoryHandle);
+        }
+        if (m_stopEvent)
+        {
+            CloseHandle(m_stopEvent);
+        }
+    }
+
+    void FileWatcher::WatchThread()
+    {
+        // Notifications are DWORD aligned.
+        alignas(DWORD) uint8_t buffer[64 * 1024];
+
+        OVERLAPPED overlapped = {};
+        overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+        while (!m_stop)
+        {
+            ResetEvent(overlapped.hEvent);
+            if (!ReadDirectoryChangesW(m_directoryHandle, buffer, sizeof(buffer), TRUE,
+                FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, nullptr, &overlapped, nullptr))
+            {
+                DX_LOG(Error, "FileWatcher", "Failed to read changes of folder %s.", m_folder.generic_string().c_str());
+                break;
+            }
+
+            const HANDLE events[] = { overlapped.hEvent, m_stopEvent };
+            if (WaitForMultipleObjects(2, events, FALSE, INFINITE) != WAIT_OBJECT_0)
+            {
+                CancelIoEx(m_directoryHandle, &overlapped);
+                DWORD ignoredSize = 0;
+                GetOverlappedResult(m_directoryHandle, &overlapped, &ignoredSize, TRUE);
+                break;
+            }
+
+            DWORD size = 0;
+            if (!GetOverlappedResult(m_directoryHandle, &overlapped, &size, FALSE) || size == 0)
+            {
+                continue; // Buffer overflow, changes are lost
+            }
+
+            for (size_t offset = 0; offset < size;)
+            {
+                const auto* notification = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(buffer + offset);
+                if (notification->Action == FILE_ACTION_ADDED ||
+                    notification->Action == FILE_ACTION_MODIFIED ||
+                    notification->Action == FILE_ACTION_RENAMED_NEW_NAME)
+                {
+                    AddChangedFile(std::wstring(notification->FileName, notification->FileNameLength / sizeof(WCHAR)));
+                }
+
+                if (notification->NextEntryOffset == 0)
+                {
+                    break;
+                }
+                offset += notification->NextEntryOffset;
+            }
+        }
+
+        CloseHandle(overlapped.hEvent);
+    }
+#elif defined(__linux__)
+    namespace Internal
+    {
+        // inotify doesn't watch subfolders, each folder has its own watch.
+        static void AddWatches(int inotifyFd, const std::filesystem::path& folder, const std::filesystem::path& relativeFolder,
+            std::unordered_map<int, std::filesystem::path>& watchFolders)
+        {
+            const int watch = inotify_add_watch(inotifyFd, (folder / relativeFolder).c_str(),
+                IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+            if (watch < 0)
+            {
+                DX_LOG(Error, "FileWatcher", "Failed to watch folder %s: %s.", (folder / relativeFolder).generic_string().c_str(), std::strerror(errno));
+                return;
+            }
+            watchFolders[watch] = relativeFolder;
+
+            std::error_code errorCode;
+            for (const auto& entry : std::filesystem::directory_iterator(folder / relativeFolder, errorCode))
+            {
+                if (entry.is_directory())
+                {
+                    AddWatches(inotifyFd, folder, relativeFolder / entry.path().filename(), watchFolders);
+                }
+            }
+        }
+    }
+
+    FileWatcher::FileWatcher(const std::filesystem::path& folder)
+        : m_folder(folder)
+    {
+        m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotifyFd < 0)
+        {
+            DX_LOG(Error, "FileWatcher", "Failed to initialize inotify: %s.", std::strerror(errno));
+            return;
+        }
+
+        Internal::AddWatches(m_inotifyFd, m_folder, {}, m_watchFolders);
+        if (m_watchFolders.empty())
+        {
+            close(m_inotifyFd);
+            m_inotifyFd = -1;
+            return;
+        }
+
+        m_isWatching = true;
+        m_thread = std::thread(&FileWatcher::WatchThread, this);
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+        m_stop = true;
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+
+        if (m_inotifyFd >= 0)
+        {
+            close(m_inotifyFd);
+        }
+    }
+
+    void FileWatcher::WatchThread()
+    {
+        // Events are aligned as inotify_event.
+        alignas(inotify_event) char buffer[16 * 1024];
+
+        while (!m_stop)
+        {
+            // Polls with a timeout to check when to stop.
+            pollfd pollFd = { m_inotifyFd, POLLIN, 0 };
+            if (poll(&pollFd, 1, 100) <= 0)
+            {
+                continue;
+            }
+
+            const ssize_t size = read(m_inotifyFd, buffer, sizeof(buffer));
+            if (size <= 0)
+            {
+                continue;
+            }
+
+            for (ssize_t offset = 0; offset < size;)
+            {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += sizeof(inotify_event) + event->len;
+
+                auto it = m_watchFolders.find(event->wd);
+                if (it == m_watchFolders.end() || event->len == 0)
+                {
+                    continue;
+                }
+                const std::filesystem::path filePath = it->second / event->name;
+
+                if (event->mask & IN_ISDIR)
+                {
+                    // Folders created later are watched too.
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    {
+                        Internal::AddWatches(m_inotifyFd, m_folder, filePath, m_watchFolders);
+                    }
+                }
+                // Files created are reported when closed after writing them.
+                else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                {
+                    AddChangedFile(filePath);
+                }
+            }
+        }
+    }
+#else
+    FileWatcher::FileWatcher(const std::filesystem::path& folder)
+        : m_folder(folder)
+    {
+        DX_LOG(Warning, "FileWatcher", "Watching files is not supported in this platform, changes in %s are not reported.", folder.generic_string().c_str());
+    }
+
+    FileWatcher::~FileWatcher() = default;
+
+    void FileWatcher::WatchThread()
+    {
+    }
+#endif
+
+    std::vector<std::filesystem::path> FileWatcher::TakeChangedFiles()
+    {
+        std::lock_guard lock(m_changedFilesMutex);
+        return std::exchange(m_changedFiles, {});
+    }
+
+    void FileWatcher::AddChangedFile(const std::filesystem::path& filePath)
+    {
+        // Editors also write temporary files and folders, only existing files are reported.
+        std::error_code errorCode;
+        if (!std::filesystem::is_regular_file(m_folder / filePath, errorCode))
+        {
+            return;
+        }
+
+        const std::filesystem::path changedFile = filePath.lexically_normal();
+
+        std::lock_guard lock(m_changedFilesMutex);
+        if (std::ranges::find(m_changedFiles, changedFile) == m_changedFiles.end())
+        {
+            m_changedFiles.push_back(changedFile);
+        }
+    }
+} // namespace DX
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace DX
+{
+    // -------------------------------------------------------
+    // Usage:
+    //
+    // FileWatcher fileWatcher(GetAssetPath() / "Shaders");
+    //
+    // // Once per frame, it doesn't block.
+    // for (const std::filesystem::path& filePath : fileWatcher.TakeChangedFiles())
+    // {
+    //     ... // Relative to the watched folder, like "Include/Lighting.hlsli"
+    // }
+    // -------------------------------------------------------
+
+    // Watches the files of a folder and its subfolders for changes, with the OS
+    // notifications (inotify on Linux and ReadDirectoryChangesW on Windows) received
+    // in a background thread. Files written or created are reported as changed,
+    // once each until they are taken, even if they are saved several times.
+    class FileWatcher
+    {
+    public:
+        explicit FileWatcher(const std::filesystem::path& folder);
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        // False if the folder couldn't be watched, no changes are reported then.
+        bool IsWatching() const { return m_isWatching; }
+
+        // Returns the files changed since the last call, relative to the watched folder.
+        std::vector<std::filesystem::path> TakeChangedFiles();
+
+    private:
+        void WatchThread();
+        void AddChangedFile(const std::filesystem::path& filePath);
+
+        std::filesystem::path m_folder;
+        bool m_isWatching = false;
+
+        std::atomic<bool> m_stop = false;
+        std::thread m_thread;
+
+        std::mutex m_changedFilesMutex;
+        std::vector<std::filesystem::path> m_changedFiles;
+
+#ifdef _WIN32
+        void* m_directoryHandle = nullptr;
+        void* m_stopEvent = nullptr;
+#elif defined(__linux__)
+        int m_inotifyFd = -1;
+        std::unordered_map<int, std::filesystem::path> m_watchFolders; // Relative folder of each watch
+#endif
+    };
+} // namespace DX
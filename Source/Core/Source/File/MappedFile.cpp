@@ -0,0 +1,194 @@
+#include <File/MappedFile.h>
+#include <Log/Log.h>
+
+#include <algorithm>
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace DX
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::filesystem::path& filePath, FileAccessPattern accessPattern)
+    {
+        DWORD flags = FILE_ATTRIBUTE_NORMAL;
+        switch (accessPattern)
+        {
+        case FileAccessPattern::Sequential: flags |= FILE_FLAG_SEQUENTIAL_SCAN; break;
+        case FileAccessPattern::Random:     flags |= FILE_FLAG_RANDOM_ACCESS; break;
+        default: break;
+        }
+
+        HANDLE file = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            DX_LOG(Error, "MappedFile", "Filename path %s failed to open.", filePath.generic_string().c_str());
+            return;
+        }
+
+        LARGE_INTEGER fileSize = {};
+        if (!GetFileSizeEx(file, &fileSize))
+        {
+            DX_LOG(Error, "MappedFile", "Filename path %s failed to get its size.", filePath.generic_string().c_str());
+            CloseHandle(file);
+            return;
+        }
+
+        // Files of size 0 cannot be mapped
+        if (fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            m_isValid = true;
+            return;
+        }
+
+        // The view keeps the file mapping alive, the handles can be closed after mapping it.
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+        {
+            DX_LOG(Error, "MappedFile", "Filename path %s failed to create file mapping.", filePath.generic_string().c_str());
+            return;
+        }
+
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!data)
+        {
+            DX_LOG(Error, "MappedFile", "Filename path %s failed to map.", filePath.generic_string().c_str());
+            return;
+        }
+
+        m_data = static_cast<const uint8_t*>(data);
+        m_size = static_cast<size_t>(fileSize.QuadPart);
+        m_isValid = true;
+    }
+
+    void MappedFile::Prefetch(size_t offset, size_t size) const
+    {
+        if (offset >= m_size || size == 0)
+        {
+            return;
+        }
+
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = const_cast<uint8_t*>(m_data + offset);
+        range.NumberOfBytes = std::min(size, m_size - offset);
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+
+    void MappedFile::Unmap()
+    {
+        if (m_data)
+        {
+            UnmapViewOfFile(m_data);
+        }
+        m_data = nullptr;
+        m_size = 0;
+        m_isValid = false;
+    }
+#else
+    MappedFile::MappedFile(const std::filesystem::path& filePath, FileAccessPattern accessPattern)
+    {
+        const int file = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0)
+        {
+            DX_LOG(Error, "MappedFile", "Filename path %s failed to open.", filePath.generic_string().c_str());
+            return;
+        }
+
+        struct stat fileStat = {};
+        if (fstat(file, &fileStat) != 0)
+        {
+            DX_LOG(Error, "MappedFile", "Filename path %s failed to get its size.", filePath.generic_string().c_str());
+            close(file);
+            return;
+        }
+
+        // Files of size 0 cannot be mapped
+        if (fileStat.st_size == 0)
+        {
+            close(file);
+            m_isValid = true;
+            return;
+        }
+
+        // The mapping keeps the file alive, the descriptor can be closed after mapping it.
+        void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (data == MAP_FAILED)
+        {
+            DX_LOG(Error, "MappedFile", "Filename path %s failed to map.", filePath.generic_string().c_str());
+            return;
+        }
+
+        switch (accessPattern)
+        {
+        case FileAccessPattern::Sequential: madvise(data, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL); break;
+        case FileAccessPattern::Random:     madvise(data, static_cast<size_t>(fileStat.st_size), MADV_RANDOM); break;
+        default: break;
+        }
+
+        m_data = static_cast<const uint8_t*>(data);
+        m_size = static_cast<size_t>(fileStat.st_size);
+        m_isValid = true;
+    }
+
+    void MappedFile::Prefetch(size_t offset, size_t size) const
+    {
+        if (offset >= m_size || size == 0)
+        {
+            return;
+        }
+
+        // madvise requires the address to be aligned to the page size.
+        static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t alignedOffset = offset - offset % pageSize;
+        const size_t alignedSize = std::min(size, m_size - offset) + (offset - alignedOffset);
+
+        madvise(const_cast<uint8_t*>(m_data + alignedOffset), alignedSize, MADV_WILLNEED);
+    }
+
+    void MappedFile::Unmap()
+    {
+        if (m_data)
+        {
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
+        m_data = nullptr;
+        m_size = 0;
+        m_isValid = false;
+    }
+#endif
+
+    MappedFile::~MappedFile()
+    {
+        Unmap();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr))
+        , m_size(std::exchange(other.m_size, 0))
+        , m_isValid(std::exchange(other.m_isValid, false))
+    {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Unmap();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_isValid = std::exchange(other.m_isValid, false);
+        }
+        return *this;
+    }
+} // namespace DX
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace DX
+{
+    // -------------------------------------------------------
+    // Usage:
+    //
+    // MappedFile file("Data.bin", FileAccessPattern::Sequential);
+    // if (file.IsValid())
+    // {
+    //     std::span<const uint8_t> data = file.GetData(); // Pages are read by the OS on first access.
+    // }
+    // -------------------------------------------------------
+
+    // How the content of a mapped file is going to be read.
+    // It's passed to the OS to tune the read ahead of pages.
+    enum class FileAccessPattern
+    {
+        Normal,
+        Sequential,
+        Random
+    };
+
+    // Read-only view of the whole content of a file mapped in memory.
+    // The file content is accessed directly from the OS pages without
+    // copying it to a heap buffer. The file is unmapped when destroyed.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::filesystem::path& filePath, FileAccessPattern accessPattern = FileAccessPattern::Normal);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        // Empty files are valid, but have no data.
+        bool IsValid() const { return m_isValid; }
+
+        std::span<const uint8_t> GetData() const { return { m_data, m_size }; }
+        std::string_view GetText() const { return { reinterpret_cast<const char*>(m_data), m_size }; }
+        size_t GetSize() const { return m_size; }
+
+        // Hints the OS to start reading the range of the file into memory
+        // before it's accessed. It doesn't block.
+        void Prefetch(size_t offset, size_t size) const;
+        void Prefetch() const { Prefetch(0, m_size); }
+
+    private:
+        void Unmap();
+
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+        bool m_isValid = false;
+    };
+} // namespace DX
@@ -0,0 +1,306 @@
+#include <File/PackFile.h>
+#include <File/FileUtils.h>
+#include <Compression/LZ4.h>
+#include <Hash/Hash.h>
+#include <Log/Log.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        static std::string NormalizePackFilePath(std::string_view path)
+        {
+            return std::filesystem::path(path).lexically_normal().generic_string();
+        }
+
+        static uint64_t HashNormalizedPackFilePath(std::string_view normalizedPath)
+        {
+            // 0 is reserved for empty slots of the table of contents
+            return std::max<uint64_t>(Hash64(normalizedPath), 1);
+        }
+
+        // LZ4 can't expand data more than 255 times, bigger sizes are corrupt.
+        static constexpr uint64_t MaxLZ4CompressionRatio = 255;
+
+        // Checks offset + size <= limit without overflowing.
+        static bool IsRangeInBounds(uint64_t offset, uint64_t size, uint64_t limit)
+        {
+            return offset <= limit && size <= limit - offset;
+        }
+    } // namespace Internal
+
+    uint64_t HashPackFilePath(std::string_view path)
+    {
+        return Internal::HashNormalizedPackFilePath(Internal::NormalizePackFilePath(path));
+    }
+
+    PackFile::PackFile(const std::filesystem::path& packFilePath)
+        : m_packFilePath(packFilePath)
+        , m_mappedFile(packFilePath, FileAccessPattern::Random)
+    {
+        if (!m_mappedFile.IsValid())
+        {
+            return;
+        }
+
+        const std::span<const uint8_t> data = m_mappedFile.GetData();
+        if (data.size() < sizeof(PackFileHeader))
+        {
+            DX_LOG(Error, "PackFile", "Pack file %s is too small.", packFilePath.generic_string().c_str());
+            return;
+        }
+
+        const PackFileHeader* header = reinterpret_cast<const PackFileHeader*>(data.data());
+        if (header->m_magic != PackFileHeader::Magic ||
+            header->m_version != PackFileHeader::CurrentVersion)
+        {
+            DX_LOG(Error, "PackFile", "Pack file %s has an invalid header.", packFilePath.generic_string().c_str());
+            return;
+        }
+
+        // Sizes are checked with divisions, the values of a corrupt header could overflow the multiplication.
+        if (!std::has_single_bit(header->m_tocSlotCount) ||
+            header->m_tocOffset % PackFileTocAlignment != 0 ||
+            header->m_tocOffset > data.size() ||
+            header->m_tocSlotCount > (data.size() - header->m_tocOffset) / sizeof(PackFileEntry) ||
+            !Internal::IsRangeInBounds(header->m_pathsOffset, header->m_pathsSize, data.size()))
+        {
+            DX_LOG(Error, "PackFile", "Pack file %s has an invalid table of contents.", packFilePath.generic_string().c_str());
+            return;
+        }
+
+        m_toc = std::span(reinterpret_cast<const PackFileEntry*>(data.data() + header->m_tocOffset), header->m_tocSlotCount);
+        m_paths = std::string_view(reinterpret_cast<const char*>(data.data() + header->m_pathsOffset), header->m_pathsSize);
+
+        const bool validEntries = std::ranges::all_of(m_toc,
+            [&](const PackFileEntry& entry)
+            {
+                return entry.m_pathHash == 0 ||
+                    (Internal::IsRangeInBounds(entry.m_offset, entry.m_size, data.size()) &&
+                     Internal::IsRangeInBounds(entry.m_pathOffset, entry.m_pathLength, m_paths.size()));
+            });
+        if (!validEntries)
+        {
+            DX_LOG(Error, "PackFile", "Pack file %s has entries out of bounds.", packFilePath.generic_string().c_str());
+            return;
+        }
+
+        // The table of contents is accessed on every lookup, bring it to memory now.
+        m_mappedFile.Prefetch(header->m_tocOffset, m_toc.size_bytes() + header->m_pathsSize);
+
+        m_isValid = true;
+
+        DX_LOG(Info, "PackFile", "Mounted pack file %s with %llu entries.",
+            packFilePath.generic_string().c_str(), static_cast<unsigned long long>(header->m_entryCount));
+    }
+
+    const PackFileEntry* PackFile::FindEntry(std::string_view path) const
+    {
+        if (!m_isValid)
+        {
+            return nullptr;
+        }
+
+        const std::string normalizedPath = Internal::NormalizePackFilePath(path);
+        const uint64_t pathHash = Internal::HashNormalizedPackFilePath(normalizedPath);
+        const uint64_t slotMask = m_toc.size() - 1;
+
+        // Paths are compared as different paths can have the same hash. The probe is bounded
+        // by the table size, a corrupt table of contents might not have empty slots.
+        uint64_t slot = pathHash & slotMask;
+        for (uint64_t probeCount = 0; probeCount < m_toc.size(); ++probeCount)
+        {
+            const PackFileEntry& entry = m_toc[slot];
+            if (entry.m_pathHash == 0)
+            {
+                return nullptr;
+            }
+            if (entry.m_pathHash == pathHash && GetEntryPath(entry) == normalizedPath)
+            {
+                return &entry;
+            }
+            slot = (slot + 1) & slotMask;
+        }
+        return nullptr;
+    }
+
+    std::string_view PackFile::GetEntryPath(const PackFileEntry& entry) const
+    {
+        return m_paths.substr(entry.m_pathOffset, entry.m_pathLength);
+    }
+
+    std::span<const uint8_t> PackFile::GetEntryData(const PackFileEntry& entry) const
+    {
+        return m_mappedFile.GetData().subspan(entry.m_offset, entry.m_size);
+    }
+
+    std::optional<std::vector<uint8_t>> PackFile::ReadEntry(const PackFileEntry& entry) const
+    {
+        // Read the whole entry in one go instead of faulting page by page.
+        m_mappedFile.Prefetch(entry.m_offset, entry.m_size);
+
+        const std::span<const uint8_t> entryData = GetEntryData(entry);
+
+        switch (entry.m_compression)
+        {
+        case PackFileCompression::None:
+            return std::vector<uint8_t>(entryData.begin(), entryData.end());
+
+        case PackFileCompression::LZ4:
+            // The size is checked before allocating, a corrupt size could ask for any amount of memory.
+            if (entry.m_uncompressedSize / Internal::MaxLZ4CompressionRatio > entry.m_size)
+            {
+                break;
+            }
+            if (std::vector<uint8_t> data(entry.m_uncompressedSize);
+                DecompressLZ4(entryData, data))
+            {
+                return data;
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        DX_LOG(Error, "PackFile", "Entry %.*s of pack file %s is corrupt.",
+            static_cast<int>(entry.m_pathLength), GetEntryPath(entry).data(), m_packFilePath.generic_string().c_str());
+        return std::nullopt;
+    }
+
+    void PackFileWriter::AddEntry(const std::string& path, std::span<const uint8_t> data, PackFileCompression compression)
+    {
+        Entry entry;
+        entry.m_path = Internal::NormalizePackFilePath(path);
+        entry.m_uncompressedSize = data.size();
+
+        if (compression == PackFileCompression::LZ4)
+        {
+            entry.m_data = CompressLZ4(data);
+            entry.m_compression = PackFileCompression::LZ4;
+        }
+
+        // Not worth decompressing, for example images already compressed.
+        if (entry.m_compression == PackFileCompression::None ||
+            entry.m_data.size() >= data.size())
+        {
+            entry.m_data.assign(data.begin(), data.end());
+            entry.m_compression = PackFileCompression::None;
+        }
+
+        m_entries.push_back(std::move(entry));
+    }
+
+    void PackFileWriter::AddStoredEntry(const std::string& path, std::vector<uint8_t> storedData, PackFileCompression compression, uint64_t uncompressedSize)
+    {
+        Entry entry;
+        entry.m_path = Internal::NormalizePackFilePath(path);
+        entry.m_data = std::move(storedData);
+        entry.m_uncompressedSize = uncompressedSize;
+        entry.m_compression = compression;
+
+        m_entries.push_back(std::move(entry));
+    }
+
+    bool PackFileWriter::Write(const std::filesystem::path& packFilePath) const
+    {
+        using namespace Internal;
+
+        // Table of contents at most half full to keep the probe sequences short.
+        PackFileHeader header;
+        header.m_entryCount = m_entries.size();
+        header.m_tocSlotCount = std::bit_ceil(std::max<uint64_t>(m_entries.size() * 2, 1));
+
+        std::vector<PackFileEntry> toc(header.m_tocSlotCount);
+        std::string paths;
+        std::vector<uint64_t> entryOffsets;
+        entryOffsets.reserve(m_entries.size());
+
+        uint64_t offset = AlignUp(sizeof(PackFileHeader), PackFileDataAlignment);
+        for (const Entry& entry : m_entries)
+        {
+            PackFileEntry tocEntry;
+            tocEntry.m_pathHash = HashNormalizedPackFilePath(entry.m_path);
+            tocEntry.m_offset = offset;
+            tocEntry.m_size = entry.m_data.size();
+            tocEntry.m_uncompressedSize = entry.m_uncompressedSize;
+            tocEntry.m_pathOffset = paths.size();
+            tocEntry.m_pathLength = static_cast<uint32_t>(entry.m_path.size());
+            tocEntry.m_compression = entry.m_compression;
+
+            const uint64_t slotMask = header.m_tocSlotCount - 1;
+            uint64_t slot = tocEntry.m_pathHash & slotMask;
+            while (toc[slot].m_pathHash != 0)
+            {
+                // Entries with the same hash but different paths are found by comparing their paths.
+                if (toc[slot].m_pathHash == tocEntry.m_pathHash &&
+                    entry.m_path == std::string_view(paths.c_str() + toc[slot].m_pathOffset, toc[slot].m_pathLength))
+                {
+                    DX_LOG(Error, "PackFile", "Entry %s added more than once.", entry.m_path.c_str());
+                    return false;
+                }
+                slot = (slot + 1) & slotMask;
+            }
+            toc[slot] = tocEntry;
+
+            paths.append(entry.m_path);
+            paths.push_back('\0');
+
+            entryOffsets.push_back(offset);
+
+            offset = AlignUp(offset + entry.m_data.size(), PackFileDataAlignment);
+        }
+
+        header.m_tocOffset = AlignUp(offset, PackFileTocAlignment);
+        header.m_pathsOffset = header.m_tocOffset + toc.size() * sizeof(PackFileEntry);
+        header.m_pathsSize = paths.size();
+
+        // Streamed in file order, without laying out the whole pack file in memory.
+        // It's written atomically so a pack file being mounted is never partially written.
+        auto writePackFile = [&](std::ostream& file)
+            {
+                uint64_t position = 0;
+                auto write = [&file, &position](const void* data, uint64_t size)
+                    {
+                        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+                        position += size;
+                    };
+
+                // Alignment padding is filled with zeros.
+                auto padTo = [&write, &position](uint64_t offset)
+                    {
+                        static constexpr char Zeros[PackFileDataAlignment] = {};
+                        while (position < offset)
+                        {
+                            write(Zeros, std::min<uint64_t>(offset - position, sizeof(Zeros)));
+                        }
+                    };
+
+                write(&header, sizeof(header));
+                for (size_t i = 0; i < m_entries.size(); ++i)
+                {
+                    padTo(entryOffsets[i]);
+                    write(m_entries[i].m_data.data(), m_entries[i].m_data.size());
+                }
+                padTo(header.m_tocOffset);
+                write(toc.data(), toc.size() * sizeof(PackFileEntry));
+                write(paths.data(), paths.size());
+            };
+
+        if (!WriteFileAtomically(packFilePath, writePackFile))
+        {
+            DX_LOG(Error, "PackFile", "Pack file %s failed to write.", packFilePath.generic_string().c_str());
+            return false;
+        }
+
+        return true;
+    }
+} // namespace DX
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <File/MappedFile.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DX
+{
+    // -------------------------------------------------------
+    // Pack file layout:
+    //
+    // PackFileHeader
+    // Entry data, each entry aligned to PackFileDataAlignment
+    // Table of contents, array of PackFileEntry aligned to PackFileTocAlignment
+    // Entry paths, null terminated strings
+    //
+    // The table of contents is a hash table indexed by the hash of the entry path,
+    // with a power of 2 size and linear probing. Entries with the same hash are told
+    // apart by their path. Lookups are O(1) and read straight from the mapped file,
+    // mounting a pack file doesn't parse or allocate anything.
+    // -------------------------------------------------------
+
+    enum class PackFileCompression : uint32_t
+    {
+        None,
+        LZ4
+    };
+
+    struct PackFileHeader
+    {
+        static constexpr uint32_t Magic = 0x4B505844; // "DXPK"
+        static constexpr uint32_t CurrentVersion = 1;
+
+        uint32_t m_magic = Magic;
+        uint32_t m_version = CurrentVersion;
+        uint64_t m_tocOffset = 0;
+        uint64_t m_tocSlotCount = 0; // Power of 2
+        uint64_t m_entryCount = 0;
+        uint64_t m_pathsOffset = 0;
+        uint64_t m_pathsSize = 0;
+    };
+
+    struct PackFileEntry
+    {
+        uint64_t m_pathHash = 0; // 0 for empty slots
+        uint64_t m_offset = 0;
+        uint64_t m_size = 0; // Size in the pack file
+        uint64_t m_uncompressedSize = 0;
+        uint64_t m_pathOffset = 0; // Offset from the start of the paths
+        PackFileCompression m_compression = PackFileCompression::None;
+        uint32_t m_pathLength = 0;
+    };
+
+    static constexpr uint64_t PackFileDataAlignment = 4096; // Page size, entries start on their own page.
+    static constexpr uint64_t PackFileTocAlignment = 64;
+
+    // Hash of an entry path. Paths are normalized, so different spellings of the same path match.
+    uint64_t HashPackFilePath(std::string_view path);
+
+    // Read-only pack file, mapped in memory.
+    class PackFile
+    {
+    public:
+        explicit PackFile(const std::filesystem::path& packFilePath);
+
+        PackFile(const PackFile&) = delete;
+        PackFile& operator=(const PackFile&) = delete;
+
+        bool IsValid() const { return m_isValid; }
+
+        const std::filesystem::path& GetPath() const { return m_packFilePath; }
+
+        const PackFileEntry* FindEntry(std::string_view path) const;
+
+        std::string_view GetEntryPath(const PackFileEntry& entry) const;
+
+        // Data of the entry as stored in the pack file, which is compressed if the entry is compressed.
+        // It points to the mapped pack file, it's valid while the pack file is alive.
+        std::span<const uint8_t> GetEntryData(const PackFileEntry& entry) const;
+
+        // Reads and decompresses the entry data. Returns nullopt if the data is corrupt.
+        std::optional<std::vector<uint8_t>> ReadEntry(const PackFileEntry& entry) const;
+
+        std::span<const PackFileEntry> GetTableOfContents() const { return m_toc; }
+
+    private:
+        std::filesystem::path m_packFilePath;
+        MappedFile m_mappedFile;
+        std::span<const PackFileEntry> m_toc;
+        std::string_view m_paths;
+        bool m_isValid = false;
+    };
+
+    // Creates pack files. Usage:
+    //
+    // PackFileWriter writer;
+    // writer.AddEntry("Shaders/PixelShader.hlsl", shaderData, PackFileCompression::LZ4);
+    // writer.Write("Assets.pak");
+    class PackFileWriter
+    {
+    public:
+        // Adds an entry with the data. When the compressed data is not smaller
+        // than the original data the entry is stored uncompressed.
+        void AddEntry(const std::string& path, std::span<const uint8_t> data, PackFileCompression compression);
+
+        // Adds an entry with data already stored as it goes in the pack file,
+        // for example compressed once and cached by a previous build.
+        void AddStoredEntry(const std::string& path, std::vector<uint8_t> storedData, PackFileCompression compression, uint64_t uncompressedSize);
+
+        // Writes the pack file with all the entries added.
+        bool Write(const std::filesystem::path& packFilePath) const;
+
+    private:
+        struct Entry
+        {
+            std::string m_path;
+            std::vector<uint8_t> m_data;
+            uint64_t m_uncompressedSize = 0;
+            PackFileCompression m_compression = PackFileCompression::None;
+        };
+
+        std::vector<Entry> m_entries;
+    };
+} // namespace DX
@@ -2,7 +2,7 @@
 
 #include <cstdint>
 #include <compare>
-#include <xhash>
+#include <functional>
 
 namespace DX
 {
@@ -0,0 +1,113 @@
+#include <Hash/Hash.h>
+
+#include <bit>
+#include <cstring>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+        static constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+        static constexpr uint64_t Prime3 = 0x165667B19E3779F9ULL;
+        static constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+        static constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+        // Unaligned little endian reads
+        static uint64_t Read64(const uint8_t* data)
+        {
+            uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        static uint32_t Read32(const uint8_t* data)
+        {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        static uint64_t Round(uint64_t accumulator, uint64_t input)
+        {
+            accumulator += input * Prime2;
+            accumulator = std::rotl(accumulator, 31);
+            return accumulator * Prime1;
+        }
+
+        static uint64_t MergeRound(uint64_t accumulator, uint64_t value)
+        {
+            accumulator ^= Round(0, value);
+            return accumulator * Prime1 + Prime4;
+        }
+    } // namespace Internal
+
+    uint64_t Hash64(const void* data, size_t size, uint64_t seed)
+    {
+        using namespace Internal;
+
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        const uint8_t* const end = bytes + size;
+
+        uint64_t hash = 0;
+
+        if (size >= 32)
+        {
+            uint64_t lanes[4] = {
+                seed + Prime1 + Prime2,
+                seed + Prime2,
+                seed,
+                seed - Prime1
+            };
+
+            const uint8_t* const lastStripe = end - 32;
+            do
+            {
+                lanes[0] = Round(lanes[0], Read64(bytes));
+                lanes[1] = Round(lanes[1], Read64(bytes + 8));
+                lanes[2] = Round(lanes[2], Read64(bytes + 16));
+                lanes[3] = Round(lanes[3], Read64(bytes + 24));
+                bytes += 32;
+            } while (bytes <= lastStripe);
+
+            hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+            for (uint64_t lane : lanes)
+            {
+                hash = MergeRound(hash, lane);
+            }
+        }
+        else
+        {
+            hash = seed + Prime5;
+        }
+
+        hash += static_cast<uint64_t>(size);
+
+        // Remaining bytes
+        for (; bytes + 8 <= end; bytes += 8)
+        {
+            hash ^= Round(0, Read64(bytes));
+            hash = std::rotl(hash, 27) * Prime1 + Prime4;
+        }
+        if (bytes + 4 <= end)
+        {
+            hash ^= static_cast<uint64_t>(Read32(bytes)) * Prime1;
+            hash = std::rotl(hash, 23) * Prime2 + Prime3;
+            bytes += 4;
+        }
+        for (; bytes < end; ++bytes)
+        {
+            hash ^= static_cast<uint64_t>(*bytes) * Prime5;
+            hash = std::rotl(hash, 11) * Prime1;
+        }
+
+        // Avalanche
+        hash ^= hash >> 33;
+        hash *= Prime2;
+        hash ^= hash >> 29;
+        hash *= Prime3;
+        hash ^= hash >> 32;
+
+        return hash;
+    }
+} // namespace DX
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace DX
+{
+    // 64 bits non-cryptographic hash, it implements the XXH64 algorithm.
+    // It processes 32 bytes per iteration in 4 independent lanes, which
+    // lets the CPU pipeline the multiplications and makes it as fast as
+    // reading the memory. Good for hashing the content of files.
+    uint64_t Hash64(const void* data, size_t size, uint64_t seed = 0);
+
+    inline uint64_t Hash64(std::string_view str, uint64_t seed = 0)
+    {
+        return Hash64(str.data(), str.size(), seed);
+    }
+} // namespace DX
@@ -0,0 +1,450 @@
+#include <Json/Json.h>
+
+#include <Log/Log.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static const JsonValue NullJsonValue;
+        static const JsonValue::Array EmptyJsonArray;
+        static const JsonValue::Object EmptyJsonObject;
+
+        // Deeper documents are rejected to avoid running out of stack.
+        static constexpr int MaxJsonDepth = 256;
+
+        // Recursive descent parser over the text of the document.
+        class JsonParser
+        {
+        public:
+            explicit JsonParser(std::string_view text)
+                : m_text(text)
+            {
+            }
+
+            std::optional<JsonValue> Parse()
+            {
+                JsonValue value;
+                if (!ParseValue(value, 0))
+                {
+                    return std::nullopt;
+                }
+
+                SkipWhitespace();
+                if (m_position != m_text.size())
+                {
+                    return std::nullopt;
+                }
+                return value;
+            }
+
+        private:
+            void SkipWhitespace()
+            {
+                while (m_position < m_text.size() &&
+                    (m_text[m_position] == ' ' || m_text[m_position] == '\t' || m_text[m_position] == '\n' || m_text[m_position] == '\r'))
+                {
+                    ++m_position;
+                }
+            }
+
+            bool Consume(char character)
+            {
+                SkipWhitespace();
+                if (m_position < m_text.size() && m_text[m_position] == character)
+                {
+                    ++m_position;
+                    return true;
+                }
+                return false;
+            }
+
+            bool ConsumeLiteral(std::string_view literal)
+            {
+                if (m_text.substr(m_position, literal.size()) != literal)
+                {
+                    return false;
+                }
+                m_position += literal.size();
+                return true;
+            }
+
+            bool ParseValue(JsonValue& value, int depth)
+            {
+                if (depth > MaxJsonDepth)
+                {
+                    return false;
+                }
+
+                SkipWhitespace();
+                if (m_position >= m_text.size())
+                {
+                    return false;
+                }
+
+                switch (m_text[m_position])
+                {
+                case '{': return ParseObject(value, depth);
+                case '[': return ParseArray(value, depth);
+                case '"':
+                {
+                    std::string string;
+                    if (!ParseString(string))
+                    {
+                        return false;
+                    }
+                    value = JsonValue(std::move(string));
+                    return true;
+                }
+                case 't':
+                    value = JsonValue(true);
+                    return ConsumeLiteral("true");
+                case 'f':
+                    value = JsonValue(false);
+                    return ConsumeLiteral("false");
+                case 'n':
+                    value = JsonValue();
+                    return ConsumeLiteral("null");
+                default:
+                    return ParseNumber(value);
+                }
+            }
+
+            bool ParseObject(JsonValue& value, int depth)
+            {
+                ++m_position; // '{'
+
+                JsonValue::Object object;
+                if (!Consume('}'))
+                {
+                    do
+                    {
+                        SkipWhitespace();
+
+                        std::string name;
+                        if (!ParseString(name) || !Consume(':'))
+                        {
+                            return false;
+                        }
+
+                        JsonValue member;
+                        if (!ParseValue(member, depth + 1))
+                        {
+                            return false;
+                        }
+                        object.emplace_back(std::move(name), std::move(member));
+                    } while (Consume(','));
+
+                    if (!Consume('}'))
+                    {
+                        return false;
+                    }
+                }
+
+                value = JsonValue(std::move(object));
+                return true;
+            }
+
+            bool ParseArray(JsonValue& value, int depth)
+            {
+                ++m_position; // '['
+
+                JsonValue::Array array;
+                if (!Consume(']'))
+                {
+                    do
+                    {
+                        JsonValue element;
+                        if (!ParseValue(element, depth + 1))
+                        {
+                            return false;
+                        }
+                        array.push_back(std::move(element));
+                    } while (Consume(','));
+
+                    if (!Consume(']'))
+                    {
+                        return false;
+                    }
+                }
+
+                value = JsonValue(std::move(array));
+                return true;
+            }
+
+            bool ParseNumber(JsonValue& value)
+            {
+                // Validate the JSON number grammar, which is stricter than strtod.
+                const size_t start = m_position;
+                auto isDigit = [this]() { return m_position < m_text.size() && m_text[m_position] >= '0' && m_text[m_position] <= '9'; };
+                auto skipDigits = [&]()
+                    {
+                        const size_t digitsStart = m_position;
+                        while (isDigit())
+                        {
+                            ++m_position;
+                        }
+                        return m_position > digitsStart;
+                    };
+
+                if (m_position < m_text.size() && m_text[m_position] == '-')
+                {
+                    ++m_position;
+                }
+                if (!skipDigits())
+                {
+                    return false;
+                }
+                if (m_position < m_text.size() && m_text[m_position] == '.')
+                {
+                    ++m_position;
+                    if (!skipDigits())
+                    {
+                        return false;
+                    }
+                }
+                if (m_position < m_text.size() && (m_text[m_position] == 'e' || m_text[m_position] == 'E'))
+                {
+                    ++m_position;
+                    if (m_position < m_text.size() && (m_text[m_position] == '+' || m_text[m_position] == '-'))
+                    {
+                        ++m_position;
+                    }
+                    if (!skipDigits())
+                    {
+                        return false;
+                    }
+                }
+
+                double number = 0.0;
+                const auto result = std::from_chars(m_text.data() + start, m_text.data() + m_position, number);
+                if (result.ec == std::errc::result_out_of_range)
+                {
+                    // from_chars leaves the number unset, strtod rounds to infinity or zero.
+                    number = std::strtod(std::string(m_text.substr(start, m_position - start)).c_str(), nullptr);
+                }
+                else if (result.ec != std::errc())
+                {
+                    return false;
+                }
+
+                value = JsonValue(number);
+                return true;
+            }
+
+            bool ParseHex4(uint32_t& codePoint)
+            {
+                if (m_position + 4 > m_text.size())
+                {
+                    return false;
+                }
+                const auto result = std::from_chars(m_text.data() + m_position, m_text.data() + m_position + 4, codePoint, 16);
+                if (result.ptr != m_text.data() + m_position + 4)
+                {
+                    return false;
+                }
+                m_position += 4;
+                return true;
+            }
+
+            static void AppendUtf8(std::string& string, uint32_t codePoint)
+            {
+                if (codePoint < 0x80)
+                {
+                    string += static_cast<char>(codePoint);
+                }
+                else if (codePoint < 0x800)
+                {
+                    string += static_cast<char>(0xC0 | (codePoint >> 6));
+                    string += static_cast<char>(0x80 | (codePoint & 0x3F));
+                }
+                else if (codePoint < 0x10000)
+                {
+                    string += static_cast<char>(0xE0 | (codePoint >> 12));
+                    string += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                    string += static_cast<char>(0x80 | (codePoint & 0x3F));
+                }
+                else
+                {
+                    string += static_cast<char>(0xF0 | (codePoint >> 18));
+                    string += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                    string += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                    string += static_cast<char>(0x80 | (codePoint & 0x3F));
+                }
+            }
+
+            bool ParseString(std::string& string)
+            {
+                if (m_position >= m_text.size() || m_text[m_position] != '"')
+                {
+                    return false;
+                }
+                ++m_position;
+
+                while (m_position < m_text.size())
+                {
+                    const char character = m_text[m_position++];
+                    if (character == '"')
+                    {
+                        return true;
+                    }
+                    else if (static_cast<unsigned char>(character) < 0x20)
+                    {
+                        return false; // Control characters must be escaped
+                    }
+                    else if (character != '\\')
+                    {
+                        string += character;
+                        continue;
+                    }
+
+                    if (m_position >= m_text.size())
+                    {
+                        return false;
+                    }
+
+                    switch (m_text[m_position++])
+                    {
+                    case '"': string += '"'; break;
+                    case '\\': string += '\\'; break;
+                    case '/': string += '/'; break;
+                    case 'b': string += '\b'; break;
+                    case 'f': string += '\f'; break;
+                    case 'n': string += '\n'; break;
+                    case 'r': string += '\r'; break;
+                    case 't': string += '\t'; break;
+                    case 'u':
+                    {
+                        uint32_t codePoint = 0;
+                        if (!ParseHex4(codePoint))
+                        {
+                            return false;
+                        }
+
+                        // Characters outside the basic plane are escaped as surrogate pairs.
+                        if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+                        {
+                            uint32_t lowSurrogate = 0;
+                            if (!ConsumeLiteral("\\u") || !ParseHex4(lowSurrogate) ||
+                                lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF)
+                            {
+                                return false;
+                            }
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                        }
+                        AppendUtf8(string, codePoint);
+                        break;
+                    }
+                    default:
+                        return false;
+                    }
+                }
+
+                return false; // Missing closing quote
+            }
+
+            std::string_view m_text;
+            size_t m_position = 0;
+        };
+    }
+
+    bool JsonValue::GetBool(bool defaultValue) const
+    {
+        const bool* value = std::get_if<bool>(&m_value);
+        return value ? *value : defaultValue;
+    }
+
+    double JsonValue::GetNumber(double defaultValue) const
+    {
+        const double* value = std::get_if<double>(&m_value);
+        return value ? *value : defaultValue;
+    }
+
+    int64_t JsonValue::GetInt(int64_t defaultValue) const
+    {
+        // Only integral numbers in the range of int64_t, converting others would truncate them
+        // or be undefined. 2^63 is exactly representable as a double, unlike INT64_MAX.
+        const double* value = std::get_if<double>(&m_value);
+        if (!value ||
+            !std::isfinite(*value) ||
+            std::trunc(*value) != *value ||
+            *value < -9223372036854775808.0 ||
+            *value >= 9223372036854775808.0)
+        {
+            return defaultValue;
+        }
+        return static_cast<int64_t>(*value);
+    }
+
+    std::string_view JsonValue::GetString(std::string_view defaultValue) const
+    {
+        const std::string* value = std::get_if<std::string>(&m_value);
+        return value ? std::string_view(*value) : defaultValue;
+    }
+
+    size_t JsonValue::GetSize() const
+    {
+        if (const Array* array = std::get_if<Array>(&m_value))
+        {
+            return array->size();
+        }
+        else if (const Object* object = std::get_if<Object>(&m_value))
+        {
+            return object->size();
+        }
+        return 0;
+    }
+
+    const JsonValue& JsonValue::operator[](size_t index) const
+    {
+        const Array* array = std::get_if<Array>(&m_value);
+        return (array && index < array->size()) ? (*array)[index] : Internal::NullJsonValue;
+    }
+
+    const JsonValue& JsonValue::operator[](std::string_view name) const
+    {
+        if (const Object* object = std::get_if<Object>(&m_value))
+        {
+            for (const auto& [memberName, member] : *object)
+            {
+                if (memberName == name)
+                {
+                    return member;
+                }
+            }
+        }
+        return Internal::NullJsonValue;
+    }
+
+    bool JsonValue::HasMember(std::string_view name) const
+    {
+        return &(*this)[name] != &Internal::NullJsonValue;
+    }
+
+    const JsonValue::Array& JsonValue::GetArray() const
+    {
+        const Array* array = std::get_if<Array>(&m_value);
+        return array ? *array : Internal::EmptyJsonArray;
+    }
+
+    const JsonValue::Object& JsonValue::GetObject() const
+    {
+        const Object* object = std::get_if<Object>(&m_value);
+        return object ? *object : Internal::EmptyJsonObject;
+    }
+
+    std::optional<JsonValue> ParseJson(std::string_view text)
+    {
+        std::optional<JsonValue> value = Internal::JsonParser(text).Parse();
+        if (!value)
+        {
+            DX_LOG(Error, "Json", "Failed to parse JSON document.");
+        }
+        return value;
+    }
+} // namespace DX
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace DX
+{
+    // -------------------------------------------------------
+    // Usage:
+    //
+    // std::optional<JsonValue> json = ParseJson(R"({ "values": [1, 2, 3] })");
+    // if (json)
+    // {
+    //     const JsonValue& values = (*json)["values"];
+    //     for (size_t i = 0; i < values.GetSize(); ++i)
+    //     {
+    //         int value = values[i].GetInt();
+    //     }
+    //     int missing = (*json)["missing"].GetInt(-1); // Missing values are null
+    // }
+    // -------------------------------------------------------
+
+    // Value of a JSON document: null, boolean, number, string, array or object.
+    //
+    // Accessing a member or element that doesn't exist returns a null value
+    // instead of failing, so nested lookups don't need checks at each level,
+    // and getters return the default value when the type doesn't match.
+    class JsonValue
+    {
+    public:
+        using Array = std::vector<JsonValue>;
+        // Members are kept in the order of the document.
+        using Object = std::vector<std::pair<std::string, JsonValue>>;
+
+        JsonValue() = default;
+        explicit JsonValue(bool value) : m_value(value) {}
+        explicit JsonValue(double value) : m_value(value) {}
+        explicit JsonValue(std::string value) : m_value(std::move(value)) {}
+        explicit JsonValue(Array value) : m_value(std::move(value)) {}
+        explicit JsonValue(Object value) : m_value(std::move(value)) {}
+
+        bool IsNull() const { return std::holds_alternative<std::monostate>(m_value); }
+        bool IsBool() const { return std::holds_alternative<bool>(m_value); }
+        bool IsNumber() const { return std::holds_alternative<double>(m_value); }
+        bool IsString() const { return std::holds_alternative<std::string>(m_value); }
+        bool IsArray() const { return std::holds_alternative<Array>(m_value); }
+        bool IsObject() const { return std::holds_alternative<Object>(m_value); }
+
+        bool GetBool(bool defaultValue = false) const;
+        double GetNumber(double defaultValue = 0.0) const;
+        // Returns the default value as well for numbers that are not integers or don't fit in int64_t.
+        int64_t GetInt(int64_t defaultValue = 0) const;
+        std::string_view GetString(std::string_view defaultValue = {}) const;
+
+        // Number of elements of an array or members of an object, 0 otherwise.
+        size_t GetSize() const;
+
+        // Element of an array.
+        const JsonValue& operator[](size_t index) const;
+
+        // Member of an object.
+        const JsonValue& operator[](std::string_view name) const;
+        bool HasMember(std::string_view name) const;
+
+        const Array& GetArray() const;
+        const Object& GetObject() const;
+
+    private:
+        std::variant<std::monostate, bool, double, std::string, Array, Object> m_value;
+    };
+
+    // Parses a JSON document. Returns nullopt if the text is not valid JSON.
+    std::optional<JsonValue> ParseJson(std::string_view text);
+} // namespace DX
@@ -5,7 +5,7 @@
 #include <cstdarg>
 #include <cstdlib>
 
-#pragma DX_DISABLE_WARNING(4996, "")
+DX_DISABLE_WARNING(4996, "-Wdeprecated-declarations")
 
 namespace DX::Internal
 {
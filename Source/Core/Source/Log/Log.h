@@ -23,7 +23,7 @@
 // Disable warning C4100: unreferenced formal parameter
 // This happens often in release configuration when using DX_LOG()
 #include <Debug/Debug.h>
-#pragma DX_DISABLE_WARNING(4100, "")
+DX_DISABLE_WARNING(4100, "-Wunused-parameter")
 
 #endif // NDEBUG
 
@@ -1,25 +1,40 @@
 #pragma once
 
-#include <memory>
+#include <atomic>
+#include <mutex>
 
 namespace DX
 {
+    // Singleton creation and destruction are thread safe.
+    // The instance is created the first time Get is called.
     template<typename T>
     class Singleton
     {
     public:
         static T& Get()
         {
-            if (!Instance)
+            // Fast path once the instance has been created
+            if (T* instance = Instance.load(std::memory_order_acquire))
             {
-                Instance.reset(new T());
+                return *instance;
             }
-            return *Instance;
+
+            std::lock_guard lock(InstanceMutex);
+            if (!Instance.load(std::memory_order_relaxed))
+            {
+                Instance.store(new T(), std::memory_order_release);
+            }
+            return *Instance.load(std::memory_order_relaxed);
         }
 
         static void Destroy()
         {
-            Instance.reset();
+            T* instance = nullptr;
+            {
+                std::lock_guard lock(InstanceMutex);
+                instance = Instance.exchange(nullptr, std::memory_order_acq_rel);
+            }
+            delete instance;
         }
 
         virtual ~Singleton() = default;
@@ -32,7 +47,7 @@ namespace DX
         Singleton() = default;
 
     private:
-        static inline std::unique_ptr<T> Instance;
+        static inline std::atomic<T*> Instance = nullptr;
+        static inline std::mutex InstanceMutex;
     };
 } // namespace DX
-
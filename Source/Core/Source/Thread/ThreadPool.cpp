@@ -0,0 +1,118 @@
+#include <Thread/ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace DX
+{
+    ThreadPool::ThreadPool(uint32_t threadCount)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        m_threads.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; ++i)
+        {
+            m_threads.emplace_back(&ThreadPool::WorkerLoop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(m_tasksMutex);
+            m_stop = true;
+        }
+        m_tasksCondition.notify_all();
+
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& func)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        // Shared with the worker tasks, which can start after the loop
+        // has finished, when there are no indices left for them.
+        struct ParallelForState
+        {
+            const std::function<void(size_t)>* m_func = nullptr;
+            size_t m_count = 0;
+            std::atomic<size_t> m_nextIndex = 0;
+            std::atomic<size_t> m_finishedCount = 0;
+            std::mutex m_finishedMutex;
+            std::condition_variable m_finishedCondition;
+        };
+
+        auto state = std::make_shared<ParallelForState>();
+        state->m_func = &func;
+        state->m_count = count;
+
+        auto runIndices = [state]()
+            {
+                size_t finishedCount = 0;
+                for (size_t index = state->m_nextIndex++; index < state->m_count; index = state->m_nextIndex++)
+                {
+                    (*state->m_func)(index);
+                    ++finishedCount;
+                }
+
+                if (finishedCount > 0 &&
+                    state->m_finishedCount.fetch_add(finishedCount) + finishedCount == state->m_count)
+                {
+                    std::lock_guard lock(state->m_finishedMutex);
+                    state->m_finishedCondition.notify_all();
+                }
+            };
+
+        // The calling thread takes one of the indices, so it doesn't need a worker for it.
+        const size_t workerTaskCount = std::min<size_t>(m_threads.size(), count - 1);
+        if (workerTaskCount > 0)
+        {
+            {
+                std::lock_guard lock(m_tasksMutex);
+                for (size_t i = 0; i < workerTaskCount; ++i)
+                {
+                    m_tasks.emplace(runIndices);
+                }
+            }
+            m_tasksCondition.notify_all();
+        }
+
+        runIndices();
+
+        std::unique_lock lock(state->m_finishedMutex);
+        state->m_finishedCondition.wait(lock, [&state]() { return state->m_finishedCount == state->m_count; });
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(m_tasksMutex);
+                m_tasksCondition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+
+                // Keep executing tasks after stop until the queue is empty.
+                if (m_tasks.empty())
+                {
+                    return;
+                }
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+
+            task();
+        }
+    }
+} // namespace DX
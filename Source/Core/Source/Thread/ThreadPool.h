@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace DX
+{
+    // -------------------------------------------------------
+    // Usage:
+    //
+    // ThreadPool threadPool;
+    //
+    // std::future<int> result = threadPool.Submit([]() { return 123; });
+    //
+    // result.get(); // Blocks until the task has been executed by a worker thread.
+    //
+    // threadPool.ParallelFor(items.size(), [&](size_t index) { Process(items[index]); });
+    // -------------------------------------------------------
+
+    // Fixed number of worker threads executing tasks in FIFO order.
+    // Tasks already submitted are executed before the pool is destroyed.
+    class ThreadPool
+    {
+    public:
+        // Thread count 0 uses the number of hardware threads.
+        explicit ThreadPool(uint32_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_threads.size()); }
+
+        // Submits a task to be executed by a worker thread.
+        // Returns a future with the result of the task.
+        template<typename Func>
+        auto Submit(Func&& func) -> std::future<std::invoke_result_t<Func>>;
+
+        // Calls func for each index in [0, count), distributed between the worker threads
+        // and the calling thread, and returns once all the calls have finished.
+        // The calling thread takes indices too, so it can be called from a task of
+        // the same pool without waiting for workers that are busy.
+        void ParallelFor(size_t count, const std::function<void(size_t)>& func);
+
+    private:
+        void WorkerLoop();
+
+        std::vector<std::thread> m_threads;
+
+        std::mutex m_tasksMutex;
+        std::condition_variable m_tasksCondition;
+        std::queue<std::function<void()>> m_tasks;
+        bool m_stop = false;
+    };
+
+    template<typename Func>
+    auto ThreadPool::Submit(Func&& func) -> std::future<std::invoke_result_t<Func>>
+    {
+        using ResultType = std::invoke_result_t<Func>;
+
+        // std::function requires copyable callables, so the packaged task is shared.
+        auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<Func>(func));
+        std::future<ResultType> result = task->get_future();
+
+        {
+            std::lock_guard lock(m_tasksMutex);
+            m_tasks.emplace([task]() { (*task)(); });
+        }
+        m_tasksCondition.notify_one();
+
+        return result;
+    }
+} // namespace DX
@@ -0,0 +1,283 @@
+#include <File/AsyncFileReader.h>
+#include <File/FileUtils.h>
+
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <vector>
+#include <string>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace UnitTest
+{
+    class AsyncFileReaderTests
+    {
+    public:
+        AsyncFileReaderTests()
+        {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(DX::GetAssetPath() / "Models"))
+            {
+                if (entry.is_regular_file())
+                {
+                    m_filePaths.push_back(entry.path());
+                    m_totalSize += entry.file_size();
+                }
+            }
+
+            for (auto backend : { DX::AsyncFileReader::Backend::Auto, DX::AsyncFileReader::Backend::ThreadPool })
+            {
+                DX::AsyncFileReader fileReader(backend);
+
+                TestRead(fileReader);
+                TestCancel(fileReader);
+            }
+
+            TestReadThroughput();
+        }
+
+    private:
+        void TestRead(DX::AsyncFileReader& fileReader);
+        void TestCancel(DX::AsyncFileReader& fileReader);
+        void TestReadThroughput();
+
+        // Removes the files from the OS cache so the next read comes from disk.
+        // Returns false when some pages are still cached, then the next read is warm.
+        bool EvictFilesFromCache() const;
+
+        // Reads all the files one after the other with blocking reads.
+        double ReadFilesSequentially() const;
+
+        // Reads all the files with a single batch of asynchronous reads.
+        double ReadFilesInBatch(DX::AsyncFileReader& fileReader) const;
+
+        std::vector<std::filesystem::path> m_filePaths;
+        uintmax_t m_totalSize = 0;
+    };
+
+    void TestsAsyncFileReader()
+    {
+        {
+            AsyncFileReaderTests tests;
+        }
+
+        DX_LOG(Info, "Test", " --------------------------");
+    }
+
+    void AsyncFileReaderTests::TestRead(DX::AsyncFileReader& fileReader)
+    {
+        DX_LOG(Info, "Test", " ----- Testing AsyncFileReader Read (%s) -----", fileReader.GetBackendName());
+
+        // Futures
+        std::vector<DX::FileReadRequest> requests;
+        for (const auto& filePath : m_filePaths)
+        {
+            requests.push_back({ filePath });
+        }
+        requests.push_back({ DX::GetAssetPath() / "Missing.bin" });
+
+        std::vector<DX::FileReadHandle> handles = fileReader.ReadBatch(std::move(requests));
+        for (size_t i = 0; i < m_filePaths.size(); ++i)
+        {
+            DX::FileReadResult result = handles[i].m_future.get();
+            DX_ASSERT(result.m_status == DX::FileReadStatus::Success, "AsyncFileReaderTests", "Failed to read %s.", m_filePaths[i].generic_string().c_str());
+            DX_ASSERT(result.m_data.size() == std::filesystem::file_size(m_filePaths[i]), "AsyncFileReaderTests",
+                "Read %zu bytes of %s.", result.m_data.size(), m_filePaths[i].generic_string().c_str());
+        }
+        DX_ASSERT(handles.back().m_future.get().m_status == DX::FileReadStatus::Failed, "AsyncFileReaderTests", "Reading a missing file didn't fail.");
+
+        // Callbacks, the content must match a blocking read.
+        std::atomic<int> matchingFiles = 0;
+        std::vector<DX::FileReadHandle> callbackHandles;
+        for (const auto& filePath : m_filePaths)
+        {
+            callbackHandles.push_back(fileReader.Read({ filePath, DX::FileReadPriority::Normal,
+                [&matchingFiles, filePath](DX::FileReadResult result)
+                {
+                    std::ifstream file(filePath, std::ios::binary);
+                    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+                    if (result.m_status == DX::FileReadStatus::Success && result.m_data == data)
+                    {
+                        ++matchingFiles;
+                    }
+                } }));
+            DX_ASSERT(!callbackHandles.back().m_future.valid(), "AsyncFileReaderTests", "Request with callback has a valid future.");
+        }
+
+        while (matchingFiles < static_cast<int>(m_filePaths.size()))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void AsyncFileReaderTests::TestCancel(DX::AsyncFileReader& fileReader)
+    {
+        DX_LOG(Info, "Test", " ----- Testing AsyncFileReader Cancel (%s) -----", fileReader.GetBackendName());
+
+        // Queue more requests than the reader keeps in flight, the last ones are still pending.
+        static constexpr int RepeatCount = 16;
+
+        std::vector<DX::FileReadRequest> requests;
+        for (int i = 0; i < RepeatCount; ++i)
+        {
+            for (const auto& filePath : m_filePaths)
+            {
+                requests.push_back({ filePath, DX::FileReadPriority::Low });
+            }
+        }
+
+        std::vector<DX::FileReadHandle> handles = fileReader.ReadBatch(std::move(requests));
+
+        // High priority requests go before the low priority ones already queued.
+        DX::FileReadHandle highPriorityHandle = fileReader.Read({ m_filePaths.front(), DX::FileReadPriority::High });
+
+        int cancelledRequests = 0;
+        for (auto& handle : handles)
+        {
+            if (fileReader.Cancel(handle.m_requestId))
+            {
+                ++cancelledRequests;
+            }
+        }
+
+        int resultsCancelled = 0;
+        for (auto& handle : handles)
+        {
+            const DX::FileReadResult result = handle.m_future.get();
+            if (result.m_status == DX::FileReadStatus::Cancelled)
+            {
+                DX_ASSERT(result.m_data.empty(), "AsyncFileReaderTests", "Cancelled request has data.");
+                ++resultsCancelled;
+            }
+        }
+
+        DX_ASSERT(resultsCancelled == cancelledRequests, "AsyncFileReaderTests",
+            "%d requests cancelled but %d results are cancelled.", cancelledRequests, resultsCancelled);
+        DX_ASSERT(highPriorityHandle.m_future.get().m_status == DX::FileReadStatus::Success, "AsyncFileReaderTests", "High priority request failed.");
+
+        // Completed requests can no longer be cancelled.
+        DX_ASSERT(!fileReader.Cancel(highPriorityHandle.m_requestId), "AsyncFileReaderTests", "Completed request was cancelled.");
+
+        DX_LOG(Info, "Test", "Cancelled %d of %zu requests.", cancelledRequests, handles.size());
+    }
+
+    void AsyncFileReaderTests::TestReadThroughput()
+    {
+        DX_LOG(Info, "Test", " ----- Testing AsyncFileReader Read Throughput -----");
+
+        DX_LOG(Info, "Test", "Reading %zu files from Assets/Models, %.2f MB in total.",
+            m_filePaths.size(), static_cast<double>(m_totalSize) / (1024.0 * 1024.0));
+
+        DX::AsyncFileReader ioUringReader(DX::AsyncFileReader::Backend::Auto);
+        DX::AsyncFileReader threadPoolReader(DX::AsyncFileReader::Backend::ThreadPool);
+
+        for (bool cold : { true, false })
+        {
+            DX_LOG(Info, "Test", "%s reads:", cold ? "Cold" : "Warm");
+
+            // Cold reads of files that couldn't be evicted from the OS cache are labelled as warm.
+            auto logReadTime = [this, cold]([[maybe_unused]] const char* readName, auto readFiles)
+                {
+                    [[maybe_unused]] const bool warm = !cold || !EvictFilesFromCache();
+                    [[maybe_unused]] const double seconds = readFiles();
+                    DX_LOG(Info, "Test", "%-24s %8.2f ms (%.2f MB/s)%s", readName, seconds * 1000.0,
+                        static_cast<double>(m_totalSize) / (1024.0 * 1024.0) / seconds,
+                        (cold && warm) ? " warm, files still cached" : "");
+                };
+
+            logReadTime("Sequential blocking", [this]() { return ReadFilesSequentially(); });
+            logReadTime(ioUringReader.GetBackendName(), [&]() { return ReadFilesInBatch(ioUringReader); });
+            logReadTime(threadPoolReader.GetBackendName(), [&]() { return ReadFilesInBatch(threadPoolReader); });
+        }
+    }
+
+    bool AsyncFileReaderTests::EvictFilesFromCache() const
+    {
+#ifdef __linux__
+        // Only clean pages can be dropped, which is the case for files only read. Pages can
+        // still stay cached, for example when mapped by another process or with some file
+        // systems, so the pages are checked after dropping them.
+        const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        bool evicted = true;
+        for (const auto& filePath : m_filePaths)
+        {
+            const int fileFd = open(filePath.c_str(), O_RDONLY);
+            if (fileFd < 0)
+            {
+                continue;
+            }
+            posix_fadvise(fileFd, 0, 0, POSIX_FADV_DONTNEED);
+
+            // Mapping the file doesn't read it, mincore reports the pages that are cached.
+            const size_t fileSize = static_cast<size_t>(lseek(fileFd, 0, SEEK_END));
+            void* fileData = (fileSize > 0) ? mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fileFd, 0) : MAP_FAILED;
+            if (fileData != MAP_FAILED)
+            {
+                std::vector<unsigned char> residentPages((fileSize + pageSize - 1) / pageSize);
+                if (mincore(fileData, fileSize, residentPages.data()) != 0 ||
+                    std::ranges::any_of(residentPages, [](unsigned char page) { return (page & 1) != 0; }))
+                {
+                    evicted = false;
+                }
+                munmap(fileData, fileSize);
+            }
+            close(fileFd);
+        }
+        return evicted;
+#else
+        return false;
+#endif
+    }
+
+    double AsyncFileReaderTests::ReadFilesSequentially() const
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+
+        // Data is kept until the end, as the batch keeps all the files in memory at once.
+        std::vector<std::vector<uint8_t>> filesData;
+        filesData.reserve(m_filePaths.size());
+
+        for (const auto& filePath : m_filePaths)
+        {
+            std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+            std::vector<uint8_t>& data = filesData.emplace_back(static_cast<size_t>(file.tellg()));
+            file.seekg(std::streamoff(0), std::ios_base::beg);
+            file.read(reinterpret_cast<char*>(data.data()), data.size());
+            DX_ASSERT(file.good(), "AsyncFileReaderTests", "Failed to read %s.", filePath.generic_string().c_str());
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        return elapsed.count();
+    }
+
+    double AsyncFileReaderTests::ReadFilesInBatch(DX::AsyncFileReader& fileReader) const
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+
+        std::vector<DX::FileReadRequest> requests;
+        for (const auto& filePath : m_filePaths)
+        {
+            requests.push_back({ filePath });
+        }
+
+        std::vector<DX::FileReadResult> results;
+        results.reserve(m_filePaths.size());
+
+        for (auto& handle : fileReader.ReadBatch(std::move(requests)))
+        {
+            [[maybe_unused]] const DX::FileReadResult& result = results.emplace_back(handle.m_future.get());
+            DX_ASSERT(result.m_status == DX::FileReadStatus::Success, "AsyncFileReaderTests", "Failed to read file.");
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        return elapsed.count();
+    }
+}
@@ -0,0 +1,97 @@
+#include <File/FileUtils.h>
+
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace UnitTest
+{
+    class FileUtilsTests
+    {
+    public:
+        FileUtilsTests()
+            : m_folder(std::filesystem::temp_directory_path() / "FileUtilsTests")
+        {
+            std::filesystem::remove_all(m_folder);
+
+            TestWriteFileAtomically();
+
+            std::filesystem::remove_all(m_folder);
+        }
+
+    private:
+        void TestWriteFileAtomically();
+
+        std::vector<uint8_t> ReadFile(const std::filesystem::path& filePath) const
+        {
+            std::ifstream file(filePath, std::ios::binary);
+            return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+
+        std::filesystem::path m_folder;
+    };
+
+    void TestsFileUtils()
+    {
+        {
+            FileUtilsTests tests;
+        }
+
+        DX_LOG(Info, "Test", " --------------------------");
+    }
+
+    void FileUtilsTests::TestWriteFileAtomically()
+    {
+        DX_LOG(Info, "Test", " ----- Testing FileUtils Write File Atomically -----");
+
+        const std::filesystem::path filePath = m_folder / "Folder" / "File.bin";
+
+        // Missing folders are created.
+        {
+            const std::vector<uint8_t> data = { 1, 2, 3, 4 };
+            [[maybe_unused]] const bool written = DX::WriteFileAtomically(filePath, data);
+            DX_ASSERT(written && ReadFile(filePath) == data, "FileUtilsTests", "File not written.");
+        }
+
+        // Threads writing the same file at once use their own temporary files,
+        // the file ends up with the whole content of one of them.
+        {
+            const int threadCount = 8;
+
+            std::vector<std::vector<uint8_t>> threadsData;
+            for (int i = 0; i < threadCount; ++i)
+            {
+                threadsData.emplace_back(64 * 1024, static_cast<uint8_t>(i));
+            }
+
+            std::vector<std::thread> threads;
+            for (const auto& threadData : threadsData)
+            {
+                threads.emplace_back([&filePath, &threadData]()
+                    {
+                        for (int i = 0; i < 16; ++i)
+                        {
+                            DX::WriteFileAtomically(filePath, threadData);
+                        }
+                    });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+
+            [[maybe_unused]] const std::vector<uint8_t> fileData = ReadFile(filePath);
+            DX_ASSERT(std::ranges::find(threadsData, fileData) != threadsData.end(),
+                "FileUtilsTests", "File written from several threads has mixed content.");
+
+            [[maybe_unused]] const auto fileCount = std::distance(std::filesystem::directory_iterator(filePath.parent_path()), std::filesystem::directory_iterator());
+            DX_ASSERT(fileCount == 1, "FileUtilsTests", "Temporary files left in the folder.");
+        }
+    }
+} // namespace UnitTest
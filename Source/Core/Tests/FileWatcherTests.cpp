@@ -0,0 +1,104 @@
+#include <File/FileWatcher.h>
+
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace UnitTest
+{
+    class FileWatcherTests
+    {
+    public:
+        FileWatcherTests()
+            : m_folder(std::filesystem::temp_directory_path() / "FileWatcherTests")
+        {
+            std::filesystem::remove_all(m_folder);
+            std::filesystem::create_directories(m_folder / "Include");
+
+            TestChangedFiles();
+
+            std::filesystem::remove_all(m_folder);
+        }
+
+    private:
+        void TestChangedFiles();
+
+        // Notifications are received in the watcher's thread, it waits until the files are reported.
+        // Files are returned as generic strings, with the same separators in all platforms.
+        std::vector<std::string> WaitForChangedFiles(DX::FileWatcher& fileWatcher, size_t fileCount) const;
+
+        void WriteFile(const std::filesystem::path& filePath, const char* content) const
+        {
+            std::ofstream(m_folder / filePath) << content;
+        }
+
+        std::filesystem::path m_folder;
+    };
+
+    void TestsFileWatcher()
+    {
+        {
+            FileWatcherTests tests;
+        }
+
+        DX_LOG(Info, "Test", " --------------------------");
+    }
+
+    void FileWatcherTests::TestChangedFiles()
+    {
+        DX_LOG(Info, "Test", " ----- Testing FileWatcher Changed Files -----");
+
+        DX::FileWatcher fileWatcher(m_folder);
+        DX_ASSERT(fileWatcher.IsWatching(), "FileWatcherTests", "Failed to watch folder %s.", m_folder.generic_string().c_str());
+
+        // Files in subfolders are reported relative to the watched folder, once even if written several times.
+        WriteFile("Shader.hlsl", "1");
+        WriteFile("Include/Common.hlsli", "1");
+        WriteFile("Shader.hlsl", "2");
+
+        [[maybe_unused]] auto changedFiles = WaitForChangedFiles(fileWatcher, 2);
+        std::ranges::sort(changedFiles);
+        DX_ASSERT(changedFiles == std::vector<std::string>({ "Include/Common.hlsli", "Shader.hlsl" }),
+            "FileWatcherTests", "Changed files reported are not the files written.");
+
+        // Files saved through a temporary file, as many editors do.
+        WriteFile("Shader.tmp", "3");
+        std::filesystem::rename(m_folder / "Shader.tmp", m_folder / "Include" / "Common.hlsli");
+
+        changedFiles = WaitForChangedFiles(fileWatcher, 1);
+        DX_ASSERT(std::ranges::find(changedFiles, "Include/Common.hlsli") != changedFiles.end(),
+            "FileWatcherTests", "File renamed over another not reported.");
+    }
+
+    std::vector<std::string> FileWatcherTests::WaitForChangedFiles(DX::FileWatcher& fileWatcher, size_t fileCount) const
+    {
+        std::vector<std::string> changedFiles;
+
+        const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (changedFiles.size() < fileCount && std::chrono::steady_clock::now() < timeout)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            for (const auto& filePath : fileWatcher.TakeChangedFiles())
+            {
+                changedFiles.push_back(filePath.generic_string());
+            }
+        }
+
+        // Notifications of the same writes can arrive a bit later.
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        for (const auto& filePath : fileWatcher.TakeChangedFiles())
+        {
+            if (std::ranges::find(changedFiles, filePath.generic_string()) == changedFiles.end())
+            {
+                changedFiles.push_back(filePath.generic_string());
+            }
+        }
+        return changedFiles;
+    }
+} // namespace UnitTest
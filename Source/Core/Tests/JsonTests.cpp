@@ -0,0 +1,140 @@
+#include <Json/Json.h>
+
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <cmath>
+#include <string>
+
+namespace UnitTest
+{
+    class JsonTests
+    {
+    public:
+        JsonTests()
+        {
+            TestNumbers();
+            TestEscapes();
+            TestNesting();
+            TestMalformed();
+        }
+
+    private:
+        void TestNumbers();
+        void TestEscapes();
+        void TestNesting();
+        void TestMalformed();
+    };
+
+    void TestsJson()
+    {
+        {
+            JsonTests tests;
+        }
+
+        DX_LOG(Info, "Test", " --------------------------");
+    }
+
+    void JsonTests::TestNumbers()
+    {
+        DX_LOG(Info, "Test", " ----- Testing Json Numbers -----");
+
+        [[maybe_unused]] const auto json = DX::ParseJson(
+            R"([0, -12, 3.5, 1e3, -2.5E-1, 9007199254740992, 1e30, -1e30, 1e400, 0.5])");
+        DX_ASSERT(json && json->GetSize() == 10, "JsonTests", "Failed to parse numbers.");
+
+        DX_ASSERT((*json)[0].GetInt(-1) == 0 && (*json)[1].GetInt() == -12, "JsonTests", "Wrong integers.");
+        DX_ASSERT((*json)[2].GetNumber() == 3.5 && (*json)[3].GetInt() == 1000 && (*json)[4].GetNumber() == -0.25,
+            "JsonTests", "Wrong numbers with fractions or exponents.");
+        DX_ASSERT((*json)[5].GetInt() == 9007199254740992, "JsonTests", "Wrong big integer.");
+
+        // Numbers that are not integers or don't fit in int64_t return the default value.
+        DX_ASSERT((*json)[6].GetInt(-1) == -1 && (*json)[7].GetInt(-1) == -1, "JsonTests", "Integer out of range converted.");
+        DX_ASSERT((*json)[8].IsNumber() && std::isinf((*json)[8].GetNumber()) && (*json)[8].GetInt(-1) == -1,
+            "JsonTests", "Number overflowing a double is not infinite.");
+        DX_ASSERT((*json)[9].GetInt(-1) == -1, "JsonTests", "Fractional number converted to integer.");
+
+        // Values of other types return the default value.
+        DX_ASSERT(DX::ParseJson(R"("12")")->GetInt(-1) == -1, "JsonTests", "String converted to integer.");
+
+        // The JSON number grammar is stricter than strtod.
+        DX_ASSERT(!DX::ParseJson("+1") && !DX::ParseJson(".5") && !DX::ParseJson("1.") &&
+            !DX::ParseJson("1e") && !DX::ParseJson("0x10") && !DX::ParseJson("NaN"),
+            "JsonTests", "Invalid number parsed.");
+    }
+
+    void JsonTests::TestEscapes()
+    {
+        DX_LOG(Info, "Test", " ----- Testing Json Escapes -----");
+
+        [[maybe_unused]] const auto json = DX::ParseJson(R"("\"\\\/\b\f\n\r\tAé€😀")");
+        DX_ASSERT(json && json->GetString() == "\"\\/\b\f\n\r\tA\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80",
+            "JsonTests", "Wrong escaped string.");
+
+        // Unknown escapes, unpaired surrogates and unescaped control characters.
+        DX_ASSERT(!DX::ParseJson(R"("\x41")") && !DX::ParseJson(R"("\u00G1")") && !DX::ParseJson(R"("\ud83d")") &&
+            !DX::ParseJson(R"("\ud83dA")") && !DX::ParseJson("\"a\nb\""),
+            "JsonTests", "Invalid string parsed.");
+    }
+
+    void JsonTests::TestNesting()
+    {
+        DX_LOG(Info, "Test", " ----- Testing Json Nesting -----");
+
+        [[maybe_unused]] const auto json = DX::ParseJson(R"(
+            {
+                "name": "Scene",
+                "nodes": [ { "mesh": 1, "children": [2, 3] }, {} ],
+                "empty": [],
+                "flag": true,
+                "nothing": null
+            })");
+        DX_ASSERT(json && json->IsObject() && json->GetSize() == 5, "JsonTests", "Failed to parse object.");
+
+        // Members are kept in the order of the document.
+        DX_ASSERT(json->GetObject()[0].first == "name" && json->GetObject()[4].first == "nothing",
+            "JsonTests", "Members are not in document order.");
+
+        DX_ASSERT((*json)["name"].GetString() == "Scene" && (*json)["flag"].GetBool() &&
+            (*json)["nothing"].IsNull() && (*json)["empty"].IsArray() && (*json)["empty"].GetSize() == 0,
+            "JsonTests", "Wrong member values.");
+        DX_ASSERT((*json)["nodes"][0]["children"][1].GetInt() == 3 && (*json)["nodes"][1].IsObject(),
+            "JsonTests", "Wrong nested values.");
+
+        // Missing members and elements are null at any depth.
+        DX_ASSERT(!json->HasMember("missing") && (*json)["missing"]["deeper"][5].IsNull() &&
+            (*json)["nodes"][2].IsNull() && (*json)["nodes"][0]["mesh"].GetInt(-1) == 1,
+            "JsonTests", "Missing values are not null.");
+
+        // Documents deeper than the limit are rejected instead of overflowing the stack.
+        [[maybe_unused]] const std::string deepArray = std::string(100000, '[') + std::string(100000, ']');
+        DX_ASSERT(!DX::ParseJson(deepArray), "JsonTests", "Too deep document parsed.");
+        [[maybe_unused]] const std::string shallowArray = std::string(100, '[') + std::string(100, ']');
+        DX_ASSERT(DX::ParseJson(shallowArray).has_value(), "JsonTests", "Failed to parse nested arrays.");
+    }
+
+    void JsonTests::TestMalformed()
+    {
+        DX_LOG(Info, "Test", " ----- Testing Json Malformed Documents -----");
+
+        for ([[maybe_unused]] const char* text : {
+            "",
+            "   ",
+            "{",
+            "[1, 2",
+            "[1, 2,]",
+            R"({"a": 1,})",
+            R"({"a" 1})",
+            R"({a: 1})",
+            R"({"a": 1} {})",
+            R"("unterminated)",
+            "tru",
+            "nul",
+            "[1 2]" })
+        {
+            DX_ASSERT(!DX::ParseJson(text), "JsonTests", "Malformed document parsed: %s", text);
+        }
+
+        DX_ASSERT(DX::ParseJson(" \t\r\n{ } \n").has_value(), "JsonTests", "Failed to parse document with whitespace.");
+    }
+} // namespace UnitTest
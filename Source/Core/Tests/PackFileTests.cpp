@@ -0,0 +1,150 @@
+#include <File/PackFile.h>
+#include <File/FileUtils.h>
+#include <Compression/LZ4.h>
+
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace UnitTest
+{
+    class PackFileTests
+    {
+    public:
+        PackFileTests()
+            : m_folder(std::filesystem::temp_directory_path() / "PackFileTests")
+        {
+            std::filesystem::remove_all(m_folder);
+
+            TestFindEntry();
+            TestInvalidFiles();
+
+            std::filesystem::remove_all(m_folder);
+        }
+
+    private:
+        void TestFindEntry();
+        void TestInvalidFiles();
+
+        // Pack file with a table of contents of one slot, written by hand to create
+        // tables of contents the writer never creates.
+        void WriteSingleSlotPackFile(const std::filesystem::path& filePath, uint64_t pathHash, const std::string& path) const
+        {
+            DX::PackFileHeader header;
+            header.m_tocOffset = DX::PackFileTocAlignment;
+            header.m_tocSlotCount = 1;
+            header.m_entryCount = 1;
+            header.m_pathsOffset = header.m_tocOffset + sizeof(DX::PackFileEntry);
+            header.m_pathsSize = path.size() + 1;
+
+            DX::PackFileEntry entry;
+            entry.m_pathHash = pathHash;
+            entry.m_pathLength = static_cast<uint32_t>(path.size());
+
+            std::vector<uint8_t> fileData(header.m_pathsOffset + header.m_pathsSize, 0);
+            std::memcpy(fileData.data(), &header, sizeof(header));
+            std::memcpy(fileData.data() + header.m_tocOffset, &entry, sizeof(entry));
+            std::memcpy(fileData.data() + header.m_pathsOffset, path.data(), path.size());
+            DX::WriteFileAtomically(filePath, fileData);
+        }
+
+        std::filesystem::path m_folder;
+    };
+
+    void TestsPackFile()
+    {
+        {
+            PackFileTests tests;
+        }
+
+        DX_LOG(Info, "Test", " --------------------------");
+    }
+
+    void PackFileTests::TestFindEntry()
+    {
+        DX_LOG(Info, "Test", " ----- Testing PackFile Find Entry -----");
+
+        const std::filesystem::path packFilePath = m_folder / "Test.pak";
+
+        const std::string text = "Entry compressed with LZ4, Entry compressed with LZ4, Entry compressed with LZ4";
+        const std::vector<uint8_t> data(text.begin(), text.end());
+
+        DX::PackFileWriter writer;
+        writer.AddEntry("Models/Model.bin", data, DX::PackFileCompression::None);
+        writer.AddEntry("Shaders/Shader.hlsl", data, DX::PackFileCompression::LZ4);
+        [[maybe_unused]] const bool written = writer.Write(packFilePath);
+        DX_ASSERT(written, "PackFileTests", "Failed to write pack file.");
+
+        DX::PackFile packFile(packFilePath);
+        DX_ASSERT(packFile.IsValid(), "PackFileTests", "Pack file written is invalid.");
+
+        // Different spellings of the same path find the same entry.
+        [[maybe_unused]] const DX::PackFileEntry* entry = packFile.FindEntry("Shaders/../Shaders/Shader.hlsl");
+        DX_ASSERT(entry && packFile.GetEntryPath(*entry) == "Shaders/Shader.hlsl" &&
+            packFile.ReadEntry(*entry) == data, "PackFileTests", "Entry not found or with different data.");
+
+        DX_ASSERT(!packFile.FindEntry("Shaders/Missing.hlsl"), "PackFileTests", "Missing entry found.");
+
+        // Adding the same path twice fails.
+        DX::PackFileWriter duplicatedWriter;
+        duplicatedWriter.AddEntry("Models/Model.bin", data, DX::PackFileCompression::None);
+        duplicatedWriter.AddEntry("Models/./Model.bin", data, DX::PackFileCompression::None);
+        DX_ASSERT(!duplicatedWriter.Write(m_folder / "Duplicated.pak"), "PackFileTests", "Pack file with duplicated entries written.");
+    }
+
+    void PackFileTests::TestInvalidFiles()
+    {
+        DX_LOG(Info, "Test", " ----- Testing PackFile Invalid Files -----");
+
+        const std::filesystem::path packFilePath = m_folder / "Invalid.pak";
+
+        // An entry with the same hash as the path looked up but a different path is not the entry.
+        {
+            WriteSingleSlotPackFile(packFilePath, DX::HashPackFilePath("Textures/Texture.png"), "Textures/Other.png");
+
+            DX::PackFile packFile(packFilePath);
+            DX_ASSERT(packFile.IsValid() && !packFile.FindEntry("Textures/Texture.png"),
+                "PackFileTests", "Entry found by hash with a different path.");
+        }
+
+        // A table of contents without empty slots ends the lookup after probing all slots.
+        {
+            WriteSingleSlotPackFile(packFilePath, DX::HashPackFilePath("Textures/Other.png"), "Textures/Other.png");
+
+            DX::PackFile packFile(packFilePath);
+            DX_ASSERT(packFile.IsValid() && packFile.FindEntry("Textures/Other.png") && !packFile.FindEntry("Textures/Missing.png"),
+                "PackFileTests", "Lookup in table of contents without empty slots failed.");
+        }
+
+        // An uncompressed size too big for the compressed data is rejected before allocating it.
+        {
+            const std::vector<uint8_t> data(1024, 7);
+
+            DX::PackFileWriter writer;
+            writer.AddStoredEntry("Models/Model.bin", DX::CompressLZ4(data), DX::PackFileCompression::LZ4, uint64_t(1) << 60);
+            writer.Write(packFilePath);
+
+            DX::PackFile packFile(packFilePath);
+            [[maybe_unused]] const DX::PackFileEntry* entry = packFile.FindEntry("Models/Model.bin");
+            DX_ASSERT(packFile.IsValid() && entry && !packFile.ReadEntry(*entry),
+                "PackFileTests", "Entry with an invalid uncompressed size was read.");
+        }
+
+        // Table of contents so big its size overflows.
+        {
+            DX::PackFileHeader header;
+            header.m_tocOffset = DX::PackFileTocAlignment;
+            header.m_tocSlotCount = uint64_t(1) << 63;
+
+            std::vector<uint8_t> fileData(DX::PackFileDataAlignment, 0);
+            std::memcpy(fileData.data(), &header, sizeof(header));
+            DX::WriteFileAtomically(packFilePath, fileData);
+
+            DX::PackFile packFile(packFilePath);
+            DX_ASSERT(!packFile.IsValid(), "PackFileTests", "Pack file with an overflowing table of contents is valid.");
+        }
+    }
+} // namespace UnitTest
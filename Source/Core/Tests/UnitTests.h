@@ -0,0 +1,10 @@
+#pragma once
+
+namespace UnitTest
+{
+    void TestsAsyncFileReader();
+    void TestsFileUtils();
+    void TestsFileWatcher();
+    void TestsJson();
+    void TestsPackFile();
+}
@@ -0,0 +1,21 @@
+#include <UnitTests.h>
+
+int main()
+{
+    // Tests reading files asynchronously and compares it with blocking reads
+    UnitTest::TestsAsyncFileReader();
+
+    // Tests writing files atomically from several threads
+    UnitTest::TestsFileUtils();
+
+    // Tests reporting the files changed in a folder, used to reload shaders
+    UnitTest::TestsFileWatcher();
+
+    // Tests parsing JSON documents, used to import glTF files and load shader reports
+    UnitTest::TestsJson();
+
+    // Tests looking up entries in pack files and rejecting corrupt ones
+    UnitTest::TestsPackFile();
+
+    return 0;
+}
@@ -1,11 +1,14 @@
 #include <Application.h>
 
 #include <Assets/AssetManager.h>
+#include <Assets/MeshAsset.h>
 #include <Window/WindowManager.h>
 #include <Renderer/RendererManager.h>
 #include <Renderer/Object.h>
 #include <Renderer/Scene.h>
 #include <Camera/Camera.h>
+#include <File/FileUtils.h>
+#include <Log/Log.h>
 
 #include <Math/Transform.h>
 
@@ -17,6 +20,13 @@ namespace DX
 
     bool Application::Initialize(const Math::Vector2Int& windowSize, int refreshRate, bool fullScreen, bool vSync)
     {
+        // Asset files are read from the pack file when the assets have been packed.
+        if (const auto packFilePath = GetExecutablePath() / "Assets.pak";
+            std::filesystem::exists(packFilePath))
+        {
+            MountPackFile(packFilePath);
+        }
+
         // Asset Manager initialization
         AssetManager::Get();
 
@@ -39,6 +49,16 @@ namespace DX
         // Camera
         m_camera = std::make_unique<Camera>(Math::Vector3(0.0f, 2.0f, -2.0f), Math::Vector3(0.0f, 1.0f, 0.0f));
 
+        // Start loading all meshes in parallel. Objects will wait for
+        // their mesh to finish loading when they are created.
+        for (const char* meshFilename : {
+            "Models/Jack/Jack.fbx",
+            "Models/DamagedHelmet/DamagedHelmet.gltf",
+            "Models/Lantern/Lantern.gltf" })
+        {
+            MeshAsset::LoadMeshAssetAsync(meshFilename);
+        }
+
         // Prepare render objects
         m_objects.push_back(std::make_unique<Cube>(
             Math::Transform{ {-3.0f, 0.5f, 0.0f} },
@@ -61,6 +81,17 @@ namespace DX
             "Models/Lantern/Lantern_normal.png",
             "Models/Lantern/Lantern_emissive.png"));
 
+        // Objects only keep their geometry in GPU buffers, report what is left in CPU memory.
+        {
+            [[maybe_unused]] size_t objectsGeometryMemory = 0;
+            for (const auto& object : m_objects)
+            {
+                objectsGeometryMemory += object->GetCpuGeometryMemoryUsage();
+            }
+            DX_LOG(Info, "Application", "Resident CPU geometry: %zu bytes in objects and %zu bytes in mesh assets.",
+                objectsGeometryMemory, AssetManager::Get().GetMemoryUsage(MeshAsset::AssetTypeId));
+        }
+
         // Prepare render Scene
         Scene* scene = m_renderer->GetScene();
         scene->SetCamera(m_camera.get());
@@ -77,6 +108,8 @@ namespace DX
         {
             WindowManager::Get().PollEvents();
 
+            AssetManager::Get().Update();
+
             // Calculate delta time
             const auto t1 = std::chrono::system_clock::now();
             const float deltaTime = std::chrono::duration<float>(t1 - t0).count();
@@ -111,5 +144,6 @@ namespace DX
         RendererManager::Destroy();
         WindowManager::Destroy();
         AssetManager::Destroy();
+        UnmountPackFiles();
     }
 }
@@ -12,6 +12,7 @@
 #include <RHI/Resource/Views/RenderTargetView.h>
 #include <RHI/Resource/Views/DepthStencilView.h>
 #include <RHI/Pipeline/Pipeline.h>
+#include <RHI/Pipeline/PipelineCache.h>
 #include <RHI/CommandList/CommandList.h>
 
 #include <Log/Log.h>
@@ -19,10 +20,11 @@
 
 #include <array>
 #include <algorithm>
+#include <mutex>
 
 #include <d3d11.h>
 
-#pragma DX_DISABLE_WARNING(4267, "")
+DX_DISABLE_WARNING(4267, "-Wconversion")
 
 namespace DX
 {
@@ -64,6 +66,8 @@ namespace DX
             return;
         }
 
+        m_pipelineCache = std::make_unique<PipelineCache>();
+
         DX_LOG(Info, "Device", "Graphics device created.");
     }
 
@@ -96,6 +100,15 @@ namespace DX
 
         m_deviceObjects.clear();
 
+        [[maybe_unused]] const PipelineCacheStats pipelineCacheStats = m_pipelineCache->GetStats();
+        DX_LOG(Info, "Device", "Pipeline cache hit rates: pipelines %.0f%% (%u created), input layouts %.0f%%, rasterizer states %.0f%%, blend states %.0f%%, depth stencil states %.0f%%.",
+            pipelineCacheStats.m_pipelines.GetHitRate() * 100.0f, pipelineCacheStats.m_pipelines.m_misses,
+            pipelineCacheStats.m_inputLayouts.GetHitRate() * 100.0f,
+            pipelineCacheStats.m_rasterizerStates.GetHitRate() * 100.0f,
+            pipelineCacheStats.m_blendStates.GetHitRate() * 100.0f,
+            pipelineCacheStats.m_depthStencilStates.GetHitRate() * 100.0f);
+
+        m_pipelineCache.reset();
         m_immediateContext.reset();
 
         DX_LOG(Info, "Device", "Graphics device destroyed.");
@@ -104,87 +117,105 @@ namespace DX
     std::shared_ptr<SwapChain> Device::CreateSwapChain(const SwapChainDesc& desc)
     {
         auto swapChain = std::make_shared<SwapChain>(this, desc);
-        m_deviceObjects.push_back(swapChain);
+        AddDeviceObject(swapChain);
         return swapChain;
     }
 
     std::shared_ptr<FrameBuffer> Device::CreateFrameBuffer(const FrameBufferDesc& desc)
     {
         auto frameBuffer = std::make_shared<FrameBuffer>(this, desc);
-        m_deviceObjects.push_back(frameBuffer);
+        AddDeviceObject(frameBuffer);
         return frameBuffer;
     }
 
     std::shared_ptr<Buffer> Device::CreateBuffer(const BufferDesc& desc)
     {
         auto buffer = std::make_shared<Buffer>(this, desc);
-        m_deviceObjects.push_back(buffer);
+        AddDeviceObject(buffer);
         return buffer;
     }
 
     std::shared_ptr<Texture> Device::CreateTexture(const TextureDesc& desc)
     {
         auto texture = std::make_shared<Texture>(this, desc);
-        m_deviceObjects.push_back(texture);
+        AddDeviceObject(texture);
         return texture;
     }
 
     std::shared_ptr<Sampler> Device::CreateSampler(const SamplerDesc& desc)
     {
         auto sampler = std::make_shared<Sampler>(this, desc);
-        m_deviceObjects.push_back(sampler);
+        AddDeviceObject(sampler);
         return sampler;
     }
 
     std::shared_ptr<Shader> Device::CreateShader(const ShaderDesc& desc)
     {
         auto shader = std::make_shared<Shader>(this, desc);
-        m_deviceObjects.push_back(shader);
+        AddDeviceObject(shader);
         return shader;
     }
 
     std::shared_ptr<ShaderResourceView> Device::CreateShaderResourceView(const ShaderResourceViewDesc& desc)
     {
         auto shaderResourceView = std::make_shared<ShaderResourceView>(this, desc);
-        m_deviceObjects.push_back(shaderResourceView);
+        AddDeviceObject(shaderResourceView);
         return shaderResourceView;
     }
 
     std::shared_ptr<ShaderRWResourceView> Device::CreateShaderRWResourceView(const ShaderRWResourceViewDesc& desc)
     {
         auto shaderRWResourceView = std::make_shared<ShaderRWResourceView>(this, desc);
-        m_deviceObjects.push_back(shaderRWResourceView);
+        AddDeviceObject(shaderRWResourceView);
         return shaderRWResourceView;
     }
 
     std::shared_ptr<RenderTargetView> Device::CreateRenderTargetView(const RenderTargetViewDesc& desc)
     {
         auto renderTargetView = std::make_shared<RenderTargetView>(this, desc);
-        m_deviceObjects.push_back(renderTargetView);
+        AddDeviceObject(renderTargetView);
         return renderTargetView;
     }
 
     std::shared_ptr<DepthStencilView> Device::CreateDepthStencilView(const DepthStencilViewDesc& desc)
     {
         auto depthStencilView = std::make_shared<DepthStencilView>(this, desc);
-        m_deviceObjects.push_back(depthStencilView);
+        AddDeviceObject(depthStencilView);
         return depthStencilView;
     }
 
     std::shared_ptr<Pipeline> Device::CreatePipeline(const PipelineDesc& desc)
     {
+        const uint64_t pipelineKey = PipelineCache::HashPipelineDesc(desc);
+        if (auto pipeline = m_pipelineCache->FindPipeline(pipelineKey, desc))
+        {
+            return pipeline;
+        }
+
+        // Created outside the cache lock, if another thread created the same
+        // pipeline meanwhile this one is discarded.
         auto pipeline = std::make_shared<Pipeline>(this, desc);
-        m_deviceObjects.push_back(pipeline);
-        return pipeline;
+        auto cachedPipeline = m_pipelineCache->AddPipeline(pipelineKey, pipeline);
+        if (cachedPipeline == pipeline)
+        {
+            AddDeviceObject(pipeline);
+        }
+        return cachedPipeline;
     }
 
     std::shared_ptr<CommandList> Device::CreateCommandList()
     {
         auto commandList = std::make_shared<CommandList>(this);
-        m_deviceObjects.push_back(commandList);
+        AddDeviceObject(commandList);
         return commandList;
     }
 
+    void Device::AddDeviceObject(std::shared_ptr<DeviceObject> deviceObject)
+    {
+        std::lock_guard lock(m_deviceObjectsMutex);
+        m_deviceObjects.push_back(std::move(deviceObject));
+    }
+
     void Device::ExecuteCommandLists(std::vector<CommandList*> commandLists)
     {
         const bool restoreContextState = false;
@@ -199,6 +230,11 @@ namespace DX
         }
     }
 
+    PipelineCache& Device::GetPipelineCache()
+    {
+        return *m_pipelineCache;
+    }
+
     ComPtr<ID3D11Device> Device::GetDX11Device()
     {
         return m_dx11Device;
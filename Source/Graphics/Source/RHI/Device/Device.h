@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #include <RHI/DirectX/ComPtr.h>
 struct ID3D11Device;
@@ -21,6 +22,7 @@ namespace DX
     class RenderTargetView;
     class DepthStencilView;
     class Pipeline;
+    class PipelineCache;
     class CommandList;
 
     struct SwapChainDesc;
@@ -37,6 +39,9 @@ namespace DX
 
     // Render device that allows to create all the objects needed for rendering.
     // It also provides the immediate context that can be used to execute rendering commands.
+    //
+    // Objects can be created from any thread, for example to create pipelines in worker threads.
+    // Executing command lists uses the immediate context and must be done from the render thread.
     class Device
     {
     public:
@@ -56,20 +61,29 @@ namespace DX
         std::shared_ptr<ShaderRWResourceView> CreateShaderRWResourceView(const ShaderRWResourceViewDesc& desc);
         std::shared_ptr<RenderTargetView> CreateRenderTargetView(const RenderTargetViewDesc& desc);
         std::shared_ptr<DepthStencilView> CreateDepthStencilView(const DepthStencilViewDesc& desc);
+        // Pipelines with the same description are created once, see PipelineCache.
         std::shared_ptr<Pipeline> CreatePipeline(const PipelineDesc& desc);
         std::shared_ptr<CommandList> CreateCommandList();
 
         void ExecuteCommandLists(std::vector<CommandList*> commandLists);
 
+        // Cache of pipelines and their state objects, with its hit rates in GetStats().
+        PipelineCache& GetPipelineCache();
+
         ComPtr<ID3D11Device> GetDX11Device();
 
     private:
         using DeviceObjects = std::vector<std::shared_ptr<DeviceObject>>;
 
+        void AddDeviceObject(std::shared_ptr<DeviceObject> deviceObject);
+
+        std::mutex m_deviceObjectsMutex;
         DeviceObjects m_deviceObjects;
 
         std::unique_ptr<DeviceContext> m_immediateContext;
 
+        std::unique_ptr<PipelineCache> m_pipelineCache;
+
     private:
         ComPtr<ID3D11Device> m_dx11Device;
     };
@@ -17,7 +17,7 @@
 #include <d3d11.h>
 #include <RHI/DirectX/Utils.h>
 
-#pragma DX_DISABLE_WARNING(4267, "")
+DX_DISABLE_WARNING(4267, "-Wconversion")
 
 namespace DX
 {
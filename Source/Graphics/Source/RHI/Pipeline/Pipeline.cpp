@@ -1,6 +1,7 @@
 #include <RHI/Pipeline/Pipeline.h>
 
 #include <RHI/Device/Device.h>
+#include <RHI/Pipeline/PipelineCache.h>
 #include <RHI/Shader/ShaderBytecode.h>
 #include <RHI/Pipeline/InputLayout/InputLayout.h>
 #include <RHI/Pipeline/RasterizerState/RasterizerState.h>
@@ -14,7 +15,7 @@
 #include <d3d11.h>
 #include <RHI/DirectX/Utils.h>
 
-#pragma DX_DISABLE_WARNING(4267, "")
+DX_DISABLE_WARNING(4267, "-Wconversion")
 
 namespace DX
 {
@@ -87,14 +88,22 @@ namespace DX
 
         // Once an input-layout object is created for a vertex shader signature, the input-layout object can be reused
         // with any other vertex shader that has an identical input signature (semantics included). 
-        auto result = m_ownerDevice->GetDX11Device()->CreateInputLayout(
-            inputLayoutDesc.data(),
-            inputLayoutDesc.size(),
-            m_desc.m_shaders[ShaderType_Vertex]->GetShaderDesc().m_bytecode->GetData(),
-            m_desc.m_shaders[ShaderType_Vertex]->GetShaderDesc().m_bytecode->GetSize(),
-            m_dx11InputLayout.GetAddressOf());
-
-        return SUCCEEDED(result);
+        const ShaderBytecode& vertexShaderBytecode = *m_desc.m_shaders[ShaderType_Vertex]->GetShaderDesc().m_bytecode;
+        m_dx11InputLayout = m_ownerDevice->GetPipelineCache().GetInputLayout(
+            PipelineCache::HashInputLayout(m_desc.m_inputLayout, vertexShaderBytecode),
+            [&]()
+            {
+                ComPtr<ID3D11InputLayout> dx11InputLayout;
+                m_ownerDevice->GetDX11Device()->CreateInputLayout(
+                    inputLayoutDesc.data(),
+                    inputLayoutDesc.size(),
+                    vertexShaderBytecode.GetData(),
+                    vertexShaderBytecode.GetSize(),
+                    dx11InputLayout.GetAddressOf());
+                return dx11InputLayout;
+            });
+
+        return m_dx11InputLayout != nullptr;
     }
 
     bool Pipeline::CreateRasterizerState()
@@ -111,11 +120,16 @@ namespace DX
         rasterizerDesc.MultisampleEnable = m_desc.m_rasterizerState.m_multisampleEnabled;
         rasterizerDesc.AntialiasedLineEnable = m_desc.m_rasterizerState.m_antialiasedLineEnabled;
 
-        auto result = m_ownerDevice->GetDX11Device()->CreateRasterizerState(
-            &rasterizerDesc,
-            m_dx11RasterizerState.GetAddressOf());
+        m_dx11RasterizerState = m_ownerDevice->GetPipelineCache().GetRasterizerState(
+            PipelineCache::HashRasterizerState(m_desc.m_rasterizerState),
+            [&]()
+            {
+                ComPtr<ID3D11RasterizerState> dx11State;
+                m_ownerDevice->GetDX11Device()->CreateRasterizerState(&rasterizerDesc, dx11State.GetAddressOf());
+                return dx11State;
+            });
 
-        return SUCCEEDED(result);
+        return m_dx11RasterizerState != nullptr;
     }
 
     bool Pipeline::CreateBlendState()
@@ -160,11 +174,16 @@ namespace DX
             rtbDesc.RenderTargetWriteMask = ToDX11ColorWriteMask(renderTargetBlend.m_colorWriteMask);
         }
 
-        auto result = m_ownerDevice->GetDX11Device()->CreateBlendState(
-            &blendDesc,
-            m_dx11BlendState.GetAddressOf());
+        m_dx11BlendState = m_ownerDevice->GetPipelineCache().GetBlendState(
+            PipelineCache::HashBlendState(m_desc.m_blendState),
+            [&]()
+            {
+                ComPtr<ID3D11BlendState> dx11State;
+                m_ownerDevice->GetDX11Device()->CreateBlendState(&blendDesc, dx11State.GetAddressOf());
+                return dx11State;
+            });
 
-        return SUCCEEDED(result);
+        return m_dx11BlendState != nullptr;
     }
 
     bool Pipeline::CreateDepthStencilState()
@@ -187,11 +206,16 @@ namespace DX
             depthStencilDesc.BackFace = ToDX11StencipBehaviour(m_desc.m_depthStencilState.m_backFaceStencilBehaviour);
         }
 
-        auto result = m_ownerDevice->GetDX11Device()->CreateDepthStencilState(
-            &depthStencilDesc,
-            m_dx11DepthStencilState.GetAddressOf());
+        m_dx11DepthStencilState = m_ownerDevice->GetPipelineCache().GetDepthStencilState(
+            PipelineCache::HashDepthStencilState(m_desc.m_depthStencilState),
+            [&]()
+            {
+                ComPtr<ID3D11DepthStencilState> dx11State;
+                m_ownerDevice->GetDX11Device()->CreateDepthStencilState(&depthStencilDesc, dx11State.GetAddressOf());
+                return dx11State;
+            });
 
-        return SUCCEEDED(result);
+        return m_dx11DepthStencilState != nullptr;
     }
 
     bool Pipeline::CreatePipelineResourceBindings()
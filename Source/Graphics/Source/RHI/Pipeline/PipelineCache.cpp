@@ -0,0 +1,389 @@
+#include <RHI/Pipeline/PipelineCache.h>
+
+#include <RHI/Pipeline/Pipeline.h>
+#include <RHI/Pipeline/PipelineDesc.h>
+#include <RHI/Shader/ShaderBytecode.h>
+#include <Hash/Hash.h>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include <d3d11.h>
+
+namespace DX
+{
+    namespace Internal
+    {
+        // Fields are hashed one by one, hashing the whole structs
+        // would include the content of their padding bytes.
+        template<typename T>
+        static uint64_t HashField(const T& value, uint64_t seed)
+        {
+            static_assert(std::is_trivially_copyable_v<T> && !std::is_class_v<T>, "Only scalar fields can be hashed.");
+            return Hash64(&value, sizeof(T), seed);
+        }
+
+        static uint64_t HashRenderTargetBlend(const RenderTargetBlend& renderTargetBlend, uint64_t seed)
+        {
+            uint64_t hash = HashField(renderTargetBlend.m_blendEnabled, seed);
+            if (renderTargetBlend.m_blendEnabled)
+            {
+                hash = HashField(renderTargetBlend.m_srcBlend, hash);
+                hash = HashField(renderTargetBlend.m_destBlend, hash);
+                hash = HashField(renderTargetBlend.m_blendOp, hash);
+                hash = HashField(renderTargetBlend.m_srcBlendAlpha, hash);
+                hash = HashField(renderTargetBlend.m_destBlendAlpha, hash);
+                hash = HashField(renderTargetBlend.m_blendOpAlpha, hash);
+            }
+            return HashField(renderTargetBlend.m_colorWriteMask, hash);
+        }
+
+        static uint64_t HashStencilBehaviour(const StencilBehaviour& stencilBehaviour, uint64_t seed)
+        {
+            uint64_t hash = HashField(stencilBehaviour.m_stencilFailOp, seed);
+            hash = HashField(stencilBehaviour.m_stencilDepthFailOp, hash);
+            hash = HashField(stencilBehaviour.m_stencilPassOp, hash);
+            return HashField(stencilBehaviour.m_stencilComparisonFunction, hash);
+        }
+
+        static bool AreBytecodesEqual(const ShaderBytecode* lhs, const ShaderBytecode* rhs)
+        {
+            if (!lhs || !rhs)
+            {
+                return lhs == rhs;
+            }
+            return lhs->GetSize() == rhs->GetSize() &&
+                std::memcmp(lhs->GetData(), rhs->GetData(), lhs->GetSize()) == 0;
+        }
+
+        static const ShaderBytecode* GetBytecode(const PipelineDesc& desc, int shaderType)
+        {
+            const auto& shader = desc.m_shaders[shaderType];
+            return shader ? shader->GetShaderDesc().m_bytecode.get() : nullptr;
+        }
+
+        static bool AreInputElementsEqual(const InputElement& lhs, const InputElement& rhs)
+        {
+            return lhs.m_semantic == rhs.m_semantic &&
+                (lhs.m_semantic != InputSemantic::CustomName || lhs.m_semanticCustomName == rhs.m_semanticCustomName) &&
+                lhs.m_semanticIndex == rhs.m_semanticIndex &&
+                lhs.m_format == rhs.m_format &&
+                lhs.m_inputSlot == rhs.m_inputSlot &&
+                lhs.m_alignedByteOffset == rhs.m_alignedByteOffset &&
+                lhs.m_instanceDataStepRate == rhs.m_instanceDataStepRate;
+        }
+
+        static bool AreRasterizerStatesEqual(const RasterizerState& lhs, const RasterizerState& rhs)
+        {
+            return lhs.m_faceFrontOrder == rhs.m_faceFrontOrder &&
+                lhs.m_faceCullMode == rhs.m_faceCullMode &&
+                lhs.m_faceFillMode == rhs.m_faceFillMode &&
+                lhs.m_depthBias == rhs.m_depthBias &&
+                lhs.m_depthBiasClamp == rhs.m_depthBiasClamp &&
+                lhs.m_slopeScaledDepthBias == rhs.m_slopeScaledDepthBias &&
+                lhs.m_depthClipDisabled == rhs.m_depthClipDisabled &&
+                lhs.m_scissorEnabled == rhs.m_scissorEnabled &&
+                lhs.m_multisampleEnabled == rhs.m_multisampleEnabled &&
+                lhs.m_antialiasedLineEnabled == rhs.m_antialiasedLineEnabled;
+        }
+
+        static bool AreRenderTargetBlendsEqual(const RenderTargetBlend& lhs, const RenderTargetBlend& rhs)
+        {
+            if (lhs.m_blendEnabled != rhs.m_blendEnabled ||
+                lhs.m_colorWriteMask != rhs.m_colorWriteMask)
+            {
+                return false;
+            }
+            return !lhs.m_blendEnabled ||
+                (lhs.m_srcBlend == rhs.m_srcBlend &&
+                lhs.m_destBlend == rhs.m_destBlend &&
+                lhs.m_blendOp == rhs.m_blendOp &&
+                lhs.m_srcBlendAlpha == rhs.m_srcBlendAlpha &&
+                lhs.m_destBlendAlpha == rhs.m_destBlendAlpha &&
+                lhs.m_blendOpAlpha == rhs.m_blendOpAlpha);
+        }
+
+        static bool AreBlendStatesEqual(const BlendState& lhs, const BlendState& rhs)
+        {
+            if (lhs.m_alphaToCoverageEnabled != rhs.m_alphaToCoverageEnabled ||
+                lhs.m_independentBlendEnabled != rhs.m_independentBlendEnabled)
+            {
+                return false;
+            }
+
+            // Without independent blend only the first render target is used.
+            const int renderTargetCount = lhs.m_independentBlendEnabled ? BlendState::MaxRenderTargets : 1;
+            for (int i = 0; i < renderTargetCount; ++i)
+            {
+                if (!AreRenderTargetBlendsEqual(lhs.renderTargetBlends[i], rhs.renderTargetBlends[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static bool AreStencilBehavioursEqual(const StencilBehaviour& lhs, const StencilBehaviour& rhs)
+        {
+            return lhs.m_stencilFailOp == rhs.m_stencilFailOp &&
+                lhs.m_stencilDepthFailOp == rhs.m_stencilDepthFailOp &&
+                lhs.m_stencilPassOp == rhs.m_stencilPassOp &&
+                lhs.m_stencilComparisonFunction == rhs.m_stencilComparisonFunction;
+        }
+
+        static bool AreDepthStencilStatesEqual(const DepthStencilState& lhs, const DepthStencilState& rhs)
+        {
+            if (lhs.m_depthEnabled != rhs.m_depthEnabled ||
+                lhs.m_stencilEnabled != rhs.m_stencilEnabled)
+            {
+                return false;
+            }
+            if (lhs.m_depthEnabled &&
+                (lhs.m_depthTestFunc != rhs.m_depthTestFunc ||
+                lhs.m_depthWriteEnabled != rhs.m_depthWriteEnabled))
+            {
+                return false;
+            }
+            return !lhs.m_stencilEnabled ||
+                (lhs.m_stencilReadMask == rhs.m_stencilReadMask &&
+                lhs.m_stencilWriteMask == rhs.m_stencilWriteMask &&
+                AreStencilBehavioursEqual(lhs.m_frontFaceStencilBehaviour, rhs.m_frontFaceStencilBehaviour) &&
+                AreStencilBehavioursEqual(lhs.m_backFaceStencilBehaviour, rhs.m_backFaceStencilBehaviour));
+        }
+    }
+
+    uint64_t PipelineCache::HashPipelineDesc(const PipelineDesc& desc)
+    {
+        uint64_t hash = 0;
+        for (int shaderType = 0; shaderType < ShaderType_Count; ++shaderType)
+        {
+            const auto& shader = desc.m_shaders[shaderType];
+            const ShaderBytecode* bytecode = shader ? shader->GetShaderDesc().m_bytecode.get() : nullptr;
+
+            hash = Internal::HashField(bytecode != nullptr, hash);
+            if (bytecode)
+            {
+                hash = Hash64(bytecode->GetData(), bytecode->GetSize(), hash);
+            }
+        }
+
+        if (desc.m_shaders[ShaderType_Vertex] && desc.m_shaders[ShaderType_Vertex]->GetShaderDesc().m_bytecode)
+        {
+            hash = Internal::HashField(HashInputLayout(desc.m_inputLayout, *desc.m_shaders[ShaderType_Vertex]->GetShaderDesc().m_bytecode), hash);
+        }
+        hash = Internal::HashField(desc.m_inputLayout.m_primitiveTopology, hash);
+        if (desc.m_inputLayout.m_primitiveTopology == PrimitiveTopology::ControlPointPatchList)
+        {
+            hash = Internal::HashField(desc.m_inputLayout.m_controlPointPatchListCount, hash);
+        }
+
+        hash = Internal::HashField(HashRasterizerState(desc.m_rasterizerState), hash);
+        hash = Internal::HashField(HashBlendState(desc.m_blendState), hash);
+        return Internal::HashField(HashDepthStencilState(desc.m_depthStencilState), hash);
+    }
+
+    uint64_t PipelineCache::HashInputLayout(const InputLayout& inputLayout, const ShaderBytecode& vertexShaderBytecode)
+    {
+        // The input layout is validated against the vertex shader input signature,
+        // the whole bytecode is hashed as it's the only way of identifying it.
+        uint64_t hash = Hash64(vertexShaderBytecode.GetData(), vertexShaderBytecode.GetSize());
+        for (const InputElement& element : inputLayout.m_inputElements)
+        {
+            hash = Internal::HashField(element.m_semantic, hash);
+            if (element.m_semantic == InputSemantic::CustomName)
+            {
+                hash = Hash64(element.m_semanticCustomName, hash);
+            }
+            hash = Internal::HashField(element.m_semanticIndex, hash);
+            hash = Internal::HashField(element.m_format, hash);
+            hash = Internal::HashField(element.m_inputSlot, hash);
+            hash = Internal::HashField(element.m_alignedByteOffset, hash);
+            hash = Internal::HashField(element.m_instanceDataStepRate, hash);
+        }
+        return hash;
+    }
+
+    uint64_t PipelineCache::HashRasterizerState(const RasterizerState& rasterizerState)
+    {
+        uint64_t hash = Internal::HashField(rasterizerState.m_faceFrontOrder, 0);
+        hash = Internal::HashField(rasterizerState.m_faceCullMode, hash);
+        hash = Internal::HashField(rasterizerState.m_faceFillMode, hash);
+        hash = Internal::HashField(rasterizerState.m_depthBias, hash);
+        hash = Internal::HashField(rasterizerState.m_depthBiasClamp, hash);
+        hash = Internal::HashField(rasterizerState.m_slopeScaledDepthBias, hash);
+        hash = Internal::HashField(rasterizerState.m_depthClipDisabled, hash);
+        hash = Internal::HashField(rasterizerState.m_scissorEnabled, hash);
+        hash = Internal::HashField(rasterizerState.m_multisampleEnabled, hash);
+        return Internal::HashField(rasterizerState.m_antialiasedLineEnabled, hash);
+    }
+
+    uint64_t PipelineCache::HashBlendState(const BlendState& blendState)
+    {
+        uint64_t hash = Internal::HashField(blendState.m_alphaToCoverageEnabled, 0);
+        hash = Internal::HashField(blendState.m_independentBlendEnabled, hash);
+
+        // Without independent blend only the first render target is used.
+        const int renderTargetCount = blendState.m_independentBlendEnabled ? BlendState::MaxRenderTargets : 1;
+        for (int i = 0; i < renderTargetCount; ++i)
+        {
+            hash = Internal::HashRenderTargetBlend(blendState.renderTargetBlends[i], hash);
+        }
+        return hash;
+    }
+
+    uint64_t PipelineCache::HashDepthStencilState(const DepthStencilState& depthStencilState)
+    {
+        uint64_t hash = Internal::HashField(depthStencilState.m_depthEnabled, 0);
+        if (depthStencilState.m_depthEnabled)
+        {
+            hash = Internal::HashField(depthStencilState.m_depthTestFunc, hash);
+            hash = Internal::HashField(depthStencilState.m_depthWriteEnabled, hash);
+        }
+
+        hash = Internal::HashField(depthStencilState.m_stencilEnabled, hash);
+        if (depthStencilState.m_stencilEnabled)
+        {
+            hash = Internal::HashField(depthStencilState.m_stencilReadMask, hash);
+            hash = Internal::HashField(depthStencilState.m_stencilWriteMask, hash);
+            hash = Internal::HashStencilBehaviour(depthStencilState.m_frontFaceStencilBehaviour, hash);
+            hash = Internal::HashStencilBehaviour(depthStencilState.m_backFaceStencilBehaviour, hash);
+        }
+        return hash;
+    }
+
+    bool PipelineCache::AreEquivalent(const PipelineDesc& lhs, const PipelineDesc& rhs)
+    {
+        for (int shaderType = 0; shaderType < ShaderType_Count; ++shaderType)
+        {
+            if (!Internal::AreBytecodesEqual(Internal::GetBytecode(lhs, shaderType), Internal::GetBytecode(rhs, shaderType)))
+            {
+                return false;
+            }
+        }
+
+        // Input layouts only take effect with a vertex shader, the bytecodes are already equal.
+        if (Internal::GetBytecode(lhs, ShaderType_Vertex) &&
+            !std::ranges::equal(lhs.m_inputLayout.m_inputElements, rhs.m_inputLayout.m_inputElements, Internal::AreInputElementsEqual))
+        {
+            return false;
+        }
+        if (lhs.m_inputLayout.m_primitiveTopology != rhs.m_inputLayout.m_primitiveTopology ||
+            (lhs.m_inputLayout.m_primitiveTopology == PrimitiveTopology::ControlPointPatchList &&
+            lhs.m_inputLayout.m_controlPointPatchListCount != rhs.m_inputLayout.m_controlPointPatchListCount))
+        {
+            return false;
+        }
+
+        return Internal::AreRasterizerStatesEqual(lhs.m_rasterizerState, rhs.m_rasterizerState) &&
+            Internal::AreBlendStatesEqual(lhs.m_blendState, rhs.m_blendState) &&
+            Internal::AreDepthStencilStatesEqual(lhs.m_depthStencilState, rhs.m_depthStencilState);
+    }
+
+    std::shared_ptr<Pipeline> PipelineCache::FindPipeline(uint64_t key, const PipelineDesc& desc)
+    {
+        std::lock_guard lock(m_mutex);
+
+        auto [begin, end] = m_pipelines.equal_range(key);
+        for (auto it = begin; it != end; ++it)
+        {
+            if (auto pipeline = it->second.lock();
+                pipeline && AreEquivalent(pipeline->GetPipelineDesc(), desc))
+            {
+                ++m_stats.m_pipelines.m_hits;
+                return pipeline;
+            }
+        }
+
+        ++m_stats.m_pipelines.m_misses;
+        return nullptr;
+    }
+
+    std::shared_ptr<Pipeline> PipelineCache::AddPipeline(uint64_t key, std::shared_ptr<Pipeline> pipeline)
+    {
+        std::lock_guard lock(m_mutex);
+
+        auto [begin, end] = m_pipelines.equal_range(key);
+        for (auto it = begin; it != end; ++it)
+        {
+            if (auto existingPipeline = it->second.lock();
+                existingPipeline && AreEquivalent(existingPipeline->GetPipelineDesc(), pipeline->GetPipelineDesc()))
+            {
+                return existingPipeline;
+            }
+        }
+
+        // Pipelines are rarely destroyed, pruning when the entries double
+        // keeps the cost constant per pipeline added.
+        if (m_pipelines.size() >= m_pruneThreshold)
+        {
+            PruneExpiredPipelines();
+        }
+
+        m_pipelines.emplace(key, pipeline);
+        return pipeline;
+    }
+
+    void PipelineCache::PruneExpiredPipelines()
+    {
+        std::erase_if(m_pipelines,
+            [](const auto& entry)
+            {
+                return entry.second.expired();
+            });
+
+        m_pruneThreshold = std::max(MinPruneThreshold, m_pipelines.size() * 2);
+    }
+
+    template<typename T>
+    ComPtr<T> PipelineCache::GetStateObject(StateObjects<T>& stateObjects, PipelineCacheCounter& counter,
+        uint64_t key, const std::function<ComPtr<T>()>& create)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            if (auto it = stateObjects.find(key);
+                it != stateObjects.end())
+            {
+                ++counter.m_hits;
+                return it->second;
+            }
+            ++counter.m_misses;
+        }
+
+        ComPtr<T> stateObject = create();
+        if (!stateObject)
+        {
+            return nullptr;
+        }
+
+        // When another thread created the same state meanwhile, both use the first one.
+        std::lock_guard lock(m_mutex);
+        return stateObjects.try_emplace(key, std::move(stateObject)).first->second;
+    }
+
+    ComPtr<ID3D11InputLayout> PipelineCache::GetInputLayout(uint64_t key, const std::function<ComPtr<ID3D11InputLayout>()>& create)
+    {
+        return GetStateObject(m_inputLayouts, m_stats.m_inputLayouts, key, create);
+    }
+
+    ComPtr<ID3D11RasterizerState> PipelineCache::GetRasterizerState(uint64_t key, const std::function<ComPtr<ID3D11RasterizerState>()>& create)
+    {
+        return GetStateObject(m_rasterizerStates, m_stats.m_rasterizerStates, key, create);
+    }
+
+    ComPtr<ID3D11BlendState> PipelineCache::GetBlendState(uint64_t key, const std::function<ComPtr<ID3D11BlendState>()>& create)
+    {
+        return GetStateObject(m_blendStates, m_stats.m_blendStates, key, create);
+    }
+
+    ComPtr<ID3D11DepthStencilState> PipelineCache::GetDepthStencilState(uint64_t key, const std::function<ComPtr<ID3D11DepthStencilState>()>& create)
+    {
+        return GetStateObject(m_depthStencilStates, m_stats.m_depthStencilStates, key, create);
+    }
+
+    PipelineCacheStats PipelineCache::GetStats() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_stats;
+    }
+} // namespace DX
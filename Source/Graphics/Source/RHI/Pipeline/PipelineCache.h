@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <RHI/DirectX/ComPtr.h>
+struct ID3D11InputLayout;
+struct ID3D11RasterizerState;
+struct ID3D11BlendState;
+struct ID3D11DepthStencilState;
+
+namespace DX
+{
+    class Pipeline;
+    class ShaderBytecode;
+    struct PipelineDesc;
+    struct InputLayout;
+    struct RasterizerState;
+    struct BlendState;
+    struct DepthStencilState;
+
+    struct PipelineCacheCounter
+    {
+        uint32_t m_hits = 0;
+        uint32_t m_misses = 0;
+
+        // Ratio [0, 1] of requests that reused an existing object.
+        float GetHitRate() const
+        {
+            const uint32_t requests = m_hits + m_misses;
+            return (requests > 0) ? static_cast<float>(m_hits) / requests : 0.0f;
+        }
+    };
+
+    struct PipelineCacheStats
+    {
+        PipelineCacheCounter m_pipelines;
+        PipelineCacheCounter m_inputLayouts;
+        PipelineCacheCounter m_rasterizerStates;
+        PipelineCacheCounter m_blendStates;
+        PipelineCacheCounter m_depthStencilStates;
+    };
+
+    // Deduplicates pipelines and the D3D11 state objects they use.
+    //
+    // Pipelines are identified by the hash of their description: the content of the
+    // shaders bytecode (not the shader objects, each material creates its own), the input
+    // layout and the state blocks. Requesting a pipeline with the same description
+    // returns the existing one. On a hash match the descriptions are compared too, so
+    // pipelines whose descriptions collide are kept apart.
+    //
+    // State objects are cached on their own, so pipelines that only differ in shaders
+    // share the rasterizer, blend and depth stencil states. Input layouts depend on the
+    // vertex shader input signature, they are shared by pipelines with the same vertex
+    // shader and input elements.
+    //
+    // Only the fields that take effect are hashed, for example the blend factors
+    // of a render target without blending enabled.
+    //
+    // It's owned by the Device and it's thread safe. Objects are created outside
+    // the lock, so pipelines can be created in parallel from worker threads.
+    class PipelineCache
+    {
+    public:
+        static uint64_t HashPipelineDesc(const PipelineDesc& desc);
+        static uint64_t HashInputLayout(const InputLayout& inputLayout, const ShaderBytecode& vertexShaderBytecode);
+        static uint64_t HashRasterizerState(const RasterizerState& rasterizerState);
+        static uint64_t HashBlendState(const BlendState& blendState);
+        static uint64_t HashDepthStencilState(const DepthStencilState& depthStencilState);
+
+        // Returns nullptr if there is no pipeline alive with that key and an equivalent description.
+        std::shared_ptr<Pipeline> FindPipeline(uint64_t key, const PipelineDesc& desc);
+
+        // Returns the pipeline passed or, if another thread added an equivalent
+        // one meanwhile, the one added first.
+        std::shared_ptr<Pipeline> AddPipeline(uint64_t key, std::shared_ptr<Pipeline> pipeline);
+
+        // Compares the fields that take effect, the same ones that are hashed.
+        static bool AreEquivalent(const PipelineDesc& lhs, const PipelineDesc& rhs);
+
+        // The create function is only called when there is no state with that key.
+        // Failed creations (null states) are not cached.
+        ComPtr<ID3D11InputLayout> GetInputLayout(uint64_t key, const std::function<ComPtr<ID3D11InputLayout>()>& create);
+        ComPtr<ID3D11RasterizerState> GetRasterizerState(uint64_t key, const std::function<ComPtr<ID3D11RasterizerState>()>& create);
+        ComPtr<ID3D11BlendState> GetBlendState(uint64_t key, const std::function<ComPtr<ID3D11BlendState>()>& create);
+        ComPtr<ID3D11DepthStencilState> GetDepthStencilState(uint64_t key, const std::function<ComPtr<ID3D11DepthStencilState>()>& create);
+
+        PipelineCacheStats GetStats() const;
+
+    private:
+        template<typename T>
+        using StateObjects = std::unordered_map<uint64_t, ComPtr<T>>;
+
+        template<typename T>
+        ComPtr<T> GetStateObject(StateObjects<T>& stateObjects, PipelineCacheCounter& counter,
+            uint64_t key, const std::function<ComPtr<T>()>& create);
+
+        // Removes the entries of destroyed pipelines. The mutex must be locked by the caller.
+        void PruneExpiredPipelines();
+
+        mutable std::mutex m_mutex;
+
+        // Weak, the cache doesn't keep pipelines alive. Several entries
+        // with the same key when their descriptions collide.
+        std::unordered_multimap<uint64_t, std::weak_ptr<Pipeline>> m_pipelines;
+
+        // Expired entries are pruned when the number of entries reaches the threshold.
+        static constexpr size_t MinPruneThreshold = 64;
+        size_t m_pruneThreshold = MinPruneThreshold;
+
+        StateObjects<ID3D11InputLayout> m_inputLayouts;
+        StateObjects<ID3D11RasterizerState> m_rasterizerStates;
+        StateObjects<ID3D11BlendState> m_blendStates;
+        StateObjects<ID3D11DepthStencilState> m_depthStencilStates;
+
+        PipelineCacheStats m_stats;
+    };
+} // namespace DX
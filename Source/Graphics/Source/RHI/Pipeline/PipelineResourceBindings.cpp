@@ -186,6 +186,11 @@ namespace DX
         return m_pipeline;
     }
 
+    void PipelineResourceBindings::SetPipeline(Pipeline* pipeline)
+    {
+        m_pipeline = pipeline;
+    }
+
     const PipelineResourceBindingData& PipelineResourceBindings::GetBindingData() const
     {
         return m_bindingData;
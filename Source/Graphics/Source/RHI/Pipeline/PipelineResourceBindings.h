@@ -1,6 +1,7 @@
 #pragma once
 
 #include <RHI/Shader/ShaderEnums.h>
+#include <RHI/Shader/ShaderBindings.h>
 
 #include <vector>
 #include <array>
@@ -45,8 +46,21 @@ namespace DX
         void SetShaderRWResourceView(const std::string& name, std::shared_ptr<ShaderRWResourceView> srwrv);
         void SetSampler(ShaderType shaderType, const std::string& name, std::shared_ptr<Sampler> sampler);
 
+        // Set resources using the bindings generated from the shaders (see ShaderBindings.h),
+        // in all the stages that use them. Slots are constants, there is no lookup by name.
+        template<typename Binding>
+        void SetConstantBuffer(std::shared_ptr<Buffer> buffer);
+        template<typename Binding>
+        void SetShaderResourceView(std::shared_ptr<ShaderResourceView> srv);
+        template<typename Binding>
+        void SetSampler(std::shared_ptr<Sampler> sampler);
+
         const Pipeline* GetPipeline() const;
 
+        // Moves the bindings to another pipeline with the same resource layout,
+        // like the same pipeline with its shaders compiled again, keeping the resources set.
+        void SetPipeline(Pipeline* pipeline);
+
         const PipelineResourceBindingData& GetBindingData() const;
 
     private:
@@ -54,4 +68,40 @@ namespace DX
 
         PipelineResourceBindingData m_bindingData;
     };
+
+    template<typename Binding>
+    void PipelineResourceBindings::SetConstantBuffer(std::shared_ptr<Buffer> buffer)
+    {
+        for (int i = 0; i < ShaderType_Count; ++i)
+        {
+            if (Binding::Stages & ShaderStageBit(static_cast<ShaderType>(i)))
+            {
+                SetConstantBuffer(static_cast<ShaderType>(i), Binding::Slot, buffer);
+            }
+        }
+    }
+
+    template<typename Binding>
+    void PipelineResourceBindings::SetShaderResourceView(std::shared_ptr<ShaderResourceView> srv)
+    {
+        for (int i = 0; i < ShaderType_Count; ++i)
+        {
+            if (Binding::Stages & ShaderStageBit(static_cast<ShaderType>(i)))
+            {
+                SetShaderResourceView(static_cast<ShaderType>(i), Binding::Slot, srv);
+            }
+        }
+    }
+
+    template<typename Binding>
+    void PipelineResourceBindings::SetSampler(std::shared_ptr<Sampler> sampler)
+    {
+        for (int i = 0; i < ShaderType_Count; ++i)
+        {
+            if (Binding::Stages & ShaderStageBit(static_cast<ShaderType>(i)))
+            {
+                SetSampler(static_cast<ShaderType>(i), Binding::Slot, sampler);
+            }
+        }
+    }
 } // namespace DX
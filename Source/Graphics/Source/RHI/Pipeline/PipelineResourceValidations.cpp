@@ -101,8 +101,10 @@ namespace DX
                                 srvInfo.m_textureType, textureDesc.m_textureType);
                         }
 
+                        // Textures with array 1 can be viewed as an array too.
                         if ((srvInfo.m_textureSubTypeFlags & TextureSubType_Array) &&
-                            textureDesc.m_arrayCount < 2)
+                            textureDesc.m_arrayCount < 2 &&
+                            srv->GetShaderResourceViewDesc().m_arrayCount == 0)
                         {
                             DX_LOG(Error, "PipelineResourceValidations",
                                 "Shader Resource View set in slot %d (name '%s') for %s Shader %s does not point to a Texture Array.",
@@ -1,4 +1,4 @@
-#include <RHI/Resource/Texture/Texture.h>
+#include <RHI/Resource/Texture/TextureEnums.h>
 
 namespace DX
 {
@@ -11,12 +11,15 @@
 
 namespace DX
 {
-    static D3D11_SRV_DIMENSION ToDX11ShaderResourceViewDimension(const Texture& texture)
+    static D3D11_SRV_DIMENSION ToDX11ShaderResourceViewDimension(const Texture& texture, const ShaderResourceViewDesc& viewDesc)
     {
         D3D11_SRV_DIMENSION srvDimension;
 
         const TextureDesc& desc = texture.GetTextureDesc();
 
+        // Textures that are not arrays can also be viewed as an array of 1 texture.
+        const bool isArrayView = (desc.m_arrayCount > 1) || (viewDesc.m_arrayCount > 0);
+
         switch (desc.m_textureType)
         {
         case TextureType::Unknown:
@@ -24,7 +27,7 @@ namespace DX
             break;
         
         case TextureType::Texture1D:
-            srvDimension = (desc.m_arrayCount > 1) ? D3D11_SRV_DIMENSION_TEXTURE1DARRAY : D3D11_SRV_DIMENSION_TEXTURE1D;
+            srvDimension = isArrayView ? D3D11_SRV_DIMENSION_TEXTURE1DARRAY : D3D11_SRV_DIMENSION_TEXTURE1D;
             break;
         
         case TextureType::Texture2D:
@@ -34,7 +37,7 @@ namespace DX
             }
             else
             {
-                srvDimension = (desc.m_arrayCount > 1) ? D3D11_SRV_DIMENSION_TEXTURE2DARRAY : D3D11_SRV_DIMENSION_TEXTURE2D;
+                srvDimension = isArrayView ? D3D11_SRV_DIMENSION_TEXTURE2DARRAY : D3D11_SRV_DIMENSION_TEXTURE2D;
             }
             break;
 
@@ -59,7 +62,7 @@ namespace DX
     {
         D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
         srvDesc.Format = ToDX11ResourceFormat(desc.m_viewFormat);
-        srvDesc.ViewDimension = ToDX11ShaderResourceViewDimension(texture);
+        srvDesc.ViewDimension = ToDX11ShaderResourceViewDimension(texture, desc);
 
         // View boundaries to the texture
         switch (srvDesc.ViewDimension)
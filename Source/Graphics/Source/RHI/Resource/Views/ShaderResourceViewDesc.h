@@ -29,6 +29,8 @@ namespace DX
         // Only for textures 1D, 2D and Cube with array > 1
         uint32_t m_firstArray; // Index of the first texture to use in an array of textures.
         uint32_t m_arrayCount; // Number of arrays in the texture to use, starting from m_firstArray.
+                               // Textures 1D and 2D with array 1 are viewed as an array when it's 1,
+                               // for shaders that declare a texture array (Texture2DArray in HLSL).
 
         // Only for Buffers.
         // Note it's the number of elements in the buffer, not bytes.
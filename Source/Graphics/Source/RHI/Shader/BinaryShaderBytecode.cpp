@@ -0,0 +1,23 @@
+#include <RHI/Shader/BinaryShaderBytecode.h>
+
+#include <Debug/Debug.h>
+
+namespace DX
+{
+    BinaryShaderBytecode::BinaryShaderBytecode(std::vector<uint8_t>&& bytecode, ShaderResourceLayout&& resourceLayout)
+        : ShaderBytecode(std::move(resourceLayout))
+        , m_bytecode(std::move(bytecode))
+    {
+        DX_ASSERT(!m_bytecode.empty(), "BinaryShaderBytecode", "Empty shader bytecode");
+    }
+
+    const void* BinaryShaderBytecode::GetData() const
+    {
+        return m_bytecode.data();
+    }
+
+    uint32_t BinaryShaderBytecode::GetSize() const
+    {
+        return static_cast<uint32_t>(m_bytecode.size());
+    }
+} // namespace DX
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <RHI/Shader/ShaderBytecode.h>
+
+#include <vector>
+
+namespace DX
+{
+    // Shader bytecode kept in memory, for formats that are not
+    // created by d3dcompiler, like DXIL and SPIR-V compiled with DXC.
+    class BinaryShaderBytecode : public ShaderBytecode
+    {
+    public:
+        BinaryShaderBytecode(std::vector<uint8_t>&& bytecode, ShaderResourceLayout&& resourceLayout);
+        ~BinaryShaderBytecode() = default;
+
+        BinaryShaderBytecode(const BinaryShaderBytecode&) = delete;
+        BinaryShaderBytecode& operator=(const BinaryShaderBytecode&) = delete;
+
+        const void* GetData() const override;
+        uint32_t GetSize() const override;
+
+    private:
+        std::vector<uint8_t> m_bytecode;
+    };
+} // namespace DX
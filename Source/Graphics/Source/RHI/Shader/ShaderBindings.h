@@ -0,0 +1,48 @@
+#pragma once
+
+#include <RHI/Shader/ShaderEnums.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DX
+{
+    // Bitmask of shader stages, one bit per ShaderType.
+    using ShaderStageMask = uint32_t;
+
+    constexpr ShaderStageMask ShaderStageBit(ShaderType shaderType)
+    {
+        return 1u << shaderType;
+    }
+} // namespace DX
+
+// -------------------------------------------------------
+// Shader bindings are headers generated by ShaderBindingsGenerator from the
+// reflection of shaders. Each resource is a struct with its constexpr slot and
+// the stages that use it, and constant buffers also have their size and the
+// offset and size of their variables:
+//
+// namespace DX::SceneShaderBindings::ConstantBuffers
+// {
+//     struct WorldMatrixConstantBuffer
+//     {
+//         static constexpr uint32_t Slot = 1;
+//         static constexpr ShaderStageMask Stages = ShaderStageBit(ShaderType_Vertex) | ShaderStageBit(ShaderType_Pixel);
+//         static constexpr uint32_t Size = 128;
+//
+//         struct worldMatrix { static constexpr uint32_t Offset = 0; static constexpr uint32_t Size = 64; };
+//     };
+// }
+//
+// The macros below check C++ structs against them, so a struct that doesn't
+// match its cbuffer in the shader fails to compile.
+// -------------------------------------------------------
+
+#define DX_CHECK_CONSTANT_BUFFER_SIZE(Struct, ConstantBuffer) \
+    static_assert(sizeof(Struct) == ConstantBuffer::Size, \
+        #Struct " doesn't have the size of " #ConstantBuffer " in the shader.")
+
+#define DX_CHECK_CONSTANT_BUFFER_MEMBER(Struct, member, ConstantBuffer, variable) \
+    static_assert(offsetof(Struct, member) == ConstantBuffer::variable::Offset && \
+        sizeof(Struct::member) == ConstantBuffer::variable::Size, \
+        #Struct "::" #member " doesn't match " #variable " of " #ConstantBuffer " in the shader.")
@@ -0,0 +1,180 @@
+#include <RHI/Shader/ShaderCompiler/ShaderBindingsGenerator.h>
+
+#include <Log/Log.h>
+
+#include <algorithm>
+#include <format>
+#include <tuple>
+#include <vector>
+
+namespace DX
+{
+    namespace Internal
+    {
+        // Resource of the bindings, with all the stages that use it.
+        struct ShaderBinding
+        {
+            std::string m_name;
+            uint32_t m_slot = 0;
+            uint32_t m_slotCount = 0;
+            std::vector<ShaderType> m_shaderTypes;
+            const ShaderConstantBufferLayout* m_constantBufferLayout = nullptr;
+        };
+
+        static bool AddShaderBindings(
+            std::vector<ShaderBinding>& bindings,
+            const ShaderReflection& shader,
+            const std::vector<ShaderResourceInfo>& resources,
+            bool isConstantBuffer)
+        {
+            for (const auto& resource : resources)
+            {
+                // Globals of the shader ($Globals) are not a binding of their own.
+                if (resource.m_name.starts_with('$'))
+                {
+                    continue;
+                }
+
+                const ShaderConstantBufferLayout* constantBufferLayout = nullptr;
+                if (isConstantBuffer)
+                {
+                    auto layoutIt = std::ranges::find(shader.m_constantBufferLayouts, resource.m_name, &ShaderConstantBufferLayout::m_name);
+                    if (layoutIt == shader.m_constantBufferLayouts.end())
+                    {
+                        DX_LOG(Error, "ShaderBindingsGenerator", "Constant buffer %s of shader %s has no layout.",
+                            resource.m_name.c_str(), shader.m_name.c_str());
+                        return false;
+                    }
+                    constantBufferLayout = &(*layoutIt);
+                }
+
+                auto it = std::ranges::find(bindings, resource.m_name, &ShaderBinding::m_name);
+                if (it == bindings.end())
+                {
+                    bindings.push_back({ resource.m_name, resource.m_startSlot, resource.m_slotCount, { shader.m_shaderType }, constantBufferLayout });
+                    continue;
+                }
+
+                if (it->m_slot != resource.m_startSlot || it->m_slotCount != resource.m_slotCount)
+                {
+                    DX_LOG(Error, "ShaderBindingsGenerator", "Resource %s of shader %s is in slot %u, but it's in slot %u in other shaders.",
+                        resource.m_name.c_str(), shader.m_name.c_str(), resource.m_startSlot, it->m_slot);
+                    return false;
+                }
+                if (constantBufferLayout && *constantBufferLayout != *it->m_constantBufferLayout)
+                {
+                    DX_LOG(Error, "ShaderBindingsGenerator", "Constant buffer %s of shader %s has a different layout than in other shaders.",
+                        resource.m_name.c_str(), shader.m_name.c_str());
+                    return false;
+                }
+                if (std::ranges::find(it->m_shaderTypes, shader.m_shaderType) == it->m_shaderTypes.end())
+                {
+                    it->m_shaderTypes.push_back(shader.m_shaderType);
+                }
+            }
+            return true;
+        }
+
+        static std::string ShaderStagesStr(std::vector<ShaderType> shaderTypes)
+        {
+            std::ranges::sort(shaderTypes);
+
+            std::string stages;
+            for (const ShaderType shaderType : shaderTypes)
+            {
+                stages += std::format("{}ShaderStageBit(ShaderType_{})", stages.empty() ? "" : " | ", ShaderTypeStr(shaderType));
+            }
+            return stages;
+        }
+
+        static void WriteShaderBindings(std::string& header, const char* namespaceName, std::vector<ShaderBinding>& bindings)
+        {
+            if (bindings.empty())
+            {
+                return;
+            }
+
+            std::ranges::sort(bindings, [](const ShaderBinding& lhs, const ShaderBinding& rhs)
+                {
+                    return std::tie(lhs.m_slot, lhs.m_name) < std::tie(rhs.m_slot, rhs.m_name);
+                });
+
+            header += std::format("    namespace {}\n    {{\n", namespaceName);
+            for (const auto& binding : bindings)
+            {
+                if (&binding != &bindings.front())
+                {
+                    header += "\n";
+                }
+
+                header += std::format("        struct {}\n        {{\n", binding.m_name);
+                header += std::format("            static constexpr uint32_t Slot = {};\n", binding.m_slot);
+                header += std::format("            static constexpr uint32_t SlotCount = {};\n", binding.m_slotCount);
+                header += std::format("            static constexpr ShaderStageMask Stages = {};\n", ShaderStagesStr(binding.m_shaderTypes));
+
+                if (binding.m_constantBufferLayout)
+                {
+                    header += std::format("            static constexpr uint32_t Size = {};\n", binding.m_constantBufferLayout->m_size);
+                    if (!binding.m_constantBufferLayout->m_variables.empty())
+                    {
+                        header += "\n";
+                    }
+                    for (const auto& variable : binding.m_constantBufferLayout->m_variables)
+                    {
+                        header += std::format("            struct {} {{ static constexpr uint32_t Offset = {}; static constexpr uint32_t Size = {}; }};\n",
+                            variable.m_name, variable.m_offset, variable.m_size);
+                    }
+                }
+
+                header += "        };\n";
+            }
+            header += std::format("    }} // namespace {}\n\n", namespaceName);
+        }
+    }
+
+    std::optional<std::string> GenerateShaderBindingsHeader(const std::string& bindingsName, std::span<const ShaderReflection> shaders)
+    {
+        std::vector<Internal::ShaderBinding> constantBuffers;
+        std::vector<Internal::ShaderBinding> shaderResourceViews;
+        std::vector<Internal::ShaderBinding> shaderRWResourceViews;
+        std::vector<Internal::ShaderBinding> samplers;
+
+        for (const auto& shader : shaders)
+        {
+            const ShaderResourceLayout& layout = shader.m_shaderResourceLayout;
+            if (!Internal::AddShaderBindings(constantBuffers, shader, layout.m_constantBuffers, true) ||
+                !Internal::AddShaderBindings(shaderResourceViews, shader, layout.m_shaderResourceViews, false) ||
+                !Internal::AddShaderBindings(shaderRWResourceViews, shader, layout.m_shaderRWResourceViews, false) ||
+                !Internal::AddShaderBindings(samplers, shader, layout.m_samplers, false))
+            {
+                return std::nullopt;
+            }
+        }
+
+        std::string header = "// Generated by ShaderBindingsGenerator from:\n";
+        for (const auto& shader : shaders)
+        {
+            header += std::format("// - {} ({})\n", shader.m_name, ShaderTypeStr(shader.m_shaderType));
+        }
+        header += "//\n// Do not edit, it's generated again when the shaders change.\n\n";
+
+        header += "#pragma once\n\n";
+        header += "#include <RHI/Shader/ShaderBindings.h>\n\n";
+        header += "#include <cstdint>\n\n";
+
+        header += std::format("namespace DX::{}\n{{\n", bindingsName);
+        Internal::WriteShaderBindings(header, "ConstantBuffers", constantBuffers);
+        Internal::WriteShaderBindings(header, "ShaderResourceViews", shaderResourceViews);
+        Internal::WriteShaderBindings(header, "ShaderRWResourceViews", shaderRWResourceViews);
+        Internal::WriteShaderBindings(header, "Samplers", samplers);
+
+        // No blank line before the end of the namespace.
+        if (header.ends_with("\n\n"))
+        {
+            header.pop_back();
+        }
+        header += std::format("}} // namespace DX::{}\n", bindingsName);
+
+        return header;
+    }
+} // namespace DX
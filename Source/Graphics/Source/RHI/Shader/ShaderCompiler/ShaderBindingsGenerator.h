@@ -0,0 +1,18 @@
+#pragma once
+
+#include <RHI/Shader/ShaderReflection.h>
+
+#include <optional>
+#include <span>
+#include <string>
+
+namespace DX
+{
+    // Generates the C++ header with the bindings of a set of shaders, usually the
+    // shaders of a pipeline, in namespace DX::<bindingsName>. See ShaderBindings.h.
+    //
+    // Resources used by several shaders are a single binding with all their stages.
+    // Returns nullopt if shaders use the same name for resources in different slots,
+    // or for constant buffers with different layouts.
+    std::optional<std::string> GenerateShaderBindingsHeader(const std::string& bindingsName, std::span<const ShaderReflection> shaders);
+} // namespace DX
@@ -0,0 +1,249 @@
+#include <RHI/Shader/ShaderCompiler/ShaderCache.h>
+#include <RHI/Shader/ShaderCompiler/ShaderFileCache.h>
+
+#include <File/FileUtils.h>
+#include <File/MappedFile.h>
+
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace DX
+{
+    namespace Internal
+    {
+        // -------------------------------------------------------
+        // Shader cache file
+        //
+        // ShaderCacheHeader
+        // Dependencies, for each one: content hash and file name
+        // Shader resource layout: constant buffers, shader resource views,
+        //     shader RW resource views and samplers, then their slot counts
+        // Shader statistics
+        // Bytecode
+        //
+        // Strings are stored as their length followed by their characters.
+        // -------------------------------------------------------
+
+        struct ShaderCacheHeader
+        {
+            static constexpr uint32_t Magic = 0x48535844; // "DXSH"
+
+            uint32_t m_magic = Magic;
+            uint32_t m_version = ShaderCacheVersion;
+            uint32_t m_dependencyCount = 0;
+            uint32_t m_bytecodeSize = 0;
+            uint64_t m_cacheKey = 0;
+        };
+
+        template<typename T>
+        static void WriteValue(std::vector<uint8_t>& data, const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be written");
+
+            const size_t offset = data.size();
+            data.resize(offset + sizeof(T));
+            std::memcpy(data.data() + offset, &value, sizeof(T));
+        }
+
+        static void WriteString(std::vector<uint8_t>& data, const std::string& str)
+        {
+            WriteValue(data, static_cast<uint32_t>(str.size()));
+            data.insert(data.end(), str.begin(), str.end());
+        }
+
+        template<typename T>
+        static bool ReadValue(std::span<const uint8_t>& data, T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be read");
+
+            if (data.size() < sizeof(T))
+            {
+                return false;
+            }
+            std::memcpy(&value, data.data(), sizeof(T));
+            data = data.subspan(sizeof(T));
+            return true;
+        }
+
+        static bool ReadString(std::span<const uint8_t>& data, std::string& str)
+        {
+            uint32_t length = 0;
+            if (!ReadValue(data, length) || data.size() < length)
+            {
+                return false;
+            }
+            str.assign(reinterpret_cast<const char*>(data.data()), length);
+            data = data.subspan(length);
+            return true;
+        }
+
+        static void WriteResources(std::vector<uint8_t>& data, const std::vector<ShaderResourceInfo>& resources)
+        {
+            WriteValue(data, static_cast<uint32_t>(resources.size()));
+            for (const auto& resource : resources)
+            {
+                WriteString(data, resource.m_name);
+                WriteValue(data, resource.m_startSlot);
+                WriteValue(data, resource.m_slotCount);
+                WriteValue(data, resource.m_bufferSubType);
+                WriteValue(data, resource.m_textureType);
+                WriteValue(data, resource.m_textureSubTypeFlags);
+            }
+        }
+
+        static bool ReadResources(std::span<const uint8_t>& data, std::vector<ShaderResourceInfo>& resources)
+        {
+            // Each resource takes more than a byte, bigger counts are from invalid data.
+            uint32_t resourceCount = 0;
+            if (!ReadValue(data, resourceCount) || resourceCount > data.size())
+            {
+                return false;
+            }
+
+            resources.resize(resourceCount);
+            for (auto& resource : resources)
+            {
+                if (!ReadString(data, resource.m_name) ||
+                    !ReadValue(data, resource.m_startSlot) ||
+                    !ReadValue(data, resource.m_slotCount) ||
+                    !ReadValue(data, resource.m_bufferSubType) ||
+                    !ReadValue(data, resource.m_textureType) ||
+                    !ReadValue(data, resource.m_textureSubTypeFlags))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    std::optional<ShaderCacheEntry> LoadShaderFromCache(uint64_t cacheKey)
+    {
+        const std::filesystem::path cacheFilePath = GetShaderCacheFilePath(cacheKey);
+        if (!std::filesystem::exists(cacheFilePath))
+        {
+            return std::nullopt;
+        }
+
+        const MappedFile cacheFile(cacheFilePath, FileAccessPattern::Sequential);
+        if (!cacheFile.IsValid())
+        {
+            return std::nullopt;
+        }
+
+        auto entry = DeserializeShaderCacheEntry(cacheKey, cacheFile.GetData());
+        if (!entry)
+        {
+            return std::nullopt;
+        }
+
+        // The entry is stale if any file included by the shader has changed.
+        for (const auto& dependency : entry->m_dependencies)
+        {
+            const auto file = ShaderFileCache::Load(dependency.m_fileName);
+            if (!file || file->m_contentHash != dependency.m_contentHash)
+            {
+                return std::nullopt;
+            }
+        }
+
+        return entry;
+    }
+
+    bool SaveShaderToCache(uint64_t cacheKey, const ShaderCacheEntry& entry)
+    {
+        return WriteFileAtomically(GetShaderCacheFilePath(cacheKey), SerializeShaderCacheEntry(cacheKey, entry));
+    }
+
+    std::filesystem::path GetShaderCacheFilePath(uint64_t cacheKey)
+    {
+        char cacheFileName[32];
+        std::snprintf(cacheFileName, sizeof(cacheFileName), "%016llx.shader", static_cast<unsigned long long>(cacheKey));
+        return GetExecutablePath() / "ShaderCache" / cacheFileName;
+    }
+
+    std::vector<uint8_t> SerializeShaderCacheEntry(uint64_t cacheKey, const ShaderCacheEntry& entry)
+    {
+        Internal::ShaderCacheHeader header;
+        header.m_dependencyCount = static_cast<uint32_t>(entry.m_dependencies.size());
+        header.m_bytecodeSize = static_cast<uint32_t>(entry.m_bytecode.size());
+        header.m_cacheKey = cacheKey;
+
+        std::vector<uint8_t> data;
+        Internal::WriteValue(data, header);
+
+        for (const auto& dependency : entry.m_dependencies)
+        {
+            Internal::WriteValue(data, dependency.m_contentHash);
+            Internal::WriteString(data, dependency.m_fileName);
+        }
+
+        const ShaderResourceLayout& layout = entry.m_shaderResourceLayout;
+        Internal::WriteResources(data, layout.m_constantBuffers);
+        Internal::WriteResources(data, layout.m_shaderResourceViews);
+        Internal::WriteResources(data, layout.m_shaderRWResourceViews);
+        Internal::WriteResources(data, layout.m_samplers);
+        Internal::WriteValue(data, layout.m_constantBuffersSlotCount);
+        Internal::WriteValue(data, layout.m_shaderResourceViewsSlotCount);
+        Internal::WriteValue(data, layout.m_shaderRWResourceViewsSlotCount);
+        Internal::WriteValue(data, layout.m_samplersSlotCount);
+
+        Internal::WriteValue(data, entry.m_statistics);
+
+        data.insert(data.end(), entry.m_bytecode.begin(), entry.m_bytecode.end());
+
+        return data;
+    }
+
+    std::optional<ShaderCacheEntry> DeserializeShaderCacheEntry(uint64_t cacheKey, std::span<const uint8_t> data)
+    {
+        Internal::ShaderCacheHeader header;
+        if (!Internal::ReadValue(data, header) ||
+            header.m_magic != Internal::ShaderCacheHeader::Magic ||
+            header.m_version != ShaderCacheVersion ||
+            header.m_cacheKey != cacheKey ||
+            header.m_dependencyCount > data.size())
+        {
+            return std::nullopt;
+        }
+
+        ShaderCacheEntry entry;
+
+        entry.m_dependencies.resize(header.m_dependencyCount);
+        for (auto& dependency : entry.m_dependencies)
+        {
+            if (!Internal::ReadValue(data, dependency.m_contentHash) ||
+                !Internal::ReadString(data, dependency.m_fileName))
+            {
+                return std::nullopt;
+            }
+        }
+
+        ShaderResourceLayout& layout = entry.m_shaderResourceLayout;
+        if (!Internal::ReadResources(data, layout.m_constantBuffers) ||
+            !Internal::ReadResources(data, layout.m_shaderResourceViews) ||
+            !Internal::ReadResources(data, layout.m_shaderRWResourceViews) ||
+            !Internal::ReadResources(data, layout.m_samplers) ||
+            !Internal::ReadValue(data, layout.m_constantBuffersSlotCount) ||
+            !Internal::ReadValue(data, layout.m_shaderResourceViewsSlotCount) ||
+            !Internal::ReadValue(data, layout.m_shaderRWResourceViewsSlotCount) ||
+            !Internal::ReadValue(data, layout.m_samplersSlotCount))
+        {
+            return std::nullopt;
+        }
+
+        if (!Internal::ReadValue(data, entry.m_statistics))
+        {
+            return std::nullopt;
+        }
+
+        if (data.size() != header.m_bytecodeSize || data.empty())
+        {
+            return std::nullopt;
+        }
+        entry.m_bytecode.assign(data.begin(), data.end());
+
+        return entry;
+    }
+} // namespace DX
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <RHI/Shader/ShaderResourceLayout.h>
+#include <RHI/Shader/ShaderCompiler/ShaderStatistics.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace DX
+{
+    // Version of the shader cache format. Increase it when the format
+    // or the way shaders are compiled changes, to discard old entries.
+    constexpr uint32_t ShaderCacheVersion = 2;
+
+    // File read by the compiler when compiling a shader, like included files,
+    // with the hash of its content at the time.
+    struct ShaderDependency
+    {
+        std::string m_fileName; // Relative to the assets folder
+        uint64_t m_contentHash = 0;
+    };
+
+    // Compiled shader as stored in the shader cache.
+    struct ShaderCacheEntry
+    {
+        std::vector<uint8_t> m_bytecode;
+        ShaderResourceLayout m_shaderResourceLayout;
+        ShaderStatistics m_statistics;
+        std::vector<ShaderDependency> m_dependencies;
+    };
+
+    // The shader cache keeps compiled shaders on disk (ShaderCache/<key>.shader next
+    // to the executable), so following launches load them with a single file read instead
+    // of compiling and reflecting them again.
+    //
+    // The key hashes the shader source and all the options that change the compiler's
+    // output. Included files are not part of the key, they are stored in the entry with
+    // the hash of their content, and the entry is discarded when any of them has changed.
+    std::optional<ShaderCacheEntry> LoadShaderFromCache(uint64_t cacheKey);
+    bool SaveShaderToCache(uint64_t cacheKey, const ShaderCacheEntry& entry);
+
+    std::filesystem::path GetShaderCacheFilePath(uint64_t cacheKey);
+
+    std::vector<uint8_t> SerializeShaderCacheEntry(uint64_t cacheKey, const ShaderCacheEntry& entry);
+
+    // Returns nullopt if the data is not a valid entry for the key.
+    // It doesn't check the dependencies, LoadShaderFromCache does.
+    std::optional<ShaderCacheEntry> DeserializeShaderCacheEntry(uint64_t cacheKey, std::span<const uint8_t> data);
+} // namespace DX
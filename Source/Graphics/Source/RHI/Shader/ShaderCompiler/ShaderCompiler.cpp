@@ -1,258 +1,69 @@
 #include <RHI/Shader/ShaderCompiler/ShaderCompiler.h>
+#include <RHI/Shader/ShaderCompiler/ShaderCache.h>
+#include <RHI/Shader/ShaderCompiler/ShaderCompilerBackend.h>
+#include <RHI/Shader/ShaderCompiler/ShaderFileCache.h>
+#include <RHI/Shader/ShaderCompiler/ShaderReport.h>
 
-#include <File/FileUtils.h>
+#include <Hash/Hash.h>
 #include <Log/Log.h>
 #include <Debug/Debug.h>
 
-#include <numeric>
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <optional>
 #include <format>
-
-#include <RHI/DirectX/ComPtr.h>
-#include <RHI/DirectX/DX11ShaderBytecode.h>
-#include <d3dcompiler.h>
-#include <d3d11.h>
+#include <unordered_map>
+#include <algorithm>
 
 namespace DX
 {
-    static const char* ToDX11CompilerTarget(ShaderType m_shaderType)
-    {
-        switch (m_shaderType)
-        {
-        case ShaderType_Vertex: return "vs_5_0";
-        case ShaderType_Hull: return "hs_5_0";
-        case ShaderType_Domain: return "ds_5_0";
-        case ShaderType_Geometry: return "gs_5_0";
-        case ShaderType_Compute: return "cs_5_0";
-        case ShaderType_Pixel: return "ps_5_0";
-
-        default:
-            DX_ASSERT(false, "ShaderCompiler", "Unsupported shader type %d.", m_shaderType);
-            return nullptr;
-        }
-    }
-
-    static void AddResourceBindingToLayout(
-        const D3D11_SHADER_INPUT_BIND_DESC& dx11ResourceDesc,
-        ShaderResourceLayout& shaderResourceLayout)
+    // Shader compiled or loaded from the shader cache in this run, with the files it was compiled from.
+    struct CompiledShader
     {
-        DX_ASSERT(!std::string(dx11ResourceDesc.Name).empty(), "ShaderCompiler", "Invalid resource name.");
+        std::shared_ptr<ShaderBytecode> m_shaderBytecode;
+        ShaderInfo m_shaderInfo;
+        std::vector<std::string> m_fileNames; // Shader file and all the files it includes
+    };
 
-        switch (dx11ResourceDesc.Type)
-        {
-        // Constant Buffer
-        case D3D_SIT_CBUFFER:
-        case D3D_SIT_TBUFFER:
-            shaderResourceLayout.m_constantBuffers.emplace_back(
-                dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount);
-            break;
-
-        // Shader Resource View
-        case D3D_SIT_TEXTURE:
-            switch (dx11ResourceDesc.Dimension)
-            {
-            case D3D11_SRV_DIMENSION_TEXTURE1D:
-                shaderResourceLayout.m_shaderResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount,
-                    TextureType::Texture1D);
-                break;
-            case D3D11_SRV_DIMENSION_TEXTURE1DARRAY:
-                shaderResourceLayout.m_shaderResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount,
-                    TextureType::Texture1D, TextureSubType_Array);
-                break;
-            case D3D11_SRV_DIMENSION_TEXTURE2D:
-                shaderResourceLayout.m_shaderResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount,
-                    TextureType::Texture2D);
-                break;
-            case D3D11_SRV_DIMENSION_TEXTURE2DARRAY:
-                shaderResourceLayout.m_shaderResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount,
-                    TextureType::Texture2D, TextureSubType_Array);
-                break;
-            case D3D11_SRV_DIMENSION_TEXTURE2DMS:
-                shaderResourceLayout.m_shaderResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount,
-                    TextureType::Texture2D, TextureSubType_Multisample);
-                break;
-            case D3D11_SRV_DIMENSION_TEXTURE2DMSARRAY:
-                shaderResourceLayout.m_shaderResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount,
-                    TextureType::Texture2D, TextureSubType_Array | TextureSubType_Multisample);
-                break;
-            case D3D11_SRV_DIMENSION_TEXTURE3D:
-                shaderResourceLayout.m_shaderResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount,
-                    TextureType::Texture3D);
-                break;
-            case D3D11_SRV_DIMENSION_TEXTURECUBE:
-                shaderResourceLayout.m_shaderResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount,
-                    TextureType::TextureCube);
-                break;
-            case D3D11_SRV_DIMENSION_TEXTURECUBEARRAY:
-                shaderResourceLayout.m_shaderResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount,
-                    TextureType::TextureCube, TextureSubType_Array);
-                break;
-            case D3D11_SRV_DIMENSION_BUFFER:
-                shaderResourceLayout.m_shaderResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount, BufferSubType::Typed);
-                break;
-            default:
-                DX_ASSERT(false, "ShaderCompiler", "Unexpected Shader dimension %d.", dx11ResourceDesc.Dimension);
-                break;
-            }
-            break;
+    // Compiled shaders by cache key.
+    static std::mutex CompiledShadersMutex;
+    static std::unordered_map<uint64_t, CompiledShader> CompiledShaders;
 
-        case D3D_SIT_STRUCTURED:
-            shaderResourceLayout.m_shaderResourceViews.emplace_back(
-                dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount, BufferSubType::Structured);
-            break;
+    // Shaders being compiled or loaded from the shader cache by cache key, so requests of
+    // a shader already in flight wait for it instead of compiling it again.
+    // Guarded by CompiledShadersMutex.
+    static std::unordered_map<uint64_t, std::shared_future<std::shared_ptr<ShaderBytecode>>> CompilingShaders;
 
-        case D3D_SIT_BYTEADDRESS:
-            shaderResourceLayout.m_shaderResourceViews.emplace_back(
-                dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount, BufferSubType::Raw);
-            break;
+    static std::atomic<uint32_t> ShaderCacheHits = 0;
+    static std::atomic<uint32_t> ShaderCacheMisses = 0;
 
-        // Shader RW Resource View
-        case D3D_SIT_UAV_RWTYPED:
-            switch (dx11ResourceDesc.Dimension)
-            {
-            case D3D11_SRV_DIMENSION_TEXTURE1D:
-                shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount,
-                    TextureType::Texture1D);
-                break;
-            case D3D11_SRV_DIMENSION_TEXTURE1DARRAY:
-                shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount,
-                    TextureType::Texture1D, TextureSubType_Array);
-                break;
-            case D3D11_SRV_DIMENSION_TEXTURE2D:
-                shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount,
-                    TextureType::Texture2D);
-                break;
-            case D3D11_SRV_DIMENSION_TEXTURE2DARRAY:
-                shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount,
-                    TextureType::Texture2D, TextureSubType_Array);
-                break;
-            case D3D11_SRV_DIMENSION_TEXTURE3D:
-                shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount,
-                    TextureType::Texture3D);
-                break;
-            case D3D11_SRV_DIMENSION_BUFFER:
-                shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
-                    dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount, BufferSubType::Typed);
-                break;
-            default:
-                DX_ASSERT(false, "ShaderCompiler", "Unexpected Shader dimension %d.", dx11ResourceDesc.Dimension);
-                break;
-            }
-            break;
-
-        case D3D_SIT_UAV_RWSTRUCTURED:
-            shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
-                dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount, BufferSubType::Structured);
-            break;
-
-        case D3D_SIT_UAV_RWBYTEADDRESS:
-            shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
-                dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount, BufferSubType::Raw);
-            break;
-
-        // Sampler
-        case D3D_SIT_SAMPLER:
-            shaderResourceLayout.m_samplers.emplace_back(
-                dx11ResourceDesc.Name, dx11ResourceDesc.BindPoint, dx11ResourceDesc.BindCount);
-            break;
-
-        default:
-            DX_ASSERT(false, "ShaderCompiler", "Unsupported shader input type %d.", dx11ResourceDesc.Type);
-            break;
-        }
-    }
+    // Folder where the reports of the shaders are written, reports are disabled when empty.
+    static std::mutex ReportFolderMutex;
+    static std::filesystem::path ReportFolder;
 
-    static uint32_t SlotCount(const std::vector<ShaderResourceInfo>& resources)
+    // Hash of the shader code and all the options that change the compiled bytecode.
+    // The shader name is included because includes are relative to its folder.
+    static uint64_t CalculateShaderCacheKey(const ShaderInfo& shaderInfo, std::string_view shaderCode)
     {
-        return std::reduce(resources.begin(), resources.end(), 0u,
-            [](uint32_t slotCount, const auto& resource)
-            {
-                return std::max<uint32_t>(slotCount, resource.m_startSlot + resource.m_slotCount);
-            });
-    }
+        std::string compileOptions = std::format("{}|{}|{}|{}",
+            ShaderCacheVersion,
+            shaderInfo.m_name,
+            shaderInfo.m_entryPoint,
+            ShaderCompilerBackend::GetCompileOptions(shaderInfo));
 
-    std::shared_ptr<ShaderBytecode> ShaderCompiler::Compile(const ShaderInfo& shaderInfo)
-    {
-        const auto shaderCode = ReadAssetTextFile(shaderInfo.m_name);
-        if (!shaderCode.has_value())
+        for (const auto& define : GetShaderDefines(shaderInfo))
         {
-            return nullptr;
+            compileOptions += std::format("|{}={}", define.m_name, define.m_value);
         }
 
-        ComPtr<ID3DBlob> shaderBlob;
-        ComPtr<ID3DBlob> errorBlob;
-
-        auto result = D3DCompile(
-            shaderCode->c_str(),
-            shaderCode->length(),
-            nullptr, // Source name
-            nullptr, // Macros for shader
-            nullptr, // Includes for shader
-            shaderInfo.m_entryPoint.c_str(),
-            ToDX11CompilerTarget(shaderInfo.m_shaderType),
-            D3DCOMPILE_ENABLE_STRICTNESS, // Flags from D3D compile constants
-            0, // Flags from D3D compile effect constants
-            shaderBlob.GetAddressOf(),
-            errorBlob.GetAddressOf());
-
-        if (FAILED(result))
-        {
-            DX_LOG(Error, "ShaderCompiler", "Failed to compile shader %s.", shaderInfo.m_name.c_str());
-            if (errorBlob && errorBlob->GetBufferPointer())
-            {
-                DX_LOG(Error, "ShaderCompiler", "Message from shader compiler:\n%s\n", static_cast<char*>(errorBlob->GetBufferPointer()));
-            }
-            return nullptr;
-        }
-
-        DX_LOG(Verbose, "ShaderCompiler", "Shader '%s' (entry point: '%s') compiled successfully.",
-            shaderInfo.m_name.c_str(), shaderInfo.m_entryPoint.c_str());
-
-        // Shader resource layout obtained from shader reflection data
-        ShaderResourceLayout shaderResourceLayout;
-        {
-            ComPtr<ID3D11ShaderReflection> dx11ShaderReflection;
-            result = D3DReflect(
-                shaderBlob->GetBufferPointer(),
-                shaderBlob->GetBufferSize(),
-                IID_PPV_ARGS(dx11ShaderReflection.GetAddressOf()));
-            if (FAILED(result)) {
-                DX_LOG(Error, "ShaderCompiler", "Failed to create shader reflection.");
-                return nullptr;
-            }
-
-            D3D11_SHADER_DESC dx11ShaderDesc;
-            dx11ShaderReflection->GetDesc(&dx11ShaderDesc);
-
-            for (uint32_t i = 0; i < dx11ShaderDesc.BoundResources; ++i)
-            {
-                D3D11_SHADER_INPUT_BIND_DESC dx11ResourceDesc;
-                dx11ShaderReflection->GetResourceBindingDesc(i, &dx11ResourceDesc);
-
-                AddResourceBindingToLayout(dx11ResourceDesc, shaderResourceLayout);
-            }
-
-            shaderResourceLayout.m_constantBuffersSlotCount = SlotCount(shaderResourceLayout.m_constantBuffers);
-            shaderResourceLayout.m_shaderResourceViewsSlotCount = SlotCount(shaderResourceLayout.m_shaderResourceViews);
-            shaderResourceLayout.m_shaderRWResourceViewsSlotCount = SlotCount(shaderResourceLayout.m_shaderRWResourceViews);
-            shaderResourceLayout.m_samplersSlotCount = SlotCount(shaderResourceLayout.m_samplers);
-        }
+        return Hash64(shaderCode, Hash64(compileOptions));
+    }
 
 #ifndef NDEBUG
+    static void LogShaderResourceLayout(const ShaderInfo& shaderInfo, const ShaderResourceLayout& shaderResourceLayout)
+    {
         // Print shader resource layout
         auto hlslViewTypeStr = [](const ShaderResourceInfo& resourceInfo, bool isRW) -> std::string
             {
@@ -268,8 +79,9 @@ namespace DX
                                 return "Structured";
                             case BufferSubType::Raw:
                                 return "ByteAddress";
+                            default:
+                                return "Unknown";
                             }
-                            return "Unknown";
                         };
 
                     return std::format("{}{}Buffer",
@@ -313,8 +125,195 @@ namespace DX
                 resourceInfo.m_name.c_str(), resourceInfo.m_startSlot, resourceInfo.m_slotCount);
         }
         DX_LOG(Verbose, "ShaderCompiler", "---------------------");
+    }
 #endif
 
-        return std::make_shared<DX11ShaderBytecode>(std::move(shaderBlob), std::move(shaderResourceLayout));
+    // Loads the shader from the shader cache or compiles it when it's not there.
+    static std::optional<CompiledShader> LoadOrCompileShader(const ShaderInfo& shaderInfo, std::string_view shaderCode, uint64_t cacheKey)
+    {
+        std::optional<ShaderCacheEntry> shaderCacheEntry = LoadShaderFromCache(cacheKey);
+        if (shaderCacheEntry.has_value())
+        {
+            [[maybe_unused]] const uint32_t hits = ++ShaderCacheHits;
+            DX_LOG(Info, "ShaderCompiler", "Shader cache hit for %s variant 0x%x (%u hits, %u misses).", shaderInfo.m_name.c_str(), shaderInfo.m_permutationKey, hits, ShaderCacheMisses.load());
+        }
+        else
+        {
+            [[maybe_unused]] const uint32_t misses = ++ShaderCacheMisses;
+            DX_LOG(Info, "ShaderCompiler", "Shader cache miss for %s variant 0x%x (%u hits, %u misses).", shaderInfo.m_name.c_str(), shaderInfo.m_permutationKey, ShaderCacheHits.load(), misses);
+
+            shaderCacheEntry = ShaderCompilerBackend::CompileShader(shaderInfo, shaderCode);
+            if (!shaderCacheEntry.has_value())
+            {
+                return std::nullopt;
+            }
+
+            DX_LOG(Verbose, "ShaderCompiler", "Shader '%s' (entry point: '%s', variant: 0x%x, format: %s) compiled successfully.",
+                shaderInfo.m_name.c_str(), shaderInfo.m_entryPoint.c_str(), shaderInfo.m_permutationKey, ShaderBytecodeFormatStr(shaderInfo.m_bytecodeFormat));
+#ifndef NDEBUG
+            LogShaderResourceLayout(shaderInfo, shaderCacheEntry->m_shaderResourceLayout);
+#endif
+
+            SaveShaderToCache(cacheKey, *shaderCacheEntry);
+        }
+
+        [[maybe_unused]] const ShaderStatistics& statistics = shaderCacheEntry->m_statistics;
+        DX_LOG(Verbose, "ShaderCompiler", "Shader %s variant 0x%x: %u instructions (%u ALU, %u texture, %u flow control), %u temp registers, %u interpolators.",
+            shaderInfo.m_name.c_str(), shaderInfo.m_permutationKey, statistics.m_instructionCount, statistics.m_aluInstructionCount,
+            statistics.m_textureInstructionCount, statistics.m_flowControlInstructionCount, statistics.m_tempRegisterCount, statistics.m_interpolatorCount);
+
+        if (const std::filesystem::path reportFolder = ShaderCompiler::GetReportFolder();
+            !reportFolder.empty())
+        {
+            SaveShaderReport(reportFolder, CreateShaderReport(shaderInfo, static_cast<uint32_t>(shaderCacheEntry->m_bytecode.size()), shaderCacheEntry->m_statistics));
+        }
+
+        CompiledShader compiledShader;
+        compiledShader.m_shaderInfo = shaderInfo;
+        compiledShader.m_fileNames.push_back(shaderInfo.m_name);
+        for (const auto& dependency : shaderCacheEntry->m_dependencies)
+        {
+            compiledShader.m_fileNames.push_back(dependency.m_fileName);
+        }
+
+        compiledShader.m_shaderBytecode = ShaderCompilerBackend::CreateShaderBytecode(std::move(*shaderCacheEntry));
+        if (!compiledShader.m_shaderBytecode)
+        {
+            return std::nullopt;
+        }
+
+        return compiledShader;
+    }
+
+    std::shared_ptr<ShaderBytecode> ShaderCompiler::Compile(const ShaderInfo& shaderInfo)
+    {
+        const auto shaderFile = ShaderFileCache::Load(shaderInfo.m_name);
+        if (!shaderFile)
+        {
+            DX_LOG(Error, "ShaderCompiler", "Failed to open shader file %s.", shaderInfo.m_name.c_str());
+            return nullptr;
+        }
+        const std::string_view shaderCode = shaderFile->m_code;
+
+        const uint64_t cacheKey = CalculateShaderCacheKey(shaderInfo, shaderCode);
+
+        // When another thread is compiling the same shader, wait for it.
+        std::promise<std::shared_ptr<ShaderBytecode>> promise;
+        std::shared_future<std::shared_ptr<ShaderBytecode>> compilingFuture;
+        {
+            std::lock_guard lock(CompiledShadersMutex);
+            if (auto it = CompiledShaders.find(cacheKey);
+                it != CompiledShaders.end())
+            {
+                return it->second.m_shaderBytecode;
+            }
+
+            if (auto it = CompilingShaders.find(cacheKey);
+                it != CompilingShaders.end())
+            {
+                compilingFuture = it->second;
+            }
+            else
+            {
+                CompilingShaders.emplace(cacheKey, promise.get_future().share());
+            }
+        }
+
+        if (compilingFuture.valid())
+        {
+            return compilingFuture.get();
+        }
+
+        std::optional<CompiledShader> compiledShader = LoadOrCompileShader(shaderInfo, shaderCode, cacheKey);
+
+        // Failed shaders are not kept, next requests try to compile them again.
+        std::shared_ptr<ShaderBytecode> shaderBytecode;
+        {
+            std::lock_guard lock(CompiledShadersMutex);
+            if (compiledShader.has_value())
+            {
+                shaderBytecode = CompiledShaders.try_emplace(cacheKey, std::move(*compiledShader)).first->second.m_shaderBytecode;
+            }
+            CompilingShaders.erase(cacheKey);
+        }
+
+        promise.set_value(shaderBytecode);
+        return shaderBytecode;
+    }
+
+    void ShaderCompiler::ReleaseCompiledShaders()
+    {
+        std::lock_guard lock(CompiledShadersMutex);
+        CompiledShaders.clear();
+    }
+
+    std::vector<ShaderInfo> ShaderCompiler::InvalidateFiles(std::span<const std::string> fileNames)
+    {
+        for (const auto& fileName : fileNames)
+        {
+            ShaderFileCache::Invalidate(fileName);
+        }
+
+        std::vector<ShaderInfo> invalidatedShaders;
+
+        std::lock_guard lock(CompiledShadersMutex);
+        std::erase_if(CompiledShaders, [&](const auto& compiledShaderPair)
+            {
+                const CompiledShader& compiledShader = compiledShaderPair.second;
+                const bool dependsOnFiles = std::ranges::any_of(compiledShader.m_fileNames, [&](const std::string& compiledFileName)
+                    {
+                        return std::ranges::find(fileNames, compiledFileName) != fileNames.end();
+                    });
+                if (dependsOnFiles)
+                {
+                    invalidatedShaders.push_back(compiledShader.m_shaderInfo);
+                }
+                return dependsOnFiles;
+            });
+
+        DX_LOG(Info, "ShaderCompiler", "%zu files changed, %zu shader variants to compile again.", fileNames.size(), invalidatedShaders.size());
+        return invalidatedShaders;
+    }
+
+    void ShaderCompiler::SetReportFolder(const std::filesystem::path& reportFolder)
+    {
+        std::lock_guard lock(ReportFolderMutex);
+        ReportFolder = reportFolder;
+    }
+
+    std::filesystem::path ShaderCompiler::GetReportFolder()
+    {
+        std::lock_guard lock(ReportFolderMutex);
+        return ReportFolder;
+    }
+
+    std::optional<ShaderReflection> ShaderCompiler::Reflect(const ShaderInfo& shaderInfo)
+    {
+        // SPIR-V has no reflection data, it has the same layouts as DXIL.
+        ShaderInfo reflectedShaderInfo = shaderInfo;
+        if (reflectedShaderInfo.m_bytecodeFormat == ShaderBytecodeFormat::SPIRV)
+        {
+            reflectedShaderInfo.m_bytecodeFormat = ShaderBytecodeFormat::DXIL;
+        }
+
+        auto shaderBytecode = Compile(reflectedShaderInfo);
+        if (!shaderBytecode)
+        {
+            return std::nullopt;
+        }
+
+        auto constantBufferLayouts = ShaderCompilerBackend::ReflectConstantBufferLayouts(*shaderBytecode);
+        if (!constantBufferLayouts.has_value())
+        {
+            DX_LOG(Error, "ShaderCompiler", "Failed to create shader reflection of %s.", shaderInfo.m_name.c_str());
+            return std::nullopt;
+        }
+
+        ShaderReflection shaderReflection;
+        shaderReflection.m_shaderType = shaderInfo.m_shaderType;
+        shaderReflection.m_name = shaderInfo.m_name;
+        shaderReflection.m_shaderResourceLayout = shaderBytecode->GetShaderResourceLayout();
+        shaderReflection.m_constantBufferLayouts = std::move(*constantBufferLayouts);
+        return shaderReflection;
     }
 } // namespace DX
@@ -2,15 +2,57 @@
 
 #include <RHI/Shader/ShaderEnums.h>
 #include <RHI/Shader/ShaderBytecode.h>
+#include <RHI/Shader/ShaderReflection.h>
 
+#include <filesystem>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
 
 namespace DX
 {
+    // Compiles HLSL shaders and reflects their resource layout.
+    //
+    // Compiled shaders are kept in the shader cache on disk and in memory, so
+    // the same shader is only compiled the first time, and loaded from the cache
+    // in later launches, unless its code, included files or defines change.
+    //
+    // Shader files and the files they include are read once and kept in memory
+    // (see ShaderFileCache.h). Each compiled variant records all the files it
+    // was compiled from, so when files change only the variants that read
+    // them are compiled again (see InvalidateFiles).
+    //
+    // Shaders are compiled with FXC to DXBC on Windows, and with DXC to DXIL or SPIR-V
+    // on other platforms (see ShaderCompilerBackend.h), with the same resource layouts.
     class ShaderCompiler
     {
     public:
         // The shader name inside ShaderInfo is the filename relative to Assets folder.
+        // It's thread safe, requests of the same shader return the same bytecode, and
+        // requests of a shader being compiled by another thread wait for it.
+        // Only the variant of the permutation key in ShaderInfo is compiled, each
+        // variant is compiled and cached separately the first time it's requested.
         static std::shared_ptr<ShaderBytecode> Compile(const ShaderInfo& shaderInfo);
+
+        // Releases the shaders kept in memory. The shader cache on disk is kept.
+        static void ReleaseCompiledShaders();
+
+        // To call when shader files have changed, filenames relative to the assets folder.
+        // The files are read again, and the variants compiled from any of them, the shader
+        // file or a file included directly or indirectly, are released from memory.
+        // Returns the variants released, which are compiled again when requested.
+        // Variants that didn't read the files keep their bytecode.
+        static std::vector<ShaderInfo> InvalidateFiles(std::span<const std::string> fileNames);
+
+        // When set, each shader variant compiled or loaded from the shader cache
+        // writes its cost report to the folder (see ShaderReport.h). Empty disables them.
+        static void SetReportFolder(const std::filesystem::path& reportFolder);
+        static std::filesystem::path GetReportFolder();
+
+        // Compiles the shader and returns its reflection data, including the layout
+        // of its constant buffers. Used by tools, like ShaderBindingsGenerator.
+        static std::optional<ShaderReflection> Reflect(const ShaderInfo& shaderInfo);
     };
 } // namespace DX
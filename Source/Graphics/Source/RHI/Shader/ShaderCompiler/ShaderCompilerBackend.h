@@ -0,0 +1,35 @@
+#pragma once
+
+#include <RHI/Shader/ShaderEnums.h>
+#include <RHI/Shader/ShaderBytecode.h>
+#include <RHI/Shader/ShaderReflection.h>
+#include <RHI/Shader/ShaderCompiler/ShaderCache.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Compiler used by ShaderCompiler, selected when building the Graphics library:
+// - FXC (d3dcompiler) on Windows, compiles DXBC for D3D11. See ShaderCompilerFXC.cpp.
+// - DXC when DX_SHADER_COMPILER_DXC is defined, compiles DXIL and SPIR-V and builds
+//   on Linux, to compile and validate shaders in tools. See ShaderCompilerDXC.cpp.
+//
+// ShaderCompiler does the caching, the backends only compile and reflect.
+namespace DX::ShaderCompilerBackend
+{
+    // Name of the compiler and the options that change its output for the shader,
+    // like the target and the flags. It's part of the key of the shader cache.
+    std::string GetCompileOptions(const ShaderInfo& shaderInfo);
+
+    // Compiles the shader and reflects its resource layout. The included files
+    // are stored in the entry as dependencies of the shader.
+    std::optional<ShaderCacheEntry> CompileShader(const ShaderInfo& shaderInfo, std::string_view shaderCode);
+
+    std::shared_ptr<ShaderBytecode> CreateShaderBytecode(ShaderCacheEntry&& shaderCacheEntry);
+
+    // Layouts of the constant buffers of a compiled shader.
+    // SPIR-V has no reflection, ShaderCompiler reflects its DXIL instead.
+    std::optional<std::vector<ShaderConstantBufferLayout>> ReflectConstantBufferLayouts(const ShaderBytecode& shaderBytecode);
+} // namespace DX::ShaderCompilerBackend
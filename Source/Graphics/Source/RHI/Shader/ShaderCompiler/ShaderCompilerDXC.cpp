@@ -0,0 +1,341 @@
+#if defined(DX_SHADER_COMPILER_DXC)
+
+#include <RHI/Shader/ShaderCompiler/ShaderCompilerBackend.h>
+#include <RHI/Shader/ShaderCompiler/ShaderIncludeLoader.h>
+#include <RHI/Shader/BinaryShaderBytecode.h>
+
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <filesystem>
+#include <format>
+#include <string>
+#include <vector>
+
+#include <dxc/dxcapi.h>
+#include <d3d12shader.h>
+
+#include <RHI/Shader/ShaderCompiler/ShaderReflectionUtils.h>
+
+namespace DX::ShaderCompilerBackend
+{
+    // HLSL version of FXC, newer versions change the semantics of some operators.
+    static const wchar_t* HLSLVersion = L"2018";
+
+    // SPIR-V has a single binding space per descriptor set, so registers of
+    // different types (b0, t0, s0, u0) are shifted to bindings that don't overlap.
+    // Bindings in SPIR-V are the slot of the ShaderResourceLayout plus these shifts.
+    static const wchar_t* SpirvConstantBufferShift = L"0";
+    static const wchar_t* SpirvSamplerShift = L"16";
+    static const wchar_t* SpirvShaderRWResourceViewShift = L"32";
+    static const wchar_t* SpirvShaderResourceViewShift = L"128";
+
+    static const wchar_t* ToDXCCompilerTarget(ShaderType m_shaderType)
+    {
+        switch (m_shaderType)
+        {
+        case ShaderType_Vertex: return L"vs_6_0";
+        case ShaderType_Hull: return L"hs_6_0";
+        case ShaderType_Domain: return L"ds_6_0";
+        case ShaderType_Geometry: return L"gs_6_0";
+        case ShaderType_Compute: return L"cs_6_0";
+        case ShaderType_Pixel: return L"ps_6_0";
+
+        default:
+            DX_ASSERT(false, "ShaderCompiler", "Unsupported shader type %d.", m_shaderType);
+            return nullptr;
+        }
+    }
+
+    // Shader names and defines are ASCII.
+    static std::wstring ToWideString(std::string_view str)
+    {
+        return std::wstring(str.begin(), str.end());
+    }
+
+    // DXC objects are not thread safe, each thread compiling shaders creates its own.
+    struct DXCInstances
+    {
+        CComPtr<IDxcUtils> m_utils;
+        CComPtr<IDxcCompiler3> m_compiler;
+    };
+
+    static DXCInstances* GetDXCInstances()
+    {
+        thread_local DXCInstances instances = []()
+            {
+                DXCInstances newInstances;
+                if (FAILED(DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&newInstances.m_utils))) ||
+                    FAILED(DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&newInstances.m_compiler))))
+                {
+                    DX_LOG(Error, "ShaderCompiler", "Failed to create DXC instances.");
+                    return DXCInstances{};
+                }
+                return newInstances;
+            }();
+
+        return (instances.m_utils && instances.m_compiler) ? &instances : nullptr;
+    }
+
+    // Loads the files included by a shader.
+    // DXC resolves the paths: local includes (#include "File.hlsl") are relative to the folder
+    // of the file that includes them, system includes (#include <File.hlsl>) to the include
+    // folder, which is the assets folder. It tries the next folder when a file doesn't exist.
+    class ShaderIncludeHandler : public IDxcIncludeHandler
+    {
+    public:
+        ShaderIncludeHandler(IDxcUtils* utils, ShaderIncludeLoader& includeLoader)
+            : m_utils(utils)
+            , m_includeLoader(includeLoader)
+        {
+        }
+
+        HRESULT STDMETHODCALLTYPE LoadSource(LPCWSTR includeFileName, IDxcBlob** includeSource) override
+        {
+            const std::string fileName = ShaderIncludeLoader::GetIncludeFileName({}, includeFileName);
+
+            auto fileData = m_includeLoader.Load(fileName);
+            if (!fileData.has_value())
+            {
+                return E_FAIL;
+            }
+
+            // The blob points to the file loaded, which is kept open until the compilation ends.
+            CComPtr<IDxcBlobEncoding> blob;
+            if (FAILED(m_utils->CreateBlobFromPinned(fileData->data(), static_cast<UINT32>(fileData->size()), DXC_CP_UTF8, &blob)))
+            {
+                return E_FAIL;
+            }
+            *includeSource = blob.Detach();
+            return S_OK;
+        }
+
+        // The handler lives in the stack during the compilation, it's not reference counted.
+        HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) override
+        {
+            if (IsEqualIID(riid, __uuidof(IDxcIncludeHandler)) || IsEqualIID(riid, __uuidof(IUnknown)))
+            {
+                *object = static_cast<IDxcIncludeHandler*>(this);
+                return S_OK;
+            }
+            *object = nullptr;
+            return E_NOINTERFACE;
+        }
+
+        ULONG STDMETHODCALLTYPE AddRef() override { return 1; }
+        ULONG STDMETHODCALLTYPE Release() override { return 1; }
+
+    private:
+        IDxcUtils* m_utils;
+        ShaderIncludeLoader& m_includeLoader;
+    };
+
+    // Arguments of the compilation of the shader to DXIL or SPIR-V, as in the command line of dxc.
+    static std::vector<std::wstring> GetCompileArguments(const ShaderInfo& shaderInfo, ShaderBytecodeFormat bytecodeFormat)
+    {
+        std::vector<std::wstring> arguments = {
+            ToWideString(shaderInfo.m_name), // Source name
+            L"-E", ToWideString(shaderInfo.m_entryPoint),
+            L"-T", ToDXCCompilerTarget(shaderInfo.m_shaderType),
+            L"-HV", HLSLVersion,
+            L"-Ges", // Strict mode, like D3DCOMPILE_ENABLE_STRICTNESS in FXC
+            L"-I", L".", // System includes from the assets folder
+        };
+
+        // Feature defines select the variant of the shader.
+        for (const auto& define : GetShaderDefines(shaderInfo))
+        {
+            arguments.push_back(L"-D");
+            arguments.push_back(ToWideString(std::format("{}={}", define.m_name, define.m_value)));
+        }
+
+        if (bytecodeFormat == ShaderBytecodeFormat::SPIRV)
+        {
+            arguments.insert(arguments.end(), {
+                L"-spirv",
+                L"-fvk-use-dx-layout", // Same layout of constant buffers as in DXIL
+                L"-fvk-b-shift", SpirvConstantBufferShift, L"0",
+                L"-fvk-s-shift", SpirvSamplerShift, L"0",
+                L"-fvk-u-shift", SpirvShaderRWResourceViewShift, L"0",
+                L"-fvk-t-shift", SpirvShaderResourceViewShift, L"0",
+            });
+        }
+
+        return arguments;
+    }
+
+    static CComPtr<IDxcBlob> Compile(
+        DXCInstances& dxc,
+        const ShaderInfo& shaderInfo,
+        std::string_view shaderCode,
+        ShaderBytecodeFormat bytecodeFormat,
+        ShaderIncludeLoader& includeLoader)
+    {
+        const std::vector<std::wstring> arguments = GetCompileArguments(shaderInfo, bytecodeFormat);
+
+        std::vector<LPCWSTR> argumentPointers;
+        argumentPointers.reserve(arguments.size());
+        for (const auto& argument : arguments)
+        {
+            argumentPointers.push_back(argument.c_str());
+        }
+
+        const DxcBuffer sourceBuffer = { shaderCode.data(), shaderCode.size(), DXC_CP_UTF8 };
+
+        ShaderIncludeHandler includeHandler(dxc.m_utils, includeLoader);
+
+        CComPtr<IDxcResult> compileResult;
+        HRESULT result = dxc.m_compiler->Compile(
+            &sourceBuffer,
+            argumentPointers.data(),
+            static_cast<UINT32>(argumentPointers.size()),
+            &includeHandler,
+            IID_PPV_ARGS(&compileResult));
+        if (SUCCEEDED(result))
+        {
+            compileResult->GetStatus(&result);
+        }
+
+        if (FAILED(result))
+        {
+            DX_LOG(Error, "ShaderCompiler", "Failed to compile shader %s to %s.", shaderInfo.m_name.c_str(), ShaderBytecodeFormatStr(bytecodeFormat));
+            CComPtr<IDxcBlobUtf8> errorBlob;
+            if (compileResult &&
+                SUCCEEDED(compileResult->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&errorBlob), nullptr)) &&
+                errorBlob && errorBlob->GetStringLength() > 0)
+            {
+                DX_LOG(Error, "ShaderCompiler", "Message from shader compiler:\n%s\n", errorBlob->GetStringPointer());
+            }
+            return nullptr;
+        }
+
+        CComPtr<IDxcBlob> shaderBlob;
+        if (FAILED(compileResult->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&shaderBlob), nullptr)) || !shaderBlob)
+        {
+            DX_LOG(Error, "ShaderCompiler", "Failed to get the bytecode of shader %s.", shaderInfo.m_name.c_str());
+            return nullptr;
+        }
+        return shaderBlob;
+    }
+
+    static CComPtr<ID3D12ShaderReflection> CreateShaderReflection(DXCInstances& dxc, const void* data, size_t size)
+    {
+        const DxcBuffer reflectionBuffer = { data, size, DXC_CP_ACP };
+
+        CComPtr<ID3D12ShaderReflection> dx12ShaderReflection;
+        if (FAILED(dxc.m_utils->CreateReflection(&reflectionBuffer, IID_PPV_ARGS(&dx12ShaderReflection))))
+        {
+            DX_LOG(Error, "ShaderCompiler", "Failed to create shader reflection.");
+            return nullptr;
+        }
+        return dx12ShaderReflection;
+    }
+
+    // Version of the DXC library loaded, a new version can compile different bytecode.
+    static std::string GetDXCVersion()
+    {
+        DXCInstances* dxc = GetDXCInstances();
+        if (!dxc)
+        {
+            return "Unknown";
+        }
+
+        CComPtr<IDxcVersionInfo> versionInfo;
+        UINT32 major = 0;
+        UINT32 minor = 0;
+        if (FAILED(dxc->m_compiler->QueryInterface(IID_PPV_ARGS(&versionInfo))) ||
+            FAILED(versionInfo->GetVersion(&major, &minor)))
+        {
+            return "Unknown";
+        }
+        return std::format("{}.{}", major, minor);
+    }
+
+    std::string GetCompileOptions(const ShaderInfo& shaderInfo)
+    {
+        std::string compileOptions = std::format("DXC|{}|{}", GetDXCVersion(), ShaderBytecodeFormatStr(shaderInfo.m_bytecodeFormat));
+        for (const auto& argument : GetCompileArguments(shaderInfo, shaderInfo.m_bytecodeFormat))
+        {
+            compileOptions += '|';
+            compileOptions.append(argument.begin(), argument.end()); // Arguments are ASCII
+        }
+        return compileOptions;
+    }
+
+    std::optional<ShaderCacheEntry> CompileShader(const ShaderInfo& shaderInfo, std::string_view shaderCode)
+    {
+        if (shaderInfo.m_bytecodeFormat != ShaderBytecodeFormat::DXIL &&
+            shaderInfo.m_bytecodeFormat != ShaderBytecodeFormat::SPIRV)
+        {
+            DX_LOG(Error, "ShaderCompiler", "Failed to compile shader %s, DXC doesn't support %s bytecode.",
+                shaderInfo.m_name.c_str(), ShaderBytecodeFormatStr(shaderInfo.m_bytecodeFormat));
+            return std::nullopt;
+        }
+
+        DXCInstances* dxc = GetDXCInstances();
+        if (!dxc)
+        {
+            return std::nullopt;
+        }
+
+        ShaderIncludeLoader includeLoader;
+
+        // The resource layout and statistics are reflected from DXIL, also for SPIR-V,
+        // so both formats have the same layout and the slots of the D3D11 build.
+        CComPtr<IDxcBlob> dxilBlob = Compile(*dxc, shaderInfo, shaderCode, ShaderBytecodeFormat::DXIL, includeLoader);
+        if (!dxilBlob)
+        {
+            return std::nullopt;
+        }
+
+        CComPtr<ID3D12ShaderReflection> dx12ShaderReflection = CreateShaderReflection(*dxc, dxilBlob->GetBufferPointer(), dxilBlob->GetBufferSize());
+        if (!dx12ShaderReflection)
+        {
+            return std::nullopt;
+        }
+
+        CComPtr<IDxcBlob> shaderBlob = dxilBlob;
+        if (shaderInfo.m_bytecodeFormat == ShaderBytecodeFormat::SPIRV)
+        {
+            shaderBlob = Compile(*dxc, shaderInfo, shaderCode, ShaderBytecodeFormat::SPIRV, includeLoader);
+            if (!shaderBlob)
+            {
+                return std::nullopt;
+            }
+        }
+
+        ShaderCacheEntry shaderCacheEntry;
+        shaderCacheEntry.m_bytecode.assign(
+            static_cast<const uint8_t*>(shaderBlob->GetBufferPointer()),
+            static_cast<const uint8_t*>(shaderBlob->GetBufferPointer()) + shaderBlob->GetBufferSize());
+        shaderCacheEntry.m_shaderResourceLayout = ReflectShaderResourceLayout<D3D12_SHADER_DESC, D3D12_SHADER_INPUT_BIND_DESC>(*dx12ShaderReflection.p);
+        shaderCacheEntry.m_statistics = ReflectShaderStatistics<D3D12_SHADER_DESC, D3D12_SHADER_BUFFER_DESC, D3D12_SIGNATURE_PARAMETER_DESC>(
+            *dx12ShaderReflection.p, shaderCacheEntry.m_shaderResourceLayout);
+        shaderCacheEntry.m_dependencies = std::move(includeLoader.GetDependencies());
+        return shaderCacheEntry;
+    }
+
+    std::shared_ptr<ShaderBytecode> CreateShaderBytecode(ShaderCacheEntry&& shaderCacheEntry)
+    {
+        return std::make_shared<BinaryShaderBytecode>(std::move(shaderCacheEntry.m_bytecode), std::move(shaderCacheEntry.m_shaderResourceLayout));
+    }
+
+    std::optional<std::vector<ShaderConstantBufferLayout>> ReflectConstantBufferLayouts(const ShaderBytecode& shaderBytecode)
+    {
+        DXCInstances* dxc = GetDXCInstances();
+        if (!dxc)
+        {
+            return std::nullopt;
+        }
+
+        CComPtr<ID3D12ShaderReflection> dx12ShaderReflection = CreateShaderReflection(*dxc, shaderBytecode.GetData(), shaderBytecode.GetSize());
+        if (!dx12ShaderReflection)
+        {
+            return std::nullopt;
+        }
+
+        return ReflectShaderConstantBufferLayouts<D3D12_SHADER_DESC, D3D12_SHADER_BUFFER_DESC, D3D12_SHADER_VARIABLE_DESC>(*dx12ShaderReflection.p);
+    }
+} // namespace DX::ShaderCompilerBackend
+
+#endif // DX_SHADER_COMPILER_DXC
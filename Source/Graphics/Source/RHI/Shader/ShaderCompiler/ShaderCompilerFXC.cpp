@@ -0,0 +1,203 @@
+#if !defined(DX_SHADER_COMPILER_DXC)
+
+#include <RHI/Shader/ShaderCompiler/ShaderCompilerBackend.h>
+#include <RHI/Shader/ShaderCompiler/ShaderIncludeLoader.h>
+
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <unordered_map>
+
+#include <RHI/DirectX/ComPtr.h>
+#include <RHI/DirectX/DX11ShaderBytecode.h>
+#include <d3dcompiler.h>
+#include <d3d11.h>
+
+#include <RHI/Shader/ShaderCompiler/ShaderReflectionUtils.h>
+
+namespace DX::ShaderCompilerBackend
+{
+    // Flags from D3D compile constants
+    static const UINT CompileFlags = D3DCOMPILE_ENABLE_STRICTNESS;
+
+    static const char* ToDX11CompilerTarget(ShaderType m_shaderType)
+    {
+        switch (m_shaderType)
+        {
+        case ShaderType_Vertex: return "vs_5_0";
+        case ShaderType_Hull: return "hs_5_0";
+        case ShaderType_Domain: return "ds_5_0";
+        case ShaderType_Geometry: return "gs_5_0";
+        case ShaderType_Compute: return "cs_5_0";
+        case ShaderType_Pixel: return "ps_5_0";
+
+        default:
+            DX_ASSERT(false, "ShaderCompiler", "Unsupported shader type %d.", m_shaderType);
+            return nullptr;
+        }
+    }
+
+    // Loads the files included by a shader.
+    // Local includes (#include "File.hlsl") are relative to the folder of the file
+    // that includes them, system includes (#include <File.hlsl>) to the assets folder.
+    class ShaderIncludeHandler : public ID3DInclude
+    {
+    public:
+        explicit ShaderIncludeHandler(const std::string& shaderFileName)
+            : m_shaderFolder(std::filesystem::path(shaderFileName).parent_path())
+        {
+        }
+
+        HRESULT STDMETHODCALLTYPE Open(D3D_INCLUDE_TYPE includeType, LPCSTR includeFileName, LPCVOID parentData, LPCVOID* data, UINT* size) override
+        {
+            // The parent data is the content of the file with the #include, unknown for the shader file.
+            std::filesystem::path folder;
+            if (includeType == D3D_INCLUDE_LOCAL)
+            {
+                auto it = m_includedFileFolders.find(parentData);
+                folder = (it != m_includedFileFolders.end()) ? it->second : m_shaderFolder;
+            }
+
+            const std::string fileName = ShaderIncludeLoader::GetIncludeFileName(folder, includeFileName);
+
+            auto fileData = m_includeLoader.Load(fileName);
+            if (!fileData.has_value())
+            {
+                DX_LOG(Error, "ShaderCompiler", "Failed to open included file %s.", fileName.c_str());
+                return E_FAIL;
+            }
+
+            *data = fileData->data();
+            *size = static_cast<UINT>(fileData->size());
+
+            m_includedFileFolders[*data] = std::filesystem::path(fileName).parent_path();
+            return S_OK;
+        }
+
+        // Included files are kept open until the handler is destroyed.
+        HRESULT STDMETHODCALLTYPE Close([[maybe_unused]] LPCVOID data) override
+        {
+            return S_OK;
+        }
+
+        std::vector<ShaderDependency>& GetDependencies() { return m_includeLoader.GetDependencies(); }
+
+    private:
+        std::filesystem::path m_shaderFolder;
+        ShaderIncludeLoader m_includeLoader;
+        std::unordered_map<const void*, std::filesystem::path> m_includedFileFolders;
+    };
+
+    std::string GetCompileOptions(const ShaderInfo& shaderInfo)
+    {
+        return std::format("FXC|{}|{}|{}",
+            ShaderBytecodeFormatStr(shaderInfo.m_bytecodeFormat),
+            ToDX11CompilerTarget(shaderInfo.m_shaderType),
+            CompileFlags);
+    }
+
+    std::optional<ShaderCacheEntry> CompileShader(const ShaderInfo& shaderInfo, std::string_view shaderCode)
+    {
+        if (shaderInfo.m_bytecodeFormat != ShaderBytecodeFormat::DXBC)
+        {
+            DX_LOG(Error, "ShaderCompiler", "Failed to compile shader %s, FXC doesn't support %s bytecode.",
+                shaderInfo.m_name.c_str(), ShaderBytecodeFormatStr(shaderInfo.m_bytecodeFormat));
+            return std::nullopt;
+        }
+
+        // Feature defines select the variant of the shader.
+        const std::vector<ShaderDefine> defines = GetShaderDefines(shaderInfo);
+
+        std::vector<D3D_SHADER_MACRO> dx11ShaderMacros;
+        dx11ShaderMacros.reserve(defines.size() + 1);
+        for (const auto& define : defines)
+        {
+            dx11ShaderMacros.push_back({ define.m_name.c_str(), define.m_value.c_str() });
+        }
+        dx11ShaderMacros.push_back({ nullptr, nullptr }); // End of the list
+
+        ShaderIncludeHandler includeHandler(shaderInfo.m_name);
+
+        ComPtr<ID3DBlob> shaderBlob;
+        ComPtr<ID3DBlob> errorBlob;
+
+        auto result = D3DCompile(
+            shaderCode.data(),
+            shaderCode.size(),
+            shaderInfo.m_name.c_str(), // Source name
+            dx11ShaderMacros.data(), // Macros for shader
+            &includeHandler, // Includes for shader
+            shaderInfo.m_entryPoint.c_str(),
+            ToDX11CompilerTarget(shaderInfo.m_shaderType),
+            CompileFlags,
+            0, // Flags from D3D compile effect constants
+            shaderBlob.GetAddressOf(),
+            errorBlob.GetAddressOf());
+
+        if (FAILED(result))
+        {
+            DX_LOG(Error, "ShaderCompiler", "Failed to compile shader %s.", shaderInfo.m_name.c_str());
+            if (errorBlob && errorBlob->GetBufferPointer())
+            {
+                DX_LOG(Error, "ShaderCompiler", "Message from shader compiler:\n%s\n", static_cast<char*>(errorBlob->GetBufferPointer()));
+            }
+            return std::nullopt;
+        }
+
+        // Shader resource layout obtained from shader reflection data
+        ComPtr<ID3D11ShaderReflection> dx11ShaderReflection;
+        result = D3DReflect(
+            shaderBlob->GetBufferPointer(),
+            shaderBlob->GetBufferSize(),
+            IID_PPV_ARGS(dx11ShaderReflection.GetAddressOf()));
+        if (FAILED(result))
+        {
+            DX_LOG(Error, "ShaderCompiler", "Failed to create shader reflection.");
+            return std::nullopt;
+        }
+
+        ShaderCacheEntry shaderCacheEntry;
+        shaderCacheEntry.m_bytecode.assign(
+            static_cast<const uint8_t*>(shaderBlob->GetBufferPointer()),
+            static_cast<const uint8_t*>(shaderBlob->GetBufferPointer()) + shaderBlob->GetBufferSize());
+        shaderCacheEntry.m_shaderResourceLayout = ReflectShaderResourceLayout<D3D11_SHADER_DESC, D3D11_SHADER_INPUT_BIND_DESC>(*dx11ShaderReflection.Get());
+        shaderCacheEntry.m_statistics = ReflectShaderStatistics<D3D11_SHADER_DESC, D3D11_SHADER_BUFFER_DESC, D3D11_SIGNATURE_PARAMETER_DESC>(
+            *dx11ShaderReflection.Get(), shaderCacheEntry.m_shaderResourceLayout);
+        shaderCacheEntry.m_dependencies = std::move(includeHandler.GetDependencies());
+        return shaderCacheEntry;
+    }
+
+    std::shared_ptr<ShaderBytecode> CreateShaderBytecode(ShaderCacheEntry&& shaderCacheEntry)
+    {
+        ComPtr<ID3DBlob> shaderBlob;
+        if (FAILED(D3DCreateBlob(shaderCacheEntry.m_bytecode.size(), shaderBlob.GetAddressOf())))
+        {
+            DX_LOG(Error, "ShaderCompiler", "Failed to create shader blob.");
+            return nullptr;
+        }
+        std::memcpy(shaderBlob->GetBufferPointer(), shaderCacheEntry.m_bytecode.data(), shaderCacheEntry.m_bytecode.size());
+
+        return std::make_shared<DX11ShaderBytecode>(std::move(shaderBlob), std::move(shaderCacheEntry.m_shaderResourceLayout));
+    }
+
+    std::optional<std::vector<ShaderConstantBufferLayout>> ReflectConstantBufferLayouts(const ShaderBytecode& shaderBytecode)
+    {
+        ComPtr<ID3D11ShaderReflection> dx11ShaderReflection;
+        auto result = D3DReflect(
+            shaderBytecode.GetData(),
+            shaderBytecode.GetSize(),
+            IID_PPV_ARGS(dx11ShaderReflection.GetAddressOf()));
+        if (FAILED(result))
+        {
+            DX_LOG(Error, "ShaderCompiler", "Failed to create shader reflection.");
+            return std::nullopt;
+        }
+
+        return ReflectShaderConstantBufferLayouts<D3D11_SHADER_DESC, D3D11_SHADER_BUFFER_DESC, D3D11_SHADER_VARIABLE_DESC>(*dx11ShaderReflection.Get());
+    }
+} // namespace DX::ShaderCompilerBackend
+
+#endif // !DX_SHADER_COMPILER_DXC
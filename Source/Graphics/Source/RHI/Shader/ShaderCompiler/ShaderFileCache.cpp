@@ -0,0 +1,52 @@
+#include <RHI/Shader/ShaderCompiler/ShaderFileCache.h>
+
+#include <File/FileUtils.h>
+#include <Hash/Hash.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace DX
+{
+    static std::mutex ShaderFilesMutex;
+    static std::unordered_map<std::string, std::shared_ptr<const ShaderSourceFile>> ShaderFiles;
+
+    std::shared_ptr<const ShaderSourceFile> ShaderFileCache::Load(const std::string& fileName)
+    {
+        {
+            std::lock_guard lock(ShaderFilesMutex);
+            if (auto it = ShaderFiles.find(fileName);
+                it != ShaderFiles.end())
+            {
+                return it->second;
+            }
+        }
+
+        // Files that don't exist are not cached, they might be created later.
+        const auto file = OpenAssetFile(fileName, FileAccessPattern::Sequential);
+        if (!file.has_value())
+        {
+            return nullptr;
+        }
+
+        auto shaderFile = std::make_shared<ShaderSourceFile>();
+        shaderFile->m_code = file->GetText();
+        shaderFile->m_contentHash = Hash64(shaderFile->m_code);
+
+        // When another thread loaded the same file meanwhile, both use the first one.
+        std::lock_guard lock(ShaderFilesMutex);
+        return ShaderFiles.try_emplace(fileName, std::move(shaderFile)).first->second;
+    }
+
+    void ShaderFileCache::Invalidate(const std::string& fileName)
+    {
+        std::lock_guard lock(ShaderFilesMutex);
+        ShaderFiles.erase(fileName);
+    }
+
+    void ShaderFileCache::Clear()
+    {
+        std::lock_guard lock(ShaderFilesMutex);
+        ShaderFiles.clear();
+    }
+} // namespace DX
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace DX
+{
+    // Content of a shader source file, the shader file or a file included by it.
+    struct ShaderSourceFile
+    {
+        std::string m_code;
+        uint64_t m_contentHash = 0;
+    };
+
+    // In-memory layer of the shader source files, shared by all the compilations,
+    // so a header included by many shaders and variants is read and hashed once.
+    //
+    // The content is copied to memory instead of keeping the files mapped, so
+    // they can be edited while the application runs. Edited files are invalidated
+    // to read them again (see ShaderCompiler::InvalidateFiles).
+    class ShaderFileCache
+    {
+    public:
+        // The filename is relative to the assets folder.
+        // Returns nullptr if the file doesn't exist. It's thread safe.
+        // The content returned stays valid after the file is invalidated.
+        static std::shared_ptr<const ShaderSourceFile> Load(const std::string& fileName);
+
+        // The next time the file is loaded it's read again.
+        static void Invalidate(const std::string& fileName);
+
+        static void Clear();
+    };
+} // namespace DX
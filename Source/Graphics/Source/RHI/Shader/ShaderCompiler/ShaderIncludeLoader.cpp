@@ -0,0 +1,29 @@
+#include <RHI/Shader/ShaderCompiler/ShaderIncludeLoader.h>
+
+#include <algorithm>
+
+namespace DX
+{
+    std::optional<std::span<const uint8_t>> ShaderIncludeLoader::Load(const std::string& fileName)
+    {
+        auto file = ShaderFileCache::Load(fileName);
+        if (!file)
+        {
+            return std::nullopt;
+        }
+
+        if (std::ranges::find(m_dependencies, fileName, &ShaderDependency::m_fileName) == m_dependencies.end())
+        {
+            m_dependencies.push_back({ fileName, file->m_contentHash });
+        }
+
+        const std::span<const uint8_t> data(reinterpret_cast<const uint8_t*>(file->m_code.data()), file->m_code.size());
+        m_includedFiles.push_back(std::move(file));
+        return data;
+    }
+
+    std::string ShaderIncludeLoader::GetIncludeFileName(const std::filesystem::path& folder, const std::filesystem::path& includeFileName)
+    {
+        return (folder / includeFileName).lexically_normal().generic_string();
+    }
+} // namespace DX
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <RHI/Shader/ShaderCompiler/ShaderCache.h>
+#include <RHI/Shader/ShaderCompiler/ShaderFileCache.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace DX
+{
+    // Loads the files included by a shader for the compiler backends and records
+    // them as dependencies of the shader, with the hash of their content. Files
+    // included by other included files are recorded too, so the dependencies are
+    // all the files the shader depends on.
+    //
+    // Files are loaded through the ShaderFileCache and kept alive until the loader
+    // is destroyed, so compilers can read their content without copies during the
+    // compilation, even if the files are invalidated meanwhile.
+    class ShaderIncludeLoader
+    {
+    public:
+        // The filename is relative to the assets folder.
+        // Returns nullopt if the file doesn't exist, compilers report the error.
+        std::optional<std::span<const uint8_t>> Load(const std::string& fileName);
+
+        std::vector<ShaderDependency>& GetDependencies() { return m_dependencies; }
+
+        // Filename relative to the assets folder of a file included from a folder.
+        static std::string GetIncludeFileName(const std::filesystem::path& folder, const std::filesystem::path& includeFileName);
+
+    private:
+        std::vector<std::shared_ptr<const ShaderSourceFile>> m_includedFiles;
+        std::vector<ShaderDependency> m_dependencies;
+    };
+} // namespace DX
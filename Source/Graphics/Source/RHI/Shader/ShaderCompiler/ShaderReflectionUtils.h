@@ -0,0 +1,272 @@
+#pragma once
+
+#include <RHI/Shader/ShaderReflection.h>
+#include <RHI/Shader/ShaderCompiler/ShaderStatistics.h>
+
+#include <Debug/Debug.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <set>
+#include <string>
+#include <vector>
+
+// Reflection shared by the compiler backends. FXC's ID3D11ShaderReflection and DXC's
+// ID3D12ShaderReflection have the same interface with different types, so these are
+// templates and the same code fills the layouts of DXBC and DXIL shaders.
+//
+// Include it after d3d11shader.h or d3d12shader.h, it uses the D3D_* enums of d3dcommon.h.
+
+namespace DX
+{
+    template<typename ShaderInputBindDesc>
+    void AddResourceBindingToLayout(
+        const ShaderInputBindDesc& resourceDesc,
+        ShaderResourceLayout& shaderResourceLayout)
+    {
+        DX_ASSERT(!std::string(resourceDesc.Name).empty(), "ShaderCompiler", "Invalid resource name.");
+
+        switch (resourceDesc.Type)
+        {
+        // Constant Buffer
+        case D3D_SIT_CBUFFER:
+        case D3D_SIT_TBUFFER:
+            shaderResourceLayout.m_constantBuffers.emplace_back(
+                resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount);
+            break;
+
+        // Shader Resource View
+        case D3D_SIT_TEXTURE:
+            switch (resourceDesc.Dimension)
+            {
+            case D3D_SRV_DIMENSION_TEXTURE1D:
+                shaderResourceLayout.m_shaderResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount,
+                    TextureType::Texture1D);
+                break;
+            case D3D_SRV_DIMENSION_TEXTURE1DARRAY:
+                shaderResourceLayout.m_shaderResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount,
+                    TextureType::Texture1D, TextureSubType_Array);
+                break;
+            case D3D_SRV_DIMENSION_TEXTURE2D:
+                shaderResourceLayout.m_shaderResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount,
+                    TextureType::Texture2D);
+                break;
+            case D3D_SRV_DIMENSION_TEXTURE2DARRAY:
+                shaderResourceLayout.m_shaderResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount,
+                    TextureType::Texture2D, TextureSubType_Array);
+                break;
+            case D3D_SRV_DIMENSION_TEXTURE2DMS:
+                shaderResourceLayout.m_shaderResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount,
+                    TextureType::Texture2D, TextureSubType_Multisample);
+                break;
+            case D3D_SRV_DIMENSION_TEXTURE2DMSARRAY:
+                shaderResourceLayout.m_shaderResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount,
+                    TextureType::Texture2D, TextureSubType_Array | TextureSubType_Multisample);
+                break;
+            case D3D_SRV_DIMENSION_TEXTURE3D:
+                shaderResourceLayout.m_shaderResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount,
+                    TextureType::Texture3D);
+                break;
+            case D3D_SRV_DIMENSION_TEXTURECUBE:
+                shaderResourceLayout.m_shaderResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount,
+                    TextureType::TextureCube);
+                break;
+            case D3D_SRV_DIMENSION_TEXTURECUBEARRAY:
+                shaderResourceLayout.m_shaderResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount,
+                    TextureType::TextureCube, TextureSubType_Array);
+                break;
+            case D3D_SRV_DIMENSION_BUFFER:
+                shaderResourceLayout.m_shaderResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount, BufferSubType::Typed);
+                break;
+            default:
+                DX_ASSERT(false, "ShaderCompiler", "Unexpected Shader dimension %d.", resourceDesc.Dimension);
+                break;
+            }
+            break;
+
+        case D3D_SIT_STRUCTURED:
+            shaderResourceLayout.m_shaderResourceViews.emplace_back(
+                resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount, BufferSubType::Structured);
+            break;
+
+        case D3D_SIT_BYTEADDRESS:
+            shaderResourceLayout.m_shaderResourceViews.emplace_back(
+                resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount, BufferSubType::Raw);
+            break;
+
+        // Shader RW Resource View
+        case D3D_SIT_UAV_RWTYPED:
+            switch (resourceDesc.Dimension)
+            {
+            case D3D_SRV_DIMENSION_TEXTURE1D:
+                shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount,
+                    TextureType::Texture1D);
+                break;
+            case D3D_SRV_DIMENSION_TEXTURE1DARRAY:
+                shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount,
+                    TextureType::Texture1D, TextureSubType_Array);
+                break;
+            case D3D_SRV_DIMENSION_TEXTURE2D:
+                shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount,
+                    TextureType::Texture2D);
+                break;
+            case D3D_SRV_DIMENSION_TEXTURE2DARRAY:
+                shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount,
+                    TextureType::Texture2D, TextureSubType_Array);
+                break;
+            case D3D_SRV_DIMENSION_TEXTURE3D:
+                shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount,
+                    TextureType::Texture3D);
+                break;
+            case D3D_SRV_DIMENSION_BUFFER:
+                shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
+                    resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount, BufferSubType::Typed);
+                break;
+            default:
+                DX_ASSERT(false, "ShaderCompiler", "Unexpected Shader dimension %d.", resourceDesc.Dimension);
+                break;
+            }
+            break;
+
+        case D3D_SIT_UAV_RWSTRUCTURED:
+            shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
+                resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount, BufferSubType::Structured);
+            break;
+
+        case D3D_SIT_UAV_RWBYTEADDRESS:
+            shaderResourceLayout.m_shaderRWResourceViews.emplace_back(
+                resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount, BufferSubType::Raw);
+            break;
+
+        // Sampler
+        case D3D_SIT_SAMPLER:
+            shaderResourceLayout.m_samplers.emplace_back(
+                resourceDesc.Name, resourceDesc.BindPoint, resourceDesc.BindCount);
+            break;
+
+        default:
+            DX_ASSERT(false, "ShaderCompiler", "Unsupported shader input type %d.", resourceDesc.Type);
+            break;
+        }
+    }
+
+    inline uint32_t SlotCount(const std::vector<ShaderResourceInfo>& resources)
+    {
+        return std::accumulate(resources.begin(), resources.end(), 0u,
+            [](uint32_t slotCount, const auto& resource)
+            {
+                return std::max<uint32_t>(slotCount, resource.m_startSlot + resource.m_slotCount);
+            });
+    }
+
+    // Usage: ReflectShaderResourceLayout<D3D11_SHADER_DESC, D3D11_SHADER_INPUT_BIND_DESC>(dx11ShaderReflection)
+    template<typename ShaderDesc, typename ShaderInputBindDesc, typename ShaderReflectionInterface>
+    ShaderResourceLayout ReflectShaderResourceLayout(ShaderReflectionInterface& shaderReflection)
+    {
+        ShaderDesc shaderDesc;
+        shaderReflection.GetDesc(&shaderDesc);
+
+        ShaderResourceLayout shaderResourceLayout;
+        for (uint32_t i = 0; i < shaderDesc.BoundResources; ++i)
+        {
+            ShaderInputBindDesc resourceDesc;
+            shaderReflection.GetResourceBindingDesc(i, &resourceDesc);
+
+            AddResourceBindingToLayout(resourceDesc, shaderResourceLayout);
+        }
+
+        shaderResourceLayout.m_constantBuffersSlotCount = SlotCount(shaderResourceLayout.m_constantBuffers);
+        shaderResourceLayout.m_shaderResourceViewsSlotCount = SlotCount(shaderResourceLayout.m_shaderResourceViews);
+        shaderResourceLayout.m_shaderRWResourceViewsSlotCount = SlotCount(shaderResourceLayout.m_shaderRWResourceViews);
+        shaderResourceLayout.m_samplersSlotCount = SlotCount(shaderResourceLayout.m_samplers);
+        return shaderResourceLayout;
+    }
+
+    // Usage: ReflectShaderConstantBufferLayouts<D3D11_SHADER_DESC, D3D11_SHADER_BUFFER_DESC, D3D11_SHADER_VARIABLE_DESC>(dx11ShaderReflection)
+    template<typename ShaderDesc, typename ShaderBufferDesc, typename ShaderVariableDesc, typename ShaderReflectionInterface>
+    std::vector<ShaderConstantBufferLayout> ReflectShaderConstantBufferLayouts(ShaderReflectionInterface& shaderReflection)
+    {
+        ShaderDesc shaderDesc;
+        shaderReflection.GetDesc(&shaderDesc);
+
+        std::vector<ShaderConstantBufferLayout> constantBufferLayouts;
+        for (uint32_t i = 0; i < shaderDesc.ConstantBuffers; ++i)
+        {
+            auto* constantBuffer = shaderReflection.GetConstantBufferByIndex(i);
+
+            ShaderBufferDesc bufferDesc;
+            constantBuffer->GetDesc(&bufferDesc);
+
+            ShaderConstantBufferLayout& constantBufferLayout = constantBufferLayouts.emplace_back();
+            constantBufferLayout.m_name = bufferDesc.Name;
+            constantBufferLayout.m_size = bufferDesc.Size;
+
+            for (uint32_t j = 0; j < bufferDesc.Variables; ++j)
+            {
+                ShaderVariableDesc variableDesc;
+                constantBuffer->GetVariableByIndex(j)->GetDesc(&variableDesc);
+
+                constantBufferLayout.m_variables.push_back({ variableDesc.Name, variableDesc.StartOffset, variableDesc.Size });
+            }
+        }
+        return constantBufferLayouts;
+    }
+
+    // Usage: ReflectShaderStatistics<D3D11_SHADER_DESC, D3D11_SHADER_BUFFER_DESC, D3D11_SIGNATURE_PARAMETER_DESC>(dx11ShaderReflection, layout)
+    template<typename ShaderDesc, typename ShaderBufferDesc, typename SignatureParameterDesc, typename ShaderReflectionInterface>
+    ShaderStatistics ReflectShaderStatistics(ShaderReflectionInterface& shaderReflection, const ShaderResourceLayout& shaderResourceLayout)
+    {
+        ShaderDesc shaderDesc;
+        shaderReflection.GetDesc(&shaderDesc);
+
+        ShaderStatistics statistics;
+        statistics.m_instructionCount = shaderDesc.InstructionCount;
+        statistics.m_aluInstructionCount = shaderDesc.FloatInstructionCount + shaderDesc.IntInstructionCount + shaderDesc.UintInstructionCount;
+        statistics.m_textureInstructionCount = shaderDesc.TextureNormalInstructions + shaderDesc.TextureLoadInstructions +
+            shaderDesc.TextureCompInstructions + shaderDesc.TextureBiasInstructions + shaderDesc.TextureGradientInstructions;
+        statistics.m_flowControlInstructionCount = shaderDesc.StaticFlowControlCount + shaderDesc.DynamicFlowControlCount;
+        statistics.m_tempRegisterCount = shaderDesc.TempRegisterCount;
+
+        // Reflection also lists the structured buffers as constant buffers.
+        for (uint32_t i = 0; i < shaderDesc.ConstantBuffers; ++i)
+        {
+            ShaderBufferDesc bufferDesc;
+            shaderReflection.GetConstantBufferByIndex(i)->GetDesc(&bufferDesc);
+            if (bufferDesc.Type == D3D_CT_CBUFFER || bufferDesc.Type == D3D_CT_TBUFFER)
+            {
+                statistics.m_constantBufferSize += bufferDesc.Size;
+            }
+        }
+        statistics.m_constantBufferCount = static_cast<uint32_t>(shaderResourceLayout.m_constantBuffers.size());
+        statistics.m_resourceCount = static_cast<uint32_t>(shaderResourceLayout.m_shaderResourceViews.size() +
+            shaderResourceLayout.m_shaderRWResourceViews.size() + shaderResourceLayout.m_samplers.size());
+
+        // Several input parameters can be packed in the same register.
+        std::set<uint32_t> inputRegisters;
+        for (uint32_t i = 0; i < shaderDesc.InputParameters; ++i)
+        {
+            SignatureParameterDesc parameterDesc;
+            shaderReflection.GetInputParameterDesc(i, &parameterDesc);
+            inputRegisters.insert(parameterDesc.Register);
+        }
+        statistics.m_interpolatorCount = static_cast<uint32_t>(inputRegisters.size());
+
+        return statistics;
+    }
+} // namespace DX
@@ -0,0 +1,256 @@
+#include <RHI/Shader/ShaderCompiler/ShaderReport.h>
+
+#include <File/FileUtils.h>
+#include <File/MappedFile.h>
+#include <Json/Json.h>
+#include <Log/Log.h>
+
+#include <algorithm>
+#include <cctype>
+#include <format>
+#include <limits>
+#include <map>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static std::string JsonString(std::string_view str)
+        {
+            std::string json = "\"";
+            for (const char c : str)
+            {
+                switch (c)
+                {
+                case '"': json += "\\\""; break;
+                case '\\': json += "\\\\"; break;
+                case '\n': json += "\\n"; break;
+                case '\r': json += "\\r"; break;
+                case '\t': json += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        json += std::format("\\u{:04x}", static_cast<unsigned char>(c));
+                    }
+                    else
+                    {
+                        json += c;
+                    }
+                    break;
+                }
+            }
+            json += "\"";
+            return json;
+        }
+
+        static bool GetString(const JsonValue& json, std::string_view key, std::string& value)
+        {
+            const JsonValue& member = json[key];
+            if (!member.IsString())
+            {
+                return false;
+            }
+            value = member.GetString();
+            return true;
+        }
+
+        static bool GetUint32(const JsonValue& json, std::string_view key, uint32_t& value)
+        {
+            const int64_t member = json[key].GetInt(-1);
+            if (member < 0 || member > std::numeric_limits<uint32_t>::max())
+            {
+                return false;
+            }
+            value = static_cast<uint32_t>(member);
+            return true;
+        }
+
+        static std::optional<ShaderType> ParseShaderType(std::string_view str)
+        {
+            for (int i = ShaderType_Unknown + 1; i < ShaderType_Count; ++i)
+            {
+                if (str == ShaderTypeStr(static_cast<ShaderType>(i)))
+                {
+                    return static_cast<ShaderType>(i);
+                }
+            }
+            return std::nullopt;
+        }
+
+        static std::optional<ShaderBytecodeFormat> ParseShaderBytecodeFormat(std::string_view str)
+        {
+            for (const auto format : { ShaderBytecodeFormat::DXBC, ShaderBytecodeFormat::DXIL, ShaderBytecodeFormat::SPIRV })
+            {
+                if (str == ShaderBytecodeFormatStr(format))
+                {
+                    return format;
+                }
+            }
+            return std::nullopt;
+        }
+    }
+
+    ShaderReport CreateShaderReport(const ShaderInfo& shaderInfo, uint32_t bytecodeSize, const ShaderStatistics& statistics)
+    {
+        ShaderReport report;
+        report.m_name = shaderInfo.m_name;
+        report.m_entryPoint = shaderInfo.m_entryPoint;
+        report.m_shaderType = shaderInfo.m_shaderType;
+        report.m_bytecodeFormat = shaderInfo.m_bytecodeFormat;
+        report.m_permutationKey = shaderInfo.m_permutationKey;
+        for (const auto& define : GetShaderDefines(shaderInfo))
+        {
+            report.m_defines += std::format("{}{}={}", report.m_defines.empty() ? "" : " ", define.m_name, define.m_value);
+        }
+        report.m_bytecodeSize = bytecodeSize;
+        report.m_statistics = statistics;
+        return report;
+    }
+
+    std::string GetShaderReportId(const ShaderReport& report)
+    {
+        std::string id = std::format("{}.{}.{}", report.m_name, report.m_entryPoint, ShaderBytecodeFormatStr(report.m_bytecodeFormat));
+        if (!report.m_defines.empty())
+        {
+            id += "." + report.m_defines;
+        }
+
+        // It's also a filename.
+        std::ranges::replace_if(id, [](char c)
+            {
+                return !(std::isalnum(static_cast<unsigned char>(c)) || c == '.' || c == '_' || c == '-' || c == '=');
+            }, '_');
+        return id;
+    }
+
+    std::string SerializeShaderReport(const ShaderReport& report)
+    {
+        std::string json = "{\n";
+        json += std::format("    \"shader\": {},\n", Internal::JsonString(report.m_name));
+        json += std::format("    \"entryPoint\": {},\n", Internal::JsonString(report.m_entryPoint));
+        json += std::format("    \"stage\": {},\n", Internal::JsonString(ShaderTypeStr(report.m_shaderType)));
+        json += std::format("    \"format\": {},\n", Internal::JsonString(ShaderBytecodeFormatStr(report.m_bytecodeFormat)));
+        json += std::format("    \"permutationKey\": {},\n", report.m_permutationKey);
+        json += std::format("    \"defines\": {},\n", Internal::JsonString(report.m_defines));
+        json += std::format("    \"bytecodeSize\": {}", report.m_bytecodeSize);
+        for (const auto& statistic : ShaderStatisticsList)
+        {
+            json += std::format(",\n    \"{}\": {}", statistic.m_name, report.m_statistics.*statistic.m_value);
+        }
+        json += "\n}\n";
+        return json;
+    }
+
+    std::optional<ShaderReport> DeserializeShaderReport(std::string_view json)
+    {
+        const auto values = ParseJson(json);
+        if (!values.has_value() || !values->IsObject())
+        {
+            return std::nullopt;
+        }
+
+        ShaderReport report;
+        std::string shaderType;
+        std::string bytecodeFormat;
+        if (!Internal::GetString(*values, "shader", report.m_name) ||
+            !Internal::GetString(*values, "entryPoint", report.m_entryPoint) ||
+            !Internal::GetString(*values, "stage", shaderType) ||
+            !Internal::GetString(*values, "format", bytecodeFormat) ||
+            !Internal::GetUint32(*values, "permutationKey", report.m_permutationKey) ||
+            !Internal::GetString(*values, "defines", report.m_defines) ||
+            !Internal::GetUint32(*values, "bytecodeSize", report.m_bytecodeSize))
+        {
+            return std::nullopt;
+        }
+
+        const auto parsedShaderType = Internal::ParseShaderType(shaderType);
+        const auto parsedBytecodeFormat = Internal::ParseShaderBytecodeFormat(bytecodeFormat);
+        if (!parsedShaderType.has_value() || !parsedBytecodeFormat.has_value())
+        {
+            return std::nullopt;
+        }
+        report.m_shaderType = *parsedShaderType;
+        report.m_bytecodeFormat = *parsedBytecodeFormat;
+
+        // Statistics missing in reports of older versions are left as 0.
+        for (const auto& statistic : ShaderStatisticsList)
+        {
+            Internal::GetUint32(*values, statistic.m_name, report.m_statistics.*statistic.m_value);
+        }
+
+        return report;
+    }
+
+    bool SaveShaderReport(const std::filesystem::path& reportFolder, const ShaderReport& report)
+    {
+        std::error_code errorCode;
+        std::filesystem::create_directories(reportFolder, errorCode);
+
+        const std::string json = SerializeShaderReport(report);
+        const std::filesystem::path reportPath = reportFolder / (GetShaderReportId(report) + ".json");
+        if (!WriteFileAtomically(reportPath, std::span(reinterpret_cast<const uint8_t*>(json.data()), json.size())))
+        {
+            DX_LOG(Error, "ShaderReport", "Failed to write shader report %s.", reportPath.string().c_str());
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<ShaderReport> LoadShaderReports(const std::filesystem::path& reportFolder)
+    {
+        std::vector<ShaderReport> reports;
+
+        std::error_code errorCode;
+        for (const auto& entry : std::filesystem::directory_iterator(reportFolder, errorCode))
+        {
+            if (!entry.is_regular_file() || entry.path().extension() != ".json")
+            {
+                continue;
+            }
+
+            const MappedFile reportFile(entry.path(), FileAccessPattern::Sequential);
+            auto report = reportFile.IsValid()
+                ? DeserializeShaderReport({ reinterpret_cast<const char*>(reportFile.GetData().data()), reportFile.GetData().size() })
+                : std::nullopt;
+            if (!report.has_value())
+            {
+                DX_LOG(Warning, "ShaderReport", "Skipping invalid shader report %s.", entry.path().string().c_str());
+                continue;
+            }
+            reports.push_back(std::move(*report));
+        }
+
+        if (errorCode)
+        {
+            DX_LOG(Error, "ShaderReport", "Failed to read shader reports from %s: %s.", reportFolder.string().c_str(), errorCode.message().c_str());
+        }
+        return reports;
+    }
+
+    std::vector<ShaderReportDiff> DiffShaderReports(std::span<const ShaderReport> baseReports, std::span<const ShaderReport> newReports)
+    {
+        // Sorted by id.
+        std::map<std::string, ShaderReportDiff> diffs;
+        for (const auto& report : baseReports)
+        {
+            const std::string id = GetShaderReportId(report);
+            diffs[id].m_baseStatistics = report.m_statistics;
+        }
+        for (const auto& report : newReports)
+        {
+            const std::string id = GetShaderReportId(report);
+            diffs[id].m_newStatistics = report.m_statistics;
+        }
+
+        std::vector<ShaderReportDiff> result;
+        for (auto& [id, diff] : diffs)
+        {
+            if (diff.m_baseStatistics != diff.m_newStatistics)
+            {
+                diff.m_id = id;
+                result.push_back(std::move(diff));
+            }
+        }
+        return result;
+    }
+} // namespace DX
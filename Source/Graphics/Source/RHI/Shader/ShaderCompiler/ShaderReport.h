@@ -0,0 +1,58 @@
+#pragma once
+
+#include <RHI/Shader/ShaderEnums.h>
+#include <RHI/Shader/ShaderCompiler/ShaderStatistics.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DX
+{
+    // Cost report of a compiled variant of a shader, see ShaderStatistics.
+    //
+    // Reports are JSON files with a flat object, one file per variant. A folder with
+    // the reports of all the shaders is a report set, and two sets are compared with
+    // DiffShaderReports to find the variants that got more expensive.
+    struct ShaderReport
+    {
+        std::string m_name;
+        std::string m_entryPoint;
+        ShaderType m_shaderType = ShaderType_Unknown;
+        ShaderBytecodeFormat m_bytecodeFormat = DefaultShaderBytecodeFormat;
+        ShaderPermutationKey m_permutationKey = 0;
+        std::string m_defines; // Defines of the variant, "NAME=VALUE" separated by spaces
+        uint32_t m_bytecodeSize = 0;
+        ShaderStatistics m_statistics;
+    };
+
+    ShaderReport CreateShaderReport(const ShaderInfo& shaderInfo, uint32_t bytecodeSize, const ShaderStatistics& statistics);
+
+    // Identifies the variant in report sets, it's also the filename of its report.
+    // Variants are identified by their defines, which keep their meaning when
+    // features are added, unlike the bits of the permutation key.
+    std::string GetShaderReportId(const ShaderReport& report);
+
+    std::string SerializeShaderReport(const ShaderReport& report);
+    std::optional<ShaderReport> DeserializeShaderReport(std::string_view json);
+
+    bool SaveShaderReport(const std::filesystem::path& reportFolder, const ShaderReport& report);
+
+    // Loads the reports of a report set. Files that are not valid reports are skipped.
+    std::vector<ShaderReport> LoadShaderReports(const std::filesystem::path& reportFolder);
+
+    // Variant whose statistics are different between two report sets.
+    struct ShaderReportDiff
+    {
+        std::string m_id;
+        std::optional<ShaderStatistics> m_baseStatistics; // Not set for variants added in the new set
+        std::optional<ShaderStatistics> m_newStatistics; // Not set for variants removed in the new set
+    };
+
+    // Returns the variants added, removed or with different statistics, sorted by id.
+    std::vector<ShaderReportDiff> DiffShaderReports(std::span<const ShaderReport> baseReports, std::span<const ShaderReport> newReports);
+} // namespace DX
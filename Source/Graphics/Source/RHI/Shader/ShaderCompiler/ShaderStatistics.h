@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace DX
+{
+    // Static cost of a compiled shader, from the reflection data of the compiler.
+    // They count the instructions of the bytecode, not of the GPU's instruction set,
+    // so they are meant to compare versions of a shader, not to time it.
+    //
+    // Counts are per bytecode format: DXC reports fewer statistics for DXIL than FXC
+    // for DXBC, and SPIR-V has the statistics of its DXIL.
+    struct ShaderStatistics
+    {
+        uint32_t m_instructionCount = 0;
+        uint32_t m_aluInstructionCount = 0; // Float, int and uint instructions
+        uint32_t m_textureInstructionCount = 0; // Sample, load, compare, bias and gradient instructions
+        uint32_t m_flowControlInstructionCount = 0; // Static and dynamic flow control
+        uint32_t m_tempRegisterCount = 0;
+        uint32_t m_constantBufferCount = 0;
+        uint32_t m_constantBufferSize = 0; // Bytes of all the constant buffers
+        uint32_t m_resourceCount = 0; // Shader resource views, shader RW resource views and samplers
+        uint32_t m_interpolatorCount = 0; // Input registers, interpolated values in pixel shaders
+
+        bool operator==(const ShaderStatistics&) const = default;
+    };
+
+    // Name of a statistic in shader reports.
+    struct ShaderStatistic
+    {
+        const char* m_name;
+        uint32_t ShaderStatistics::* m_value;
+    };
+
+    inline constexpr std::array<ShaderStatistic, 9> ShaderStatisticsList = { {
+        { "instructions", &ShaderStatistics::m_instructionCount },
+        { "aluInstructions", &ShaderStatistics::m_aluInstructionCount },
+        { "textureInstructions", &ShaderStatistics::m_textureInstructionCount },
+        { "flowControlInstructions", &ShaderStatistics::m_flowControlInstructionCount },
+        { "tempRegisters", &ShaderStatistics::m_tempRegisterCount },
+        { "constantBuffers", &ShaderStatistics::m_constantBufferCount },
+        { "constantBufferSize", &ShaderStatistics::m_constantBufferSize },
+        { "resources", &ShaderStatistics::m_resourceCount },
+        { "interpolators", &ShaderStatistics::m_interpolatorCount },
+    } };
+} // namespace DX
@@ -1,5 +1,7 @@
 #include <RHI/Shader/ShaderEnums.h>
 
+#include <Debug/Debug.h>
+
 namespace DX
 {
     const char* ShaderTypeStr(ShaderType shaderType)
@@ -24,4 +26,42 @@ namespace DX
             return "Unknown";
         }
     }
+
+    const char* ShaderBytecodeFormatStr(ShaderBytecodeFormat format)
+    {
+        switch (format)
+        {
+        case ShaderBytecodeFormat::DXBC:
+            return "DXBC";
+        case ShaderBytecodeFormat::DXIL:
+            return "DXIL";
+        case ShaderBytecodeFormat::SPIRV:
+            return "SPIRV";
+        default:
+            return "Unknown";
+        }
+    }
+
+    std::vector<ShaderDefine> GetShaderDefines(const ShaderInfo& shaderInfo)
+    {
+        std::vector<ShaderDefine> defines = shaderInfo.m_defines;
+        defines.reserve(defines.size() + shaderInfo.m_features.size());
+
+        [[maybe_unused]] ShaderPermutationKey featureBits = 0;
+        for (const auto& feature : shaderInfo.m_features)
+        {
+            DX_ASSERT(feature.m_bit != 0 && (feature.m_bit & (feature.m_bit - 1)) == 0, "ShaderInfo",
+                "Feature %s of shader %s is not a single bit.", feature.m_define.c_str(), shaderInfo.m_name.c_str());
+            DX_ASSERT((featureBits & feature.m_bit) == 0, "ShaderInfo",
+                "Feature %s of shader %s uses the bit of another feature.", feature.m_define.c_str(), shaderInfo.m_name.c_str());
+            featureBits |= feature.m_bit;
+
+            defines.push_back({ feature.m_define, (shaderInfo.m_permutationKey & feature.m_bit) ? "1" : "0" });
+        }
+
+        DX_ASSERT((shaderInfo.m_permutationKey & ~featureBits) == 0, "ShaderInfo",
+            "Permutation key 0x%x of shader %s has bits of unknown features.", shaderInfo.m_permutationKey, shaderInfo.m_name.c_str());
+
+        return defines;
+    }
 } // namespace DX
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace DX
 {
@@ -20,10 +22,58 @@ namespace DX
 
     const char* ShaderTypeStr(ShaderType shaderType);
 
+    // Format of the compiled shader. DXBC is compiled with FXC (d3dcompiler) for D3D11.
+    // DXIL and SPIR-V are compiled with DXC, which also builds on Linux.
+    enum class ShaderBytecodeFormat
+    {
+        DXBC,
+        DXIL,
+        SPIRV
+    };
+
+    const char* ShaderBytecodeFormatStr(ShaderBytecodeFormat format);
+
+    // Format of the backend the shader compiler is built with (see ShaderCompiler.h).
+#if defined(DX_SHADER_COMPILER_DXC)
+    constexpr ShaderBytecodeFormat DefaultShaderBytecodeFormat = ShaderBytecodeFormat::DXIL;
+#else
+    constexpr ShaderBytecodeFormat DefaultShaderBytecodeFormat = ShaderBytecodeFormat::DXBC;
+#endif
+
+    // Macro defined when compiling a shader, like #define in the shader code.
+    struct ShaderDefine
+    {
+        std::string m_name;
+        std::string m_value;
+    };
+
+    // Bitmask of the features compiled in a variant of a shader, one bit per feature.
+    // It's the key of the variant, the shader is compiled once per requested key.
+    using ShaderPermutationKey = uint32_t;
+
+    // Optional part of a shader, compiled in or out of its variants with a macro.
+    // The macro is defined as 1 in variants whose key has the bit set, and as 0 otherwise,
+    // so shaders test it with #if.
+    struct ShaderFeature
+    {
+        ShaderPermutationKey m_bit = 0;
+        std::string m_define;
+    };
+
     struct ShaderInfo
     {
         ShaderType m_shaderType;
         std::string m_name;
         std::string m_entryPoint;
+        std::vector<ShaderDefine> m_defines;
+
+        // Features of the shader and the ones enabled in this variant.
+        std::vector<ShaderFeature> m_features;
+        ShaderPermutationKey m_permutationKey = 0;
+
+        ShaderBytecodeFormat m_bytecodeFormat = DefaultShaderBytecodeFormat;
     };
+
+    // Defines of the shader plus the defines of its features for the variant.
+    std::vector<ShaderDefine> GetShaderDefines(const ShaderInfo& shaderInfo);
 } // namespace DX
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <RHI/Shader/ShaderEnums.h>
+#include <RHI/Shader/ShaderResourceLayout.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace DX
+{
+    // Variable of a constant buffer, with its offset and size in bytes.
+    struct ShaderConstantBufferVariable
+    {
+        std::string m_name;
+        uint32_t m_offset = 0;
+        uint32_t m_size = 0;
+
+        bool operator==(const ShaderConstantBufferVariable&) const = default;
+    };
+
+    // Layout in memory of a constant buffer, as the shader reads it.
+    struct ShaderConstantBufferLayout
+    {
+        std::string m_name;
+        uint32_t m_size = 0; // Multiple of 16 bytes
+        std::vector<ShaderConstantBufferVariable> m_variables;
+
+        bool operator==(const ShaderConstantBufferLayout&) const = default;
+    };
+
+    // Reflection data of a compiled shader: the resources it uses and
+    // the layout of its constant buffers. Used by tools that generate code
+    // from shaders, the renderer only needs the ShaderResourceLayout.
+    struct ShaderReflection
+    {
+        ShaderType m_shaderType = ShaderType_Unknown;
+        std::string m_name;
+        ShaderResourceLayout m_shaderResourceLayout;
+        std::vector<ShaderConstantBufferLayout> m_constantBufferLayouts;
+    };
+} // namespace DX
@@ -50,6 +50,8 @@ namespace DX
         // For Texture View only
         TextureType m_textureType = TextureType::Unknown;
         TextureSubTypeFlags m_textureSubTypeFlags = 0;
+
+        bool operator==(const ShaderResourceInfo&) const = default;
     };
 
     // Defines what resources are used by a shader and the slots they are expected to be bound to.
@@ -64,5 +66,7 @@ namespace DX
         uint32_t m_shaderResourceViewsSlotCount = 0;
         uint32_t m_shaderRWResourceViewsSlotCount = 0;
         uint32_t m_samplersSlotCount = 0;
+
+        bool operator==(const ShaderResourceLayout&) const = default;
     };
 } // namespace DX
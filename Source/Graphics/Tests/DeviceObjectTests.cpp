@@ -3,6 +3,8 @@
 #include <RHI/FrameBuffer/FrameBuffer.h>
 #include <RHI/Shader/Shader.h>
 #include <RHI/Shader/ShaderCompiler/ShaderCompiler.h>
+#include <RHI/Shader/ShaderCompiler/ShaderBindingsGenerator.h>
+#include <RHI/Shader/ShaderCompiler/ShaderReport.h>
 #include <RHI/Sampler/Sampler.h>
 #include <RHI/Resource/Texture/Texture.h>
 #include <RHI/Resource/Buffer/Buffer.h>
@@ -10,15 +12,21 @@
 #include <RHI/Resource/Views/ShaderResourceView.h>
 #include <RHI/Resource/Views/ShaderRWResourceView.h>
 #include <RHI/Pipeline/Pipeline.h>
+#include <RHI/Pipeline/PipelineCache.h>
 
 #include <Log/Log.h>
 #include <Debug/Debug.h>
 #include <Math/Vector2.h>
 #include <Math/Vector3.h>
 
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <numeric>
+#include <thread>
+#include <vector>
 
-#pragma DX_DISABLE_WARNING(4267, "")
+DX_DISABLE_WARNING(4267, "-Wconversion")
 
 namespace UnitTest
 {
@@ -141,6 +149,117 @@ namespace UnitTest
 
         auto vertexShader = m_device->CreateShader({ vertexShaderInfo, vertexShaderByteCode });
         auto pixelShader = m_device->CreateShader({ pixelShaderInfo, pixelShaderByteCode });
+
+        // Compiling the same shader again returns the same bytecode.
+        [[maybe_unused]] auto pixelShaderByteCodeAgain = DX::ShaderCompiler::Compile(pixelShaderInfo);
+        DX_ASSERT(pixelShaderByteCodeAgain == pixelShaderByteCode, "DeviceObjectTests", "Shader compiled again.");
+
+        // Once released from memory, it's loaded from the shader cache on disk.
+        DX::ShaderCompiler::ReleaseCompiledShaders();
+        [[maybe_unused]] auto pixelShaderByteCodeCached = DX::ShaderCompiler::Compile(pixelShaderInfo);
+        DX_ASSERT(pixelShaderByteCodeCached &&
+            pixelShaderByteCodeCached->GetSize() == pixelShaderByteCode->GetSize() &&
+            std::memcmp(pixelShaderByteCodeCached->GetData(), pixelShaderByteCode->GetData(), pixelShaderByteCode->GetSize()) == 0,
+            "DeviceObjectTests", "Shader bytecode from the shader cache is different.");
+        DX_ASSERT(pixelShaderByteCodeCached->GetShaderResourceLayout().m_shaderResourceViewsSlotCount ==
+            pixelShaderByteCode->GetShaderResourceLayout().m_shaderResourceViewsSlotCount,
+            "DeviceObjectTests", "Shader resource layout from the shader cache is different.");
+
+        // Defines are part of the shader, compiling with them is a different shader.
+        DX::ShaderInfo pixelShaderWithDefineInfo = pixelShaderInfo;
+        pixelShaderWithDefineInfo.m_defines = { { "TEST_DEFINE", "1" } };
+        [[maybe_unused]] auto pixelShaderWithDefineByteCode = DX::ShaderCompiler::Compile(pixelShaderWithDefineInfo);
+        DX_ASSERT(pixelShaderWithDefineByteCode && pixelShaderWithDefineByteCode != pixelShaderByteCodeCached,
+            "DeviceObjectTests", "Shader with defines is the same as without them.");
+
+        // Each permutation key is a variant of the shader, compiled once when requested.
+        DX::ShaderInfo pixelShaderVariantInfo = pixelShaderInfo;
+        pixelShaderVariantInfo.m_features = { { 1 << 0, "TEST_FEATURE" } };
+        pixelShaderVariantInfo.m_permutationKey = 0;
+        [[maybe_unused]] auto pixelShaderVariantByteCode = DX::ShaderCompiler::Compile(pixelShaderVariantInfo);
+        pixelShaderVariantInfo.m_permutationKey = 1 << 0;
+        [[maybe_unused]] auto pixelShaderFeatureVariantByteCode = DX::ShaderCompiler::Compile(pixelShaderVariantInfo);
+        DX_ASSERT(pixelShaderVariantByteCode && pixelShaderFeatureVariantByteCode &&
+            pixelShaderVariantByteCode != pixelShaderFeatureVariantByteCode,
+            "DeviceObjectTests", "Shader variants with different permutation keys are the same.");
+        DX_ASSERT(DX::ShaderCompiler::Compile(pixelShaderVariantInfo) == pixelShaderFeatureVariantByteCode,
+            "DeviceObjectTests", "Shader variant compiled again.");
+
+        // Requests from several threads of a shader being compiled wait for it, all get the same bytecode.
+        {
+            DX::ShaderCompiler::ReleaseCompiledShaders();
+
+            std::vector<std::shared_ptr<DX::ShaderBytecode>> concurrentByteCodes(8);
+            std::vector<std::thread> threads;
+            for (auto& concurrentByteCode : concurrentByteCodes)
+            {
+                threads.emplace_back([&pixelShaderVariantInfo, &concurrentByteCode]()
+                    {
+                        concurrentByteCode = DX::ShaderCompiler::Compile(pixelShaderVariantInfo);
+                    });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+
+            DX_ASSERT(concurrentByteCodes.front() &&
+                std::ranges::all_of(concurrentByteCodes, [&](const auto& byteCode) { return byteCode == concurrentByteCodes.front(); }),
+                "DeviceObjectTests", "Shader requested from several threads compiled more than once.");
+        }
+
+        // FXC only compiles DXBC, DXIL and SPIR-V are compiled by the DXC backend.
+        DX::ShaderInfo pixelShaderDXILInfo = pixelShaderInfo;
+        pixelShaderDXILInfo.m_bytecodeFormat = DX::ShaderBytecodeFormat::DXIL;
+        DX_ASSERT(DX::ShaderCompiler::Compile(pixelShaderDXILInfo) == nullptr,
+            "DeviceObjectTests", "FXC compiled a DXIL shader.");
+
+        // Reflection has the layout of the constant buffers, used to generate the shader bindings.
+        [[maybe_unused]] auto pixelShaderReflection = DX::ShaderCompiler::Reflect(pixelShaderInfo);
+        DX_ASSERT(pixelShaderReflection &&
+            std::ranges::any_of(pixelShaderReflection->m_constantBufferLayouts, [](const DX::ShaderConstantBufferLayout& layout)
+                {
+                    return layout.m_name == "CBuffer" && layout.m_size == 64 && layout.m_variables.size() == 1;
+                }),
+            "DeviceObjectTests", "Constant buffer layout not found in shader reflection.");
+
+        [[maybe_unused]] auto shaderBindingsHeader = DX::GenerateShaderBindingsHeader("TestShaderBindings", std::span(&*pixelShaderReflection, 1));
+        DX_ASSERT(shaderBindingsHeader && shaderBindingsHeader->find("struct CBuffer") != std::string::npos,
+            "DeviceObjectTests", "Shader bindings not generated.");
+
+        // When a file changes, only the variants compiled from it are compiled again.
+        [[maybe_unused]] auto vertexShaderByteCodeBeforeChange = DX::ShaderCompiler::Compile(vertexShaderInfo);
+        [[maybe_unused]] auto pixelShaderByteCodeBeforeChange = DX::ShaderCompiler::Compile(pixelShaderInfo);
+        const std::string includedFileName = "Shaders/Tests/PixelShaderTestTypes.hlsli";
+        [[maybe_unused]] const auto invalidatedShaders = DX::ShaderCompiler::InvalidateFiles(std::span(&includedFileName, 1));
+        DX_ASSERT(!invalidatedShaders.empty() &&
+            std::ranges::all_of(invalidatedShaders, [&](const DX::ShaderInfo& shaderInfo)
+                {
+                    return shaderInfo.m_name == pixelShaderInfo.m_name;
+                }),
+            "DeviceObjectTests", "Shaders invalidated don't match the shaders including the file.");
+        DX_ASSERT(DX::ShaderCompiler::Compile(vertexShaderInfo) == vertexShaderByteCodeBeforeChange,
+            "DeviceObjectTests", "Shader not including the file changed was compiled again.");
+        DX_ASSERT(DX::ShaderCompiler::Compile(pixelShaderInfo) != pixelShaderByteCodeBeforeChange,
+            "DeviceObjectTests", "Shader including the file changed was not compiled again.");
+
+        // With a report folder, compiled shaders write their cost reports.
+        const std::filesystem::path reportFolder = std::filesystem::temp_directory_path() / "DeviceObjectTestsShaderReports";
+        std::filesystem::remove_all(reportFolder);
+        DX::ShaderCompiler::SetReportFolder(reportFolder);
+        DX::ShaderCompiler::ReleaseCompiledShaders();
+        DX::ShaderCompiler::Compile(pixelShaderInfo);
+        DX::ShaderCompiler::SetReportFolder({});
+
+        [[maybe_unused]] const auto shaderReports = DX::LoadShaderReports(reportFolder);
+        DX_ASSERT(shaderReports.size() == 1 &&
+            shaderReports[0].m_name == pixelShaderInfo.m_name &&
+            shaderReports[0].m_statistics.m_instructionCount > 0 &&
+            shaderReports[0].m_statistics.m_constantBufferSize >= 64,
+            "DeviceObjectTests", "Shader report not written.");
+        DX_ASSERT(DX::DiffShaderReports(shaderReports, shaderReports).empty(),
+            "DeviceObjectTests", "Shader report is different from itself.");
+        std::filesystem::remove_all(reportFolder);
     }
 
     void DeviceObjectTests::TestSampler()
@@ -278,6 +397,7 @@ namespace UnitTest
         auto texture = m_device->CreateTexture(textureDesc);
 
         auto textureSRV = m_device->CreateShaderResourceView({ texture, texture->GetTextureDesc().m_format, 0, -1 });
+        auto textureArraySRV = m_device->CreateShaderResourceView({ texture, texture->GetTextureDesc().m_format, 0, -1, 0, 1 });
         auto textureSRWRV = m_device->CreateShaderRWResourceView({ texture, texture->GetTextureDesc().m_format, 0 });
         auto textureRTV = m_device->CreateRenderTargetView({ texture, texture->GetTextureDesc().m_format, 0 });
     }
@@ -626,5 +746,37 @@ namespace UnitTest
         };
 
         auto pipeline = m_device->CreatePipeline(pipelineDesc);
+
+        [[maybe_unused]] const DX::PipelineCacheStats statsBefore = m_device->GetPipelineCache().GetStats();
+
+        // Same description with other shader objects of the same bytecode, as each material creates its own.
+        DX::PipelineDesc sameDesc = pipelineDesc;
+        sameDesc.m_shaders[DX::ShaderType_Vertex] = m_device->CreateShader({ vertexShaderInfo, vertexShaderByteCode });
+        sameDesc.m_shaders[DX::ShaderType_Pixel] = m_device->CreateShader({ pixelShaderInfo, pixelShaderByteCode });
+        [[maybe_unused]] auto samePipeline = m_device->CreatePipeline(sameDesc);
+        DX_ASSERT(samePipeline == pipeline, "DeviceObjectTests", "Pipeline with the same description was created again.");
+
+        // Only the depth stencil state differs, the other state objects are shared.
+        DX::PipelineDesc readOnlyDepthDesc = pipelineDesc;
+        readOnlyDepthDesc.m_depthStencilState.m_depthWriteEnabled = false;
+        [[maybe_unused]] auto readOnlyDepthPipeline = m_device->CreatePipeline(readOnlyDepthDesc);
+        DX_ASSERT(readOnlyDepthPipeline != pipeline, "DeviceObjectTests", "Pipelines with different depth stencil states must be different.");
+        DX_ASSERT(readOnlyDepthPipeline->GetDX11InputLayout() == pipeline->GetDX11InputLayout() &&
+            readOnlyDepthPipeline->GetDX11RasterizerState() == pipeline->GetDX11RasterizerState() &&
+            readOnlyDepthPipeline->GetDX11BlendState() == pipeline->GetDX11BlendState(),
+            "DeviceObjectTests", "State objects are not shared between pipelines.");
+        DX_ASSERT(readOnlyDepthPipeline->GetDX11DepthStencilState() != pipeline->GetDX11DepthStencilState(),
+            "DeviceObjectTests", "Different depth stencil states share the same object.");
+
+        [[maybe_unused]] const DX::PipelineCacheStats statsAfter = m_device->GetPipelineCache().GetStats();
+        DX_ASSERT(statsAfter.m_pipelines.m_hits == statsBefore.m_pipelines.m_hits + 1 &&
+            statsAfter.m_pipelines.m_misses == statsBefore.m_pipelines.m_misses + 1,
+            "DeviceObjectTests", "Pipeline cache hits and misses not counted.");
+        DX_ASSERT(statsAfter.m_rasterizerStates.m_hits == statsBefore.m_rasterizerStates.m_hits + 1,
+            "DeviceObjectTests", "Rasterizer state cache hits not counted.");
+
+        // A different description with the same key, as when hashes collide, doesn't find the pipeline.
+        DX_ASSERT(!m_device->GetPipelineCache().FindPipeline(DX::PipelineCache::HashPipelineDesc(pipelineDesc), readOnlyDepthDesc),
+            "DeviceObjectTests", "Pipeline found with the key of another description.");
     }
 }
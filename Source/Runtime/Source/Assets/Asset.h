@@ -1,15 +1,30 @@
 #pragma once
 
+#include <GenericId/GenericId.h>
+#include <Hash/Hash.h>
+
 #include <string>
 #include <memory>
 #include <cstdint>
+#include <filesystem>
 
 namespace DX
 {
-    using AssetId = std::string;
+    // Compact asset identifier. It's the hash of the asset's filename
+    // relative to the Assets folder, see MakeAssetId.
+    using AssetId = GenericId<struct AssetIdTag>;
 
     using AssetType = uint32_t;
 
+    // Returns the id of the asset with the filename relative to the Assets folder.
+    // Different spellings of the same path, like "Models/Jack.fbx" and "./Models/Jack.fbx",
+    // produce the same id.
+    inline AssetId MakeAssetId(const std::string& fileName)
+    {
+        const std::string normalizedFileName = std::filesystem::path(fileName).lexically_normal().generic_string();
+        return AssetId(Hash64(normalizedFileName));
+    }
+
     // Base asset class with asset id and type.
     class AssetBase
     {
@@ -19,30 +34,52 @@ namespace DX
         AssetBase(const AssetBase&) = delete;
         AssetBase& operator=(const AssetBase&) = delete;
 
-        const AssetId& GetAssetId() const
+        AssetId GetAssetId() const
         {
             return m_assetId;
         }
 
         bool IsAssetIdValid() const
         {
-            return m_assetId != "";
+            return m_assetId.IsValid();
+        }
+
+        // Filename relative to the Assets folder the asset was loaded from.
+        const std::string& GetFileName() const
+        {
+            return m_fileName;
         }
 
         virtual AssetType GetAssetType() const = 0;
 
+        // Size in bytes of the data kept in CPU memory by the asset.
+        virtual size_t GetDataSizeInBytes() const = 0;
+
     protected:
-        AssetBase(AssetId assetId)
-            : m_assetId(assetId)
+        friend class AssetManager;
+
+        AssetBase(const std::string& fileName)
+            : m_assetId(MakeAssetId(fileName))
+            , m_fileName(fileName)
         {
         }
 
+        // Frees the data kept in CPU memory by the asset.
+        virtual void ReleaseData() = 0;
+
     private:
         AssetId m_assetId;
+        std::string m_fileName;
+
+        // Hash of the file content the data was loaded from, assets with the same
+        // hash share the data. Zero when the asset wasn't created from a file.
+        uint64_t m_contentHash = 0;
     };
 
     // Templated asset class with data.
     // All specific assets must derive from this.
+    //
+    // The data is shared by all assets loaded from files with identical content.
     template<typename T>
     class Asset : public AssetBase
     {
@@ -55,12 +92,17 @@ namespace DX
         }
 
     protected:
-        Asset(AssetId assetId, std::unique_ptr<DataType> data)
-            : AssetBase(assetId)
+        Asset(const std::string& fileName, std::shared_ptr<DataType> data)
+            : AssetBase(fileName)
             , m_data(std::move(data))
         {
         }
 
-        std::unique_ptr<DataType> m_data;
+        void ReleaseData() override
+        {
+            m_data.reset();
+        }
+
+        std::shared_ptr<DataType> m_data;
     };
 } // namespace DX
@@ -1,52 +1,432 @@
 #include <Assets/AssetManager.h>
 #include <Log/Log.h>
 
-#include <numeric>
+#include <algorithm>
+#include <vector>
 
 namespace DX
 {
+    namespace Internal
+    {
+        static bool IsSameFileName(const std::string& lhs, const std::string& rhs)
+        {
+            return std::filesystem::path(lhs).lexically_normal() == std::filesystem::path(rhs).lexically_normal();
+        }
+    }
+
     AssetManager::AssetManager()
     {
         DX_LOG(Info, "Asset Manager", "Initializing Asset Manager...");
+
+        m_threadPool = std::make_unique<ThreadPool>();
+        m_fileReader = std::make_unique<AsyncFileReader>();
+
+        DX_LOG(Info, "Asset Manager", "Using %u threads for loading assets.", m_threadPool->GetThreadCount());
+        DX_LOG(Info, "Asset Manager", "Using %s for reading asset files.", m_fileReader->GetBackendName());
     }
 
     AssetManager::~AssetManager()
     {
+        // Finish all loads in flight before destroying the assets.
+        // Reads still pending are cancelled and their loads finish in the worker threads.
+        m_fileReader.reset();
+        m_threadPool.reset();
+
 #ifndef NDEBUG
-        int leakedAssets = std::reduce(m_assets.begin(), m_assets.end(), 0,
-            [](int accumulator, const auto& asset)
-            {
-                return accumulator + (asset.second.use_count() > 1) ? 1 : 0;
-            });
+        int leakedAssets = 0;
+        for (const auto& assetShard : m_assetShards)
+        {
+            leakedAssets += static_cast<int>(std::ranges::count_if(assetShard.m_assets,
+                [](const auto& asset)
+                {
+                    return asset.second.m_asset.use_count() > 1;
+                }));
+        }
         if (leakedAssets > 0)
         {
             DX_LOG(Warning, "Device", "There are %d assets still referenced at the time of destroying asset manager.", leakedAssets);
         }
 #endif
 
-        m_assets.clear();
+        if (const size_t deduplicatedMemory = GetDeduplicatedMemory();
+            deduplicatedMemory > 0)
+        {
+            DX_LOG(Info, "Asset Manager", "Sharing data between assets with identical content saved %zu bytes.", deduplicatedMemory);
+        }
+
+        m_loadedCallbacks.clear();
+        m_contentData.clear();
+        for (auto& assetShard : m_assetShards)
+        {
+            assetShard.m_assets.clear();
+        }
 
         DX_LOG(Info, "Asset Manager", "Terminating Asset Manager...");
     }
 
     void AssetManager::AddAsset(std::shared_ptr<AssetBase> asset)
     {
-        m_assets.emplace(asset->GetAssetId(), asset);
+        AssetShard& assetShard = GetAssetShard(asset->GetAssetId());
+
+        std::unique_lock lock(assetShard.m_mutex);
+        InsertAsset(assetShard, std::move(asset));
     }
 
     void AssetManager::RemoveAsset(AssetId assetId)
     {
+        AssetShard& assetShard = GetAssetShard(assetId);
+
+        std::unique_lock lock(assetShard.m_mutex);
         // If there are no other references to the asset it'll be destroyed when removed from map.
-        m_assets.erase(assetId);
+        if (auto it = assetShard.m_assets.find(assetId);
+            it != assetShard.m_assets.end())
+        {
+            EraseAsset(assetShard, it);
+        }
     }
 
     std::shared_ptr<AssetBase> AssetManager::GetAsset(AssetId assetId)
     {
-        if (auto it = m_assets.find(assetId);
-            it != m_assets.end())
+        AssetShard& assetShard = GetAssetShard(assetId);
+
+        std::shared_lock lock(assetShard.m_mutex);
+        return FindAsset(assetShard, assetId);
+    }
+
+    void AssetManager::DispatchLoadedCallbacks()
+    {
+        LoadedCallbacks readyCallbacks;
+        {
+            std::lock_guard lock(m_loadedCallbacksMutex);
+
+            auto readyIt = std::partition(m_loadedCallbacks.begin(), m_loadedCallbacks.end(),
+                [](const auto& loadedCallback)
+                {
+                    return loadedCallback.first.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+                });
+
+            readyCallbacks.assign(std::make_move_iterator(readyIt), std::make_move_iterator(m_loadedCallbacks.end()));
+            m_loadedCallbacks.erase(readyIt, m_loadedCallbacks.end());
+        }
+
+        // Callbacks are called without the lock so they can request more assets.
+        for (auto& [future, callback] : readyCallbacks)
+        {
+            callback(future.get());
+        }
+    }
+
+    void AssetManager::Update()
+    {
+        DispatchLoadedCallbacks();
+
+        EvictAssetsOverBudget();
+
+        ++m_frame;
+    }
+
+    bool AssetManager::ReleaseAssetData(AssetId assetId)
+    {
+        AssetShard& assetShard = GetAssetShard(assetId);
+
+        std::unique_lock lock(assetShard.m_mutex);
+        auto it = assetShard.m_assets.find(assetId);
+        if (it == assetShard.m_assets.end())
+        {
+            DX_LOG(Warning, "Asset Manager", "Asset 0x%016llx not found when releasing its data.", static_cast<unsigned long long>(assetId.GetValue()));
+            return false;
+        }
+
+        // Other holders still use the data. New references are only created
+        // with the shard locked, so the count cannot grow meanwhile.
+        if (it->second.m_asset.use_count() > 1)
+        {
+            return false;
+        }
+
+        std::shared_ptr<AssetBase> asset = it->second.m_asset;
+        EraseAsset(assetShard, it);
+        asset->ReleaseData();
+        return true;
+    }
+
+    void AssetManager::SetMemoryBudget(size_t memoryBudgetInBytes)
+    {
+        std::lock_guard lock(m_memoryMutex);
+        m_memoryBudget = memoryBudgetInBytes;
+    }
+
+    size_t AssetManager::GetMemoryBudget() const
+    {
+        std::lock_guard lock(m_memoryMutex);
+        return m_memoryBudget;
+    }
+
+    size_t AssetManager::GetMemoryUsage() const
+    {
+        std::lock_guard lock(m_memoryMutex);
+        return m_memoryUsage;
+    }
+
+    size_t AssetManager::GetMemoryUsage(AssetType assetType) const
+    {
+        std::lock_guard lock(m_memoryMutex);
+        if (auto it = m_memoryUsagePerType.find(assetType);
+            it != m_memoryUsagePerType.end())
         {
             return it->second;
         }
-        return {};
+        return 0;
+    }
+
+    size_t AssetManager::GetDeduplicatedMemory() const
+    {
+        std::lock_guard lock(m_memoryMutex);
+        return m_deduplicatedMemory;
+    }
+
+    std::pair<AssetFuture, std::shared_ptr<AssetManager::AssetPromise>> AssetManager::BeginLoad(AssetId assetId, const std::string& fileName, AssetType assetType)
+    {
+        auto readyFuture = [](std::shared_ptr<AssetBase> asset)
+            {
+                AssetPromise promise;
+                promise.set_value(std::move(asset));
+                return promise.get_future().share();
+            };
+
+        AssetShard& assetShard = GetAssetShard(assetId);
+
+        auto checkAssetType = [&](const std::shared_ptr<AssetBase>& asset)
+            {
+                if (asset->GetAssetType() != assetType)
+                {
+                    DX_LOG(Error, "AssetManager", "An asset of different asset type already exists with Id %s.", fileName.c_str());
+                    return readyFuture(nullptr);
+                }
+                if (!Internal::IsSameFileName(asset->GetFileName(), fileName))
+                {
+                    DX_LOG(Error, "AssetManager", "Asset %s has the same Id as asset %s.", fileName.c_str(), asset->GetFileName().c_str());
+                    return readyFuture(nullptr);
+                }
+                return readyFuture(asset);
+            };
+
+        // Fast path with shared lock for assets already loaded
+        {
+            std::shared_lock lock(assetShard.m_mutex);
+            if (auto asset = FindAsset(assetShard, assetId))
+            {
+                return { checkAssetType(asset), nullptr };
+            }
+        }
+
+        std::unique_lock lock(assetShard.m_mutex);
+
+        // Check again if asset exists, it could have finished loading after the shared lock was released.
+        if (auto asset = FindAsset(assetShard, assetId))
+        {
+            return { checkAssetType(asset), nullptr };
+        }
+
+        // Check if asset is already being loaded
+        if (auto it = assetShard.m_loadingAssets.find(assetId);
+            it != assetShard.m_loadingAssets.end())
+        {
+            if (it->second.m_assetType != assetType)
+            {
+                DX_LOG(Error, "AssetManager", "An asset of different asset type is already loading with Id %s.", fileName.c_str());
+                return { readyFuture(nullptr), nullptr };
+            }
+            return { it->second.m_future, nullptr };
+        }
+
+        auto promise = std::make_shared<AssetPromise>();
+        AssetFuture future = promise->get_future().share();
+        assetShard.m_loadingAssets.emplace(assetId, LoadingAsset{ future, assetType });
+        return { future, promise };
+    }
+
+    void AssetManager::EndLoad(AssetId assetId, std::shared_ptr<AssetBase> asset, AssetPromise& promise)
+    {
+        AssetShard& assetShard = GetAssetShard(assetId);
+        {
+            std::unique_lock lock(assetShard.m_mutex);
+            if (asset)
+            {
+                InsertAsset(assetShard, asset);
+            }
+            assetShard.m_loadingAssets.erase(assetId);
+        }
+
+        promise.set_value(std::move(asset));
+    }
+
+    AssetManager::AssetShard& AssetManager::GetAssetShard(AssetId assetId)
+    {
+        return m_assetShards[std::hash<AssetId>{}(assetId) % AssetShardCount];
+    }
+
+    std::shared_ptr<AssetBase> AssetManager::FindAsset(AssetShard& assetShard, AssetId assetId)
+    {
+        auto it = assetShard.m_assets.find(assetId);
+        if (it == assetShard.m_assets.end())
+        {
+            return nullptr;
+        }
+
+        // Only write the frame when it changes, so threads looking up
+        // the same asset within a frame do not contend on its cache line.
+        const uint64_t frame = m_frame.load(std::memory_order_relaxed);
+        if (it->second.m_lastUsedFrame.load(std::memory_order_relaxed) != frame)
+        {
+            it->second.m_lastUsedFrame.store(frame, std::memory_order_relaxed);
+        }
+
+        return it->second.m_asset;
+    }
+
+    void AssetManager::InsertAsset(AssetShard& assetShard, std::shared_ptr<AssetBase> asset)
+    {
+        const AssetId assetId = asset->GetAssetId();
+        const size_t dataSizeInBytes = asset->GetDataSizeInBytes();
+
+        auto [it, inserted] = assetShard.m_assets.try_emplace(assetId, std::move(asset), dataSizeInBytes, m_frame.load(std::memory_order_relaxed));
+        if (!inserted)
+        {
+            return;
+        }
+
+        std::lock_guard lock(m_memoryMutex);
+
+        // Shared data is only accounted for the first of its assets.
+        if (const uint64_t contentHash = it->second.m_asset->m_contentHash;
+            contentHash != 0 && m_contentAssetCounts[contentHash]++ > 0)
+        {
+            m_deduplicatedMemory += dataSizeInBytes;
+            return;
+        }
+
+        m_memoryUsagePerType[it->second.m_asset->GetAssetType()] += dataSizeInBytes;
+        m_memoryUsage += dataSizeInBytes;
+    }
+
+    size_t AssetManager::EraseAsset(AssetShard& assetShard, Assets::iterator assetIt)
+    {
+        const AssetBase& asset = *assetIt->second.m_asset;
+        const size_t dataSizeInBytes = assetIt->second.m_dataSizeInBytes;
+        size_t freedMemory = dataSizeInBytes;
+
+        {
+            std::lock_guard lock(m_memoryMutex);
+
+            // Shared data stops being accounted with the last of its assets.
+            const uint64_t contentHash = asset.m_contentHash;
+            if (contentHash != 0 && --m_contentAssetCounts[contentHash] > 0)
+            {
+                m_deduplicatedMemory -= dataSizeInBytes;
+                freedMemory = 0;
+            }
+            else
+            {
+                m_contentAssetCounts.erase(contentHash);
+                m_memoryUsagePerType[asset.GetAssetType()] -= dataSizeInBytes;
+                m_memoryUsage -= dataSizeInBytes;
+            }
+        }
+
+        assetShard.m_assets.erase(assetIt);
+        return freedMemory;
+    }
+
+    void AssetManager::EvictAssetsOverBudget()
+    {
+        size_t memoryToFree = 0;
+        {
+            std::lock_guard lock(m_memoryMutex);
+            if (m_memoryUsage <= m_memoryBudget)
+            {
+                return;
+            }
+            memoryToFree = m_memoryUsage - m_memoryBudget;
+        }
+
+        struct EvictionCandidate
+        {
+            AssetShard* m_assetShard;
+            AssetId m_assetId;
+            uint64_t m_lastUsedFrame;
+        };
+
+        // Assets are only evictable when the manager holds the last reference to them.
+        std::vector<EvictionCandidate> candidates;
+        for (auto& assetShard : m_assetShards)
+        {
+            std::shared_lock lock(assetShard.m_mutex);
+            for (const auto& [assetId, assetEntry] : assetShard.m_assets)
+            {
+                if (assetEntry.m_asset.use_count() == 1)
+                {
+                    candidates.push_back({ &assetShard, assetId, assetEntry.m_lastUsedFrame.load(std::memory_order_relaxed) });
+                }
+            }
+        }
+
+        std::ranges::sort(candidates, {}, &EvictionCandidate::m_lastUsedFrame);
+
+        size_t evictedAssets = 0;
+        size_t evictedMemory = 0;
+        for (const auto& candidate : candidates)
+        {
+            if (evictedMemory >= memoryToFree)
+            {
+                break;
+            }
+
+            std::unique_lock lock(candidate.m_assetShard->m_mutex);
+
+            // Check again, the asset could have been requested after gathering the candidates.
+            if (auto it = candidate.m_assetShard->m_assets.find(candidate.m_assetId);
+                it != candidate.m_assetShard->m_assets.end() && it->second.m_asset.use_count() == 1)
+            {
+                evictedMemory += EraseAsset(*candidate.m_assetShard, it);
+                ++evictedAssets;
+            }
+        }
+
+        if (evictedAssets > 0)
+        {
+            DX_LOG(Verbose, "Asset Manager", "Evicted %zu assets freeing %zu bytes to stay within the memory budget.", evictedAssets, evictedMemory);
+        }
+    }
+
+    std::shared_ptr<void> AssetManager::FindContentData(uint64_t contentHash)
+    {
+        std::lock_guard lock(m_contentDataMutex);
+
+        auto it = m_contentData.find(contentHash);
+        if (it == m_contentData.end())
+        {
+            return nullptr;
+        }
+
+        auto data = it->second.lock();
+        if (!data)
+        {
+            // Data was freed, all assets using it were released or evicted.
+            m_contentData.erase(it);
+        }
+        return data;
+    }
+
+    void AssetManager::AddContentData(uint64_t contentHash, std::shared_ptr<void> data)
+    {
+        std::lock_guard lock(m_contentDataMutex);
+        m_contentData[contentHash] = data;
+    }
+
+    void AssetManager::AddLoadedCallback(AssetFuture future, std::function<void(std::shared_ptr<AssetBase>)> callback)
+    {
+        std::lock_guard lock(m_loadedCallbacksMutex);
+        m_loadedCallbacks.emplace_back(std::move(future), std::move(callback));
     }
 } // namespace DX
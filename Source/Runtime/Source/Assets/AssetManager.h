@@ -2,21 +2,90 @@
 
 #include <Singleton/Singleton.h>
 #include <Assets/Asset.h>
+#include <Assets/CookedAsset.h>
 #include <File/FileUtils.h>
+#include <File/AsyncFileReader.h>
+#include <Hash/Hash.h>
+#include <Thread/ThreadPool.h>
 #include <Log/Log.h>
 
 #include <memory>
 #include <unordered_map>
 #include <functional>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <array>
+#include <atomic>
+#include <optional>
+#include <span>
 
 namespace DX
 {
+    // The file data is the content of the file the asset loads from, the cooked file when
+    // the asset is cooked (see ResolveAssetFileName). It's only valid during the call.
     template<typename T>
-    using LoadDataFunc = std::function<std::unique_ptr<typename T::DataType>(const std::filesystem::path& fileNamePath)>;
-    
+    using LoadDataFunc = std::function<std::unique_ptr<typename T::DataType>(const std::string& fileName, std::span<const uint8_t> fileData)>;
+
+    template<typename T>
+    using AssetLoadedCallback = std::function<void(std::shared_ptr<T> asset)>;
+
+    using AssetFuture = std::shared_future<std::shared_ptr<AssetBase>>;
+
+    // Handle to an asset that might still be loading.
+    // Handles of the same asset share the same load.
+    template<typename T>
+    class AssetHandle
+    {
+    public:
+        AssetHandle() = default;
+        explicit AssetHandle(AssetFuture future)
+            : m_future(std::move(future))
+        {
+        }
+
+        bool IsValid() const
+        {
+            return m_future.valid();
+        }
+
+        bool IsReady() const
+        {
+            return IsValid() && m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+
+        // Blocks until the asset is loaded. Returns null if the asset failed to load.
+        std::shared_ptr<T> Get() const
+        {
+            return IsValid() ? std::static_pointer_cast<T>(m_future.get()) : nullptr;
+        }
+
+    private:
+        AssetFuture m_future;
+    };
+
     // Manager for all assets. It stores all assets in a map and provides methods to get them.
     // Each specific asset type will use AssetManager to load and store assets.
     // Do not use AssetManager directly, use the specific Asset class instead.
+    //
+    // Assets can be loaded synchronously or asynchronously in a pool of worker threads.
+    // An asset is loaded only once, requests for an asset already loading share the same load.
+    //
+    // It's thread safe. Assets are split in shards by the hash of their id, each shard with its
+    // own reader-writer lock, so lookups from different threads rarely contend with each other.
+    //
+    // The CPU memory used by assets is accounted per asset type and kept under a budget.
+    // When the budget is exceeded, assets no longer referenced outside the manager are
+    // evicted, least recently used first.
+    //
+    // Asynchronous loads of files in the assets folder read them with an AsyncFileReader,
+    // which keeps many reads in flight at once, and decode them in the worker threads.
+    // The data read is hashed and passed to the decoder, so the file is read only once.
+    //
+    // Assets loaded from files with identical content share the same data. The content of
+    // the file is hashed when loading and, if the data of an identical file is already in
+    // memory, the new asset uses it instead of loading it again. Shared data is accounted
+    // once, with a count of the assets sharing it, until the last of them is removed.
     class AssetManager : public Singleton<AssetManager>
     {
         friend class Singleton<AssetManager>;
@@ -34,24 +103,139 @@ namespace DX
         std::shared_ptr<T> GetAssetAs(AssetId assetId);
 
         // Loads an asset from a file. The filename is relative to the Assets folder.
+        // If the asset is being loaded asynchronously it waits for it to finish.
         template<typename T>
         std::shared_ptr<T> LoadAssetAs(const std::string& fileName, LoadDataFunc<T> loadDataFunc);
 
+        // Loads an asset from a file in a worker thread. The filename is relative to the Assets folder.
+        // The callback, when provided, is called from the main thread in DispatchLoadedCallbacks.
+        template<typename T>
+        AssetHandle<T> LoadAssetAsync(const std::string& fileName, LoadDataFunc<T> loadDataFunc, AssetLoadedCallback<T> callback = {});
+
+        // Calls the callbacks of the asynchronous loads that have finished.
+        // Call it regularly from the main thread.
+        void DispatchLoadedCallbacks();
+
+        // Calls the callbacks of the loads that have finished and evicts assets
+        // if over the memory budget. Call it once per frame from the main thread.
+        void Update();
+
+        // Frees the CPU data of an asset that is no longer needed, for example after uploading it
+        // to the GPU. The asset is removed from the manager, so loading it again reads the file.
+        // Only released when the manager holds the last reference to the asset, the caller must
+        // drop its own references first. Returns false when the asset is still used elsewhere.
+        bool ReleaseAssetData(AssetId assetId);
+
+        void SetMemoryBudget(size_t memoryBudgetInBytes);
+        size_t GetMemoryBudget() const;
+
+        // CPU memory used by the data of all assets or of the assets of a type.
+        size_t GetMemoryUsage() const;
+        size_t GetMemoryUsage(AssetType assetType) const;
+
+        // CPU memory saved by the assets in the manager sharing the data of assets with identical content.
+        size_t GetDeduplicatedMemory() const;
+
+        // Worker threads loading assets. Loaders can split their work between
+        // them with ParallelFor, also when running on one of the workers.
+        ThreadPool& GetThreadPool() { return *m_threadPool; }
+
+        static constexpr size_t DefaultMemoryBudget = 512 * 1024 * 1024;
+
     private:
-        using Assets = std::unordered_map<AssetId, std::shared_ptr<AssetBase>>;
+        using AssetPromise = std::promise<std::shared_ptr<AssetBase>>;
+
+        // Returns the future of the asset. When the asset is neither loaded nor being loaded
+        // it also returns a promise, meaning the caller is responsible for loading it.
+        std::pair<AssetFuture, std::shared_ptr<AssetPromise>> BeginLoad(AssetId assetId, const std::string& fileName, AssetType assetType);
+        void EndLoad(AssetId assetId, std::shared_ptr<AssetBase> asset, AssetPromise& promise);
+
+        void AddLoadedCallback(AssetFuture future, std::function<void(std::shared_ptr<AssetBase>)> callback);
+
+        // The file is opened when its data is not provided.
+        template<typename T>
+        std::shared_ptr<T> CreateAsset(const std::string& fileName, const LoadDataFunc<T>& loadDataFunc,
+            std::optional<std::span<const uint8_t>> fileData = std::nullopt);
+
+        std::shared_ptr<void> FindContentData(uint64_t contentHash);
+        void AddContentData(uint64_t contentHash, std::shared_ptr<void> data);
+
+        struct AssetEntry
+        {
+            AssetEntry(std::shared_ptr<AssetBase> asset, size_t dataSizeInBytes, uint64_t frame)
+                : m_asset(std::move(asset))
+                , m_dataSizeInBytes(dataSizeInBytes)
+                , m_lastUsedFrame(frame)
+            {
+            }
+
+            std::shared_ptr<AssetBase> m_asset;
+            size_t m_dataSizeInBytes = 0;
+
+            // Atomic so it can be updated by lookups holding the shard's shared lock.
+            std::atomic<uint64_t> m_lastUsedFrame = 0;
+        };
+        using Assets = std::unordered_map<AssetId, AssetEntry>;
+        struct LoadingAsset
+        {
+            AssetFuture m_future;
+            AssetType m_assetType;
+        };
+        using LoadingAssets = std::unordered_map<AssetId, LoadingAsset>;
 
-        Assets m_assets;
+        struct AssetShard
+        {
+            std::shared_mutex m_mutex;
+            Assets m_assets;
+            LoadingAssets m_loadingAssets;
+        };
+
+        static constexpr size_t AssetShardCount = 16;
+
+        AssetShard& GetAssetShard(AssetId assetId);
+
+        // Functions operating on the assets of a shard. The shard must be locked by the caller,
+        // FindAsset with at least a shared lock, InsertAsset and EraseAsset with a unique lock.
+        std::shared_ptr<AssetBase> FindAsset(AssetShard& assetShard, AssetId assetId);
+        void InsertAsset(AssetShard& assetShard, std::shared_ptr<AssetBase> asset);
+        // Returns the memory freed, none when the data is still shared with other assets.
+        size_t EraseAsset(AssetShard& assetShard, Assets::iterator assetIt);
+
+        void EvictAssetsOverBudget();
+
+        std::array<AssetShard, AssetShardCount> m_assetShards;
+
+        // Used as the clock for the least recently used eviction.
+        std::atomic<uint64_t> m_frame = 0;
+
+        mutable std::mutex m_memoryMutex;
+        std::unordered_map<AssetType, size_t> m_memoryUsagePerType;
+        size_t m_memoryUsage = 0;
+        size_t m_memoryBudget = DefaultMemoryBudget;
+
+        // Number of assets in the manager sharing the data of each content hash. Shared
+        // data is accounted once, when the first of its assets is inserted, and stops
+        // being accounted when the last one is erased.
+        std::unordered_map<uint64_t, size_t> m_contentAssetCounts;
+        size_t m_deduplicatedMemory = 0;
+
+        // Weak references to the data of loaded assets by the hash of their file content.
+        std::mutex m_contentDataMutex;
+        std::unordered_map<uint64_t, std::weak_ptr<void>> m_contentData;
+
+        using LoadedCallbacks = std::vector<std::pair<AssetFuture, std::function<void(std::shared_ptr<AssetBase>)>>>;
+
+        std::mutex m_loadedCallbacksMutex;
+        LoadedCallbacks m_loadedCallbacks;
+
+        std::unique_ptr<ThreadPool> m_threadPool;
+        std::unique_ptr<AsyncFileReader> m_fileReader;
     };
 
     template<typename T>
     std::shared_ptr<T> AssetManager::GetAssetAs(AssetId assetId)
     {
-        if (auto it = m_assets.find(assetId);
-            it != m_assets.end())
-        {
-            return std::static_pointer_cast<T>(it->second);
-        }
-        return {};
+        return std::static_pointer_cast<T>(GetAsset(assetId));
     }
 
     template<typename T>
@@ -63,39 +247,112 @@ namespace DX
             return nullptr;
         }
 
-        // Check if asset already exists (by Id)
-        if (auto asset = GetAsset(fileName))
+        const AssetId assetId = MakeAssetId(fileName);
+
+        auto [future, promise] = BeginLoad(assetId, fileName, T::AssetTypeId);
+        if (promise)
         {
-            if (asset->GetAssetType() == T::AssetTypeId)
+            EndLoad(assetId, CreateAsset<T>(fileName, loadDataFunc), *promise);
+        }
+
+        return std::static_pointer_cast<T>(future.get());
+    }
+
+    template<typename T>
+    AssetHandle<T> AssetManager::LoadAssetAsync(const std::string& fileName, LoadDataFunc<T> loadDataFunc, AssetLoadedCallback<T> callback)
+    {
+        if (fileName.empty())
+        {
+            DX_LOG(Error, "AssetManager", "Filename is empty.");
+            return {};
+        }
+
+        const AssetId assetId = MakeAssetId(fileName);
+
+        auto [future, promise] = BeginLoad(assetId, fileName, T::AssetTypeId);
+        if (promise)
+        {
+            // Assets cooked by AssetCooker load from their cooked file.
+            const std::string loadFileName = ResolveAssetFileName(fileName);
+            if (IsAssetFilePacked(loadFileName))
             {
-                return std::static_pointer_cast<T>(asset);
+                m_threadPool->Submit([this, assetId, fileName, loadDataFunc = std::move(loadDataFunc), promise = promise]()
+                    {
+                        EndLoad(assetId, CreateAsset<T>(fileName, loadDataFunc), *promise);
+                    });
             }
             else
             {
-                DX_LOG(Error, "AssetManager", "An asset of different asset type already exists with Id %s.", fileName.c_str());
+                FileReadRequest readRequest;
+                readRequest.m_filePath = GetAssetPath() / loadFileName;
+                readRequest.m_callback = [this, assetId, fileName, loadDataFunc = std::move(loadDataFunc), promise = promise](FileReadResult result)
+                    {
+                        // Called from the I/O thread, hash and decode in a worker thread.
+                        m_threadPool->Submit([this, assetId, fileName, loadDataFunc, promise, result = std::move(result)]()
+                            {
+                                std::optional<std::span<const uint8_t>> fileData;
+                                if (result.m_status == FileReadStatus::Success)
+                                {
+                                    fileData = result.m_data;
+                                }
+                                EndLoad(assetId, CreateAsset<T>(fileName, loadDataFunc, fileData), *promise);
+                            });
+                    };
+                m_fileReader->Read(std::move(readRequest));
+            }
+        }
+
+        if (callback)
+        {
+            AddLoadedCallback(future, [callback = std::move(callback)](std::shared_ptr<AssetBase> asset)
+                {
+                    callback(std::static_pointer_cast<T>(asset));
+                });
+        }
+
+        return AssetHandle<T>(future);
+    }
+
+    template<typename T>
+    std::shared_ptr<T> AssetManager::CreateAsset(const std::string& fileName, const LoadDataFunc<T>& loadDataFunc,
+        std::optional<std::span<const uint8_t>> fileData)
+    {
+        // Open the file, either cooked or its source file, when it hasn't been read already.
+        std::optional<AssetFile> file;
+        if (!fileData)
+        {
+            const std::string loadFileName = ResolveAssetFileName(fileName);
+            file = OpenAssetFile(loadFileName, FileAccessPattern::Sequential);
+            if (!file)
+            {
+                DX_LOG(Error, "AssetManager", "Filename %s does not exist.", fileName.c_str());
                 return nullptr;
             }
+            fileData = file->GetData();
         }
 
-        // Check if filename exists
-        auto fileNamePath = GetAssetPath() / fileName;
-        if (!std::filesystem::exists(fileNamePath))
+        // Share the data with an asset loaded from a file with identical content.
+        // The hash is seeded with the asset type so only assets of the same type share data.
+        const uint64_t contentHash = Hash64(fileData->data(), fileData->size(), T::AssetTypeId);
+        if (auto contentData = std::static_pointer_cast<typename T::DataType>(FindContentData(contentHash)))
         {
-            DX_LOG(Error, "AssetManager", "Filename path %s does not exist.", fileNamePath.generic_string().c_str());
-            return nullptr;
+            auto asset = std::shared_ptr<T>(new T(fileName, std::move(contentData)));
+            asset->m_contentHash = contentHash;
+            DX_LOG(Verbose, "Asset Manager", "Asset %s shares data with an asset of identical content.", fileName.c_str());
+            return asset;
         }
 
-        auto data = loadDataFunc(fileNamePath);
+        std::shared_ptr<typename T::DataType> data = loadDataFunc(fileName, *fileData);
         if (!data)
         {
-            DX_LOG(Error, "AssetManager", "Failed to load asset %s.", fileNamePath.generic_string().c_str());
+            DX_LOG(Error, "AssetManager", "Failed to load asset %s.", fileName.c_str());
             return nullptr;
         }
 
-        std::shared_ptr<T> newAsset(new T(fileName, std::move(data)));
-
-        DX::AssetManager::Get().AddAsset(newAsset);
+        AddContentData(contentHash, data);
 
-        return newAsset;
+        auto asset = std::shared_ptr<T>(new T(fileName, std::move(data)));
+        asset->m_contentHash = contentHash;
+        return asset;
     }
 } // namespace DX
@@ -0,0 +1,294 @@
+#include <Assets/CookedAsset.h>
+#include <Assets/MeshAsset.h>
+#include <Assets/TextureAsset.h>
+#include <Renderer/TextureStreamer.h>
+#include <File/FileUtils.h>
+#include <Log/Log.h>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace DX
+{
+    namespace Internal
+    {
+        template<typename T>
+        static void WriteValue(std::vector<uint8_t>& cookedData, const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const size_t offset = cookedData.size();
+            cookedData.resize(offset + sizeof(T));
+            std::memcpy(cookedData.data() + offset, &value, sizeof(T));
+        }
+
+        template<typename T>
+        static void WriteArray(std::vector<uint8_t>& cookedData, const std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            WriteValue(cookedData, static_cast<uint64_t>(values.size()));
+            const size_t offset = cookedData.size();
+            cookedData.resize(offset + values.size() * sizeof(T));
+            std::memcpy(cookedData.data() + offset, values.data(), values.size() * sizeof(T));
+        }
+
+        // Reads from the front of the data, advancing it. Returns false when there is not enough data.
+        template<typename T>
+        static bool ReadValue(std::span<const uint8_t>& cookedData, T& value)
+        {
+            if (cookedData.size() < sizeof(T))
+            {
+                return false;
+            }
+            std::memcpy(&value, cookedData.data(), sizeof(T));
+            cookedData = cookedData.subspan(sizeof(T));
+            return true;
+        }
+
+        template<typename T>
+        static bool ReadArray(std::span<const uint8_t>& cookedData, std::vector<T>& values)
+        {
+            uint64_t count = 0;
+            if (!ReadValue(cookedData, count) ||
+                count > cookedData.size() / sizeof(T))
+            {
+                return false;
+            }
+            values.resize(static_cast<size_t>(count));
+            std::memcpy(values.data(), cookedData.data(), values.size() * sizeof(T));
+            cookedData = cookedData.subspan(values.size() * sizeof(T));
+            return true;
+        }
+
+        static std::vector<uint8_t> BeginCookedData(AssetType assetType)
+        {
+            CookedAssetHeader header;
+            header.m_assetType = assetType;
+
+            std::vector<uint8_t> cookedData;
+            WriteValue(cookedData, header);
+            return cookedData;
+        }
+
+        static bool ReadCookedHeader(std::span<const uint8_t>& cookedData, AssetType assetType)
+        {
+            CookedAssetHeader header;
+            if (!ReadValue(cookedData, header) ||
+                header.m_magic != CookedAssetHeader::Magic)
+            {
+                DX_LOG(Error, "CookedAsset", "Invalid cooked asset.");
+                return false;
+            }
+            if (header.m_version != CookedAssetVersion ||
+                header.m_assetType != assetType)
+            {
+                DX_LOG(Error, "CookedAsset", "Cooked asset has version %u and type 0x%08X, expected version %u and type 0x%08X. Cook the assets again.",
+                    header.m_version, header.m_assetType, CookedAssetVersion, assetType);
+                return false;
+            }
+            return true;
+        }
+
+        // Number of bytes per texel of cooked textures (R8G8B8A8_UNORM).
+        static constexpr uint64_t TextureTexelSize = 4;
+
+        // Layout of a cooked texture. The mip data is not read, only located.
+        struct CookedTextureLayout
+        {
+            Math::Vector2Int m_size;
+            std::vector<uint64_t> m_mipOffsets;
+            std::span<const uint8_t> m_data;
+        };
+
+        static std::optional<CookedTextureLayout> ReadCookedTextureLayout(std::span<const uint8_t> cookedData)
+        {
+            if (!ReadCookedHeader(cookedData, TextureAsset::AssetTypeId))
+            {
+                return std::nullopt;
+            }
+
+            CookedTextureLayout layout;
+            uint64_t dataSize = 0;
+            if (!ReadValue(cookedData, layout.m_size) ||
+                !ReadArray(cookedData, layout.m_mipOffsets) ||
+                !ReadValue(cookedData, dataSize) ||
+                dataSize > cookedData.size())
+            {
+                DX_LOG(Error, "CookedAsset", "Cooked texture is truncated.");
+                return std::nullopt;
+            }
+            layout.m_data = cookedData.first(static_cast<size_t>(dataSize));
+
+            // Mips are contiguous from the biggest, each with the size of its dimensions,
+            // so a corrupt file can't make uploads read outside the data.
+            const size_t mipCount = layout.m_mipOffsets.size();
+            if (layout.m_size.x <= 0 || layout.m_size.y <= 0 ||
+                mipCount == 0 || mipCount > 32)
+            {
+                DX_LOG(Error, "CookedAsset", "Cooked texture has invalid size %dx%d with %zu mips.",
+                    layout.m_size.x, layout.m_size.y, mipCount);
+                return std::nullopt;
+            }
+
+            uint64_t mipOffset = 0;
+            for (uint32_t mip = 0; mip < mipCount; ++mip)
+            {
+                const uint64_t mipSizeInBytes = TextureTexelSize *
+                    static_cast<uint64_t>(std::max(1, layout.m_size.x >> mip)) *
+                    static_cast<uint64_t>(std::max(1, layout.m_size.y >> mip));
+                if (layout.m_mipOffsets[mip] != mipOffset ||
+                    mipSizeInBytes > layout.m_data.size() - mipOffset)
+                {
+                    DX_LOG(Error, "CookedAsset", "Cooked texture has invalid mip %u.", mip);
+                    return std::nullopt;
+                }
+                mipOffset += mipSizeInBytes;
+            }
+
+            if (mipOffset != layout.m_data.size())
+            {
+                DX_LOG(Error, "CookedAsset", "Cooked texture has %zu bytes, its mips have %zu.",
+                    layout.m_data.size(), static_cast<size_t>(mipOffset));
+                return std::nullopt;
+            }
+
+            return layout;
+        }
+    } // namespace Internal
+
+    std::string GetCookedAssetFileName(const std::string& fileName)
+    {
+        return fileName + ".cooked";
+    }
+
+    std::string ResolveAssetFileName(const std::string& fileName)
+    {
+        std::string cookedFileName = GetCookedAssetFileName(fileName);
+        return AssetFileExists(cookedFileName) ? cookedFileName : fileName;
+    }
+
+    std::vector<uint8_t> SerializeMeshData(const MeshData& meshData)
+    {
+        std::vector<uint8_t> cookedData = Internal::BeginCookedData(MeshAsset::AssetTypeId);
+
+        Internal::WriteArray(cookedData, meshData.m_positions);
+        Internal::WriteArray(cookedData, meshData.m_textCoords);
+        Internal::WriteArray(cookedData, meshData.m_normals);
+        Internal::WriteArray(cookedData, meshData.m_tangents);
+        Internal::WriteArray(cookedData, meshData.m_binormals);
+        Internal::WriteArray(cookedData, meshData.m_indices);
+        Internal::WriteArray(cookedData, meshData.m_subMeshes);
+
+        return cookedData;
+    }
+
+    std::unique_ptr<MeshData> DeserializeMeshData(std::span<const uint8_t> cookedData)
+    {
+        if (!Internal::ReadCookedHeader(cookedData, MeshAsset::AssetTypeId))
+        {
+            return nullptr;
+        }
+
+        auto meshData = std::make_unique<MeshData>();
+        if (!Internal::ReadArray(cookedData, meshData->m_positions) ||
+            !Internal::ReadArray(cookedData, meshData->m_textCoords) ||
+            !Internal::ReadArray(cookedData, meshData->m_normals) ||
+            !Internal::ReadArray(cookedData, meshData->m_tangents) ||
+            !Internal::ReadArray(cookedData, meshData->m_binormals) ||
+            !Internal::ReadArray(cookedData, meshData->m_indices) ||
+            !Internal::ReadArray(cookedData, meshData->m_subMeshes))
+        {
+            DX_LOG(Error, "CookedAsset", "Cooked mesh is truncated.");
+            return nullptr;
+        }
+
+        // Vertex streams are interleaved when creating the vertex buffer, they all have one element per vertex.
+        const size_t vertexCount = meshData->m_positions.size();
+        if (meshData->m_textCoords.size() != vertexCount ||
+            meshData->m_normals.size() != vertexCount ||
+            meshData->m_tangents.size() != vertexCount ||
+            meshData->m_binormals.size() != vertexCount)
+        {
+            DX_LOG(Error, "CookedAsset", "Cooked mesh has vertex streams of different lengths.");
+            return nullptr;
+        }
+
+        if (!std::ranges::all_of(meshData->m_indices, [vertexCount](Index index) { return index < vertexCount; }))
+        {
+            DX_LOG(Error, "CookedAsset", "Cooked mesh has indices outside its %zu vertices.", vertexCount);
+            return nullptr;
+        }
+
+        if (!std::ranges::all_of(meshData->m_subMeshes, [&meshData](const SubMesh& subMesh)
+            {
+                return static_cast<uint64_t>(subMesh.m_indexOffset) + subMesh.m_indexCount <= meshData->m_indices.size() &&
+                    static_cast<uint64_t>(subMesh.m_vertexOffset) + subMesh.m_vertexCount <= meshData->m_positions.size();
+            }))
+        {
+            DX_LOG(Error, "CookedAsset", "Cooked mesh has invalid sub-meshes.");
+            return nullptr;
+        }
+
+        return meshData;
+    }
+
+    std::vector<uint8_t> SerializeTextureMipChain(const TextureMipChain& mipChain)
+    {
+        std::vector<uint8_t> cookedData = Internal::BeginCookedData(TextureAsset::AssetTypeId);
+
+        std::vector<uint64_t> mipOffsets(mipChain.m_mipOffsets.begin(), mipChain.m_mipOffsets.end());
+
+        Internal::WriteValue(cookedData, mipChain.m_size);
+        Internal::WriteArray(cookedData, mipOffsets);
+        Internal::WriteArray(cookedData, mipChain.m_data);
+
+        return cookedData;
+    }
+
+    std::optional<CookedTextureInfo> ReadCookedTextureInfo(std::span<const uint8_t> cookedData)
+    {
+        const auto layout = Internal::ReadCookedTextureLayout(cookedData);
+        if (!layout)
+        {
+            return std::nullopt;
+        }
+
+        CookedTextureInfo info;
+        info.m_size = layout->m_size;
+        info.m_mipCount = static_cast<uint32_t>(layout->m_mipOffsets.size());
+        return info;
+    }
+
+    std::shared_ptr<TextureMipChain> DeserializeTextureMipChain(std::span<const uint8_t> cookedData, uint32_t firstMip, uint32_t mipCount)
+    {
+        const auto layout = Internal::ReadCookedTextureLayout(cookedData);
+        if (!layout)
+        {
+            return nullptr;
+        }
+
+        const uint32_t layoutMipCount = static_cast<uint32_t>(layout->m_mipOffsets.size());
+        if (firstMip >= layoutMipCount)
+        {
+            DX_LOG(Error, "CookedAsset", "Cooked texture has %u mips, mip %u requested.", layoutMipCount, firstMip);
+            return nullptr;
+        }
+        mipCount = std::min(mipCount, layoutMipCount - firstMip);
+        const uint32_t endMip = firstMip + mipCount;
+
+        // Mips are stored from the biggest, the range read is contiguous.
+        const uint64_t beginOffset = layout->m_mipOffsets[firstMip];
+        const uint64_t endOffset = (endMip < layoutMipCount) ? layout->m_mipOffsets[endMip] : layout->m_data.size();
+
+        auto mipChain = std::make_shared<TextureMipChain>();
+        mipChain->m_size = Math::Vector2Int(
+            std::max(1, layout->m_size.x >> firstMip),
+            std::max(1, layout->m_size.y >> firstMip));
+        mipChain->m_data.assign(layout->m_data.begin() + beginOffset, layout->m_data.begin() + endOffset);
+        for (uint32_t mip = firstMip; mip < endMip; ++mip)
+        {
+            mipChain->m_mipOffsets.push_back(static_cast<size_t>(layout->m_mipOffsets[mip] - beginOffset));
+        }
+        return mipChain;
+    }
+} // namespace DX
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Assets/Asset.h>
+#include <Math/Vector2.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace DX
+{
+    struct MeshData;
+    struct TextureMipChain;
+
+    // -------------------------------------------------------
+    // Cooked assets are imported offline by AssetCooker and stored in a
+    // binary format ready to use, so loading them doesn't run importers.
+    //
+    // The cooked file of an asset is next to it with the .cooked extension,
+    // for example "Models/Jack/Jack.fbx.cooked". Loaders use the cooked file
+    // when it exists and import the source file otherwise.
+    //
+    // Cooked file layout:
+    //
+    // CookedAssetHeader
+    // Asset data, its layout depends on the asset type
+    // -------------------------------------------------------
+
+    // Version of the cooked formats and of the importers producing them.
+    // Bump it when either changes so AssetCooker cooks all assets again.
+    static constexpr uint32_t CookedAssetVersion = 3;
+
+    struct CookedAssetHeader
+    {
+        static constexpr uint32_t Magic = 0x41435844; // "DXCA"
+
+        uint32_t m_magic = Magic;
+        uint32_t m_version = CookedAssetVersion;
+        AssetType m_assetType = 0;
+        uint32_t m_reserved = 0;
+    };
+
+    // Returns the filename of the cooked file of an asset.
+    std::string GetCookedAssetFileName(const std::string& fileName);
+
+    // Returns the file to load the asset from, the cooked file if it exists or the source file otherwise.
+    std::string ResolveAssetFileName(const std::string& fileName);
+
+    std::vector<uint8_t> SerializeMeshData(const MeshData& meshData);
+    std::unique_ptr<MeshData> DeserializeMeshData(std::span<const uint8_t> cookedData);
+
+    // Size and mip count of a cooked texture.
+    struct CookedTextureInfo
+    {
+        Math::Vector2Int m_size; // Size of mip 0
+        uint32_t m_mipCount = 0;
+    };
+
+    std::vector<uint8_t> SerializeTextureMipChain(const TextureMipChain& mipChain);
+
+    // Reads the size and mip count of a cooked texture without reading its mips.
+    std::optional<CookedTextureInfo> ReadCookedTextureInfo(std::span<const uint8_t> cookedData);
+
+    // Reads mipCount mips starting from firstMip, the mip chain returned starts at firstMip.
+    // Only the bytes of those mips are accessed, so reading from a mapped file only loads
+    // their pages. Returns null when the range is outside the texture's mips.
+    std::shared_ptr<TextureMipChain> DeserializeTextureMipChain(std::span<const uint8_t> cookedData,
+        uint32_t firstMip = 0, uint32_t mipCount = std::numeric_limits<uint32_t>::max());
+} // namespace DX
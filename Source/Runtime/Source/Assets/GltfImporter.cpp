@@ -0,0 +1,618 @@
+#include <Assets/GltfImporter.h>
+#include <Assets/MeshAsset.h>
+
+#include <File/FileUtils.h>
+#include <Json/Json.h>
+#include <Log/Log.h>
+#include <Math/Vector4.h>
+#include <Math/Matrix4x4.h>
+#include <Math/Quaternion.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace DX
+{
+    namespace Internal
+    {
+        // Accessor component types
+        static constexpr int64_t GltfUnsignedByte = 5121;
+        static constexpr int64_t GltfUnsignedShort = 5123;
+        static constexpr int64_t GltfUnsignedInt = 5125;
+        static constexpr int64_t GltfFloat = 5126;
+
+        static constexpr int64_t GltfTrianglesMode = 4;
+
+        static size_t GetGltfComponentSize(int64_t componentType)
+        {
+            switch (componentType)
+            {
+            case 5120: // Byte
+            case GltfUnsignedByte: return 1;
+            case 5122: // Short
+            case GltfUnsignedShort: return 2;
+            case GltfUnsignedInt:
+            case GltfFloat: return 4;
+            default: return 0;
+            }
+        }
+
+        static uint32_t GetGltfComponentCount(std::string_view type)
+        {
+            if (type == "SCALAR") return 1;
+            if (type == "VEC2") return 2;
+            if (type == "VEC3") return 3;
+            if (type == "VEC4") return 4;
+            if (type == "MAT2") return 4;
+            if (type == "MAT3") return 9;
+            if (type == "MAT4") return 16;
+            return 0;
+        }
+
+        // Buffer URIs are relative to the gltf file and can have escaped characters, like %20.
+        static std::string DecodeGltfUri(std::string_view uri)
+        {
+            std::string decodedUri;
+            decodedUri.reserve(uri.size());
+            for (size_t i = 0; i < uri.size(); ++i)
+            {
+                if (uri[i] == '%' && i + 2 < uri.size() && std::isxdigit(static_cast<unsigned char>(uri[i + 1])) && std::isxdigit(static_cast<unsigned char>(uri[i + 2])))
+                {
+                    decodedUri += static_cast<char>(std::stoi(std::string(uri.substr(i + 1, 2)), nullptr, 16));
+                    i += 2;
+                }
+                else
+                {
+                    decodedUri += uri[i];
+                }
+            }
+            return decodedUri;
+        }
+
+        // Elements of an accessor inside a mapped buffer.
+        struct GltfAccessor
+        {
+            const uint8_t* m_data = nullptr;
+            size_t m_count = 0;
+            size_t m_stride = 0;
+            int64_t m_componentType = 0;
+            uint32_t m_componentCount = 0;
+
+            bool IsFloat(uint32_t componentCount) const
+            {
+                return m_componentType == GltfFloat && m_componentCount == componentCount;
+            }
+
+            bool IsTightlyPacked() const
+            {
+                return m_stride == GetGltfComponentSize(m_componentType) * m_componentCount;
+            }
+
+            // Elements are not guaranteed to be aligned in the buffer.
+            template<typename T>
+            T Read(size_t index) const
+            {
+                T value;
+                std::memcpy(&value, m_data + index * m_stride, sizeof(T));
+                return value;
+            }
+        };
+
+        // JSON of a gltf file and the content of its buffers.
+        class GltfDocument
+        {
+        public:
+            bool Load(const std::string& fileName)
+            {
+                const auto file = OpenAssetFile(fileName, FileAccessPattern::Sequential);
+                if (!file)
+                {
+                    DX_LOG(Error, "GltfImporter", "Failed to open gltf file %s.", fileName.c_str());
+                    return false;
+                }
+                m_fileNames.push_back(fileName);
+
+                std::optional<JsonValue> json = ParseJson(file->GetText());
+                if (!json)
+                {
+                    DX_LOG(Error, "GltfImporter", "Failed to parse gltf file %s.", fileName.c_str());
+                    return false;
+                }
+                m_json = std::move(*json);
+
+                if (!m_json["asset"]["version"].GetString().starts_with("2."))
+                {
+                    DX_LOG(Warning, "GltfImporter", "Gltf file %s is not version 2.", fileName.c_str());
+                    return false;
+                }
+
+                // Required extensions are usually compressions, like Draco or meshopt.
+                if (m_json["extensionsRequired"].GetSize() > 0)
+                {
+                    DX_LOG(Warning, "GltfImporter", "Gltf file %s requires extensions not supported.", fileName.c_str());
+                    return false;
+                }
+
+                const std::filesystem::path folder = std::filesystem::path(fileName).parent_path();
+                for (const JsonValue& buffer : m_json["buffers"].GetArray())
+                {
+                    const std::string_view uri = buffer["uri"].GetString();
+                    if (uri.empty() || uri.starts_with("data:"))
+                    {
+                        DX_LOG(Warning, "GltfImporter", "Gltf file %s has embedded buffers, which are not supported.", fileName.c_str());
+                        return false;
+                    }
+
+                    const std::string bufferFileName = (folder / DecodeGltfUri(uri)).lexically_normal().generic_string();
+                    auto bufferFile = OpenAssetFile(bufferFileName, FileAccessPattern::Sequential);
+                    if (!bufferFile)
+                    {
+                        DX_LOG(Error, "GltfImporter", "Failed to open buffer %s of gltf file %s.", bufferFileName.c_str(), fileName.c_str());
+                        return false;
+                    }
+
+                    if (static_cast<int64_t>(bufferFile->GetSize()) < buffer["byteLength"].GetInt())
+                    {
+                        DX_LOG(Error, "GltfImporter", "Buffer %s of gltf file %s is smaller than expected.", bufferFileName.c_str(), fileName.c_str());
+                        return false;
+                    }
+
+                    m_buffers.push_back(std::move(*bufferFile));
+                    m_fileNames.push_back(bufferFileName);
+                }
+
+                return true;
+            }
+
+            const JsonValue& GetJson() const
+            {
+                return m_json;
+            }
+
+            // Filenames of the gltf file and its buffers.
+            const std::vector<std::string>& GetFileNames() const
+            {
+                return m_fileNames;
+            }
+
+            // Returns nullopt if the accessor is not valid or not stored in a buffer view,
+            // which are accessors initialized to zeros or sparse accessors.
+            std::optional<GltfAccessor> GetAccessor(const JsonValue& accessorIndex) const
+            {
+                const JsonValue& accessor = m_json["accessors"][static_cast<size_t>(accessorIndex.GetInt(-1))];
+                if (!accessor.IsObject() || accessor.HasMember("sparse") || !accessor.HasMember("bufferView"))
+                {
+                    return std::nullopt;
+                }
+
+                const JsonValue& bufferView = m_json["bufferViews"][static_cast<size_t>(accessor["bufferView"].GetInt(-1))];
+                const int64_t bufferIndex = bufferView["buffer"].GetInt(-1);
+                if (!bufferView.IsObject() || bufferIndex < 0 || bufferIndex >= static_cast<int64_t>(m_buffers.size()))
+                {
+                    return std::nullopt;
+                }
+
+                GltfAccessor result;
+                result.m_componentType = accessor["componentType"].GetInt();
+                result.m_componentCount = GetGltfComponentCount(accessor["type"].GetString());
+
+                const int64_t elementSize = static_cast<int64_t>(GetGltfComponentSize(result.m_componentType) * result.m_componentCount);
+                const int64_t count = accessor["count"].GetInt(-1);
+                const int64_t stride = bufferView["byteStride"].GetInt(elementSize);
+                const int64_t accessorOffset = accessor["byteOffset"].GetInt(0);
+                const int64_t viewOffset = bufferView["byteOffset"].GetInt(0);
+                const int64_t viewLength = bufferView["byteLength"].GetInt(-1);
+
+                const std::span<const uint8_t> bufferData = m_buffers[bufferIndex].GetData();
+                const int64_t bufferSize = static_cast<int64_t>(bufferData.size());
+
+                // The accessor must be inside its buffer view and the buffer view inside its buffer.
+                // Checked with subtractions and a division, the values come from the file and
+                // adding or multiplying them could overflow.
+                if (elementSize == 0 || count < 0 || stride < elementSize || accessorOffset < 0 || viewOffset < 0 || viewLength < 0 ||
+                    viewOffset > bufferSize || viewLength > bufferSize - viewOffset ||
+                    (count > 0 && (accessorOffset > viewLength - elementSize ||
+                        count - 1 > (viewLength - accessorOffset - elementSize) / stride)))
+                {
+                    return std::nullopt;
+                }
+
+                result.m_data = bufferData.data() + viewOffset + accessorOffset;
+                result.m_count = static_cast<size_t>(count);
+                result.m_stride = static_cast<size_t>(stride);
+                return result;
+            }
+
+        private:
+            JsonValue m_json;
+            std::vector<AssetFile> m_buffers;
+            std::vector<std::string> m_fileNames;
+        };
+
+        // Mirrors the Z axis to convert from glTF right handed coordinates
+        // to left handed, the same way aiProcess_MakeLeftHanded does.
+        static Math::Vector3Packed ToLeftHanded(const Math::Vector3& vector)
+        {
+            Math::Vector3Packed result;
+            result.x = vector.x;
+            result.y = vector.y;
+            result.z = -vector.z;
+            return result;
+        }
+
+        static bool IsIdentity(const Math::Matrix4x4& matrix)
+        {
+            for (int row = 0; row < 4; ++row)
+            {
+                for (int column = 0; column < 4; ++column)
+                {
+                    if (matrix(row, column) != ((row == column) ? 1.0f : 0.0f))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        static Math::Matrix4x4 GetGltfNodeTransform(const JsonValue& node)
+        {
+            // Both glTF and Matrix4x4 store matrices in column major order.
+            if (const JsonValue& matrix = node["matrix"];
+                matrix.IsArray())
+            {
+                float elements[16];
+                for (int i = 0; i < 16; ++i)
+                {
+                    elements[i] = static_cast<float>(matrix[i].GetNumber((i % 5 == 0) ? 1.0 : 0.0));
+                }
+                return Math::Matrix4x4(elements);
+            }
+
+            const JsonValue& translation = node["translation"];
+            const JsonValue& rotation = node["rotation"]; // Quaternion as x, y, z, w
+            const JsonValue& scale = node["scale"];
+
+            return Math::Matrix4x4::Transform(
+                Math::Vector3(
+                    static_cast<float>(translation[0].GetNumber(0.0)),
+                    static_cast<float>(translation[1].GetNumber(0.0)),
+                    static_cast<float>(translation[2].GetNumber(0.0))),
+                Math::Quaternion(
+                    static_cast<float>(rotation[3].GetNumber(1.0)),
+                    static_cast<float>(rotation[0].GetNumber(0.0)),
+                    static_cast<float>(rotation[1].GetNumber(0.0)),
+                    static_cast<float>(rotation[2].GetNumber(0.0))).ToMatrix(),
+                Math::Vector3(
+                    static_cast<float>(scale[0].GetNumber(1.0)),
+                    static_cast<float>(scale[1].GetNumber(1.0)),
+                    static_cast<float>(scale[2].GetNumber(1.0))));
+        }
+
+        // Reads the triangle indices with their winding order flipped, like aiProcess_FlipWindingOrder.
+        template<typename T>
+        static bool ReadGltfIndices(const GltfAccessor& accessor, Index* indices, Index vertexBase, size_t vertexCount)
+        {
+            for (size_t i = 0; i < accessor.m_count; i += 3)
+            {
+                const T index0 = accessor.Read<T>(i + 0);
+                const T index1 = accessor.Read<T>(i + 1);
+                const T index2 = accessor.Read<T>(i + 2);
+                if (std::max({ index0, index1, index2 }) >= vertexCount)
+                {
+                    return false;
+                }
+
+                indices[i + 0] = vertexBase + index2;
+                indices[i + 1] = vertexBase + index1;
+                indices[i + 2] = vertexBase + index0;
+            }
+            return true;
+        }
+
+        // Generates tangents and binormals from the texture coordinates of the triangles,
+        // like aiProcess_CalcTangentSpace, for primitives without tangents.
+        static void GenerateTangents(MeshData& meshData, size_t vertexBase, size_t vertexCount, size_t indexBase, size_t indexCount)
+        {
+            std::vector<Math::Vector3> tangents(vertexCount, Math::Vector3(0.0f));
+            std::vector<Math::Vector3> binormals(vertexCount, Math::Vector3(0.0f));
+
+            for (size_t i = indexBase; i < indexBase + indexCount; i += 3)
+            {
+                const size_t vertex0 = meshData.m_indices[i + 0] - vertexBase;
+                const size_t vertex1 = meshData.m_indices[i + 1] - vertexBase;
+                const size_t vertex2 = meshData.m_indices[i + 2] - vertexBase;
+
+                const Math::Vector3 position0(meshData.m_positions[vertexBase + vertex0]);
+                const Math::Vector3 edge1 = Math::Vector3(meshData.m_positions[vertexBase + vertex1]) - position0;
+                const Math::Vector3 edge2 = Math::Vector3(meshData.m_positions[vertexBase + vertex2]) - position0;
+
+                const Math::Vector2 textCoord0(meshData.m_textCoords[vertexBase + vertex0]);
+                const Math::Vector2 deltaTextCoord1 = Math::Vector2(meshData.m_textCoords[vertexBase + vertex1]) - textCoord0;
+                const Math::Vector2 deltaTextCoord2 = Math::Vector2(meshData.m_textCoords[vertexBase + vertex2]) - textCoord0;
+
+                const float determinant = deltaTextCoord1.x * deltaTextCoord2.y - deltaTextCoord2.x * deltaTextCoord1.y;
+                if (std::abs(determinant) < 1e-12f)
+                {
+                    continue; // Texture coordinates degenerated
+                }
+
+                const float invDeterminant = 1.0f / determinant;
+                const Math::Vector3 tangent = (edge1 * deltaTextCoord2.y - edge2 * deltaTextCoord1.y) * invDeterminant;
+                const Math::Vector3 binormal = (edge2 * deltaTextCoord1.x - edge1 * deltaTextCoord2.x) * invDeterminant;
+
+                for (size_t vertex : { vertex0, vertex1, vertex2 })
+                {
+                    tangents[vertex] += tangent;
+                    binormals[vertex] += binormal;
+                }
+            }
+
+            meshData.m_tangents.resize(vertexBase + vertexCount);
+            meshData.m_binormals.resize(vertexBase + vertexCount);
+            for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+            {
+                const Math::Vector3 normal(meshData.m_normals[vertexBase + vertex]);
+
+                // Make them perpendicular to the normal
+                Math::Vector3 tangent = tangents[vertex] - normal * Math::Dot(normal, tangents[vertex]);
+                Math::Vector3 binormal = binormals[vertex] - normal * Math::Dot(normal, binormals[vertex]);
+                if (tangent.LengthSquared() < 1e-12f || binormal.LengthSquared() < 1e-12f)
+                {
+                    // Any basis perpendicular to the normal
+                    tangent = Math::Cross((std::abs(normal.x) < 0.9f) ? Math::Vector3(1.0f, 0.0f, 0.0f) : Math::Vector3(0.0f, 1.0f, 0.0f), normal);
+                    binormal = Math::Cross(normal, tangent);
+                }
+
+                meshData.m_tangents[vertexBase + vertex] = Math::Vector3Packed(tangent.Normalized());
+                meshData.m_binormals[vertexBase + vertex] = Math::Vector3Packed(binormal.Normalized());
+            }
+        }
+
+        static bool ProcessGltfPrimitive(MeshData& meshData, const GltfDocument& document, const JsonValue& primitive, const Math::Matrix4x4& transform)
+        {
+            if (primitive["mode"].GetInt(GltfTrianglesMode) != GltfTrianglesMode)
+            {
+                DX_LOG(Warning, "GltfImporter", "Primitives other than triangles are not supported.");
+                return false;
+            }
+
+            const JsonValue& attributes = primitive["attributes"];
+            const std::optional<GltfAccessor> positions = document.GetAccessor(attributes["POSITION"]);
+            const std::optional<GltfAccessor> normals = document.GetAccessor(attributes["NORMAL"]);
+            const std::optional<GltfAccessor> textCoords = document.GetAccessor(attributes["TEXCOORD_0"]);
+            const std::optional<GltfAccessor> tangents = document.GetAccessor(attributes["TANGENT"]);
+
+            // Quantized attributes and missing normals are left to assimp.
+            if (!positions || !positions->IsFloat(3) ||
+                !normals || !normals->IsFloat(3) ||
+                !textCoords || !textCoords->IsFloat(2) ||
+                (attributes.HasMember("TANGENT") && (!tangents || !tangents->IsFloat(4))))
+            {
+                DX_LOG(Warning, "GltfImporter", "Primitive with vertex attributes not supported.");
+                return false;
+            }
+
+            const size_t vertexCount = positions->m_count;
+            if (normals->m_count != vertexCount ||
+                textCoords->m_count != vertexCount ||
+                (tangents && tangents->m_count != vertexCount))
+            {
+                DX_LOG(Error, "GltfImporter", "Primitive vertex attributes have different counts.");
+                return false;
+            }
+
+            std::optional<GltfAccessor> indices;
+            if (primitive.HasMember("indices"))
+            {
+                indices = document.GetAccessor(primitive["indices"]);
+                if (!indices || indices->m_componentCount != 1 ||
+                    (indices->m_componentType != GltfUnsignedByte && indices->m_componentType != GltfUnsignedShort && indices->m_componentType != GltfUnsignedInt))
+                {
+                    DX_LOG(Error, "GltfImporter", "Primitive indices are not valid.");
+                    return false;
+                }
+            }
+
+            const size_t indexCount = indices ? indices->m_count : vertexCount;
+            if (indexCount % 3 != 0)
+            {
+                DX_LOG(Error, "GltfImporter", "Primitive index count is not a multiple of 3.");
+                return false;
+            }
+
+            const size_t vertexBase = meshData.m_positions.size();
+            const size_t indexBase = meshData.m_indices.size();
+
+            // Indices
+            meshData.m_indices.resize(indexBase + indexCount);
+            Index* indexData = meshData.m_indices.data() + indexBase;
+            bool validIndices = true;
+            if (!indices)
+            {
+                // Non indexed triangles
+                for (size_t i = 0; i < indexCount; i += 3)
+                {
+                    indexData[i + 0] = static_cast<Index>(vertexBase + i + 2);
+                    indexData[i + 1] = static_cast<Index>(vertexBase + i + 1);
+                    indexData[i + 2] = static_cast<Index>(vertexBase + i + 0);
+                }
+            }
+            else if (indices->m_componentType == GltfUnsignedByte)
+            {
+                validIndices = ReadGltfIndices<uint8_t>(*indices, indexData, static_cast<Index>(vertexBase), vertexCount);
+            }
+            else if (indices->m_componentType == GltfUnsignedShort)
+            {
+                validIndices = ReadGltfIndices<uint16_t>(*indices, indexData, static_cast<Index>(vertexBase), vertexCount);
+            }
+            else
+            {
+                validIndices = ReadGltfIndices<uint32_t>(*indices, indexData, static_cast<Index>(vertexBase), vertexCount);
+            }
+
+            if (!validIndices)
+            {
+                DX_LOG(Error, "GltfImporter", "Primitive indices are out of range.");
+                return false;
+            }
+
+            const bool hasTransform = !IsIdentity(transform);
+            const Math::Matrix3x3 transform3x3 = Math::Matrix4x4::ToRotationMatrix(transform);
+
+            // Positions
+            meshData.m_positions.resize(vertexBase + vertexCount);
+            for (size_t i = 0; i < vertexCount; ++i)
+            {
+                const Math::Vector3 position(positions->Read<Math::Vector3Packed>(i));
+                meshData.m_positions[vertexBase + i] = ToLeftHanded(hasTransform ? transform * position : position);
+            }
+
+            // Texture coordinates are used as they are, copied directly when tightly packed.
+            meshData.m_textCoords.resize(vertexBase + vertexCount);
+            if (textCoords->IsTightlyPacked())
+            {
+                std::memcpy(meshData.m_textCoords.data() + vertexBase, textCoords->m_data, vertexCount * sizeof(Math::Vector2Packed));
+            }
+            else
+            {
+                for (size_t i = 0; i < vertexCount; ++i)
+                {
+                    meshData.m_textCoords[vertexBase + i] = textCoords->Read<Math::Vector2Packed>(i);
+                }
+            }
+
+            // Normals
+            meshData.m_normals.resize(vertexBase + vertexCount);
+            for (size_t i = 0; i < vertexCount; ++i)
+            {
+                const Math::Vector3 normal(normals->Read<Math::Vector3Packed>(i));
+                meshData.m_normals[vertexBase + i] = ToLeftHanded(hasTransform ? transform3x3 * normal : normal);
+            }
+
+            // Tangents
+            if (tangents)
+            {
+                meshData.m_tangents.resize(vertexBase + vertexCount);
+                meshData.m_binormals.resize(vertexBase + vertexCount);
+                for (size_t i = 0; i < vertexCount; ++i)
+                {
+                    // The W component is the handedness of the tangent basis.
+                    const Math::Vector4 tangent(tangents->Read<Math::Vector4Packed>(i));
+                    const Math::Vector3 normal(normals->Read<Math::Vector3Packed>(i));
+                    const Math::Vector3 tangent3(tangent.x, tangent.y, tangent.z);
+                    const Math::Vector3 binormal = Math::Cross(normal, tangent3) * tangent.w;
+
+                    meshData.m_tangents[vertexBase + i] = ToLeftHanded(hasTransform ? transform3x3 * tangent3 : tangent3);
+                    meshData.m_binormals[vertexBase + i] = ToLeftHanded(hasTransform ? transform3x3 * binormal : binormal);
+                }
+            }
+            else
+            {
+                GenerateTangents(meshData, vertexBase, vertexCount, indexBase, indexCount);
+            }
+
+            // Each primitive is a sub-mesh. Primitives without material use the default
+            // material, which assimp adds after the ones in the file.
+            SubMesh& subMesh = meshData.m_subMeshes.emplace_back();
+            subMesh.m_indexOffset = static_cast<uint32_t>(indexBase);
+            subMesh.m_indexCount = static_cast<uint32_t>(indexCount);
+            subMesh.m_vertexOffset = static_cast<uint32_t>(vertexBase);
+            subMesh.m_vertexCount = static_cast<uint32_t>(vertexCount);
+            subMesh.m_materialIndex = static_cast<uint32_t>(primitive["material"].GetInt(static_cast<int64_t>(document.GetJson()["materials"].GetSize())));
+            CalculateSubMeshBounds(subMesh, std::span(meshData.m_positions).subspan(vertexBase, vertexCount));
+
+            return true;
+        }
+
+        static bool ProcessGltfNode(MeshData& meshData, const GltfDocument& document, const JsonValue& nodeIndex, const Math::Matrix4x4& parentTransform, size_t depth)
+        {
+            const JsonValue& json = document.GetJson();
+            const JsonValue& node = json["nodes"][static_cast<size_t>(nodeIndex.GetInt(-1))];
+
+            // A node can't be deeper than the number of nodes, unless there are cycles.
+            if (!node.IsObject() || depth > json["nodes"].GetSize())
+            {
+                DX_LOG(Error, "GltfImporter", "Node hierarchy is not valid.");
+                return false;
+            }
+
+            const Math::Matrix4x4 nodeTransform = parentTransform * GetGltfNodeTransform(node);
+
+            if (node.HasMember("mesh"))
+            {
+                const JsonValue& mesh = json["meshes"][static_cast<size_t>(node["mesh"].GetInt(-1))];
+                if (!mesh.IsObject())
+                {
+                    DX_LOG(Error, "GltfImporter", "Node references a mesh that doesn't exist.");
+                    return false;
+                }
+
+                for (const JsonValue& primitive : mesh["primitives"].GetArray())
+                {
+                    if (!ProcessGltfPrimitive(meshData, document, primitive, nodeTransform))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            for (const JsonValue& childIndex : node["children"].GetArray())
+            {
+                if (!ProcessGltfNode(meshData, document, childIndex, nodeTransform, depth + 1))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    std::unique_ptr<MeshData> ImportGltfMesh(const std::string& fileName, std::vector<std::string>* dependencies)
+    {
+        Internal::GltfDocument document;
+        if (!document.Load(fileName))
+        {
+            return nullptr;
+        }
+
+        const JsonValue& json = document.GetJson();
+        const JsonValue& scene = json["scenes"][static_cast<size_t>(json["scene"].GetInt(0))];
+        if (!scene.IsObject())
+        {
+            DX_LOG(Warning, "GltfImporter", "Gltf file %s has no scene.", fileName.c_str());
+            return nullptr;
+        }
+
+        auto meshData = std::make_unique<MeshData>();
+
+        for (const JsonValue& nodeIndex : scene["nodes"].GetArray())
+        {
+            if (!Internal::ProcessGltfNode(*meshData, document, nodeIndex, Math::Matrix4x4::Identity(), 0))
+            {
+                DX_LOG(Warning, "GltfImporter", "Failed to import gltf file %s.", fileName.c_str());
+                return nullptr;
+            }
+        }
+
+        if (meshData->m_positions.empty())
+        {
+            DX_LOG(Warning, "GltfImporter", "Gltf file %s has no meshes.", fileName.c_str());
+            return nullptr;
+        }
+
+        if (dependencies)
+        {
+            dependencies->insert(dependencies->end(), document.GetFileNames().begin(), document.GetFileNames().end());
+        }
+
+        return meshData;
+    }
+} // namespace DX
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace DX
+{
+    struct MeshData;
+
+    // Imports the meshes of a glTF 2.0 file (.gltf with its buffers in .bin files)
+    // without assimp.
+    //
+    // The JSON is parsed and the buffers are opened as asset files, so their content
+    // is mapped and not copied. The vertex streams are built straight from the
+    // accessors, only touching the data that needs converting: positions, normals
+    // and tangents are transformed by their node and mirrored to left handed
+    // coordinates, and the winding order of the indices is flipped. Texture coordinates
+    // are copied as they are, glTF already has the origin at the top left like DirectX.
+    // Each primitive is a sub-mesh with the material it references.
+    // Tangents are generated when the file doesn't have them. The result is the same
+    // as importing the file with assimp and the flags in MeshAsset::GetImporterFlags.
+    //
+    // Returns nullptr if the file can't be imported or uses features not supported,
+    // like embedded buffers, sparse accessors, quantized attributes, primitives other
+    // than triangles or missing normals. Those files can still be imported with assimp.
+    //
+    // When provided, the filenames of the gltf and buffer files are added to dependencies.
+    std::unique_ptr<MeshData> ImportGltfMesh(const std::string& fileName, std::vector<std::string>* dependencies = nullptr);
+} // namespace DX
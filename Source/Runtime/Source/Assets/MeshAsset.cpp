@@ -1,156 +1,219 @@
 #include <Assets/MeshAsset.h>
 #include <Assets/AssetManager.h>
+#include <Assets/CookedAsset.h>
+#include <Assets/GltfImporter.h>
 #include <Log/Log.h>
 #include <Debug/Debug.h>
 
+#include <File/FileUtils.h>
+#include <File/MappedFile.h>
+#include <Hash/Hash.h>
+
 #include <assimp/Importer.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/IOStream.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define DX_MESH_IMPORT_SSE 1
+#else
+#define DX_MESH_IMPORT_SSE 0
+#endif
+
 namespace DX
 {
     namespace Internal
     {
-        bool ProcessAssimpMesh(MeshData* meshData, const aiMesh* mesh, const aiMatrix4x4& transform)
+        // Assimp stream reading the content of an asset file.
+        class AssetIOStream : public Assimp::IOStream
         {
-            uint32_t vertexBaseCount = static_cast<uint32_t>(meshData->m_positions.size());
-            uint32_t indexBaseCount = static_cast<uint32_t>(meshData->m_indices.size());
-
-            const aiMatrix3x3 transform3x3(transform);
+        public:
+            explicit AssetIOStream(AssetFile file)
+                : m_file(std::move(file))
+            {
+            }
 
-            if (mesh->HasPositions())
+            size_t Read(void* buffer, size_t size, size_t count) override
             {
-                meshData->m_positions.resize(vertexBaseCount + mesh->mNumVertices);
-                std::transform(mesh->mVertices, mesh->mVertices + mesh->mNumVertices,
-                    meshData->m_positions.begin() + vertexBaseCount,
-                    [&transform](const aiVector3D& lhs)
-                    {
-                        const aiVector3D lhsTransformed = transform * lhs;
+                if (size == 0)
+                {
+                    return 0;
+                }
+
+                const size_t readCount = std::min(count, (m_file.GetSize() - m_position) / size);
+                std::memcpy(buffer, m_file.GetData().data() + m_position, readCount * size);
+                m_position += readCount * size;
+                return readCount;
+            }
 
-                        Math::Vector3Packed rhs;
-                        rhs.x = lhsTransformed.x;
-                        rhs.y = lhsTransformed.y;
-                        rhs.z = lhsTransformed.z;
-                        return rhs;
-                    });
+            size_t Write(const void*, size_t, size_t) override
+            {
+                return 0;
+            }
 
-                meshData->m_indices.resize(indexBaseCount + mesh->mNumFaces * 3);
-                for (uint32_t faceIndex = 0; faceIndex < mesh->mNumFaces; ++faceIndex)
+            aiReturn Seek(size_t offset, aiOrigin origin) override
+            {
+                size_t position = 0;
+                switch (origin)
                 {
-                    DX_ASSERT(mesh->mFaces[faceIndex].mNumIndices == 3, "MeshAsset", "Mesh face must have 3 indices");
+                case aiOrigin_SET: position = offset; break;
+                case aiOrigin_CUR: position = m_position + offset; break;
+                case aiOrigin_END: position = m_file.GetSize() - offset; break;
+                default: return aiReturn_FAILURE;
+                }
 
-                    const uint32_t index = indexBaseCount + faceIndex * 3;
-                    meshData->m_indices[index + 0] = vertexBaseCount + mesh->mFaces[faceIndex].mIndices[0];
-                    meshData->m_indices[index + 1] = vertexBaseCount + mesh->mFaces[faceIndex].mIndices[1];
-                    meshData->m_indices[index + 2] = vertexBaseCount + mesh->mFaces[faceIndex].mIndices[2];
+                if (position > m_file.GetSize())
+                {
+                    return aiReturn_FAILURE;
                 }
+                m_position = position;
+                return aiReturn_SUCCESS;
             }
-            else
+
+            size_t Tell() const override
             {
-                DX_LOG(Error, "MeshAsset", "Mesh %s has no positions\n", mesh->mName.C_Str());
-                return false;
+                return m_position;
             }
 
-            // Use first set of texture coordinates
-            if (mesh->HasTextureCoords(0))
-            {
-                meshData->m_textCoords.resize(vertexBaseCount + mesh->mNumVertices);
-                std::transform(mesh->mTextureCoords[0], mesh->mTextureCoords[0] + mesh->mNumVertices,
-                    meshData->m_textCoords.begin() + vertexBaseCount,
-                    [](const aiVector3D& lhs)
-                    {
-                        Math::Vector2Packed rhs;
-                        rhs.x = lhs.x;
-                        rhs.y = lhs.y;
-                        return rhs;
-                    });
-            }
-            else
-            {
-                DX_LOG(Error, "MeshAsset", "Mesh %s has no texture coordinates\n", mesh->mName.C_Str());
-                return false;
+            size_t FileSize() const override
+            {
+                return m_file.GetSize();
             }
 
-            if (mesh->HasNormals())
+            void Flush() override
             {
-                meshData->m_normals.resize(vertexBaseCount + mesh->mNumVertices);
-                std::transform(mesh->mNormals, mesh->mNormals + mesh->mNumVertices,
-                    meshData->m_normals.begin() + vertexBaseCount,
-                    [&transform3x3](const aiVector3D& lhs)
-                    {
-                        const aiVector3D lhsTransformed = transform3x3 * lhs;
+            }
 
-                        Math::Vector3Packed rhs;
-                        rhs.x = lhsTransformed.x;
-                        rhs.y = lhsTransformed.y;
-                        rhs.z = lhsTransformed.z;
-                        return rhs;
-                    });
+        private:
+            AssetFile m_file;
+            size_t m_position = 0;
+        };
+
+        // Assimp file system that opens asset files, from the
+        // mounted pack files or the assets folder.
+        class AssetIOSystem : public Assimp::IOSystem
+        {
+        public:
+            // When provided, the filenames of all the files opened are added to the list.
+            explicit AssetIOSystem(std::vector<std::string>* openedFileNames = nullptr)
+                : m_openedFileNames(openedFileNames)
+            {
             }
-            else
+
+            bool Exists(const char* fileName) const override
             {
-                DX_LOG(Error, "MeshAsset", "Mesh %s has no normals\n", mesh->mName.C_Str());
-                return false;
+                return AssetFileExists(fileName);
             }
 
-            if (mesh->HasTangentsAndBitangents())
+            char getOsSeparator() const override
             {
-                meshData->m_tangents.resize(vertexBaseCount + mesh->mNumVertices);
-                std::transform(mesh->mTangents, mesh->mTangents + mesh->mNumVertices,
-                    meshData->m_tangents.begin() + vertexBaseCount,
-                    [&transform3x3](const aiVector3D& lhs)
-                    {
-                        const aiVector3D lhsTransformed = transform3x3 * lhs;
+                return '/';
+            }
 
-                        Math::Vector3Packed rhs;
-                        rhs.x = lhsTransformed.x;
-                        rhs.y = lhsTransformed.y;
-                        rhs.z = lhsTransformed.z;
-                        return rhs;
-                    });
+            Assimp::IOStream* Open(const char* fileName, const char* mode) override
+            {
+                // Asset files are read only
+                if (std::strchr(mode, 'w') || std::strchr(mode, 'a'))
+                {
+                    return nullptr;
+                }
 
-                meshData->m_binormals.resize(vertexBaseCount + mesh->mNumVertices);
-                std::transform(mesh->mBitangents, mesh->mBitangents + mesh->mNumVertices,
-                    meshData->m_binormals.begin() + vertexBaseCount,
-                    [&transform3x3](const aiVector3D& lhs)
-                    {
-                        const aiVector3D lhsTransformed = transform3x3 * lhs;
+                auto file = OpenAssetFile(fileName, FileAccessPattern::Sequential);
+                if (!file)
+                {
+                    return nullptr;
+                }
 
-                        Math::Vector3Packed rhs;
-                        rhs.x = lhsTransformed.x;
-                        rhs.y = lhsTransformed.y;
-                        rhs.z = lhsTransformed.z;
-                        return rhs;
-                    });
+                if (m_openedFileNames)
+                {
+                    m_openedFileNames->push_back(fileName);
+                }
+                return new AssetIOStream(std::move(*file));
             }
-            else
+
+            void Close(Assimp::IOStream* stream) override
             {
-                DX_LOG(Error, "MeshAsset", "Mesh %s has no tangents and binormals\n", mesh->mName.C_Str());
-                return false;
+                delete stream;
             }
 
-            return true;
-        }
+        private:
+            std::vector<std::string>* m_openedFileNames = nullptr;
+        };
+
+        // Mesh of the scene with the transform of its node and the
+        // ranges of vertices and indices assigned to it in the mesh data.
+        struct AssimpMeshInstance
+        {
+            const aiMesh* m_mesh = nullptr;
+            aiMatrix4x4 m_transform;
+            uint32_t m_vertexOffset = 0;
+            uint32_t m_indexOffset = 0;
+        };
+
+        // Range of vertices or faces of a mesh converted by one task.
+        struct AssimpMeshBatch
+        {
+            uint32_t m_meshInstanceIndex = 0;
+            uint32_t m_begin = 0;
+            uint32_t m_end = 0;
+            bool m_faces = false;
+        };
+
+        static constexpr uint32_t AssimpMeshBatchSize = 16 * 1024;
 
-        bool ProcessAssimpNode(MeshData* meshData, const aiNode* node, const aiScene* scene, const aiMatrix4x4& parentTransform)
+        // First pass: collects the meshes of the node hierarchy, checks they have
+        // the vertex attributes needed and assigns them their ranges.
+        static bool CollectAssimpMeshes(std::vector<AssimpMeshInstance>& meshInstances, uint32_t& vertexCount, uint32_t& indexCount,
+            const aiNode* node, const aiScene* scene, const aiMatrix4x4& parentTransform)
         {
             // Calculate the node's model transformation
             const aiMatrix4x4 nodeModelTransform = parentTransform * node->mTransformation;
 
-            // Process each mesh located at this node
+            // Collect each mesh located at this node
             for (uint32_t i = 0; i < node->mNumMeshes; i++)
             {
-                aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-                if (!ProcessAssimpMesh(meshData, mesh, nodeModelTransform))
+                const aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
+                if (!mesh->HasPositions())
+                {
+                    DX_LOG(Error, "MeshAsset", "Mesh %s has no positions\n", mesh->mName.C_Str());
+                    return false;
+                }
+                // Use first set of texture coordinates
+                if (!mesh->HasTextureCoords(0))
+                {
+                    DX_LOG(Error, "MeshAsset", "Mesh %s has no texture coordinates\n", mesh->mName.C_Str());
+                    return false;
+                }
+                if (!mesh->HasNormals())
                 {
+                    DX_LOG(Error, "MeshAsset", "Mesh %s has no normals\n", mesh->mName.C_Str());
                     return false;
                 }
+                if (!mesh->HasTangentsAndBitangents())
+                {
+                    DX_LOG(Error, "MeshAsset", "Mesh %s has no tangents and binormals\n", mesh->mName.C_Str());
+                    return false;
+                }
+
+                meshInstances.push_back({ mesh, nodeModelTransform, vertexCount, indexCount });
+                vertexCount += mesh->mNumVertices;
+                indexCount += mesh->mNumFaces * 3;
             }
 
-            // Recursively process each child node
+            // Recursively collect each child node
             for (unsigned int i = 0; i < node->mNumChildren; i++)
             {
-                if (!ProcessAssimpNode(meshData, node->mChildren[i], scene, nodeModelTransform))
+                if (!CollectAssimpMeshes(meshInstances, vertexCount, indexCount, node->mChildren[i], scene, nodeModelTransform))
                 {
                     return false;
                 }
@@ -158,10 +221,311 @@ namespace DX
 
             return true;
         }
+
+        // Transforms vectors by the 3x4 part of a matrix, the translation is only added to points.
+        //
+        // With SSE, vectors are processed 4 at a time: the 12 floats of 4 vectors are loaded
+        // in 3 registers, transposed to registers with all the x, y and z components, transformed
+        // with 4 vectors per instruction and transposed back before storing them.
+        static void TransformVectors(const aiVector3D* input, Math::Vector3Packed* output, uint32_t count, const aiMatrix4x4& transform, bool isPoint)
+        {
+            static_assert(sizeof(aiVector3D) == 3 * sizeof(float) && sizeof(Math::Vector3Packed) == 3 * sizeof(float),
+                "Vectors must be 3 packed floats");
+
+            uint32_t i = 0;
+
+#if DX_MESH_IMPORT_SSE
+            const float translationScale = isPoint ? 1.0f : 0.0f;
+            const __m128 a1 = _mm_set1_ps(transform.a1), a2 = _mm_set1_ps(transform.a2), a3 = _mm_set1_ps(transform.a3), a4 = _mm_set1_ps(transform.a4 * translationScale);
+            const __m128 b1 = _mm_set1_ps(transform.b1), b2 = _mm_set1_ps(transform.b2), b3 = _mm_set1_ps(transform.b3), b4 = _mm_set1_ps(transform.b4 * translationScale);
+            const __m128 c1 = _mm_set1_ps(transform.c1), c2 = _mm_set1_ps(transform.c2), c3 = _mm_set1_ps(transform.c3), c4 = _mm_set1_ps(transform.c4 * translationScale);
+
+            for (; i + 4 <= count; i += 4)
+            {
+                // [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3]
+                const float* inputFloats = reinterpret_cast<const float*>(input + i);
+                const __m128 v0 = _mm_loadu_ps(inputFloats + 0);
+                const __m128 v1 = _mm_loadu_ps(inputFloats + 4);
+                const __m128 v2 = _mm_loadu_ps(inputFloats + 8);
+
+                // [x0 x1 x2 x3] [y0 y1 y2 y3] [z0 z1 z2 z3]
+                const __m128 x = _mm_shuffle_ps(_mm_shuffle_ps(v0, v0, _MM_SHUFFLE(3, 3, 0, 0)), _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+                const __m128 y = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+                const __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(v2, v2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+                const __m128 tx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a1, x), _mm_mul_ps(a2, y)), _mm_add_ps(_mm_mul_ps(a3, z), a4));
+                const __m128 ty = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b1, x), _mm_mul_ps(b2, y)), _mm_add_ps(_mm_mul_ps(b3, z), b4));
+                const __m128 tz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c1, x), _mm_mul_ps(c2, y)), _mm_add_ps(_mm_mul_ps(c3, z), c4));
+
+                // Back to [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3]
+                float* outputFloats = reinterpret_cast<float*>(output + i);
+                _mm_storeu_ps(outputFloats + 0, _mm_shuffle_ps(_mm_shuffle_ps(tx, ty, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(tz, tx, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+                _mm_storeu_ps(outputFloats + 4, _mm_shuffle_ps(_mm_shuffle_ps(ty, tz, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(tx, ty, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+                _mm_storeu_ps(outputFloats + 8, _mm_shuffle_ps(_mm_shuffle_ps(tz, tx, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(ty, tz, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+            }
+#endif
+
+            // Remaining vectors
+            const aiMatrix3x3 transform3x3(transform);
+            for (; i < count; ++i)
+            {
+                const aiVector3D transformed = isPoint ? transform * input[i] : transform3x3 * input[i];
+                output[i].x = transformed.x;
+                output[i].y = transformed.y;
+                output[i].z = transformed.z;
+            }
+        }
+
+        // Second pass: converts a range of vertices or faces of a mesh into its range in the mesh data.
+        static void ConvertAssimpMeshBatch(MeshData& meshData, const AssimpMeshInstance& meshInstance, const AssimpMeshBatch& batch)
+        {
+            const aiMesh* mesh = meshInstance.m_mesh;
+            const uint32_t count = batch.m_end - batch.m_begin;
+
+            if (batch.m_faces)
+            {
+                for (uint32_t faceIndex = batch.m_begin; faceIndex < batch.m_end; ++faceIndex)
+                {
+                    DX_ASSERT(mesh->mFaces[faceIndex].mNumIndices == 3, "MeshAsset", "Mesh face must have 3 indices");
+
+                    const uint32_t index = meshInstance.m_indexOffset + faceIndex * 3;
+                    meshData.m_indices[index + 0] = meshInstance.m_vertexOffset + mesh->mFaces[faceIndex].mIndices[0];
+                    meshData.m_indices[index + 1] = meshInstance.m_vertexOffset + mesh->mFaces[faceIndex].mIndices[1];
+                    meshData.m_indices[index + 2] = meshInstance.m_vertexOffset + mesh->mFaces[faceIndex].mIndices[2];
+                }
+                return;
+            }
+
+            const uint32_t vertexIndex = meshInstance.m_vertexOffset + batch.m_begin;
+
+            TransformVectors(mesh->mVertices + batch.m_begin, meshData.m_positions.data() + vertexIndex, count, meshInstance.m_transform, true);
+            TransformVectors(mesh->mNormals + batch.m_begin, meshData.m_normals.data() + vertexIndex, count, meshInstance.m_transform, false);
+            TransformVectors(mesh->mTangents + batch.m_begin, meshData.m_tangents.data() + vertexIndex, count, meshInstance.m_transform, false);
+            TransformVectors(mesh->mBitangents + batch.m_begin, meshData.m_binormals.data() + vertexIndex, count, meshInstance.m_transform, false);
+
+            // Use first set of texture coordinates
+            const aiVector3D* textCoords = mesh->mTextureCoords[0] + batch.m_begin;
+            Math::Vector2Packed* outputTextCoords = meshData.m_textCoords.data() + vertexIndex;
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                outputTextCoords[i].x = textCoords[i].x;
+                outputTextCoords[i].y = textCoords[i].y;
+            }
+        }
+
+        // Converts all the meshes of the scene into the mesh data in two passes. The first one
+        // assigns each mesh its ranges so the mesh data is allocated once, and the second one
+        // converts the meshes in batches in parallel, each writing to its own range.
+        static bool ProcessAssimpScene(MeshData& meshData, const aiScene* scene, ThreadPool& threadPool)
+        {
+            std::vector<AssimpMeshInstance> meshInstances;
+            uint32_t vertexCount = 0;
+            uint32_t indexCount = 0;
+            if (aiMatrix4x4 identityMatrix;
+                !CollectAssimpMeshes(meshInstances, vertexCount, indexCount, scene->mRootNode, scene, identityMatrix))
+            {
+                return false;
+            }
+
+            meshData.m_positions.resize(vertexCount);
+            meshData.m_textCoords.resize(vertexCount);
+            meshData.m_normals.resize(vertexCount);
+            meshData.m_tangents.resize(vertexCount);
+            meshData.m_binormals.resize(vertexCount);
+            meshData.m_indices.resize(indexCount);
+
+            std::vector<AssimpMeshBatch> batches;
+            for (uint32_t meshInstanceIndex = 0; meshInstanceIndex < meshInstances.size(); ++meshInstanceIndex)
+            {
+                const aiMesh* mesh = meshInstances[meshInstanceIndex].m_mesh;
+                for (uint32_t begin = 0; begin < mesh->mNumVertices; begin += AssimpMeshBatchSize)
+                {
+                    batches.push_back({ meshInstanceIndex, begin, std::min(begin + AssimpMeshBatchSize, mesh->mNumVertices), false });
+                }
+                for (uint32_t begin = 0; begin < mesh->mNumFaces; begin += AssimpMeshBatchSize)
+                {
+                    batches.push_back({ meshInstanceIndex, begin, std::min(begin + AssimpMeshBatchSize, mesh->mNumFaces), true });
+                }
+            }
+
+            threadPool.ParallelFor(batches.size(), [&](size_t batchIndex)
+                {
+                    const AssimpMeshBatch& batch = batches[batchIndex];
+                    ConvertAssimpMeshBatch(meshData, meshInstances[batch.m_meshInstanceIndex], batch);
+                });
+
+            // Each mesh instance is a sub-mesh, its bounds are calculated from the transformed positions.
+            meshData.m_subMeshes.resize(meshInstances.size());
+            threadPool.ParallelFor(meshInstances.size(), [&](size_t meshInstanceIndex)
+                {
+                    const AssimpMeshInstance& meshInstance = meshInstances[meshInstanceIndex];
+
+                    SubMesh& subMesh = meshData.m_subMeshes[meshInstanceIndex];
+                    subMesh.m_indexOffset = meshInstance.m_indexOffset;
+                    subMesh.m_indexCount = meshInstance.m_mesh->mNumFaces * 3;
+                    subMesh.m_vertexOffset = meshInstance.m_vertexOffset;
+                    subMesh.m_vertexCount = meshInstance.m_mesh->mNumVertices;
+                    subMesh.m_materialIndex = meshInstance.m_mesh->mMaterialIndex;
+
+                    CalculateSubMeshBounds(subMesh,
+                        std::span(meshData.m_positions).subspan(subMesh.m_vertexOffset, subMesh.m_vertexCount));
+                });
+
+            return true;
+        }
+
+        // -------------------------------------------------------
+        // Import cache
+        //
+        // Meshes imported with assimp are cached on disk, so following launches
+        // load them with a single read instead of importing them again. Cache files
+        // are named by the hash of the source file content seeded with the importer
+        // flags and the format version, and contain:
+        //
+        // MeshImportCacheHeader
+        // Dependencies, for each one: content hash, path length and path
+        // Mesh data in the cooked format
+        // -------------------------------------------------------
+
+        struct MeshImportCacheHeader
+        {
+            static constexpr uint32_t Magic = 0x434D5844; // "DXMC"
+
+            uint32_t m_magic = Magic;
+            uint32_t m_version = CookedAssetVersion;
+            uint32_t m_importerFlags = 0;
+            uint32_t m_dependencyCount = 0;
+            uint64_t m_cacheKey = 0;
+        };
+
+        static std::atomic<uint32_t> MeshImportCacheHits = 0;
+        static std::atomic<uint32_t> MeshImportCacheMisses = 0;
+
+        static uint64_t CalculateMeshImportCacheKey(std::span<const uint8_t> sourceData)
+        {
+            const uint64_t seed = (static_cast<uint64_t>(CookedAssetVersion) << 32) | MeshAsset::GetImporterFlags();
+            return Hash64(sourceData.data(), sourceData.size(), seed);
+        }
+
+        static std::filesystem::path GetMeshImportCacheFilePath(uint64_t cacheKey)
+        {
+            char cacheFileName[32];
+            std::snprintf(cacheFileName, sizeof(cacheFileName), "%016llx.mesh", static_cast<unsigned long long>(cacheKey));
+            return GetExecutablePath() / "ImportCache" / cacheFileName;
+        }
+
+        static std::optional<uint64_t> HashAssetFileContent(const std::string& fileName)
+        {
+            const auto file = OpenAssetFile(fileName, FileAccessPattern::Sequential);
+            if (!file)
+            {
+                return std::nullopt;
+            }
+            return Hash64(file->GetData().data(), file->GetSize());
+        }
+
+        static std::unique_ptr<MeshData> LoadMeshFromImportCache(uint64_t cacheKey)
+        {
+            const std::filesystem::path cacheFilePath = GetMeshImportCacheFilePath(cacheKey);
+            if (!std::filesystem::exists(cacheFilePath))
+            {
+                return nullptr;
+            }
+
+            const MappedFile cacheFile(cacheFilePath, FileAccessPattern::Sequential);
+            if (!cacheFile.IsValid())
+            {
+                return nullptr;
+            }
+
+            std::span<const uint8_t> cacheData = cacheFile.GetData();
+
+            MeshImportCacheHeader header;
+            if (cacheData.size() < sizeof(header))
+            {
+                return nullptr;
+            }
+            std::memcpy(&header, cacheData.data(), sizeof(header));
+            cacheData = cacheData.subspan(sizeof(header));
+
+            if (header.m_magic != MeshImportCacheHeader::Magic ||
+                header.m_version != CookedAssetVersion ||
+                header.m_importerFlags != MeshAsset::GetImporterFlags() ||
+                header.m_cacheKey != cacheKey)
+            {
+                return nullptr;
+            }
+
+            // The cache is stale if any file the importer read has changed, like gltf buffers.
+            for (uint32_t i = 0; i < header.m_dependencyCount; ++i)
+            {
+                uint64_t dependencyHash = 0;
+                uint32_t pathLength = 0;
+                if (cacheData.size() < sizeof(dependencyHash) + sizeof(pathLength))
+                {
+                    return nullptr;
+                }
+                std::memcpy(&dependencyHash, cacheData.data(), sizeof(dependencyHash));
+                std::memcpy(&pathLength, cacheData.data() + sizeof(dependencyHash), sizeof(pathLength));
+                cacheData = cacheData.subspan(sizeof(dependencyHash) + sizeof(pathLength));
+
+                if (cacheData.size() < pathLength)
+                {
+                    return nullptr;
+                }
+                const std::string dependency(reinterpret_cast<const char*>(cacheData.data()), pathLength);
+                cacheData = cacheData.subspan(pathLength);
+
+                if (HashAssetFileContent(dependency) != dependencyHash)
+                {
+                    return nullptr;
+                }
+            }
+
+            return DeserializeMeshData(cacheData);
+        }
+
+        static void SaveMeshToImportCache(const std::string& fileName, uint64_t cacheKey, const std::vector<std::string>& dependencies, const MeshData& meshData)
+        {
+            std::vector<uint8_t> cacheData(sizeof(MeshImportCacheHeader));
+
+            MeshImportCacheHeader header;
+            header.m_importerFlags = MeshAsset::GetImporterFlags();
+            header.m_cacheKey = cacheKey;
+
+            for (const auto& dependency : dependencies)
+            {
+                // The importer also reads the mesh file itself, which is already the cache key.
+                if (std::filesystem::path(dependency).lexically_normal() == std::filesystem::path(fileName).lexically_normal())
+                {
+                    continue;
+                }
+
+                const std::optional<uint64_t> dependencyHash = HashAssetFileContent(dependency);
+                if (!dependencyHash)
+                {
+                    return;
+                }
+
+                const uint32_t pathLength = static_cast<uint32_t>(dependency.size());
+                const size_t offset = cacheData.size();
+                cacheData.resize(offset + sizeof(*dependencyHash) + sizeof(pathLength) + pathLength);
+                std::memcpy(cacheData.data() + offset, &*dependencyHash, sizeof(*dependencyHash));
+                std::memcpy(cacheData.data() + offset + sizeof(*dependencyHash), &pathLength, sizeof(pathLength));
+                std::memcpy(cacheData.data() + offset + sizeof(*dependencyHash) + sizeof(pathLength), dependency.data(), pathLength);
+                ++header.m_dependencyCount;
+            }
+            std::memcpy(cacheData.data(), &header, sizeof(header));
+
+            const std::vector<uint8_t> serializedMeshData = SerializeMeshData(meshData);
+            cacheData.insert(cacheData.end(), serializedMeshData.begin(), serializedMeshData.end());
+
+            WriteFileAtomically(GetMeshImportCacheFilePath(cacheKey), cacheData);
+        }
     }
 
-    MeshAsset::MeshAsset(AssetId assetId, std::unique_ptr<MeshData> data)
-        : Super(assetId, std::move(data))
+    MeshAsset::MeshAsset(const std::string& fileName, std::shared_ptr<MeshData> data)
+        : Super(fileName, std::move(data))
     {
     }
 
@@ -169,47 +533,120 @@ namespace DX
     {
         return DX::AssetManager::Get().LoadAssetAs<MeshAsset>(
             fileName, 
-            std::bind(&MeshAsset::LoadMesh, std::placeholders::_1));
+            std::bind(&MeshAsset::LoadMesh, std::placeholders::_1, std::placeholders::_2));
     }
 
-    std::unique_ptr<MeshData> MeshAsset::LoadMesh(const std::filesystem::path& fileNamePath)
+    AssetHandle<MeshAsset> MeshAsset::LoadMeshAssetAsync(const std::string& fileName, AssetLoadedCallback<MeshAsset> callback)
     {
-        Assimp::Importer importer;
+        return DX::AssetManager::Get().LoadAssetAsync<MeshAsset>(
+            fileName,
+            std::bind(&MeshAsset::LoadMesh, std::placeholders::_1, std::placeholders::_2),
+            std::move(callback));
+    }
 
-        const uint32_t importerFlags = 
+    size_t MeshAsset::GetDataSizeInBytes() const
+    {
+        if (!m_data)
+        {
+            return 0;
+        }
+
+        return m_data->m_positions.size() * sizeof(Math::Vector3Packed) +
+            m_data->m_textCoords.size() * sizeof(Math::Vector2Packed) +
+            m_data->m_normals.size() * sizeof(Math::Vector3Packed) +
+            m_data->m_tangents.size() * sizeof(Math::Vector3Packed) +
+            m_data->m_binormals.size() * sizeof(Math::Vector3Packed) +
+            m_data->m_indices.size() * sizeof(Index) +
+            m_data->m_subMeshes.size() * sizeof(SubMesh);
+    }
+
+    uint32_t MeshAsset::GetImporterFlags()
+    {
+        return
             aiProcess_Triangulate |
             aiProcess_ConvertToLeftHanded |
             aiProcess_GenSmoothNormals |
             aiProcess_CalcTangentSpace |
             aiProcess_JoinIdenticalVertices;
+    }
 
-        const aiScene* scene = importer.ReadFile(fileNamePath.generic_string(), importerFlags);
+    std::unique_ptr<MeshData> MeshAsset::LoadMesh(const std::string& fileName, std::span<const uint8_t> fileData)
+    {
+        // Cooked meshes are ready to use, otherwise import the source file.
+        if (const std::string loadFileName = ResolveAssetFileName(fileName);
+            loadFileName != fileName)
+        {
+            return DeserializeMeshData(fileData);
+        }
+
+        // Meshes imported before are loaded from the import cache.
+        const uint64_t cacheKey = Internal::CalculateMeshImportCacheKey(fileData);
+
+        if (auto meshData = Internal::LoadMeshFromImportCache(cacheKey))
+        {
+            [[maybe_unused]] const uint32_t hits = ++Internal::MeshImportCacheHits;
+            DX_LOG(Info, "MeshAsset", "Import cache hit for %s (%u hits, %u misses).", fileName.c_str(), hits, Internal::MeshImportCacheMisses.load());
+            return meshData;
+        }
+
+        [[maybe_unused]] const uint32_t misses = ++Internal::MeshImportCacheMisses;
+        DX_LOG(Info, "MeshAsset", "Import cache miss for %s (%u hits, %u misses).", fileName.c_str(), Internal::MeshImportCacheHits.load(), misses);
+
+        std::vector<std::string> dependencies;
+        auto meshData = ImportMesh(fileName, &dependencies);
+        if (meshData)
+        {
+            Internal::SaveMeshToImportCache(fileName, cacheKey, dependencies, *meshData);
+        }
+        return meshData;
+    }
+
+    std::unique_ptr<MeshData> MeshAsset::ImportMesh(const std::string& fileName, std::vector<std::string>* dependencies)
+    {
+        if (std::filesystem::path(fileName).extension() == ".gltf")
+        {
+            if (auto meshData = ImportGltfMesh(fileName, dependencies))
+            {
+                return meshData;
+            }
+
+            DX_LOG(Info, "MeshAsset", "Importing %s with assimp instead.", fileName.c_str());
+        }
+
+        return ImportMeshWithAssimp(fileName, dependencies);
+    }
+
+    std::unique_ptr<MeshData> MeshAsset::ImportMeshWithAssimp(const std::string& fileName, std::vector<std::string>* dependencies)
+    {
+        Assimp::Importer importer;
+
+        // Assimp reads the mesh file, and other files it references, through the asset files.
+        importer.SetIOHandler(new Internal::AssetIOSystem(dependencies));
+
+        const aiScene* scene = importer.ReadFile(fileName, GetImporterFlags());
 
         if (!scene || 
             !scene->mRootNode ||
             scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)
         {
             DX_LOG(Error, "MeshAsset", "Assimp failed to import mesh: %s\n\nError message: %s\n", 
-                fileNamePath.generic_string().c_str(), importer.GetErrorString());
+                fileName.c_str(), importer.GetErrorString());
             return nullptr;
         }
 
         if (!scene->HasMeshes())
         {
             DX_LOG(Error, "MeshAsset", "Assimp failed to import mesh: %s\n\nError message: %s\n",
-                fileNamePath.generic_string().c_str(), importer.GetErrorString());
+                fileName.c_str(), importer.GetErrorString());
             return nullptr;
         }
 
         auto meshData = std::make_unique<MeshData>();
 
-        // TODO: Import AABBs and separate sort mesh data in sub-meshes.
-
-        if (aiMatrix4x4 identityMatrix;
-            !Internal::ProcessAssimpNode(meshData.get(), scene->mRootNode, scene, identityMatrix))
+        if (!Internal::ProcessAssimpScene(*meshData, scene, AssetManager::Get().GetThreadPool()))
         {
             DX_LOG(Error, "MeshAsset", "Assimp failed to process mesh: %s",
-                fileNamePath.generic_string().c_str());
+                fileName.c_str());
             return nullptr;
         }
 
@@ -1,16 +1,14 @@
 #pragma once
 
 #include <Assets/Asset.h>
+#include <Assets/AssetManager.h>
 #include <Math/Vector2.h>
 #include <Math/Vector3.h>
 #include <Renderer/Vertices.h>
+#include <Renderer/SubMesh.h>
 
 #include <vector>
-
-namespace std::filesystem
-{
-    class path;
-}
+#include <string>
 
 namespace DX
 {
@@ -23,18 +21,40 @@ namespace DX
         std::vector<Math::Vector3Packed> m_binormals;
 
         std::vector<Index> m_indices;
+
+        // One sub-mesh per mesh of the source file, with its node transform applied.
+        std::vector<SubMesh> m_subMeshes;
     };
 
     // Mesh asset with the list of vertices, indices and other
     // data needed to create a mesh.
     // 
     // Mesh asset formats supported: fbx and gltf
+    // Gltf files are imported natively and other formats with assimp.
+    // Meshes cooked by AssetCooker are loaded from their cooked file instead.
     class MeshAsset : public Asset<MeshData>
     {
     public:
         // Loads a mesh from a file. The filename is relative to the assets folder.
         static std::shared_ptr<MeshAsset> LoadMeshAsset(const std::string& fileName);
 
+        // Loads a mesh from a file in a worker thread. The filename is relative to the assets folder.
+        // The callback, when provided, is called from the main thread once the mesh is loaded.
+        static AssetHandle<MeshAsset> LoadMeshAssetAsync(const std::string& fileName, AssetLoadedCallback<MeshAsset> callback = {});
+
+        // Imports a mesh from its source file, without using the cooked file.
+        // Gltf files are imported with the native glTF importer (see GltfImporter.h)
+        // and other formats, or gltf files it doesn't support, with assimp.
+        // When provided, the files read by the importer are added to dependencies,
+        // including the mesh file and others it references, like gltf buffers.
+        static std::unique_ptr<MeshData> ImportMesh(const std::string& fileName, std::vector<std::string>* dependencies = nullptr);
+
+        // Imports a mesh from its source file with assimp.
+        static std::unique_ptr<MeshData> ImportMeshWithAssimp(const std::string& fileName, std::vector<std::string>* dependencies = nullptr);
+
+        // Assimp post processing flags used to import meshes.
+        static uint32_t GetImporterFlags();
+
         static inline const AssetType AssetTypeId = 0x73E47A71;
 
         AssetType GetAssetType() const override
@@ -42,13 +62,15 @@ namespace DX
             return AssetTypeId;
         }
 
+        size_t GetDataSizeInBytes() const override;
+
     protected:
         friend class AssetManager;
         using Super = Asset<MeshData>;
 
-        MeshAsset(AssetId assetId, std::unique_ptr<MeshData> data);
+        MeshAsset(const std::string& fileName, std::shared_ptr<MeshData> data);
 
     private:
-        static std::unique_ptr<MeshData> LoadMesh(const std::filesystem::path& fileNamePath);
+        static std::unique_ptr<MeshData> LoadMesh(const std::string& fileName, std::span<const uint8_t> fileData);
     };
 } // namespace DX
@@ -1,13 +1,24 @@
 #include <Assets/TextureAsset.h>
 #include <Assets/AssetManager.h>
+#include <Assets/CookedAsset.h>
+#include <Renderer/TextureStreamer.h>
+#include <File/FileUtils.h>
 #include <Log/Log.h>
 
+#include <cstdlib>
+#include <cstring>
+
 #include <stb_image.h>
 
 namespace DX
 {
-    TextureAsset::TextureAsset(AssetId assetId, std::unique_ptr<TextureData> data)
-        : Super(assetId, std::move(data))
+    TextureData::~TextureData()
+    {
+        stbi_image_free(m_data);
+    }
+
+    TextureAsset::TextureAsset(const std::string& fileName, std::shared_ptr<TextureData> data)
+        : Super(fileName, std::move(data))
     {
     }
 
@@ -15,15 +26,53 @@ namespace DX
     {
         return DX::AssetManager::Get().LoadAssetAs<TextureAsset>(
             fileName, 
-            std::bind(&TextureAsset::LoadTexture, std::placeholders::_1));
+            std::bind(&TextureAsset::LoadTexture, std::placeholders::_1, std::placeholders::_2));
     }
 
-    std::unique_ptr<TextureData> TextureAsset::LoadTexture(const std::filesystem::path& fileNamePath)
+    AssetHandle<TextureAsset> TextureAsset::LoadTextureAssetAsync(const std::string& fileName, AssetLoadedCallback<TextureAsset> callback)
     {
+        return DX::AssetManager::Get().LoadAssetAsync<TextureAsset>(
+            fileName,
+            std::bind(&TextureAsset::LoadTexture, std::placeholders::_1, std::placeholders::_2),
+            std::move(callback));
+    }
+
+    size_t TextureAsset::GetDataSizeInBytes() const
+    {
+        return (m_data && m_data->m_data)
+            ? static_cast<size_t>(m_data->m_size.x) * m_data->m_size.y * STBI_rgb_alpha
+            : 0;
+    }
+
+    std::unique_ptr<TextureData> TextureAsset::LoadTexture(const std::string& fileName, std::span<const uint8_t> fileData)
+    {
+        // Cooked textures are already decoded, only their first mip is read.
+        if (const std::string loadFileName = ResolveAssetFileName(fileName);
+            loadFileName != fileName)
+        {
+            const auto mipChain = DeserializeTextureMipChain(fileData, 0, 1);
+            if (!mipChain)
+            {
+                DX_LOG(Error, "TextureAsset", "Failed to load cooked texture %s.", loadFileName.c_str());
+                return nullptr;
+            }
+
+            // Allocated with malloc as stbi_image_free, used to free the data, calls free.
+            const size_t mipSize = mipChain->m_data.size();
+
+            auto textureData = std::make_unique<TextureData>();
+            textureData->m_size = mipChain->m_size;
+            textureData->m_data = static_cast<uint8_t*>(std::malloc(mipSize));
+            std::memcpy(textureData->m_data, mipChain->m_data.data(), mipSize);
+            return textureData;
+        }
+
+        // Decode directly from the file content, without copying it into another buffer first.
         auto textureData = std::make_unique<TextureData>();
 
-        textureData->m_data = stbi_load(
-            fileNamePath.generic_string().c_str(),
+        textureData->m_data = stbi_load_from_memory(
+            fileData.data(),
+            static_cast<int>(fileData.size()),
             &textureData->m_size.x,
             &textureData->m_size.y,
             nullptr,
@@ -31,7 +80,7 @@ namespace DX
 
         if (!textureData->m_data)
         {
-            DX_LOG(Error, "TextureAsset", "Failed to load texture %s.", fileNamePath.generic_string().c_str());
+            DX_LOG(Error, "TextureAsset", "Failed to load texture %s.", fileName.c_str());
             return nullptr;
         }
 
@@ -1,19 +1,21 @@
 #pragma once
 
 #include <Assets/Asset.h>
+#include <Assets/AssetManager.h>
 #include <Math/Vector2.h>
 
-namespace std::filesystem
-{
-    class path;
-}
-
 namespace DX
 {
     struct TextureData
     {
+        TextureData() = default;
+        ~TextureData();
+
+        TextureData(const TextureData&) = delete;
+        TextureData& operator=(const TextureData&) = delete;
+
         Math::Vector2Int m_size;
-        uint8_t* m_data;
+        uint8_t* m_data = nullptr; // RGBA 8 bits per channel, owned and freed by TextureData.
     };
 
     // Texture formats supported: jpeg, png, bmp, psd, tga, gif, hdr, pic, and pnm
@@ -23,6 +25,10 @@ namespace DX
         // Loads a texture from a file. The filename is relative to the assets folder.
         static std::shared_ptr<TextureAsset> LoadTextureAsset(const std::string& fileName);
 
+        // Loads a texture from a file in a worker thread. The filename is relative to the assets folder.
+        // The callback, when provided, is called from the main thread once the texture is loaded.
+        static AssetHandle<TextureAsset> LoadTextureAssetAsync(const std::string& fileName, AssetLoadedCallback<TextureAsset> callback = {});
+
         static inline const AssetType AssetTypeId = 0xB8FCE1BE;
 
         AssetType GetAssetType() const override
@@ -30,13 +36,15 @@ namespace DX
             return AssetTypeId;
         }
 
+        size_t GetDataSizeInBytes() const override;
+
     protected:
         friend class AssetManager;
         using Super = Asset<TextureData>;
 
-        TextureAsset(AssetId assetId, std::unique_ptr<TextureData> data);
+        TextureAsset(const std::string& fileName, std::shared_ptr<TextureData> data);
 
     private:
-        static std::unique_ptr<TextureData> LoadTexture(const std::filesystem::path& fileNamePath);
+        static std::unique_ptr<TextureData> LoadTexture(const std::string& fileName, std::span<const uint8_t> fileData);
     };
 } // namespace DX
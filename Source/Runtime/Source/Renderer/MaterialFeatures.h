@@ -0,0 +1,19 @@
+#pragma once
+
+#include <RHI/Shader/ShaderEnums.h>
+
+namespace DX
+{
+    // Optional parts of an object's material, each one a feature of the scene's
+    // pixel shader (see PixelShader.hlsl). Materials without a texture select a
+    // variant of the shader without its texture fetches and calculations.
+    enum MaterialFeature : ShaderPermutationKey
+    {
+        MaterialFeature_None = 0,
+
+        MaterialFeature_EmissiveMap = 1 << 0,
+        MaterialFeature_NormalMap = 1 << 1,
+
+        MaterialFeature_All = MaterialFeature_EmissiveMap | MaterialFeature_NormalMap
+    };
+} // namespace DX
@@ -1,11 +1,10 @@
 #include <Renderer/Object.h>
 #include <Renderer/RendererManager.h>
-#include <Assets/TextureAsset.h>
+#include <Renderer/TextureStreamer.h>
 #include <Assets/MeshAsset.h>
 
 #include <RHI/Device/Device.h>
 #include <RHI/Resource/Buffer/Buffer.h>
-#include <RHI/Resource/Texture/Texture.h>
 #include <RHI/Resource/Views/ShaderResourceView.h>
 #include <RHI/Sampler/Sampler.h>
 
@@ -14,10 +13,12 @@
 #include <mathfu/constants.h>
 
 #include <algorithm>
+#include <memory>
+#include <numeric>
 
 #include <d3d11.h>
 
-#pragma DX_DISABLE_WARNING(4267, "")
+DX_DISABLE_WARNING(4267, "-Wconversion")
 
 namespace DX
 {
@@ -27,17 +28,32 @@ namespace DX
 
     std::shared_ptr<ShaderResourceView> Object::GetDiffuseTextureView() const
     {
-        return m_diffuseTextureView;
+        return GetTextureStreamer()->GetShaderResourceView(m_diffuseTextureId);
     }
 
     std::shared_ptr<ShaderResourceView> Object::GetEmissiveTextureView() const
     {
-        return m_emissiveTextureView;
+        return GetTextureStreamer()->GetShaderResourceView(m_emissiveTextureId);
     }
 
     std::shared_ptr<ShaderResourceView> Object::GetNormalTextureView() const
     {
-        return m_normalTextureView;
+        return GetTextureStreamer()->GetShaderResourceView(m_normalTextureId);
+    }
+
+    uint32_t Object::GetDiffuseTextureSlice() const
+    {
+        return GetTextureStreamer()->GetArraySlice(m_diffuseTextureId);
+    }
+
+    uint32_t Object::GetEmissiveTextureSlice() const
+    {
+        return GetTextureStreamer()->GetArraySlice(m_emissiveTextureId);
+    }
+
+    uint32_t Object::GetNormalTextureSlice() const
+    {
+        return GetTextureStreamer()->GetArraySlice(m_normalTextureId);
     }
 
     std::shared_ptr<Sampler> Object::GetSampler() const
@@ -45,6 +61,22 @@ namespace DX
         return m_textureSampler;
     }
 
+    ShaderPermutationKey Object::GetMaterialFeatures() const
+    {
+        // Missing textures are constant colors that don't change the result:
+        // black for emissive and a flat normal for the normal map.
+        ShaderPermutationKey materialFeatures = MaterialFeature_None;
+        if (!m_emissiveFilename.empty())
+        {
+            materialFeatures |= MaterialFeature_EmissiveMap;
+        }
+        if (!m_normalFilename.empty())
+        {
+            materialFeatures |= MaterialFeature_NormalMap;
+        }
+        return materialFeatures;
+    }
+
     std::shared_ptr<Buffer> Object::GetVertexBuffer() const
     {
         return m_vertexBuffer;
@@ -55,21 +87,71 @@ namespace DX
         return m_indexBuffer;
     }
 
-    void Object::CreateBuffers()
+    float Object::GetBoundingRadius() const
+    {
+        const float maxScale = std::max({ m_transform.m_scale.x, m_transform.m_scale.y, m_transform.m_scale.z });
+        return m_localBoundingRadius * maxScale;
+    }
+
+    size_t Object::GetCpuGeometryMemoryUsage() const
+    {
+        return m_subMeshes.capacity() * sizeof(SubMesh);
+    }
+
+    TextureStreamer* Object::GetTextureStreamer() const
+    {
+        auto* renderer = RendererManager::Get().GetRenderer();
+        DX_ASSERT(renderer, "Object", "Default renderer not found");
+
+        return renderer->GetTextureStreamer();
+    }
+
+    void Object::RegisterTextures()
+    {
+        TextureStreamer* textureStreamer = GetTextureStreamer();
+        DX_ASSERT(textureStreamer, "Object", "Texture streamer not found");
+
+        // Textures are streamed, until they are loaded a fallback color is used.
+        m_diffuseTextureId = textureStreamer->RegisterTexture(m_diffuseFilename, Math::Colors::White);
+        m_emissiveTextureId = textureStreamer->RegisterTexture(m_emissiveFilename, Math::Colors::Black);
+        m_normalTextureId = textureStreamer->RegisterTexture(m_normalFilename, Math::Color(0.5f, 0.5f, 1.0f, 1.0f)); // Flat normal
+
+        // Shared by all objects, so materials with the same views are bound once.
+        m_textureSampler = textureStreamer->GetSampler();
+    }
+
+    void Object::CreateBuffers(std::span<const VertexPNTBUv> vertexData, std::span<const Index> indexData)
     {
         auto* renderer = RendererManager::Get().GetRenderer();
         DX_ASSERT(renderer, "Object", "Default renderer not found");
 
+        // Bounding radius around the local origin, used to estimate the object size on screen.
+        m_localBoundingRadius = std::transform_reduce(vertexData.begin(), vertexData.end(), 0.0f,
+            [](float lhs, float rhs) { return std::max(lhs, rhs); },
+            [](const VertexPNTBUv& vertex) { return Math::Vector3(vertex.m_position).Length(); });
+
+        if (m_subMeshes.empty())
+        {
+            SubMesh& subMesh = m_subMeshes.emplace_back();
+            subMesh.m_indexCount = static_cast<uint32_t>(indexData.size());
+            subMesh.m_vertexCount = static_cast<uint32_t>(vertexData.size());
+
+            std::vector<Math::Vector3Packed> positions(vertexData.size());
+            std::transform(vertexData.begin(), vertexData.end(), positions.begin(),
+                [](const VertexPNTBUv& vertex) { return vertex.m_position; });
+            CalculateSubMeshBounds(subMesh, positions);
+        }
+
         // Vertex Buffer
         {
             BufferDesc vertexBufferDesc = {};
             vertexBufferDesc.m_elementSizeInBytes = GetVertexSize();
-            vertexBufferDesc.m_elementCount = m_vertexData.size();
+            vertexBufferDesc.m_elementCount = vertexData.size();
             vertexBufferDesc.m_usage = ResourceUsage::Immutable;
             vertexBufferDesc.m_bindFlags = BufferBind_VertexBuffer;
             vertexBufferDesc.m_cpuAccess = ResourceCPUAccess::None;
             vertexBufferDesc.m_bufferSubType = BufferSubType::None;
-            vertexBufferDesc.m_initialData = m_vertexData.data();
+            vertexBufferDesc.m_initialData = vertexData.data();
 
             m_vertexBuffer = renderer->GetDevice()->CreateBuffer(vertexBufferDesc);
         }
@@ -78,144 +160,15 @@ namespace DX
         {
             BufferDesc indexBufferDesc = {};
             indexBufferDesc.m_elementSizeInBytes = GetIndexSize();
-            indexBufferDesc.m_elementCount = m_indexData.size();
+            indexBufferDesc.m_elementCount = indexData.size();
             indexBufferDesc.m_usage = ResourceUsage::Immutable;
             indexBufferDesc.m_bindFlags = BufferBind_IndexBuffer;
             indexBufferDesc.m_cpuAccess = ResourceCPUAccess::None;
             indexBufferDesc.m_bufferSubType = BufferSubType::None;
-            indexBufferDesc.m_initialData = m_indexData.data();
+            indexBufferDesc.m_initialData = indexData.data();
 
             m_indexBuffer = renderer->GetDevice()->CreateBuffer(indexBufferDesc);
-        }
-
-        // Diffuse Texture
-        {
-            auto textureAsset = TextureAsset::LoadTextureAsset(m_diffuseFilename);
-            DX_ASSERT(textureAsset.get(), "Object", "Failed to load texture");
-
-            TextureDesc textureDesc = {};
-            textureDesc.m_textureType = TextureType::Texture2D;
-            textureDesc.m_dimensions = Math::Vector3Int(textureAsset->GetData()->m_size, 0);
-            textureDesc.m_mipCount = 1;
-            textureDesc.m_format = ResourceFormat::R8G8B8A8_UNORM;
-            textureDesc.m_usage = ResourceUsage::Immutable;
-            textureDesc.m_bindFlags = TextureBind_ShaderResource;
-            textureDesc.m_cpuAccess = ResourceCPUAccess::None;
-            textureDesc.m_arrayCount = 1;
-            textureDesc.m_sampleCount = 1;
-            textureDesc.m_sampleQuality = 0;
-            textureDesc.m_initialData = textureAsset->GetData()->m_data;
-
-            m_diffuseTexture = renderer->GetDevice()->CreateTexture(textureDesc);
-
-            ShaderResourceViewDesc srvDesc = {};
-            srvDesc.m_resource = m_diffuseTexture;
-            srvDesc.m_viewFormat = textureDesc.m_format;
-            srvDesc.m_firstMip = 0;
-            srvDesc.m_mipCount = -1;
-
-            m_diffuseTextureView = renderer->GetDevice()->CreateShaderResourceView(srvDesc);
-        }
-
-        // Emissive Texture
-        {
-            const ResourceFormat format = ResourceFormat::R8G8B8A8_UNORM;
-
-            if (m_emissiveFilename.empty())
-            {
-                uint32_t textureData = 0; // 1 texel with all RGBA set to zero
-
-                TextureDesc textureDesc = {};
-                textureDesc.m_textureType = TextureType::Texture2D;
-                textureDesc.m_dimensions = Math::Vector3Int(1, 1, 0); // 1x1 dimensions
-                textureDesc.m_mipCount = 1;
-                textureDesc.m_format = format;
-                textureDesc.m_usage = ResourceUsage::Immutable;
-                textureDesc.m_bindFlags = TextureBind_ShaderResource;
-                textureDesc.m_cpuAccess = ResourceCPUAccess::None;
-                textureDesc.m_arrayCount = 1;
-                textureDesc.m_sampleCount = 1;
-                textureDesc.m_sampleQuality = 0;
-                textureDesc.m_initialData = &textureData;
-
-                m_emissiveTexture = renderer->GetDevice()->CreateTexture(textureDesc);
-            }
-            else
-            {
-                auto textureAsset = TextureAsset::LoadTextureAsset(m_emissiveFilename);
-                DX_ASSERT(textureAsset.get(), "Object", "Failed to load texture");
-
-                TextureDesc textureDesc = {};
-                textureDesc.m_textureType = TextureType::Texture2D;
-                textureDesc.m_dimensions = Math::Vector3Int(textureAsset->GetData()->m_size, 0);
-                textureDesc.m_mipCount = 1;
-                textureDesc.m_format = format;
-                textureDesc.m_usage = ResourceUsage::Immutable;
-                textureDesc.m_bindFlags = TextureBind_ShaderResource;
-                textureDesc.m_cpuAccess = ResourceCPUAccess::None;
-                textureDesc.m_arrayCount = 1;
-                textureDesc.m_sampleCount = 1;
-                textureDesc.m_sampleQuality = 0;
-                textureDesc.m_initialData = textureAsset->GetData()->m_data;
-
-                m_emissiveTexture = renderer->GetDevice()->CreateTexture(textureDesc);
-            }
-
-            ShaderResourceViewDesc srvDesc = {};
-            srvDesc.m_resource = m_emissiveTexture;
-            srvDesc.m_viewFormat = format;
-            srvDesc.m_firstMip = 0;
-            srvDesc.m_mipCount = -1;
-
-            m_emissiveTextureView = renderer->GetDevice()->CreateShaderResourceView(srvDesc);
-        }
-
-        // Normal Texture
-        {
-            auto textureAsset = TextureAsset::LoadTextureAsset(m_normalFilename);
-            DX_ASSERT(textureAsset.get(), "Object", "Failed to load texture");
-
-            TextureDesc textureDesc = {};
-            textureDesc.m_textureType = TextureType::Texture2D;
-            textureDesc.m_dimensions = Math::Vector3Int(textureAsset->GetData()->m_size, 0);
-            textureDesc.m_mipCount = 1;
-            textureDesc.m_format = ResourceFormat::R8G8B8A8_UNORM;
-            textureDesc.m_usage = ResourceUsage::Immutable;
-            textureDesc.m_bindFlags = TextureBind_ShaderResource;
-            textureDesc.m_cpuAccess = ResourceCPUAccess::None;
-            textureDesc.m_arrayCount = 1;
-            textureDesc.m_sampleCount = 1;
-            textureDesc.m_sampleQuality = 0;
-            textureDesc.m_initialData = textureAsset->GetData()->m_data;
-
-            m_normalTexture = renderer->GetDevice()->CreateTexture(textureDesc);
-
-            ShaderResourceViewDesc srvDesc = {};
-            srvDesc.m_resource = m_normalTexture;
-            srvDesc.m_viewFormat = textureDesc.m_format;
-            srvDesc.m_firstMip = 0;
-            srvDesc.m_mipCount = -1;
-
-            m_normalTextureView = renderer->GetDevice()->CreateShaderResourceView(srvDesc);
-        }
-
-        // Sampler State
-        {
-            SamplerDesc samplerDesc = {};
-            samplerDesc.m_minFilter = FilterSampling::Linear;
-            samplerDesc.m_magFilter = FilterSampling::Linear;
-            samplerDesc.m_mipFilter = FilterSampling::Linear;
-            samplerDesc.m_filterMode = FilterMode::Normal;
-            samplerDesc.m_addressU = AddressMode::Wrap;
-            samplerDesc.m_addressV = AddressMode::Wrap;
-            samplerDesc.m_addressW = AddressMode::Wrap;
-            samplerDesc.m_mipBias = 0;
-            samplerDesc.m_mipClamp = NoMipClamping;
-            samplerDesc.m_maxAnisotropy = 1;
-            samplerDesc.m_borderColor = Math::Color(0.0f);
-            samplerDesc.m_comparisonFunction = ComparisonFunction::Always;
-
-            m_textureSampler = renderer->GetDevice()->CreateSampler(samplerDesc);
+            m_indexCount = static_cast<uint32_t>(indexData.size());
         }
     }
 
@@ -225,13 +178,14 @@ namespace DX
         m_transform = transform;
         m_diffuseFilename = "Textures/Wall_Stone_Albedo.png";
         m_normalFilename = "Textures/Wall_Stone_Normal.png";
+        RegisterTextures();
 
         const Math::Vector3 half = 0.5f * extends;
 
         // 6 faces, 2 triangles each face, 3 vertices each triangle.
         // Clockwise order (CW) - LeftHand
 
-        m_vertexData =
+        std::vector<VertexPNTBUv> vertexData =
         {
             // Front face
             { Math::Vector3Packed({-half.x, -half.y, -half.z}), Math::Vector3Packed(-mathfu::kAxisZ3f), Math::Vector3Packed(mathfu::kAxisX3f), Math::Vector3Packed(-mathfu::kAxisY3f), Math::Vector2Packed({0.0f, 0.0f}) },
@@ -271,13 +225,13 @@ namespace DX
         };
 
         // Flip UVs and calculate binormals
-        for (auto& vertex : m_vertexData)
+        for (auto& vertex : vertexData)
         {
             vertex.m_uv.y = -vertex.m_uv.y;
             vertex.m_binormal = Math::Vector3::CrossProduct(Math::Vector3(vertex.m_tangent), Math::Vector3(vertex.m_normal));
         }
 
-        m_indexData =
+        const std::vector<Index> indexData =
         {
             // Front face
             0, 1, 2,
@@ -304,7 +258,7 @@ namespace DX
             22, 21, 20
         };
 
-        CreateBuffers();
+        CreateBuffers(vertexData, indexData);
     }
 
 
@@ -312,12 +266,14 @@ namespace DX
         const std::string& meshFilename,
         const std::string& diffuseFilename,
         const std::string& normalFilename,
-        const std::string& emissiveFilename)
+        const std::string& emissiveFilename,
+        bool keepMeshData)
     {
         m_transform = transform;
         m_diffuseFilename = diffuseFilename;
         m_normalFilename = normalFilename;
         m_emissiveFilename = emissiveFilename;
+        RegisterTextures();
 
         auto meshAsset = MeshAsset::LoadMeshAsset(meshFilename);
         if (!meshAsset)
@@ -327,22 +283,40 @@ namespace DX
         }
 
         const MeshData* meshData = meshAsset->GetData();
+        if (!meshData)
+        {
+            DX_LOG(Error, "Mesh", "Mesh asset %s has no data", meshFilename.c_str());
+            return;
+        }
+        m_subMeshes = meshData->m_subMeshes;
 
-        m_vertexData.resize(meshData->m_positions.size());
-        for (uint32_t i = 0; i < meshData->m_positions.size(); ++i)
+        // Interleaved vertices only live until they are uploaded. The buffer is not
+        // initialized, all vertices are written.
         {
-            m_vertexData[i] = VertexPNTBUv
+            const size_t vertexCount = meshData->m_positions.size();
+            auto vertexData = std::make_unique_for_overwrite<VertexPNTBUv[]>(vertexCount);
+            for (size_t i = 0; i < vertexCount; ++i)
             {
-                .m_position = meshData->m_positions[i],
-                .m_normal = meshData->m_normals[i],
-                .m_tangent = meshData->m_tangents[i],
-                .m_binormal = meshData->m_binormals[i],
-                .m_uv = meshData->m_textCoords[i]
-            };
-        }
+                vertexData[i] = VertexPNTBUv
+                {
+                    .m_position = meshData->m_positions[i],
+                    .m_normal = meshData->m_normals[i],
+                    .m_tangent = meshData->m_tangents[i],
+                    .m_binormal = meshData->m_binormals[i],
+                    .m_uv = meshData->m_textCoords[i]
+                };
+            }
 
-        m_indexData = meshData->m_indices;
+            CreateBuffers({ vertexData.get(), vertexCount }, meshData->m_indices);
+        }
 
-        CreateBuffers();
+        // Mesh data is in the GPU buffers now, free the asset's CPU copy
+        // unless other objects still use the asset.
+        if (!keepMeshData)
+        {
+            const AssetId meshAssetId = meshAsset->GetAssetId();
+            meshAsset.reset();
+            AssetManager::Get().ReleaseAssetData(meshAssetId);
+        }
     }
 } // namespace DX
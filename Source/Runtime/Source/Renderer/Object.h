@@ -2,15 +2,18 @@
 
 #include <Math/Transform.h>
 #include <Renderer/Vertices.h>
+#include <Renderer/SubMesh.h>
+#include <Renderer/TextureStreamer.h>
+#include <Renderer/MaterialFeatures.h>
 
 #include <vector>
 #include <memory>
+#include <span>
 #include <string>
 
 namespace DX
 {
     class Buffer;
-    class Texture;
     class ShaderResourceView;
     class Sampler;
     class CommandList;
@@ -22,7 +25,10 @@ namespace DX
         Object();
         virtual ~Object();
 
-        uint32_t GetIndexCount() const { return static_cast<uint32_t>(m_indexData.size()); }
+        uint32_t GetIndexCount() const { return m_indexCount; }
+
+        // Parts of the object drawn separately, there is at least one.
+        const std::vector<SubMesh>& GetSubMeshes() const { return m_subMeshes; }
 
         Math::Transform& GetTransform() { return m_transform; }
         const Math::Transform& GetTransform() const { return m_transform; }
@@ -31,22 +37,47 @@ namespace DX
         std::shared_ptr<ShaderResourceView> GetDiffuseTextureView() const;
         std::shared_ptr<ShaderResourceView> GetEmissiveTextureView() const;
         std::shared_ptr<ShaderResourceView> GetNormalTextureView() const;
+
+        // Slices of the texture arrays to sample, all texture views are arrays.
+        uint32_t GetDiffuseTextureSlice() const;
+        uint32_t GetEmissiveTextureSlice() const;
+        uint32_t GetNormalTextureSlice() const;
+
         std::shared_ptr<Sampler> GetSampler() const;
 
+        // Features of the shader variant used to draw the object, from the textures it has.
+        ShaderPermutationKey GetMaterialFeatures() const;
+
         std::shared_ptr<Buffer> GetVertexBuffer() const;
         std::shared_ptr<Buffer> GetIndexBuffer() const;
 
+        // Radius of the sphere around the object's position that contains the object.
+        float GetBoundingRadius() const;
+
+        StreamingTextureId GetDiffuseTextureId() const { return m_diffuseTextureId; }
+        StreamingTextureId GetEmissiveTextureId() const { return m_emissiveTextureId; }
+        StreamingTextureId GetNormalTextureId() const { return m_normalTextureId; }
+
+        // CPU memory kept by the object for its geometry. Vertices and indices
+        // are only in the GPU buffers, so this is the sub-mesh table.
+        size_t GetCpuGeometryMemoryUsage() const;
+
     protected:
-        void CreateBuffers();
+        // Registers the textures in the texture streamer, their fallback colors are used until loaded.
+        // Call it once the filenames are set, before anything that can fail, so the texture ids are always valid.
+        void RegisterTextures();
+
+        // Creates the GPU buffers with the vertices and indices.
+        // The object doesn't keep the vertex and index data, it can be freed afterwards.
+        void CreateBuffers(std::span<const VertexPNTBUv> vertexData, std::span<const Index> indexData);
 
         uint32_t GetVertexSize() const { return sizeof(VertexPNTBUv); }
         uint32_t GetIndexSize() const { return sizeof(Index); }
 
         Math::Transform m_transform = Math::Transform::CreateIdentity();
 
-        // Filled by subclass
-        std::vector<VertexPNTBUv> m_vertexData;
-        std::vector<Index> m_indexData;
+        // Filled by subclass, optional. When empty, the whole object is a single sub-mesh.
+        std::vector<SubMesh> m_subMeshes;
 
         // Filled by subclass
         std::string m_diffuseFilename;
@@ -56,13 +87,15 @@ namespace DX
     private:
         std::shared_ptr<Buffer> m_vertexBuffer;
         std::shared_ptr<Buffer> m_indexBuffer;
+        uint32_t m_indexCount = 0;
+
+        TextureStreamer* GetTextureStreamer() const;
+
+        float m_localBoundingRadius = 0.0f;
 
-        std::shared_ptr<Texture> m_diffuseTexture;
-        std::shared_ptr<Texture> m_emissiveTexture;
-        std::shared_ptr<Texture> m_normalTexture;
-        std::shared_ptr<ShaderResourceView> m_diffuseTextureView;
-        std::shared_ptr<ShaderResourceView> m_emissiveTextureView;
-        std::shared_ptr<ShaderResourceView> m_normalTextureView;
+        StreamingTextureId m_diffuseTextureId;
+        StreamingTextureId m_emissiveTextureId;
+        StreamingTextureId m_normalTextureId;
         std::shared_ptr<Sampler> m_textureSampler;
     };
 
@@ -73,6 +106,13 @@ namespace DX
             const Math::Vector3& extends);
     };
 
+    // Object with the geometry of a mesh asset.
+    //
+    // The vertex streams of the mesh data are interleaved in a temporary buffer
+    // to upload them, and the indices are uploaded directly from the mesh data.
+    // Once uploaded, the mesh asset's CPU data is released from the AssetManager when
+    // nothing else references the asset, unless keepMeshData is true, for example when
+    // more objects will be created from the mesh later.
     class Mesh : public Object
     {
     public:
@@ -80,6 +120,7 @@ namespace DX
             const std::string& meshFilename, 
             const std::string& diffuseFilename, 
             const std::string& normalFilename,
-            const std::string& emissiveFilename = "");
+            const std::string& emissiveFilename = "",
+            bool keepMeshData = false);
     };
 } // namespace DX
@@ -0,0 +1,343 @@
+#include <Renderer/PipelineLibrary.h>
+
+#include <File/FileUtils.h>
+#include <File/MappedFile.h>
+#include <Hash/Hash.h>
+#include <Log/Log.h>
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+namespace DX
+{
+    namespace Internal
+    {
+        // -------------------------------------------------------
+        // Pipeline library file
+        //
+        // PipelineLibraryHeader
+        // Entries, for each one: first use frame and pipeline object description
+        //     (shader filenames, shader features, permutation key, input elements,
+        //     blend state and depth stencil state)
+        //
+        // Fields are stored one by one, without the padding of the structs.
+        // Strings are stored as their length followed by their characters.
+        // -------------------------------------------------------
+
+        static constexpr uint32_t PipelineLibraryVersion = 1;
+
+        struct PipelineLibraryHeader
+        {
+            static constexpr uint32_t Magic = 0x4C505844; // "DXPL"
+
+            uint32_t m_magic = Magic;
+            uint32_t m_version = PipelineLibraryVersion;
+            uint32_t m_entryCount = 0;
+        };
+
+        template<typename T>
+        static void WriteValue(std::vector<uint8_t>& data, const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be written");
+
+            const size_t offset = data.size();
+            data.resize(offset + sizeof(T));
+            std::memcpy(data.data() + offset, &value, sizeof(T));
+        }
+
+        static void WriteString(std::vector<uint8_t>& data, const std::string& str)
+        {
+            WriteValue(data, static_cast<uint32_t>(str.size()));
+            data.insert(data.end(), str.begin(), str.end());
+        }
+
+        template<typename T>
+        static bool ReadValue(std::span<const uint8_t>& data, T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be read");
+
+            if (data.size() < sizeof(T))
+            {
+                return false;
+            }
+            std::memcpy(&value, data.data(), sizeof(T));
+            data = data.subspan(sizeof(T));
+            return true;
+        }
+
+        static bool ReadString(std::span<const uint8_t>& data, std::string& str)
+        {
+            uint32_t length = 0;
+            if (!ReadValue(data, length) || data.size() < length)
+            {
+                return false;
+            }
+            str.assign(reinterpret_cast<const char*>(data.data()), length);
+            data = data.subspan(length);
+            return true;
+        }
+
+        static void WriteStencilBehaviour(std::vector<uint8_t>& data, const StencilBehaviour& stencilBehaviour)
+        {
+            WriteValue(data, stencilBehaviour.m_stencilFailOp);
+            WriteValue(data, stencilBehaviour.m_stencilDepthFailOp);
+            WriteValue(data, stencilBehaviour.m_stencilPassOp);
+            WriteValue(data, stencilBehaviour.m_stencilComparisonFunction);
+        }
+
+        static bool ReadStencilBehaviour(std::span<const uint8_t>& data, StencilBehaviour& stencilBehaviour)
+        {
+            return ReadValue(data, stencilBehaviour.m_stencilFailOp) &&
+                ReadValue(data, stencilBehaviour.m_stencilDepthFailOp) &&
+                ReadValue(data, stencilBehaviour.m_stencilPassOp) &&
+                ReadValue(data, stencilBehaviour.m_stencilComparisonFunction);
+        }
+
+        static void WriteDesc(std::vector<uint8_t>& data, const PipelineObjectDesc& desc)
+        {
+            for (const auto& shaderFilename : desc.m_shaderFilenames)
+            {
+                WriteString(data, shaderFilename);
+            }
+
+            for (const auto& shaderFeatures : desc.m_shaderFeatures)
+            {
+                WriteValue(data, static_cast<uint32_t>(shaderFeatures.size()));
+                for (const auto& feature : shaderFeatures)
+                {
+                    WriteValue(data, feature.m_bit);
+                    WriteString(data, feature.m_define);
+                }
+            }
+            WriteValue(data, desc.m_permutationKey);
+
+            WriteValue(data, static_cast<uint32_t>(desc.m_inputElements.size()));
+            for (const auto& element : desc.m_inputElements)
+            {
+                WriteValue(data, element.m_semantic);
+                WriteValue(data, element.m_semanticIndex);
+                WriteValue(data, element.m_format);
+                WriteValue(data, element.m_inputSlot);
+                WriteValue(data, element.m_alignedByteOffset);
+                WriteValue(data, element.m_instanceDataStepRate);
+                WriteString(data, element.m_semanticCustomName);
+            }
+
+            WriteValue(data, desc.m_blendState.m_blendEnabled);
+            WriteValue(data, desc.m_blendState.m_srcBlend);
+            WriteValue(data, desc.m_blendState.m_destBlend);
+            WriteValue(data, desc.m_blendState.m_blendOp);
+            WriteValue(data, desc.m_blendState.m_srcBlendAlpha);
+            WriteValue(data, desc.m_blendState.m_destBlendAlpha);
+            WriteValue(data, desc.m_blendState.m_blendOpAlpha);
+            WriteValue(data, desc.m_blendState.m_colorWriteMask);
+
+            WriteValue(data, desc.m_depthStencilState.m_depthEnabled);
+            WriteValue(data, desc.m_depthStencilState.m_depthTestFunc);
+            WriteValue(data, desc.m_depthStencilState.m_depthWriteEnabled);
+            WriteValue(data, desc.m_depthStencilState.m_stencilEnabled);
+            WriteValue(data, desc.m_depthStencilState.m_stencilReadMask);
+            WriteValue(data, desc.m_depthStencilState.m_stencilWriteMask);
+            WriteStencilBehaviour(data, desc.m_depthStencilState.m_frontFaceStencilBehaviour);
+            WriteStencilBehaviour(data, desc.m_depthStencilState.m_backFaceStencilBehaviour);
+        }
+
+        static bool ReadDesc(std::span<const uint8_t>& data, PipelineObjectDesc& desc)
+        {
+            for (auto& shaderFilename : desc.m_shaderFilenames)
+            {
+                if (!ReadString(data, shaderFilename))
+                {
+                    return false;
+                }
+            }
+
+            for (auto& shaderFeatures : desc.m_shaderFeatures)
+            {
+                // Each feature takes more than a byte, bigger counts are from invalid data.
+                uint32_t featureCount = 0;
+                if (!ReadValue(data, featureCount) || featureCount > data.size())
+                {
+                    return false;
+                }
+
+                shaderFeatures.resize(featureCount);
+                for (auto& feature : shaderFeatures)
+                {
+                    if (!ReadValue(data, feature.m_bit) ||
+                        !ReadString(data, feature.m_define))
+                    {
+                        return false;
+                    }
+                }
+            }
+            if (!ReadValue(data, desc.m_permutationKey))
+            {
+                return false;
+            }
+
+            uint32_t elementCount = 0;
+            if (!ReadValue(data, elementCount) || elementCount > data.size())
+            {
+                return false;
+            }
+            desc.m_inputElements.resize(elementCount);
+            for (auto& element : desc.m_inputElements)
+            {
+                if (!ReadValue(data, element.m_semantic) ||
+                    !ReadValue(data, element.m_semanticIndex) ||
+                    !ReadValue(data, element.m_format) ||
+                    !ReadValue(data, element.m_inputSlot) ||
+                    !ReadValue(data, element.m_alignedByteOffset) ||
+                    !ReadValue(data, element.m_instanceDataStepRate) ||
+                    !ReadString(data, element.m_semanticCustomName))
+                {
+                    return false;
+                }
+            }
+
+            return ReadValue(data, desc.m_blendState.m_blendEnabled) &&
+                ReadValue(data, desc.m_blendState.m_srcBlend) &&
+                ReadValue(data, desc.m_blendState.m_destBlend) &&
+                ReadValue(data, desc.m_blendState.m_blendOp) &&
+                ReadValue(data, desc.m_blendState.m_srcBlendAlpha) &&
+                ReadValue(data, desc.m_blendState.m_destBlendAlpha) &&
+                ReadValue(data, desc.m_blendState.m_blendOpAlpha) &&
+                ReadValue(data, desc.m_blendState.m_colorWriteMask) &&
+                ReadValue(data, desc.m_depthStencilState.m_depthEnabled) &&
+                ReadValue(data, desc.m_depthStencilState.m_depthTestFunc) &&
+                ReadValue(data, desc.m_depthStencilState.m_depthWriteEnabled) &&
+                ReadValue(data, desc.m_depthStencilState.m_stencilEnabled) &&
+                ReadValue(data, desc.m_depthStencilState.m_stencilReadMask) &&
+                ReadValue(data, desc.m_depthStencilState.m_stencilWriteMask) &&
+                ReadStencilBehaviour(data, desc.m_depthStencilState.m_frontFaceStencilBehaviour) &&
+                ReadStencilBehaviour(data, desc.m_depthStencilState.m_backFaceStencilBehaviour);
+        }
+
+        static void SortByPriority(std::vector<PipelineLibraryEntry>& entries)
+        {
+            std::ranges::stable_sort(entries, {}, &PipelineLibraryEntry::m_firstUseFrame);
+        }
+    }
+
+    PipelineLibrary::PipelineLibrary(const std::filesystem::path& filePath)
+        : m_filePath(filePath)
+    {
+        if (!std::filesystem::exists(m_filePath))
+        {
+            return;
+        }
+
+        const MappedFile file(m_filePath, FileAccessPattern::Sequential);
+        if (!file.IsValid())
+        {
+            return;
+        }
+
+        std::span<const uint8_t> data = file.GetData();
+
+        // Libraries of other versions are discarded, they are written again when saving.
+        Internal::PipelineLibraryHeader header;
+        if (!Internal::ReadValue(data, header) ||
+            header.m_magic != Internal::PipelineLibraryHeader::Magic ||
+            header.m_version != Internal::PipelineLibraryVersion)
+        {
+            DX_LOG(Warning, "PipelineLibrary", "Pipeline library %s is not valid, it's created again.", m_filePath.generic_string().c_str());
+            m_changed = true;
+            return;
+        }
+
+        m_entries.reserve(std::min<size_t>(header.m_entryCount, data.size()));
+        for (uint32_t i = 0; i < header.m_entryCount; ++i)
+        {
+            PipelineLibraryEntry entry;
+            if (!Internal::ReadValue(data, entry.m_firstUseFrame) ||
+                !Internal::ReadDesc(data, entry.m_desc))
+            {
+                DX_LOG(Warning, "PipelineLibrary", "Pipeline library %s is truncated, %u of %u pipelines loaded.",
+                    m_filePath.generic_string().c_str(), i, header.m_entryCount);
+                m_changed = true;
+                break;
+            }
+            entry.m_descHash = HashDesc(entry.m_desc);
+            m_entries.push_back(std::move(entry));
+        }
+
+        Internal::SortByPriority(m_entries);
+
+        DX_LOG(Verbose, "PipelineLibrary", "Pipeline library loaded with %zu pipelines.", m_entries.size());
+    }
+
+    bool PipelineLibrary::Contains(const PipelineObjectDesc& desc) const
+    {
+        const uint64_t descHash = HashDesc(desc);
+        return std::ranges::find(m_entries, descHash, &PipelineLibraryEntry::m_descHash) != m_entries.end();
+    }
+
+    void PipelineLibrary::Record(const PipelineObjectDesc& desc, uint32_t frameIndex)
+    {
+        const uint64_t descHash = HashDesc(desc);
+        if (auto it = std::ranges::find(m_entries, descHash, &PipelineLibraryEntry::m_descHash);
+            it != m_entries.end())
+        {
+            if (frameIndex < it->m_firstUseFrame)
+            {
+                it->m_firstUseFrame = frameIndex;
+                m_changed = true;
+            }
+            return;
+        }
+
+        m_entries.push_back({ desc, frameIndex, descHash });
+        m_changed = true;
+    }
+
+    void PipelineLibrary::Remove(const PipelineObjectDesc& desc)
+    {
+        const uint64_t descHash = HashDesc(desc);
+        if (std::erase_if(m_entries, [descHash](const PipelineLibraryEntry& entry) { return entry.m_descHash == descHash; }) > 0)
+        {
+            m_changed = true;
+        }
+    }
+
+    bool PipelineLibrary::Save()
+    {
+        if (!m_changed)
+        {
+            return true;
+        }
+
+        Internal::SortByPriority(m_entries);
+
+        Internal::PipelineLibraryHeader header;
+        header.m_entryCount = static_cast<uint32_t>(m_entries.size());
+
+        std::vector<uint8_t> data;
+        Internal::WriteValue(data, header);
+        for (const auto& entry : m_entries)
+        {
+            Internal::WriteValue(data, entry.m_firstUseFrame);
+            Internal::WriteDesc(data, entry.m_desc);
+        }
+
+        if (!WriteFileAtomically(m_filePath, data))
+        {
+            DX_LOG(Error, "PipelineLibrary", "Failed to write pipeline library %s.", m_filePath.generic_string().c_str());
+            return false;
+        }
+
+        m_changed = false;
+        DX_LOG(Verbose, "PipelineLibrary", "Pipeline library saved with %zu pipelines.", m_entries.size());
+        return true;
+    }
+
+    uint64_t PipelineLibrary::HashDesc(const PipelineObjectDesc& desc)
+    {
+        std::vector<uint8_t> data;
+        Internal::WriteDesc(data, desc);
+        return Hash64(data.data(), data.size());
+    }
+} // namespace DX
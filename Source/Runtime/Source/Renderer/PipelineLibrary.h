@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Renderer/PipelineObject.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace DX
+{
+    struct PipelineLibraryEntry
+    {
+        PipelineObjectDesc m_desc;
+
+        // Frame the pipeline was drawn with for the first time.
+        uint32_t m_firstUseFrame = 0;
+
+        uint64_t m_descHash = 0; // See PipelineLibrary::HashDesc
+    };
+
+    // -------------------------------------------------------
+    // Usage:
+    //
+    // PipelineLibrary pipelineLibrary(GetExecutablePath() / "PipelineLibrary.bin");
+    //
+    // // While loading, pipelines used in previous runs are created in worker threads.
+    // for (const PipelineLibraryEntry& entry : pipelineLibrary.GetEntries())
+    // {
+    //     ... // PipelineObject::CreateAsync(renderer, entry.m_desc)
+    // }
+    //
+    // // When drawing with a pipeline.
+    // pipelineLibrary.Record(pipelineObjectDesc, frameIndex);
+    //
+    // // When closing.
+    // pipelineLibrary.Save();
+    // -------------------------------------------------------
+
+    // Descriptions of the pipelines used while running, stored in a file so
+    // the next run can create them ahead of time, while loading.
+    //
+    // Entries are sorted by the frame they were first used, so the pipelines of
+    // the first visible frame come first. Pipelines used in previous runs are kept
+    // until removed, a run doesn't need to use all of them.
+    //
+    // It's not thread safe.
+    class PipelineLibrary
+    {
+    public:
+        // Loads the library from the file, if it exists.
+        explicit PipelineLibrary(const std::filesystem::path& filePath);
+
+        // Sorted by priority: the frame first used, then the order they were recorded.
+        const std::vector<PipelineLibraryEntry>& GetEntries() const { return m_entries; }
+
+        bool Contains(const PipelineObjectDesc& desc) const;
+
+        // Adds the description if it's not in the library, or moves it
+        // to an earlier frame if it's used before than in previous runs.
+        void Record(const PipelineObjectDesc& desc, uint32_t frameIndex);
+
+        // For descriptions that are no longer used, like after changing their shaders.
+        void Remove(const PipelineObjectDesc& desc);
+
+        // Writes the file when the library has changed since loaded.
+        bool Save();
+
+        // Identifies the description by the content of all its fields.
+        static uint64_t HashDesc(const PipelineObjectDesc& desc);
+
+    private:
+        std::filesystem::path m_filePath;
+        std::vector<PipelineLibraryEntry> m_entries;
+        bool m_changed = false;
+    };
+} // namespace DX
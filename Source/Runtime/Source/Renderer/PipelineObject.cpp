@@ -5,10 +5,76 @@
 #include <RHI/Shader/ShaderCompiler/ShaderCompiler.h>
 #include <RHI/Shader/Shader.h>
 #include <RHI/Pipeline/Pipeline.h>
+#include <RHI/Pipeline/PipelineResourceBindings.h>
+#include <RHI/Shader/ShaderResourceLayout.h>
+
+#include <Assets/AssetManager.h>
+#include <Log/Log.h>
+
+#include <atomic>
 
 namespace DX
 {
+    namespace Internal
+    {
+        static ShaderInfo GetShaderInfo(const PipelineObjectDesc& desc, ShaderType shaderType)
+        {
+            ShaderInfo shaderInfo{ shaderType, desc.m_shaderFilenames[shaderType], "main" };
+            shaderInfo.m_features = desc.m_shaderFeatures[shaderType];
+            for (const auto& feature : shaderInfo.m_features)
+            {
+                shaderInfo.m_permutationKey |= (desc.m_permutationKey & feature.m_bit);
+            }
+            return shaderInfo;
+        }
+
+        // Pipeline being created by CreateAsync, shared by the tasks compiling its shaders.
+        struct PipelineCreation
+        {
+            Renderer* m_renderer = nullptr;
+            PipelineObjectDesc m_desc;
+            PipelineObject::ShaderBytecodes m_shaderBytecodes;
+            std::atomic<uint32_t> m_pendingShaderCount = 0;
+            std::promise<std::shared_ptr<PipelineObject>> m_pipelineObject;
+        };
+
+        static void CreatePipelineObject(PipelineCreation& pipelineCreation)
+        {
+            for (int i = 0; i < ShaderType_Count; ++i)
+            {
+                if (!pipelineCreation.m_desc.m_shaderFilenames[i].empty() &&
+                    !pipelineCreation.m_shaderBytecodes[i])
+                {
+                    DX_LOG(Error, "PipelineObject", "Failed to create pipeline, shader %s not compiled.",
+                        pipelineCreation.m_desc.m_shaderFilenames[i].c_str());
+                    pipelineCreation.m_pipelineObject.set_value(nullptr);
+                    return;
+                }
+            }
+
+            pipelineCreation.m_pipelineObject.set_value(std::make_shared<PipelineObject>(
+                pipelineCreation.m_renderer, pipelineCreation.m_desc, pipelineCreation.m_shaderBytecodes));
+        }
+    }
+
     PipelineObject::PipelineObject(Renderer* renderer, const PipelineObjectDesc& desc)
+        : PipelineObject(renderer, desc, [&desc]()
+            {
+                ShaderBytecodes shaderBytecodes;
+                for (int i = 0; i < ShaderType_Count; ++i)
+                {
+                    if (!desc.m_shaderFilenames[i].empty())
+                    {
+                        shaderBytecodes[i] = ShaderCompiler::Compile(Internal::GetShaderInfo(desc, static_cast<ShaderType>(i)));
+                    }
+                }
+                return shaderBytecodes;
+            }())
+    {
+    }
+
+    PipelineObject::PipelineObject(Renderer* renderer, const PipelineObjectDesc& desc, const ShaderBytecodes& shaderBytecodes)
+        : m_desc(desc)
     {
         PipelineDesc pipelineDesc = {};
         for (int i = 0; i < ShaderType_Count; ++i)
@@ -17,9 +83,8 @@ namespace DX
             {
                 continue;
             }
-            const ShaderInfo shaderInfo{ static_cast<ShaderType>(i), desc.m_shaderFilenames[i], "main"};
-            auto shaderByteCode = ShaderCompiler::Compile(shaderInfo);
-            pipelineDesc.m_shaders[i] = renderer->GetDevice()->CreateShader({ shaderInfo, shaderByteCode });
+            const ShaderInfo shaderInfo = Internal::GetShaderInfo(desc, static_cast<ShaderType>(i));
+            pipelineDesc.m_shaders[i] = renderer->GetDevice()->CreateShader({ shaderInfo, shaderBytecodes[i] });
         }
         pipelineDesc.m_inputLayout.m_inputElements = desc.m_inputElements;
         pipelineDesc.m_inputLayout.m_primitiveTopology = PrimitiveTopology::TriangleList;
@@ -38,4 +103,96 @@ namespace DX
         m_materialResourceBindings = m_pipeline->CreateResourceBindingsObject();
         m_objectResourceBindings = m_pipeline->CreateResourceBindingsObject();
     }
+
+    bool PipelineObject::UsesShaderVariant(const ShaderInfo& shaderInfo) const
+    {
+        if (m_desc.m_shaderFilenames[shaderInfo.m_shaderType] != shaderInfo.m_name)
+        {
+            return false;
+        }
+
+        const ShaderInfo pipelineShaderInfo = Internal::GetShaderInfo(m_desc, shaderInfo.m_shaderType);
+        return pipelineShaderInfo.m_permutationKey == shaderInfo.m_permutationKey &&
+            pipelineShaderInfo.m_bytecodeFormat == shaderInfo.m_bytecodeFormat;
+    }
+
+    void PipelineObject::ReplacePipeline(PipelineObject&& pipelineObject)
+    {
+        bool sameResourceLayout = true;
+        for (int i = 0; i < ShaderType_Count; ++i)
+        {
+            const ShaderResourceLayout* layout = m_pipeline->GetShaderResourceLayout(static_cast<ShaderType>(i));
+            const ShaderResourceLayout* newLayout = pipelineObject.m_pipeline->GetShaderResourceLayout(static_cast<ShaderType>(i));
+            sameResourceLayout &= (!layout && !newLayout) || (layout && newLayout && *layout == *newLayout);
+        }
+
+        m_pipeline = std::move(pipelineObject.m_pipeline);
+
+        if (sameResourceLayout)
+        {
+            m_sceneResourceBindings->SetPipeline(m_pipeline.get());
+            m_pipelineResourceBindings->SetPipeline(m_pipeline.get());
+            m_materialResourceBindings->SetPipeline(m_pipeline.get());
+            m_objectResourceBindings->SetPipeline(m_pipeline.get());
+        }
+        else
+        {
+            DX_LOG(Warning, "PipelineObject", "Resource layout of pipeline variant 0x%x changed, its resource bindings are empty until set again.",
+                m_desc.m_permutationKey);
+            m_sceneResourceBindings = std::move(pipelineObject.m_sceneResourceBindings);
+            m_pipelineResourceBindings = std::move(pipelineObject.m_pipelineResourceBindings);
+            m_materialResourceBindings = std::move(pipelineObject.m_materialResourceBindings);
+            m_objectResourceBindings = std::move(pipelineObject.m_objectResourceBindings);
+        }
+    }
+
+    std::vector<std::shared_future<std::shared_ptr<PipelineObject>>> PipelineObject::CreateAsync(
+        Renderer* renderer, std::span<const PipelineObjectDesc> descs)
+    {
+        ThreadPool& threadPool = AssetManager::Get().GetThreadPool();
+
+        std::vector<std::shared_future<std::shared_ptr<PipelineObject>>> pipelineObjects;
+        pipelineObjects.reserve(descs.size());
+
+        for (const auto& desc : descs)
+        {
+            auto pipelineCreation = std::make_shared<Internal::PipelineCreation>();
+            pipelineCreation->m_renderer = renderer;
+            pipelineCreation->m_desc = desc;
+            pipelineObjects.push_back(pipelineCreation->m_pipelineObject.get_future().share());
+
+            std::vector<ShaderType> shaderTypes;
+            for (int i = 0; i < ShaderType_Count; ++i)
+            {
+                if (!desc.m_shaderFilenames[i].empty())
+                {
+                    shaderTypes.push_back(static_cast<ShaderType>(i));
+                }
+            }
+
+            if (shaderTypes.empty())
+            {
+                Internal::CreatePipelineObject(*pipelineCreation);
+                continue;
+            }
+
+            // The task compiling the last shader of the pipeline creates it, so no task waits for others.
+            pipelineCreation->m_pendingShaderCount = static_cast<uint32_t>(shaderTypes.size());
+            for (const ShaderType shaderType : shaderTypes)
+            {
+                threadPool.Submit([pipelineCreation, shaderType]()
+                    {
+                        pipelineCreation->m_shaderBytecodes[shaderType] =
+                            ShaderCompiler::Compile(Internal::GetShaderInfo(pipelineCreation->m_desc, shaderType));
+
+                        if (--pipelineCreation->m_pendingShaderCount == 0)
+                        {
+                            Internal::CreatePipelineObject(*pipelineCreation);
+                        }
+                    });
+            }
+        }
+
+        return pipelineObjects;
+    }
 } // namespace DX
@@ -5,7 +5,10 @@
 #include <RHI/Pipeline/BlendState/BlendState.h>
 #include <RHI/Pipeline/DepthStencilState/DepthStencilState.h>
 
+#include <array>
+#include <future>
 #include <memory>
+#include <span>
 #include <vector>
 
 namespace DX
@@ -13,12 +16,20 @@ namespace DX
     class Renderer;
     class Pipeline;
     class PipelineResourceBindings;
+    class ShaderBytecode;
 
     struct PipelineObjectDesc
     {
         using ShaderFilenames = std::array<std::string, ShaderType_Count>;
 
         ShaderFilenames m_shaderFilenames;
+
+        // Features of each shader, and the ones enabled in this pipeline. Each shader
+        // only gets the bits of its own features, so shaders without features are shared
+        // by all the variants of the pipeline.
+        std::array<std::vector<ShaderFeature>, ShaderType_Count> m_shaderFeatures;
+        ShaderPermutationKey m_permutationKey = 0;
+
         std::vector<InputElement> m_inputElements;
         RenderTargetBlend m_blendState;
         DepthStencilState m_depthStencilState;
@@ -28,17 +39,44 @@ namespace DX
     class PipelineObject
     {
     public:
+        using ShaderBytecodes = std::array<std::shared_ptr<ShaderBytecode>, ShaderType_Count>;
+
+        // Compiles the shaders one after the other and creates the pipeline.
         PipelineObject(Renderer* renderer, const PipelineObjectDesc& desc);
+
+        // Creates the pipeline with shaders already compiled.
+        PipelineObject(Renderer* renderer, const PipelineObjectDesc& desc, const ShaderBytecodes& shaderBytecodes);
+
         ~PipelineObject() = default;
 
+        // Compiles the shaders of all the pipelines concurrently in the asset manager's thread pool,
+        // each stage being a task, and creates each pipeline as soon as all its shaders are compiled.
+        // It returns immediately, with a future per pipeline in the same order as the descriptions.
+        // The future holds null when any of the shaders of the pipeline failed to compile.
+        static std::vector<std::shared_future<std::shared_ptr<PipelineObject>>> CreateAsync(
+            Renderer* renderer, std::span<const PipelineObjectDesc> descs);
+
         Pipeline* GetPipeline() { return m_pipeline.get(); }
 
+        const PipelineObjectDesc& GetDesc() const { return m_desc; }
+        ShaderPermutationKey GetPermutationKey() const { return m_desc.m_permutationKey; }
+
+        // Whether the shader variant is used by any stage of the pipeline.
+        bool UsesShaderVariant(const ShaderInfo& shaderInfo) const;
+
+        // Replaces the pipeline with the one of another pipeline object of the same description,
+        // like with its shaders compiled again. It must be called between frames, when no
+        // commands are being recorded with the pipeline. The resource bindings objects are kept,
+        // with the resources set, if the shaders use the same resources in the same slots.
+        void ReplacePipeline(PipelineObject&& pipelineObject);
+
         PipelineResourceBindings* GetSceneResourceBindings() { return m_sceneResourceBindings.get(); }
         PipelineResourceBindings* GetPipelineResourceBindings() { return m_pipelineResourceBindings.get(); }
         PipelineResourceBindings* GetMaterialResourceBindings() { return m_materialResourceBindings.get(); }
         PipelineResourceBindings* GetObjectResourceBindings() { return m_objectResourceBindings.get(); }
 
     private:
+        PipelineObjectDesc m_desc;
         std::shared_ptr<Pipeline> m_pipeline;
         std::shared_ptr<PipelineResourceBindings> m_sceneResourceBindings;
         std::shared_ptr<PipelineResourceBindings> m_pipelineResourceBindings;
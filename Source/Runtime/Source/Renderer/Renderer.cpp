@@ -1,5 +1,6 @@
 #include <Renderer/Renderer.h>
 #include <Renderer/Scene.h>
+#include <Renderer/TextureStreamer.h>
 
 #include <RHI/Device/Device.h>
 #include <RHI/Device/DeviceContext.h>
@@ -42,6 +43,12 @@ namespace DX
             return false;
         }
 
+        if (!CreateTextureStreamer())
+        {
+            Terminate();
+            return false;
+        }
+
         if (!CreateScene())
         {
             Terminate();
@@ -58,6 +65,7 @@ namespace DX
         m_window->UnregisterWindowResizeEvent(m_windowResizeHandler);
 
         m_scene.reset();
+        m_textureStreamer.reset();
         m_swapChain.reset();
         m_device.reset();
     }
@@ -82,6 +90,11 @@ namespace DX
         return m_scene.get();
     }
 
+    TextureStreamer* Renderer::GetTextureStreamer()
+    {
+        return m_textureStreamer.get();
+    }
+
     bool Renderer::CreateDevice()
     {
         m_device = std::make_unique<Device>();
@@ -126,6 +139,19 @@ namespace DX
         return true;
     }
 
+    bool Renderer::CreateTextureStreamer()
+    {
+        m_textureStreamer = std::make_unique<TextureStreamer>(m_device.get());
+
+        if (!m_textureStreamer)
+        {
+            DX_LOG(Error, "Renderer", "Failed to create texture streamer.");
+            return false;
+        }
+
+        return true;
+    }
+
     bool Renderer::CreateScene()
     {
         m_scene = std::make_unique<Scene>(this);
@@ -12,6 +12,7 @@ namespace DX
     class SwapChain;
     class FrameBuffer;
     class Scene;
+    class TextureStreamer;
 
     using RendererId = GenericId<struct RendererIdTag>;
 
@@ -34,12 +35,14 @@ namespace DX
         Device* GetDevice();
         FrameBuffer* GetFrameBuffer();
         Scene* GetScene();
+        TextureStreamer* GetTextureStreamer();
 
         void Present();
 
     private:
         bool CreateDevice();
         bool CreateSwapChain();
+        bool CreateTextureStreamer();
         bool CreateScene();
 
         RendererId m_rendererId;
@@ -47,6 +50,7 @@ namespace DX
         WindowResizeEvent::Handler m_windowResizeHandler;
         std::unique_ptr<Device> m_device;
         std::shared_ptr<SwapChain> m_swapChain;
+        std::unique_ptr<TextureStreamer> m_textureStreamer;
         std::unique_ptr<Scene> m_scene;
     };
 } // namespace DX
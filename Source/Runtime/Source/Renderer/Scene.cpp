@@ -1,7 +1,10 @@
 #include <Renderer/Scene.h>
 #include <Renderer/Renderer.h>
 #include <Renderer/PipelineObject.h>
+#include <Renderer/PipelineLibrary.h>
 #include <Renderer/Object.h>
+#include <Renderer/MaterialFeatures.h>
+#include <Renderer/TextureStreamer.h>
 #include <Window/WindowManager.h>
 #include <Camera/Camera.h>
 
@@ -10,24 +13,113 @@
 #include <RHI/CommandList/CommandList.h>
 #include <RHI/Pipeline/PipelineResourceBindings.h>
 #include <RHI/Resource/Buffer/Buffer.h>
+#include <RHI/Shader/ShaderCompiler/ShaderCompiler.h>
+#include <ShaderBindings/SceneShaderBindings.h>
 
 #include <Math/Vector2.h>
+#include <Math/Vector4.h>
+#include <File/FileUtils.h>
+#include <File/FileWatcher.h>
+#include <Log/Log.h>
 #include <Debug/Debug.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <tuple>
+
 // GLFW uses Vulkan by default, so we need to indicate to not use it.
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
 namespace DX
 {
+    // Slots and constant buffer layouts of VertexShader.hlsl and PixelShader.hlsl,
+    // generated by ShaderBindingsGenerator when building.
+    namespace ConstantBuffers = SceneShaderBindings::ConstantBuffers;
+    namespace ShaderResourceViews = SceneShaderBindings::ShaderResourceViews;
+    namespace Samplers = SceneShaderBindings::Samplers;
+
+    namespace Internal
+    {
+        // Planes of the frustum of a transform to clip space, with their normals
+        // pointing inside. When the transform includes the world matrix of an object,
+        // the planes are in the object's local space.
+        using FrustumPlanes = std::array<Math::Vector4, 6>;
+
+        static FrustumPlanes ExtractFrustumPlanes(const Math::Matrix4x4& transform)
+        {
+            auto row = [&transform](int index)
+                {
+                    return Math::Vector4(transform(index, 0), transform(index, 1), transform(index, 2), transform(index, 3));
+                };
+
+            // The near plane is z > -w, which also contains the points with z > 0
+            // for projections with the depth range from 0 to 1.
+            return FrustumPlanes{
+                row(3) + row(0), // Left
+                row(3) - row(0), // Right
+                row(3) + row(1), // Bottom
+                row(3) - row(1), // Top
+                row(3) + row(2), // Near
+                row(3) - row(2)  // Far
+            };
+        }
+
+        static bool IsAabbOutsideFrustum(const FrustumPlanes& frustumPlanes, const Math::Vector3& aabbMin, const Math::Vector3& aabbMax)
+        {
+            const Math::Vector3 center = (aabbMin + aabbMax) * 0.5f;
+            const Math::Vector3 extents = (aabbMax - aabbMin) * 0.5f;
+
+            for (const auto& plane : frustumPlanes)
+            {
+                // Distance to the plane of the center and of the box corner furthest inside
+                const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+                const float radius = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+                if (distance + radius < 0.0f)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
     Scene::Scene(Renderer* renderer)
         : m_renderer(renderer)
     {
+        // Constant buffers must have the layout of the cbuffers in the shaders.
+        DX_CHECK_CONSTANT_BUFFER_SIZE(ViewProjBuffer, ConstantBuffers::ViewProjMatrixConstantBuffer);
+        DX_CHECK_CONSTANT_BUFFER_MEMBER(ViewProjBuffer, m_viewMatrix, ConstantBuffers::ViewProjMatrixConstantBuffer, viewMatrix);
+        DX_CHECK_CONSTANT_BUFFER_MEMBER(ViewProjBuffer, m_projMatrix, ConstantBuffers::ViewProjMatrixConstantBuffer, projMatrix);
+        DX_CHECK_CONSTANT_BUFFER_MEMBER(ViewProjBuffer, m_camPos, ConstantBuffers::ViewProjMatrixConstantBuffer, camPos);
+
+        DX_CHECK_CONSTANT_BUFFER_SIZE(LightBuffer, ConstantBuffers::LightConstantBuffer);
+        DX_CHECK_CONSTANT_BUFFER_MEMBER(LightBuffer, m_lightDir, ConstantBuffers::LightConstantBuffer, LightDir);
+        DX_CHECK_CONSTANT_BUFFER_MEMBER(LightBuffer, m_lightColor, ConstantBuffers::LightConstantBuffer, LightColor);
+
+        DX_CHECK_CONSTANT_BUFFER_SIZE(MaterialBuffer, ConstantBuffers::MaterialConstantBuffer);
+        DX_CHECK_CONSTANT_BUFFER_MEMBER(MaterialBuffer, m_diffuseSlice, ConstantBuffers::MaterialConstantBuffer, diffuseSlice);
+        DX_CHECK_CONSTANT_BUFFER_MEMBER(MaterialBuffer, m_emissiveSlice, ConstantBuffers::MaterialConstantBuffer, emissiveSlice);
+        DX_CHECK_CONSTANT_BUFFER_MEMBER(MaterialBuffer, m_normalSlice, ConstantBuffers::MaterialConstantBuffer, normalSlice);
+
+        DX_CHECK_CONSTANT_BUFFER_SIZE(WorldBuffer, ConstantBuffers::WorldMatrixConstantBuffer);
+        DX_CHECK_CONSTANT_BUFFER_MEMBER(WorldBuffer, m_worldMatrix, ConstantBuffers::WorldMatrixConstantBuffer, worldMatrix);
+        DX_CHECK_CONSTANT_BUFFER_MEMBER(WorldBuffer, m_inverseTransposeWorldMatrix, ConstantBuffers::WorldMatrixConstantBuffer, inverseTransposeWorldMatrix);
+
         // Create pipeline object
         {
-            PipelineObjectDesc pipelineObjectDesc = {};
+            PipelineObjectDesc& pipelineObjectDesc = m_pipelineObjectDesc;
             pipelineObjectDesc.m_shaderFilenames[ShaderType_Vertex] = "Shaders/VertexShader.hlsl";
             pipelineObjectDesc.m_shaderFilenames[ShaderType_Pixel] = "Shaders/PixelShader.hlsl";
+            pipelineObjectDesc.m_shaderFeatures[ShaderType_Pixel] = {
+                ShaderFeature{ MaterialFeature_EmissiveMap, "EMISSIVE_MAP" },
+                ShaderFeature{ MaterialFeature_NormalMap, "NORMAL_MAP" },
+            };
             pipelineObjectDesc.m_inputElements = {
                 DX::InputElement{ DX::InputSemantic::Position, 0, DX::ResourceFormat::R32G32B32_FLOAT, 0, 0 },
                 DX::InputElement{ DX::InputSemantic::Normal, 0, DX::ResourceFormat::R32G32B32_FLOAT, 0, 12 },
@@ -46,7 +138,25 @@ namespace DX
                 .m_stencilEnabled = false
             };
 
-            m_pipelineObject = std::make_unique<PipelineObject>(renderer, pipelineObjectDesc);
+            // Variants are created in worker threads when objects need them, meanwhile
+            // objects are drawn with a simpler pixel shader, which compiles faster.
+            // It uses all the textures, as the variant with all the features.
+            PipelineObjectDesc fallbackPipelineObjectDesc = pipelineObjectDesc;
+            fallbackPipelineObjectDesc.m_shaderFilenames[ShaderType_Pixel] = "Shaders/FallbackPixelShader.hlsl";
+            fallbackPipelineObjectDesc.m_shaderFeatures[ShaderType_Pixel].clear();
+            fallbackPipelineObjectDesc.m_permutationKey = MaterialFeature_All;
+
+            m_fallbackPipelineObject = std::make_unique<PipelineObject>(renderer, fallbackPipelineObjectDesc);
+
+            // Shaders read from pack files don't change.
+            if (!IsAssetFilePacked(pipelineObjectDesc.m_shaderFilenames[ShaderType_Pixel]))
+            {
+                m_shaderFileWatcher = std::make_unique<FileWatcher>(GetAssetPath() / "Shaders");
+            }
+
+            // Variants drawn in previous runs are created while the application loads.
+            m_pipelineLibrary = std::make_unique<PipelineLibrary>(GetExecutablePath() / "PipelineLibrary.bin");
+            WarmUpPipelineObjects();
         }
 
         // Per Scene Resources
@@ -75,6 +185,22 @@ namespace DX
             m_lightConstantBuffer = renderer->GetDevice()->CreateBuffer(constantBufferDesc);
         }
 
+        // Per Material Resources
+        {
+            const MaterialBuffer materialBuffer;
+
+            BufferDesc constantBufferDesc = {};
+            constantBufferDesc.m_elementSizeInBytes = sizeof(MaterialBuffer);
+            constantBufferDesc.m_elementCount = 1;
+            constantBufferDesc.m_usage = ResourceUsage::Dynamic;
+            constantBufferDesc.m_bindFlags = BufferBind_ConstantBuffer;
+            constantBufferDesc.m_cpuAccess = ResourceCPUAccess::Write;
+            constantBufferDesc.m_bufferSubType = BufferSubType::None;
+            constantBufferDesc.m_initialData = &materialBuffer;
+
+            m_materialConstantBuffer = renderer->GetDevice()->CreateBuffer(constantBufferDesc);
+        }
+
         // Per Object Resources
         {
             const WorldBuffer worldBuffer;
@@ -96,7 +222,24 @@ namespace DX
         m_commandListObjects = renderer->GetDevice()->CreateCommandList();
     }
 
-    Scene::~Scene() = default;
+    Scene::~Scene()
+    {
+        // Pipelines can still be in creation, using the device.
+        for (const auto& [materialFeatures, pipelineObject] : m_pipelineObjects)
+        {
+            pipelineObject.wait();
+        }
+        for (const auto& pipelineReload : m_pipelineReloads)
+        {
+            pipelineReload.m_newPipelineObject.wait();
+        }
+
+        if (m_onDemandPipelineCount > 0)
+        {
+            DX_LOG(Info, "Scene", "%u pipeline variants were created on demand, they are warmed up in the next run.", m_onDemandPipelineCount);
+        }
+        m_pipelineLibrary->Save();
+    }
 
     void Scene::SetCamera(Camera* camera)
     {
@@ -106,6 +249,8 @@ namespace DX
     void Scene::AddObject(Object* object)
     {
         m_objects.insert(object);
+
+        RequestPipelineObject(object->GetMaterialFeatures());
     }
 
     void Scene::RemoveObject(Object* object)
@@ -115,6 +260,13 @@ namespace DX
 
     void Scene::Render()
     {
+        // Textures views are swapped by the streamer here, before recording any command.
+        UpdateTextureStreaming();
+
+        // Also pipelines with shaders reloaded.
+        UpdateShaderHotReload();
+        UpdatePipelineWarmUp();
+
         // Clear and update scene constant buffers
         std::future updateScene = std::async(std::launch::async, [&]()
             {
@@ -148,27 +300,90 @@ namespace DX
                     Math::Vector2{m_renderer->GetWindow()->GetSize()}}
                 });
 
-                // Bind pipeline
-                m_commandListObjects->BindPipeline(*m_pipelineObject->GetPipeline());
+                CullAndSortSubMeshes();
 
-                // Bind per Scene resources
+                PipelineObject* pipelineObject = nullptr;
+                const Object* boundObject = nullptr;
+                ShaderPermutationKey drawnFeatures = 0;
+                MaterialBindings boundMaterialBindings;
+                for (const auto& subMeshDraw : m_subMeshDraws)
                 {
-                    m_pipelineObject->GetSceneResourceBindings()->SetConstantBuffer(ShaderType_Vertex, 0, m_viewProjMatrixConstantBuffer);
-                    m_pipelineObject->GetSceneResourceBindings()->SetConstantBuffer(ShaderType_Pixel, 0, m_lightConstantBuffer);
+                    // Draws are grouped by object, its resources are bound with its first sub-mesh.
+                    if (subMeshDraw.m_object == boundObject)
+                    {
+                        m_commandListObjects->DrawIndexed(subMeshDraw.m_subMesh->m_indexCount, subMeshDraw.m_subMesh->m_indexOffset);
+                        continue;
+                    }
 
-                    m_commandListObjects->BindResources(*m_pipelineObject->GetSceneResourceBindings());
-                }
+                    // Variants are recorded the first frame they are drawn, even with the fallback pipeline.
+                    if (!boundObject || subMeshDraw.m_materialFeatures != drawnFeatures)
+                    {
+                        drawnFeatures = subMeshDraw.m_materialFeatures;
+                        if (m_recordedPipelineVariants.insert(drawnFeatures).second)
+                        {
+                            m_pipelineLibrary->Record(GetPipelineObjectDesc(drawnFeatures), m_frameIndex);
+                        }
+                    }
 
-                for (auto* object : m_objects)
-                {
-                    // Bind per Material resources
+                    boundObject = subMeshDraw.m_object;
+                    const Object* object = subMeshDraw.m_object;
+
+                    // Bind pipeline, objects are grouped by variant.
+                    if (PipelineObject* variantPipelineObject = GetPipelineObject(subMeshDraw.m_materialFeatures);
+                        variantPipelineObject != pipelineObject)
                     {
-                        m_pipelineObject->GetMaterialResourceBindings()->SetShaderResourceView(ShaderType_Pixel, 0, object->GetDiffuseTextureView());
-                        m_pipelineObject->GetMaterialResourceBindings()->SetShaderResourceView(ShaderType_Pixel, 1, object->GetEmissiveTextureView());
-                        m_pipelineObject->GetMaterialResourceBindings()->SetShaderResourceView(ShaderType_Pixel, 2, object->GetNormalTextureView());
-                        m_pipelineObject->GetMaterialResourceBindings()->SetSampler(ShaderType_Pixel, 0, object->GetSampler());
+                        pipelineObject = variantPipelineObject;
+                        m_commandListObjects->BindPipeline(*pipelineObject->GetPipeline());
+
+                        // Bind per Scene resources
+                        pipelineObject->GetSceneResourceBindings()->SetConstantBuffer<ConstantBuffers::ViewProjMatrixConstantBuffer>(m_viewProjMatrixConstantBuffer);
+                        pipelineObject->GetSceneResourceBindings()->SetConstantBuffer<ConstantBuffers::LightConstantBuffer>(m_lightConstantBuffer);
+
+                        m_commandListObjects->BindResources(*pipelineObject->GetSceneResourceBindings());
 
-                        m_commandListObjects->BindResources(*m_pipelineObject->GetMaterialResourceBindings());
+                        boundMaterialBindings = {};
+                    }
+
+                    // Bind per Material resources
+                    {
+                        const MaterialBuffer materialBuffer = {
+                            object->GetDiffuseTextureSlice(),
+                            object->GetEmissiveTextureSlice(),
+                            object->GetNormalTextureSlice()
+                        };
+
+                        m_commandListObjects->UpdateDynamicBuffer(*m_materialConstantBuffer, &materialBuffer, sizeof(materialBuffer));
+
+                        // Packed textures share the view of their array, so materials
+                        // using them often only differ in the slices of the constant buffer.
+                        // Textures of features not in the pipeline's variant are not used.
+                        const ShaderPermutationKey pipelineFeatures = pipelineObject->GetPermutationKey();
+                        const MaterialBindings materialBindings = {
+                            {
+                                object->GetDiffuseTextureView(),
+                                (pipelineFeatures & MaterialFeature_EmissiveMap) ? object->GetEmissiveTextureView() : nullptr,
+                                (pipelineFeatures & MaterialFeature_NormalMap) ? object->GetNormalTextureView() : nullptr
+                            },
+                            object->GetSampler()
+                        };
+
+                        if (materialBindings != boundMaterialBindings)
+                        {
+                            pipelineObject->GetMaterialResourceBindings()->SetConstantBuffer<ConstantBuffers::MaterialConstantBuffer>(m_materialConstantBuffer);
+                            pipelineObject->GetMaterialResourceBindings()->SetShaderResourceView<ShaderResourceViews::diffuseTexture>(materialBindings.m_textureViews[0]);
+                            if (pipelineFeatures & MaterialFeature_EmissiveMap)
+                            {
+                                pipelineObject->GetMaterialResourceBindings()->SetShaderResourceView<ShaderResourceViews::emissiveTexture>(materialBindings.m_textureViews[1]);
+                            }
+                            if (pipelineFeatures & MaterialFeature_NormalMap)
+                            {
+                                pipelineObject->GetMaterialResourceBindings()->SetShaderResourceView<ShaderResourceViews::normalTexture>(materialBindings.m_textureViews[2]);
+                            }
+                            pipelineObject->GetMaterialResourceBindings()->SetSampler<Samplers::texSampler>(materialBindings.m_sampler);
+
+                            m_commandListObjects->BindResources(*pipelineObject->GetMaterialResourceBindings());
+                            boundMaterialBindings = materialBindings;
+                        }
                     }
 
                     // Bind per Object resources
@@ -183,10 +398,9 @@ namespace DX
 
                             m_commandListObjects->UpdateDynamicBuffer(*m_worldMatrixConstantBuffer, &worldBuffer, sizeof(worldBuffer));
                         }
-                        m_pipelineObject->GetObjectResourceBindings()->SetConstantBuffer(ShaderType_Vertex, 1, m_worldMatrixConstantBuffer);
-                        m_pipelineObject->GetObjectResourceBindings()->SetConstantBuffer(ShaderType_Pixel, 1, m_worldMatrixConstantBuffer);
+                        pipelineObject->GetObjectResourceBindings()->SetConstantBuffer<ConstantBuffers::WorldMatrixConstantBuffer>(m_worldMatrixConstantBuffer);
 
-                        m_commandListObjects->BindResources(*m_pipelineObject->GetObjectResourceBindings());
+                        m_commandListObjects->BindResources(*pipelineObject->GetObjectResourceBindings());
                     }
 
                     // Bind Vertex and Index Buffers
@@ -194,7 +408,7 @@ namespace DX
                     m_commandListObjects->BindIndexBuffer(*object->GetIndexBuffer());
 
                     // Draw
-                    m_commandListObjects->DrawIndexed(object->GetIndexCount());
+                    m_commandListObjects->DrawIndexed(subMeshDraw.m_subMesh->m_indexCount, subMeshDraw.m_subMesh->m_indexOffset);
                 }
 
                 m_commandListObjects->Close();
@@ -205,6 +419,264 @@ namespace DX
 
         drawObjects.wait();
         m_renderer->GetDevice()->ExecuteCommandLists({ m_commandListObjects.get() });
+
+        ++m_frameIndex;
+    }
+
+    void Scene::RequestPipelineObject(ShaderPermutationKey materialFeatures)
+    {
+        if (m_pipelineObjects.contains(materialFeatures))
+        {
+            return;
+        }
+
+        const PipelineObjectDesc pipelineObjectDesc = GetPipelineObjectDesc(materialFeatures);
+        if (!m_pipelineLibrary->Contains(pipelineObjectDesc))
+        {
+            ++m_onDemandPipelineCount;
+            DX_LOG(Warning, "Scene", "Pipeline variant 0x%x is not in the pipeline library, it's created on demand.", materialFeatures);
+        }
+
+        m_pipelineObjects.emplace(materialFeatures,
+            PipelineObject::CreateAsync(m_renderer, std::span(&pipelineObjectDesc, 1)).front());
+    }
+
+    void Scene::WarmUpPipelineObjects()
+    {
+        // Entries of previous runs with other shaders or states than the current variants are not used anymore.
+        std::vector<PipelineObjectDesc> warmUpDescs;
+        std::vector<PipelineObjectDesc> staleDescs;
+        for (const PipelineLibraryEntry& entry : m_pipelineLibrary->GetEntries())
+        {
+            if (PipelineLibrary::HashDesc(GetPipelineObjectDesc(entry.m_desc.m_permutationKey)) == entry.m_descHash)
+            {
+                warmUpDescs.push_back(entry.m_desc);
+            }
+            else
+            {
+                staleDescs.push_back(entry.m_desc);
+            }
+        }
+        for (const auto& staleDesc : staleDescs)
+        {
+            m_pipelineLibrary->Remove(staleDesc);
+        }
+
+        if (warmUpDescs.empty())
+        {
+            return;
+        }
+
+        // The thread pool runs the tasks in order, entries are sorted by the frame first drawn,
+        // so the variants of the first visible frame are created first.
+        m_warmUpStartTime = std::chrono::steady_clock::now();
+        m_warmUpPipelineObjects = PipelineObject::CreateAsync(m_renderer, warmUpDescs);
+        for (size_t i = 0; i < warmUpDescs.size(); ++i)
+        {
+            m_pipelineObjects.emplace(warmUpDescs[i].m_permutationKey, m_warmUpPipelineObjects[i]);
+        }
+
+        DX_LOG(Info, "Scene", "Warming up %zu pipeline variants from the pipeline library.", warmUpDescs.size());
+    }
+
+    void Scene::UpdatePipelineWarmUp()
+    {
+        if (m_warmUpPipelineObjects.empty() ||
+            std::any_of(m_warmUpPipelineObjects.begin(), m_warmUpPipelineObjects.end(), [](const auto& pipelineObject)
+                {
+                    return pipelineObject.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+                }))
+        {
+            return;
+        }
+
+        [[maybe_unused]] const float warmUpTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_warmUpStartTime).count();
+        DX_LOG(Info, "Scene", "Pipeline warm-up finished in frame %u, %zu variants created in %.1f ms.",
+            m_frameIndex, m_warmUpPipelineObjects.size(), warmUpTime);
+        m_warmUpPipelineObjects.clear();
+    }
+
+    PipelineObjectDesc Scene::GetPipelineObjectDesc(ShaderPermutationKey materialFeatures) const
+    {
+        PipelineObjectDesc pipelineObjectDesc = m_pipelineObjectDesc;
+        pipelineObjectDesc.m_permutationKey = materialFeatures;
+        return pipelineObjectDesc;
+    }
+
+    PipelineObject* Scene::GetPipelineObject(ShaderPermutationKey materialFeatures) const
+    {
+        if (auto it = m_pipelineObjects.find(materialFeatures);
+            it != m_pipelineObjects.end() &&
+            it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+            it->second.get())
+        {
+            return it->second.get().get();
+        }
+        return m_fallbackPipelineObject.get();
+    }
+
+    void Scene::UpdateShaderHotReload()
+    {
+        // Replace the pipelines reloaded. It only takes the ones already created, so the frame is never stalled.
+        for (auto it = m_pipelineReloads.begin(); it != m_pipelineReloads.end();)
+        {
+            if (it->m_newPipelineObject.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                ++it;
+                continue;
+            }
+
+            // A later reload of the same pipeline has newer shaders.
+            const bool isSuperseded = std::any_of(std::next(it), m_pipelineReloads.end(), [&it](const PipelineReload& pipelineReload)
+                {
+                    return pipelineReload.m_pipelineObject == it->m_pipelineObject;
+                });
+            if (!isSuperseded)
+            {
+                if (const auto& newPipelineObject = it->m_newPipelineObject.get())
+                {
+                    it->m_pipelineObject->ReplacePipeline(std::move(*newPipelineObject));
+                    DX_LOG(Info, "Scene", "Pipeline variant 0x%x reloaded.", it->m_pipelineObject->GetPermutationKey());
+                }
+                else
+                {
+                    DX_LOG(Warning, "Scene", "Failed to reload pipeline variant 0x%x, the previous one is kept.", it->m_pipelineObject->GetPermutationKey());
+                }
+            }
+            it = m_pipelineReloads.erase(it);
+        }
+
+        if (!m_shaderFileWatcher)
+        {
+            return;
+        }
+
+        std::vector<std::string> changedFiles;
+        for (const auto& filePath : m_shaderFileWatcher->TakeChangedFiles())
+        {
+            changedFiles.push_back((std::filesystem::path("Shaders") / filePath).generic_string());
+        }
+        if (changedFiles.empty())
+        {
+            return;
+        }
+
+        // Only the shader variants compiled from the files changed are compiled again.
+        const std::vector<ShaderInfo> changedShaders = ShaderCompiler::InvalidateFiles(changedFiles);
+
+        auto reloadPipelineObject = [this, &changedShaders](PipelineObject* pipelineObject)
+            {
+                if (std::any_of(changedShaders.begin(), changedShaders.end(), [pipelineObject](const ShaderInfo& shaderInfo)
+                    {
+                        return pipelineObject->UsesShaderVariant(shaderInfo);
+                    }))
+                {
+                    m_pipelineReloads.push_back({ pipelineObject,
+                        PipelineObject::CreateAsync(m_renderer, std::span(&pipelineObject->GetDesc(), 1)).front() });
+                }
+            };
+
+        reloadPipelineObject(m_fallbackPipelineObject.get());
+
+        std::vector<ShaderPermutationKey> failedVariants;
+        for (const auto& [materialFeatures, pipelineObject] : m_pipelineObjects)
+        {
+            if (pipelineObject.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                continue;
+            }
+
+            if (pipelineObject.get())
+            {
+                reloadPipelineObject(pipelineObject.get().get());
+            }
+            else
+            {
+                failedVariants.push_back(materialFeatures);
+            }
+        }
+
+        // Variants whose shaders failed to compile are requested again, the change might fix them.
+        for (const ShaderPermutationKey materialFeatures : failedVariants)
+        {
+            m_pipelineObjects.erase(materialFeatures);
+            RequestPipelineObject(materialFeatures);
+        }
+    }
+
+    void Scene::UpdateTextureStreaming()
+    {
+        TextureStreamer* textureStreamer = m_renderer->GetTextureStreamer();
+
+        // Projected size in pixels of a sphere of radius 1 at distance 1.
+        const float screenHeight = static_cast<float>(m_renderer->GetWindow()->GetSize().y);
+        const float projectionScale = m_camera->GetProjectionMatrix()(1, 1) * 0.5f * screenHeight;
+
+        for (auto* object : m_objects)
+        {
+            const float distance = (object->GetTransform().m_position - m_camera->GetTransform().m_position).Length();
+            const float radius = object->GetBoundingRadius();
+
+            // Screen size of the object's diameter, assuming the texture covers the whole object.
+            const float screenSize = (distance > radius)
+                ? 2.0f * radius * projectionScale / distance
+                : screenHeight; // Camera inside the bounding sphere
+
+            textureStreamer->RequestScreenSize(object->GetDiffuseTextureId(), screenSize);
+            textureStreamer->RequestScreenSize(object->GetEmissiveTextureId(), screenSize);
+            textureStreamer->RequestScreenSize(object->GetNormalTextureId(), screenSize);
+        }
+
+        textureStreamer->Update();
+    }
+
+    void Scene::CullAndSortSubMeshes()
+    {
+        m_subMeshDraws.clear();
+
+        const Math::Matrix4x4 viewProjMatrix = m_camera->GetProjectionMatrix() * m_camera->GetViewMatrix();
+
+        for (const auto* object : m_objects)
+        {
+            // Culling is done in the object's local space, so the sub-mesh bounds are not transformed.
+            const Math::Matrix4x4 worldViewProjMatrix = viewProjMatrix * object->GetTransform().ToMatrix();
+            const Internal::FrustumPlanes frustumPlanes = Internal::ExtractFrustumPlanes(worldViewProjMatrix);
+
+            // Clip space w is the depth in view space.
+            const Math::Vector4 depthRow(worldViewProjMatrix(3, 0), worldViewProjMatrix(3, 1), worldViewProjMatrix(3, 2), worldViewProjMatrix(3, 3));
+
+            const ShaderPermutationKey materialFeatures = object->GetMaterialFeatures();
+
+            const size_t firstDraw = m_subMeshDraws.size();
+            float objectDepth = std::numeric_limits<float>::max();
+            for (const auto& subMesh : object->GetSubMeshes())
+            {
+                if (subMesh.m_indexCount == 0 ||
+                    Internal::IsAabbOutsideFrustum(frustumPlanes, Math::Vector3(subMesh.m_aabbMin), Math::Vector3(subMesh.m_aabbMax)))
+                {
+                    continue;
+                }
+
+                const Math::Vector3 sphereCenter(subMesh.m_sphereCenter);
+                const float depth = depthRow.x * sphereCenter.x + depthRow.y * sphereCenter.y + depthRow.z * sphereCenter.z + depthRow.w;
+
+                m_subMeshDraws.push_back({ object, &subMesh, materialFeatures, 0.0f, depth });
+                objectDepth = std::min(objectDepth, depth);
+            }
+
+            for (size_t i = firstDraw; i < m_subMeshDraws.size(); ++i)
+            {
+                m_subMeshDraws[i].m_objectDepth = objectDepth;
+            }
+        }
+
+        // By pipeline variant to bind each one once, then front to back to reject occluded pixels
+        // with the depth test, keeping the sub-meshes of each object together to bind its resources once.
+        std::sort(m_subMeshDraws.begin(), m_subMeshDraws.end(), [](const SubMeshDraw& lhs, const SubMeshDraw& rhs)
+            {
+                return std::tie(lhs.m_materialFeatures, lhs.m_objectDepth, lhs.m_object, lhs.m_depth) <
+                    std::tie(rhs.m_materialFeatures, rhs.m_objectDepth, rhs.m_object, rhs.m_depth);
+            });
     }
 
     void Scene::UpdateLightInfo()
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <Renderer/PipelineObject.h>
+
 #include <Math/Matrix4x4.h>
 #include <Math/Vector3.h>
 
+#include <array>
+#include <chrono>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include <future>
 
 namespace DX
@@ -12,12 +18,31 @@ namespace DX
     class Renderer;
     class Camera;
     class Object;
-    class PipelineObject;
     class CommandList;
     class Buffer;
+    class ShaderResourceView;
+    class Sampler;
+    class FileWatcher;
+    class PipelineLibrary;
+    struct SubMesh;
 
     // A scene is a collection of objects and a camera.
     // It is responsible for rendering all the objects added to the scene.
+    //
+    // Objects are drawn per sub-mesh: sub-meshes outside the camera frustum are
+    // culled and the visible ones are drawn front to back, grouped by object.
+    //
+    // Each object is drawn with the variant of the pipeline for its material features,
+    // draws are grouped by variant first to switch pipelines once per variant.
+    //
+    // Variants drawn are recorded in the pipeline library, and the ones recorded in previous
+    // runs are created in worker threads when the scene is created, while the application
+    // loads, in the order they were first drawn. Variants not in the library are reported
+    // as created on demand.
+    //
+    // Shaders edited in Assets/Shaders are reloaded while running: the pipelines using
+    // them are created again in worker threads and replace the previous ones between
+    // frames. When the shaders fail to compile the previous pipelines are kept.
     class Scene
     {
     public:
@@ -32,14 +57,63 @@ namespace DX
         void Render();
 
     private:
+        void UpdateTextureStreaming();
+        void UpdateShaderHotReload();
+        void UpdatePipelineWarmUp();
         void UpdateLightInfo();
+        void CullAndSortSubMeshes();
+
+        // Starts creating the pipeline variant with the material features, if not requested yet.
+        void RequestPipelineObject(ShaderPermutationKey materialFeatures);
+
+        // Starts creating the variants in the pipeline library, the first drawn first.
+        void WarmUpPipelineObjects();
+
+        PipelineObjectDesc GetPipelineObjectDesc(ShaderPermutationKey materialFeatures) const;
+
+        // The fallback pipeline until the variant has been created.
+        PipelineObject* GetPipelineObject(ShaderPermutationKey materialFeatures) const;
 
         Renderer* m_renderer = nullptr;
         Camera* m_camera = nullptr;
-        std::unique_ptr<PipelineObject> m_pipelineObject;
+
+        // Variants of the pipeline by material features, only the ones used by objects
+        // are created, in worker threads.
+        PipelineObjectDesc m_pipelineObjectDesc;
+        std::unordered_map<ShaderPermutationKey, std::shared_future<std::shared_ptr<PipelineObject>>> m_pipelineObjects;
+        std::unique_ptr<PipelineObject> m_fallbackPipelineObject;
+
+        // Variants drawn, in this and previous runs, and the ones being warmed up.
+        std::unique_ptr<PipelineLibrary> m_pipelineLibrary;
+        std::unordered_set<ShaderPermutationKey> m_recordedPipelineVariants; // Recorded in this run
+        std::vector<std::shared_future<std::shared_ptr<PipelineObject>>> m_warmUpPipelineObjects;
+        std::chrono::steady_clock::time_point m_warmUpStartTime;
+        uint32_t m_onDemandPipelineCount = 0;
+        uint32_t m_frameIndex = 0;
+
+        // Pipelines being created again with the shaders changed on disk, applied in order.
+        struct PipelineReload
+        {
+            PipelineObject* m_pipelineObject = nullptr;
+            std::shared_future<std::shared_ptr<PipelineObject>> m_newPipelineObject;
+        };
+        std::unique_ptr<FileWatcher> m_shaderFileWatcher;
+        std::vector<PipelineReload> m_pipelineReloads;
 
         std::unordered_set<Object*> m_objects;
 
+        // Visible sub-mesh to draw, with the distance to the camera of its bounding
+        // sphere and of the closest visible sub-mesh of its object.
+        struct SubMeshDraw
+        {
+            const Object* m_object = nullptr;
+            const SubMesh* m_subMesh = nullptr;
+            ShaderPermutationKey m_materialFeatures = 0;
+            float m_objectDepth = 0.0f;
+            float m_depth = 0.0f;
+        };
+        std::vector<SubMeshDraw> m_subMeshDraws;
+
         std::shared_ptr<CommandList> m_commandListScene;
         std::shared_ptr<CommandList> m_commandListObjects;
 
@@ -60,6 +134,25 @@ namespace DX
         LightBuffer m_lightInfo;
         std::shared_ptr<Buffer> m_lightConstantBuffer;
 
+        // Per Material Resources
+        struct MaterialBuffer
+        {
+            uint32_t m_diffuseSlice = 0;
+            uint32_t m_emissiveSlice = 0;
+            uint32_t m_normalSlice = 0;
+            uint32_t m_padding = 0;
+        };
+        std::shared_ptr<Buffer> m_materialConstantBuffer;
+
+        // Views and sampler last bound, materials with the same ones only update their slices.
+        struct MaterialBindings
+        {
+            std::array<std::shared_ptr<ShaderResourceView>, 3> m_textureViews;
+            std::shared_ptr<Sampler> m_sampler;
+
+            bool operator==(const MaterialBindings&) const = default;
+        };
+
         // Per Object Resources
         struct WorldBuffer
         {
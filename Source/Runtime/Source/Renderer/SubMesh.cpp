@@ -0,0 +1,39 @@
+#include <Renderer/SubMesh.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace DX
+{
+    void CalculateSubMeshBounds(SubMesh& subMesh, std::span<const Math::Vector3Packed> positions)
+    {
+        if (positions.empty())
+        {
+            subMesh.m_aabbMin = Math::Vector3Packed(Math::Vector3(0.0f));
+            subMesh.m_aabbMax = Math::Vector3Packed(Math::Vector3(0.0f));
+            subMesh.m_sphereCenter = Math::Vector3Packed(Math::Vector3(0.0f));
+            subMesh.m_sphereRadius = 0.0f;
+            return;
+        }
+
+        Math::Vector3 aabbMin(positions[0]);
+        Math::Vector3 aabbMax(positions[0]);
+        for (const auto& position : positions)
+        {
+            aabbMin = Math::Vector3::Min(aabbMin, Math::Vector3(position));
+            aabbMax = Math::Vector3::Max(aabbMax, Math::Vector3(position));
+        }
+
+        const Math::Vector3 sphereCenter = (aabbMin + aabbMax) * 0.5f;
+        float sphereRadiusSquared = 0.0f;
+        for (const auto& position : positions)
+        {
+            sphereRadiusSquared = std::max(sphereRadiusSquared, (Math::Vector3(position) - sphereCenter).LengthSquared());
+        }
+
+        subMesh.m_aabbMin = Math::Vector3Packed(aabbMin);
+        subMesh.m_aabbMax = Math::Vector3Packed(aabbMax);
+        subMesh.m_sphereCenter = Math::Vector3Packed(sphereCenter);
+        subMesh.m_sphereRadius = std::sqrt(sphereRadiusSquared);
+    }
+} // namespace DX
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Math/Vector3.h>
+
+#include <cstdint>
+#include <span>
+
+namespace DX
+{
+    // Part of a mesh drawn with a single material.
+    //
+    // Indices of sub-meshes are relative to the whole mesh, so a sub-mesh is drawn
+    // with its index range and no base vertex. The vertex range is the one
+    // referenced by its indices, its bounds are calculated from it.
+    //
+    // Bounds are in the local space of the mesh, they are used to cull and sort
+    // the sub-meshes that are not visible instead of drawing the whole mesh.
+    struct SubMesh
+    {
+        uint32_t m_indexOffset = 0;
+        uint32_t m_indexCount = 0;
+        uint32_t m_vertexOffset = 0;
+        uint32_t m_vertexCount = 0;
+
+        // Index of the material in the source file.
+        uint32_t m_materialIndex = 0;
+
+        Math::Vector3Packed m_aabbMin;
+        Math::Vector3Packed m_aabbMax;
+
+        Math::Vector3Packed m_sphereCenter;
+        float m_sphereRadius = 0.0f;
+    };
+
+    // Calculates the bounding box and sphere of a sub-mesh from the positions of its vertex range.
+    // The sphere is centered in the bounding box, which is tighter than the sphere of the box.
+    void CalculateSubMeshBounds(SubMesh& subMesh, std::span<const Math::Vector3Packed> positions);
+} // namespace DX
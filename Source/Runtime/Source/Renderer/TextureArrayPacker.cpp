@@ -0,0 +1,135 @@
+#include <Renderer/TextureArrayPacker.h>
+#include <Renderer/TextureStreamer.h>
+
+#include <RHI/Device/Device.h>
+#include <RHI/Resource/Texture/Texture.h>
+#include <RHI/Resource/Views/ShaderResourceView.h>
+
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace DX
+{
+    TextureArrayPacker::TextureArrayPacker(Device* device)
+        : m_device(device)
+    {
+    }
+
+    TextureArrayPacker::~TextureArrayPacker() = default;
+
+    PackedTextureLocation TextureArrayPacker::AddTexture(const TextureMipChain& mipChain)
+    {
+        DX_ASSERT(mipChain.GetMipCount() > 0, "TextureArrayPacker", "Texture without mips");
+
+        auto it = std::ranges::find_if(m_textureArrays, [&mipChain](const TextureArray& textureArray)
+            {
+                return textureArray.m_size == mipChain.m_size &&
+                    textureArray.m_mipCount == mipChain.GetMipCount() &&
+                    textureArray.m_sliceSizeInBytes == mipChain.m_data.size() &&
+                    textureArray.m_sliceCount < MaxSlicesPerArray;
+            });
+
+        if (it == m_textureArrays.end())
+        {
+            TextureArray& textureArray = m_textureArrays.emplace_back();
+            textureArray.m_size = mipChain.m_size;
+            textureArray.m_mipCount = mipChain.GetMipCount();
+            textureArray.m_sliceSizeInBytes = mipChain.m_data.size();
+            it = std::prev(m_textureArrays.end());
+        }
+
+        it->m_data.insert(it->m_data.end(), mipChain.m_data.begin(), mipChain.m_data.end());
+        it->m_dirty = true;
+
+        return PackedTextureLocation{
+            static_cast<uint32_t>(std::distance(m_textureArrays.begin(), it)),
+            it->m_sliceCount++
+        };
+    }
+
+    bool TextureArrayPacker::Update()
+    {
+        bool viewsChanged = false;
+        for (auto& textureArray : m_textureArrays)
+        {
+            if (textureArray.m_dirty)
+            {
+                // Not retried when it fails, until another texture is added.
+                textureArray.m_dirty = false;
+                viewsChanged |= CreateTextureArray(textureArray);
+            }
+        }
+        return viewsChanged;
+    }
+
+    std::shared_ptr<ShaderResourceView> TextureArrayPacker::GetShaderResourceView(uint32_t arrayIndex) const
+    {
+        DX_ASSERT(arrayIndex < m_textureArrays.size(), "TextureArrayPacker", "Invalid array index %u", arrayIndex);
+        return m_textureArrays[arrayIndex].m_textureView;
+    }
+
+    uint32_t TextureArrayPacker::GetTextureCount() const
+    {
+        uint32_t textureCount = 0;
+        for (const auto& textureArray : m_textureArrays)
+        {
+            textureCount += textureArray.m_sliceCount;
+        }
+        return textureCount;
+    }
+
+    bool TextureArrayPacker::CreateTextureArray(TextureArray& textureArray)
+    {
+        TextureDesc textureDesc = {};
+        textureDesc.m_textureType = TextureType::Texture2D;
+        textureDesc.m_dimensions = Math::Vector3Int(textureArray.m_size, 0);
+        textureDesc.m_mipCount = textureArray.m_mipCount;
+        textureDesc.m_format = ResourceFormat::R8G8B8A8_UNORM;
+        textureDesc.m_usage = ResourceUsage::Immutable;
+        textureDesc.m_bindFlags = TextureBind_ShaderResource;
+        textureDesc.m_cpuAccess = ResourceCPUAccess::None;
+        textureDesc.m_arrayCount = textureArray.m_sliceCount;
+        textureDesc.m_sampleCount = 1;
+        textureDesc.m_sampleQuality = 0;
+        textureDesc.m_initialData = textureArray.m_data.data();
+
+        auto newTexture = m_device->CreateTexture(textureDesc);
+        if (!newTexture)
+        {
+            DX_LOG(Error, "TextureArrayPacker", "Failed to create texture array %dx%d with %u slices.",
+                textureArray.m_size.x, textureArray.m_size.y, textureArray.m_sliceCount);
+            return false;
+        }
+
+        // Always viewed as an array, also when it only has 1 slice.
+        ShaderResourceViewDesc srvDesc = {};
+        srvDesc.m_resource = newTexture;
+        srvDesc.m_viewFormat = textureDesc.m_format;
+        srvDesc.m_firstMip = 0;
+        srvDesc.m_mipCount = -1;
+        srvDesc.m_firstArray = 0;
+        srvDesc.m_arrayCount = textureArray.m_sliceCount;
+
+        auto newTextureView = m_device->CreateShaderResourceView(srvDesc);
+        if (!newTextureView)
+        {
+            DX_LOG(Error, "TextureArrayPacker", "Failed to create texture array view %dx%d with %u slices.",
+                textureArray.m_size.x, textureArray.m_size.y, textureArray.m_sliceCount);
+            return false;
+        }
+
+        m_memoryUsage -= textureArray.m_sliceSizeInBytes * textureArray.m_residentSliceCount;
+        m_memoryUsage += textureArray.m_sliceSizeInBytes * textureArray.m_sliceCount;
+
+        DX_LOG(Verbose, "TextureArrayPacker", "Texture array %dx%d with %u mips has %u slices. Packed memory: %llu KB.",
+            textureArray.m_size.x, textureArray.m_size.y, textureArray.m_mipCount, textureArray.m_sliceCount, m_memoryUsage / 1024);
+
+        textureArray.m_residentSliceCount = textureArray.m_sliceCount;
+        textureArray.m_texture = std::move(newTexture);
+        textureArray.m_textureView = std::move(newTextureView);
+        return true;
+    }
+} // namespace DX
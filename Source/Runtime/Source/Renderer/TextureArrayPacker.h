@@ -0,0 +1,84 @@
+#pragma once
+
+#include <Math/Vector2.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace DX
+{
+    class Device;
+    class Texture;
+    class ShaderResourceView;
+    struct TextureMipChain;
+
+    // Array and slice where a texture has been packed.
+    struct PackedTextureLocation
+    {
+        uint32_t m_arrayIndex = 0;
+        uint32_t m_slice = 0;
+    };
+
+    // Packs textures with the same size and mip count as slices of Texture2D arrays.
+    //
+    // Small textures, like the 1x1 constant colors used as default or fallback textures,
+    // would otherwise be a GPU allocation and a view each. Packed, all the textures of
+    // an array share one allocation and one view, and shaders select them by slice, so
+    // materials using textures of the same array bind the same view.
+    //
+    // Textures are R8G8B8A8_UNORM with their full mip chain, which is the format of all
+    // textures of the TextureStreamer. Their data is kept in CPU memory, because arrays
+    // are immutable and created again with all their slices when textures are added.
+    class TextureArrayPacker
+    {
+    public:
+        explicit TextureArrayPacker(Device* device);
+        ~TextureArrayPacker();
+
+        TextureArrayPacker(const TextureArrayPacker&) = delete;
+        TextureArrayPacker& operator=(const TextureArrayPacker&) = delete;
+
+        // Adds a texture to the array of its size and mip count. Its location never changes,
+        // but the array's view doesn't include it until the next Update().
+        PackedTextureLocation AddTexture(const TextureMipChain& mipChain);
+
+        // Creates again the arrays with textures added since the last update.
+        // Returns true when views have changed, get them again in that case.
+        bool Update();
+
+        std::shared_ptr<ShaderResourceView> GetShaderResourceView(uint32_t arrayIndex) const;
+
+        uint32_t GetArrayCount() const { return static_cast<uint32_t>(m_textureArrays.size()); }
+        uint32_t GetTextureCount() const;
+
+        // GPU memory used by all the arrays.
+        uint64_t GetMemoryUsage() const { return m_memoryUsage; }
+
+    private:
+        // Maximum number of slices of a Texture2D array in DirectX 11.
+        static constexpr uint32_t MaxSlicesPerArray = 2048;
+
+        struct TextureArray
+        {
+            Math::Vector2Int m_size;
+            uint32_t m_mipCount = 0;
+            size_t m_sliceSizeInBytes = 0;
+            uint32_t m_sliceCount = 0;
+            uint32_t m_residentSliceCount = 0; // Slices in the GPU texture
+            bool m_dirty = false; // Textures added since the last update
+
+            // Full mip chain of all slices, one after the other.
+            std::vector<uint8_t> m_data;
+
+            std::shared_ptr<Texture> m_texture;
+            std::shared_ptr<ShaderResourceView> m_textureView;
+        };
+
+        bool CreateTextureArray(TextureArray& textureArray);
+
+        Device* m_device = nullptr;
+        std::vector<TextureArray> m_textureArrays;
+        uint64_t m_memoryUsage = 0;
+    };
+} // namespace DX
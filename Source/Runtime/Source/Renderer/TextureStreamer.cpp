@@ -0,0 +1,626 @@
+#include <Renderer/TextureStreamer.h>
+
+#include <RHI/Device/Device.h>
+#include <RHI/Resource/Texture/Texture.h>
+#include <RHI/Resource/Views/ShaderResourceView.h>
+#include <RHI/Sampler/Sampler.h>
+
+#include <Assets/AssetManager.h>
+#include <Assets/CookedAsset.h>
+#include <File/FileUtils.h>
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <stb_image.h>
+
+namespace DX
+{
+    namespace Internal
+    {
+        // Number of bytes per texel of the streamed textures (R8G8B8A8_UNORM).
+        static const uint32_t TexelSize = 4;
+
+        // Generates the next mip using a 2x2 box filter.
+        // Odd dimensions clamp the last row/column.
+        static void GenerateMip(const uint8_t* src, const Math::Vector2Int& srcSize, uint8_t* dst, const Math::Vector2Int& dstSize)
+        {
+            for (int y = 0; y < dstSize.y; ++y)
+            {
+                const int srcY0 = std::min(2 * y, srcSize.y - 1);
+                const int srcY1 = std::min(2 * y + 1, srcSize.y - 1);
+
+                for (int x = 0; x < dstSize.x; ++x)
+                {
+                    const int srcX0 = std::min(2 * x, srcSize.x - 1);
+                    const int srcX1 = std::min(2 * x + 1, srcSize.x - 1);
+
+                    const uint8_t* texel00 = src + (srcY0 * srcSize.x + srcX0) * TexelSize;
+                    const uint8_t* texel01 = src + (srcY0 * srcSize.x + srcX1) * TexelSize;
+                    const uint8_t* texel10 = src + (srcY1 * srcSize.x + srcX0) * TexelSize;
+                    const uint8_t* texel11 = src + (srcY1 * srcSize.x + srcX1) * TexelSize;
+
+                    uint8_t* texel = dst + (y * dstSize.x + x) * TexelSize;
+                    for (uint32_t c = 0; c < TexelSize; ++c)
+                    {
+                        texel[c] = static_cast<uint8_t>((texel00[c] + texel01[c] + texel10[c] + texel11[c] + 2) / 4);
+                    }
+                }
+            }
+        }
+
+        // 1x1 texture with a constant color.
+        static TextureMipChain CreateConstantMipChain(const Math::Color& color)
+        {
+            TextureMipChain mipChain;
+            mipChain.m_size = Math::Vector2Int(1, 1);
+            mipChain.m_data = {
+                static_cast<uint8_t>(std::clamp(color.x, 0.0f, 1.0f) * 255.0f),
+                static_cast<uint8_t>(std::clamp(color.y, 0.0f, 1.0f) * 255.0f),
+                static_cast<uint8_t>(std::clamp(color.z, 0.0f, 1.0f) * 255.0f),
+                static_cast<uint8_t>(std::clamp(color.w, 0.0f, 1.0f) * 255.0f)
+            };
+            mipChain.m_mipOffsets = { 0 };
+            return mipChain;
+        }
+
+        // Copy of the mips [firstMip, endMip) of the mip chain.
+        static std::shared_ptr<TextureMipChain> CopyMips(const TextureMipChain& mipChain, uint32_t firstMip, uint32_t endMip)
+        {
+            const size_t firstMipOffset = mipChain.m_mipOffsets[firstMip];
+            const size_t endMipOffset = (endMip < mipChain.GetMipCount()) ? mipChain.m_mipOffsets[endMip] : mipChain.m_data.size();
+
+            auto mips = std::make_shared<TextureMipChain>();
+            mips->m_size = mipChain.GetMipSize(firstMip);
+            mips->m_data.assign(mipChain.m_data.begin() + firstMipOffset, mipChain.m_data.begin() + endMipOffset);
+            for (uint32_t mip = firstMip; mip < endMip; ++mip)
+            {
+                mips->m_mipOffsets.push_back(mipChain.m_mipOffsets[mip] - firstMipOffset);
+            }
+            return mips;
+        }
+
+        // Appends the mips that follow the last mip of the mip chain.
+        static void AppendMips(TextureMipChain& mipChain, const TextureMipChain& nextMips)
+        {
+            const size_t offset = mipChain.m_data.size();
+            mipChain.m_data.insert(mipChain.m_data.end(), nextMips.m_data.begin(), nextMips.m_data.end());
+            for (size_t mipOffset : nextMips.m_mipOffsets)
+            {
+                mipChain.m_mipOffsets.push_back(offset + mipOffset);
+            }
+        }
+    }
+
+    Math::Vector2Int TextureMipChain::GetMipSize(uint32_t mip) const
+    {
+        return Math::Vector2Int(
+            std::max(1, m_size.x >> mip),
+            std::max(1, m_size.y >> mip));
+    }
+
+    size_t TextureMipChain::GetSizeInBytes(uint32_t firstMip) const
+    {
+        DX_ASSERT(firstMip < GetMipCount(), "TextureStreamer", "Invalid mip %u", firstMip);
+        return m_data.size() - m_mipOffsets[firstMip];
+    }
+
+    TextureStreamer::TextureStreamer(Device* device, const TextureStreamerDesc& desc)
+        : m_device(device)
+        , m_desc(desc)
+        , m_textureArrayPacker(device)
+    {
+        DX_LOG(Info, "TextureStreamer", "Initializing Texture Streamer with a budget of %llu MB...",
+            m_desc.m_memoryBudgetInBytes / (1024 * 1024));
+
+        SamplerDesc samplerDesc = {};
+        samplerDesc.m_minFilter = FilterSampling::Linear;
+        samplerDesc.m_magFilter = FilterSampling::Linear;
+        samplerDesc.m_mipFilter = FilterSampling::Linear;
+        samplerDesc.m_filterMode = FilterMode::Normal;
+        samplerDesc.m_addressU = AddressMode::Wrap;
+        samplerDesc.m_addressV = AddressMode::Wrap;
+        samplerDesc.m_addressW = AddressMode::Wrap;
+        samplerDesc.m_mipBias = 0;
+        samplerDesc.m_mipClamp = NoMipClamping;
+        samplerDesc.m_maxAnisotropy = 1;
+        samplerDesc.m_borderColor = Math::Color(0.0f);
+        samplerDesc.m_comparisonFunction = ComparisonFunction::Always;
+
+        m_sampler = m_device->CreateSampler(samplerDesc);
+    }
+
+    TextureStreamer::~TextureStreamer()
+    {
+        // Wait for all decodes in flight before destroying the textures.
+        for (auto& texture : m_textures)
+        {
+            if (texture.m_pendingDecode.valid())
+            {
+                texture.m_pendingDecode.wait();
+            }
+        }
+
+        m_textures.clear();
+        m_textureIds.clear();
+
+        DX_LOG(Info, "TextureStreamer", "Terminating Texture Streamer...");
+    }
+
+    StreamingTextureId TextureStreamer::RegisterTexture(const std::string& fileName, const Math::Color& fallbackColor)
+    {
+        if (!fileName.empty())
+        {
+            if (auto it = m_textureIds.find(fileName);
+                it != m_textureIds.end())
+            {
+                return it->second;
+            }
+        }
+
+        StreamingTexture& texture = m_textures.emplace_back();
+        texture.m_fileName = fileName;
+        PackTexture(texture, Internal::CreateConstantMipChain(fallbackColor));
+
+        const StreamingTextureId textureId(m_textures.size());
+
+        if (!fileName.empty())
+        {
+            texture.m_pendingDecode = AssetManager::Get().GetThreadPool().Submit([fileName, mipTailSize = m_desc.m_mipTailSize]()
+                {
+                    return DecodeMipTail(fileName, mipTailSize);
+                });
+
+            m_textureIds.emplace(fileName, textureId);
+        }
+
+        return textureId;
+    }
+
+    std::shared_ptr<ShaderResourceView> TextureStreamer::GetShaderResourceView(StreamingTextureId textureId) const
+    {
+        DX_ASSERT(textureId.IsValid() && textureId.GetValue() <= m_textures.size(), "TextureStreamer", "Invalid texture id");
+        return m_textures[textureId.GetValue() - 1].m_textureView;
+    }
+
+    uint32_t TextureStreamer::GetArraySlice(StreamingTextureId textureId) const
+    {
+        DX_ASSERT(textureId.IsValid() && textureId.GetValue() <= m_textures.size(), "TextureStreamer", "Invalid texture id");
+        return m_textures[textureId.GetValue() - 1].m_arraySlice;
+    }
+
+    void TextureStreamer::RequestScreenSize(StreamingTextureId textureId, float screenSizeInPixels)
+    {
+        DX_ASSERT(textureId.IsValid() && textureId.GetValue() <= m_textures.size(), "TextureStreamer", "Invalid texture id");
+
+        StreamingTexture& texture = m_textures[textureId.GetValue() - 1];
+        texture.m_requestedScreenSize = std::max(texture.m_requestedScreenSize, screenSizeInPixels);
+    }
+
+    void TextureStreamer::Update()
+    {
+        ++m_frameIndex;
+
+        std::vector<StreamingTexture*> upgrades;
+        uint32_t uploadCount = 0;
+
+        for (auto& texture : m_textures)
+        {
+            // Upload the mips of the decodes finished. The mip tail is uploaded as soon
+            // as it's decoded, higher mips within the uploads allowed per frame.
+            if (texture.m_pendingDecode.valid() &&
+                texture.m_pendingDecode.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+                (!texture.m_mipTailChain || uploadCount < m_desc.m_maxUploadsPerFrame))
+            {
+                if (FinishDecode(texture) && texture.m_mipTailChain)
+                {
+                    ++uploadCount;
+                }
+            }
+
+            // Not streamed: decoding for the first time, packed, or the mip tail failed to upload.
+            // Only textures with their mip tail resident are streamed.
+            if (!texture.m_mipTailChain)
+            {
+                texture.m_requestedScreenSize = 0.0f;
+                continue;
+            }
+
+            if (texture.m_requestedScreenSize > 0.0f)
+            {
+                texture.m_lastRequestedFrame = m_frameIndex;
+            }
+            texture.m_wantedMip = CalculateWantedMip(texture);
+            texture.m_requestedScreenSize = 0.0f;
+
+            if (texture.m_wantedMip < texture.m_residentMip &&
+                !texture.m_pendingDecode.valid())
+            {
+                upgrades.push_back(&texture);
+            }
+        }
+
+        // Upgrade first the textures missing more mips.
+        std::ranges::sort(upgrades, [](const StreamingTexture* lhs, const StreamingTexture* rhs)
+            {
+                return (lhs->m_residentMip - lhs->m_wantedMip) > (rhs->m_residentMip - rhs->m_wantedMip);
+            });
+
+        for (auto* texture : upgrades)
+        {
+            if (uploadCount >= m_desc.m_maxUploadsPerFrame)
+            {
+                break;
+            }
+
+            const uint64_t bytesNeeded =
+                CalculateSizeInBytes(*texture, texture->m_wantedMip) -
+                CalculateSizeInBytes(*texture, texture->m_residentMip);
+
+            if (m_residentMemory + m_pendingMemory + bytesNeeded > m_desc.m_memoryBudgetInBytes &&
+                !EvictForBudget(bytesNeeded, texture))
+            {
+                continue;
+            }
+
+            StartDecode(*texture, texture->m_wantedMip);
+            ++uploadCount;
+        }
+
+        // Arrays with new textures are created again, with new views.
+        if (m_textureArrayPacker.Update())
+        {
+            for (auto& texture : m_textures)
+            {
+                if (texture.m_packedLocation)
+                {
+                    texture.m_textureView = m_textureArrayPacker.GetShaderResourceView(texture.m_packedLocation->m_arrayIndex);
+                    texture.m_arraySlice = texture.m_packedLocation->m_slice;
+                }
+            }
+        }
+    }
+
+    void TextureStreamer::StartDecode(StreamingTexture& texture, uint32_t firstMip)
+    {
+        // The memory is accounted while reading, so reads started in the same frame stay within the budget.
+        texture.m_pendingMip = firstMip;
+        texture.m_pendingSizeInBytes = CalculateSizeInBytes(texture, firstMip) - CalculateSizeInBytes(texture, texture.m_residentMip);
+        m_pendingMemory += texture.m_pendingSizeInBytes;
+
+        // Only the mips above the mip tail are read, the mip tail is in CPU memory already.
+        texture.m_pendingDecode = AssetManager::Get().GetThreadPool().Submit([fileName = texture.m_fileName, firstMip, endMip = texture.m_mipTail]()
+            {
+                return DecodeMips(fileName, firstMip, endMip);
+            });
+    }
+
+    bool TextureStreamer::FinishDecode(StreamingTexture& texture)
+    {
+        const DecodedMips decodedMips = texture.m_pendingDecode.get();
+        const std::shared_ptr<TextureMipChain>& mipChain = decodedMips.m_mipChain;
+
+        // First decode, upload the mip tail and keep it in CPU memory.
+        // Textures that are all mip tail are never streamed, they are packed instead.
+        if (!texture.m_mipTailChain)
+        {
+            if (!mipChain ||
+                mipChain->GetMipCount() != decodedMips.m_mipCount - decodedMips.m_firstMip)
+            {
+                return false;
+            }
+
+            const uint32_t mipTail = decodedMips.m_firstMip;
+            if (mipTail == 0)
+            {
+                PackTexture(texture, *mipChain);
+                return false;
+            }
+
+            texture.m_size = decodedMips.m_size;
+            texture.m_mipCount = decodedMips.m_mipCount;
+            texture.m_mipTail = mipTail;
+
+            if (!MakeResident(texture, *mipChain, mipTail, mipTail))
+            {
+                DX_LOG(Error, "TextureStreamer", "Texture %s is not streamed, it keeps its fallback texture.", texture.m_fileName.c_str());
+                return false;
+            }
+
+            texture.m_mipTailChain = mipChain;
+            return true;
+        }
+
+        // Upgrade, upload the mips requested and release them.
+        m_pendingMemory -= std::exchange(texture.m_pendingSizeInBytes, 0);
+        const uint32_t firstMip = std::exchange(texture.m_pendingMip, NotResident);
+
+        // The file could have changed while streaming, only mips of the same size are used.
+        if (!mipChain ||
+            decodedMips.m_size.x != texture.m_size.x ||
+            decodedMips.m_size.y != texture.m_size.y ||
+            decodedMips.m_mipCount != texture.m_mipCount ||
+            decodedMips.m_firstMip != firstMip ||
+            mipChain->GetMipCount() != texture.m_mipTail - firstMip ||
+            firstMip >= texture.m_residentMip)
+        {
+            return false;
+        }
+
+        const uint64_t bytesNeeded = CalculateSizeInBytes(texture, firstMip) - CalculateSizeInBytes(texture, texture.m_residentMip);
+        if (m_residentMemory + m_pendingMemory + bytesNeeded > m_desc.m_memoryBudgetInBytes &&
+            !EvictForBudget(bytesNeeded, &texture))
+        {
+            return false;
+        }
+
+        // The texture is immutable, its new mips are created with the mip tail kept in CPU memory.
+        Internal::AppendMips(*mipChain, *texture.m_mipTailChain);
+
+        return MakeResident(texture, *mipChain, firstMip, firstMip);
+    }
+
+    TextureStreamer::DecodedMips TextureStreamer::DecodeMipTail(const std::string& fileName, uint32_t mipTailSize)
+    {
+        DecodedMips decodedMips;
+
+        // Cooked textures already have their mip chain, only the mip tail is read from it.
+        if (const std::string loadFileName = ResolveAssetFileName(fileName);
+            loadFileName != fileName)
+        {
+            const auto file = OpenAssetFile(loadFileName, FileAccessPattern::Random);
+            const auto info = file ? ReadCookedTextureInfo(file->GetData()) : std::nullopt;
+            if (!info)
+            {
+                return decodedMips;
+            }
+
+            decodedMips.m_size = info->m_size;
+            decodedMips.m_mipCount = info->m_mipCount;
+            decodedMips.m_firstMip = CalculateMipTail(info->m_size, info->m_mipCount, mipTailSize);
+            decodedMips.m_mipChain = DeserializeTextureMipChain(file->GetData(), decodedMips.m_firstMip);
+            return decodedMips;
+        }
+
+        // Source files are decoded whole, only the mip tail is kept.
+        const auto mipChain = ImportTexture(fileName);
+        if (!mipChain)
+        {
+            return decodedMips;
+        }
+
+        decodedMips.m_size = mipChain->m_size;
+        decodedMips.m_mipCount = mipChain->GetMipCount();
+        decodedMips.m_firstMip = CalculateMipTail(mipChain->m_size, mipChain->GetMipCount(), mipTailSize);
+        decodedMips.m_mipChain = (decodedMips.m_firstMip == 0)
+            ? mipChain
+            : Internal::CopyMips(*mipChain, decodedMips.m_firstMip, mipChain->GetMipCount());
+        return decodedMips;
+    }
+
+    TextureStreamer::DecodedMips TextureStreamer::DecodeMips(const std::string& fileName, uint32_t firstMip, uint32_t endMip)
+    {
+        DecodedMips decodedMips;
+        decodedMips.m_firstMip = firstMip;
+
+        // Cooked textures only read the bytes of the mips requested.
+        if (const std::string loadFileName = ResolveAssetFileName(fileName);
+            loadFileName != fileName)
+        {
+            const auto file = OpenAssetFile(loadFileName, FileAccessPattern::Random);
+            const auto info = file ? ReadCookedTextureInfo(file->GetData()) : std::nullopt;
+            if (!info || firstMip >= endMip || endMip > info->m_mipCount)
+            {
+                return decodedMips;
+            }
+
+            decodedMips.m_size = info->m_size;
+            decodedMips.m_mipCount = info->m_mipCount;
+            decodedMips.m_mipChain = DeserializeTextureMipChain(file->GetData(), firstMip, endMip - firstMip);
+            return decodedMips;
+        }
+
+        const auto mipChain = ImportTexture(fileName);
+        if (!mipChain || firstMip >= endMip || endMip > mipChain->GetMipCount())
+        {
+            return decodedMips;
+        }
+
+        decodedMips.m_size = mipChain->m_size;
+        decodedMips.m_mipCount = mipChain->GetMipCount();
+        decodedMips.m_mipChain = Internal::CopyMips(*mipChain, firstMip, endMip);
+        return decodedMips;
+    }
+
+    std::shared_ptr<TextureMipChain> TextureStreamer::ImportTexture(const std::string& fileName)
+    {
+        const auto file = OpenAssetFile(fileName, FileAccessPattern::Sequential);
+        if (!file)
+        {
+            return nullptr;
+        }
+
+        Math::Vector2Int size;
+        uint8_t* decodedData = stbi_load_from_memory(
+            file->GetData().data(),
+            static_cast<int>(file->GetSize()),
+            &size.x,
+            &size.y,
+            nullptr,
+            STBI_rgb_alpha);
+
+        if (!decodedData)
+        {
+            DX_LOG(Error, "TextureStreamer", "Failed to load texture %s.", fileName.c_str());
+            return nullptr;
+        }
+
+        auto mipChain = std::make_shared<TextureMipChain>();
+        mipChain->m_size = size;
+
+        const uint32_t mipCount = 1 + static_cast<uint32_t>(std::floor(std::log2(std::max(size.x, size.y))));
+
+        size_t totalSize = 0;
+        mipChain->m_mipOffsets.resize(mipCount);
+        for (uint32_t mip = 0; mip < mipCount; ++mip)
+        {
+            const Math::Vector2Int mipSize = mipChain->GetMipSize(mip);
+            mipChain->m_mipOffsets[mip] = totalSize;
+            totalSize += static_cast<size_t>(mipSize.x) * mipSize.y * Internal::TexelSize;
+        }
+
+        mipChain->m_data.resize(totalSize);
+        std::copy(decodedData, decodedData + static_cast<size_t>(size.x) * size.y * Internal::TexelSize, mipChain->m_data.begin());
+
+        stbi_image_free(decodedData);
+
+        for (uint32_t mip = 1; mip < mipCount; ++mip)
+        {
+            Internal::GenerateMip(
+                mipChain->m_data.data() + mipChain->m_mipOffsets[mip - 1], mipChain->GetMipSize(mip - 1),
+                mipChain->m_data.data() + mipChain->m_mipOffsets[mip], mipChain->GetMipSize(mip));
+        }
+
+        return mipChain;
+    }
+
+    uint64_t TextureStreamer::CalculateSizeInBytes(const StreamingTexture& texture, uint32_t firstMip)
+    {
+        uint64_t sizeInBytes = 0;
+        for (uint32_t mip = firstMip; mip < texture.m_mipCount; ++mip)
+        {
+            sizeInBytes += static_cast<uint64_t>(std::max(1, texture.m_size.x >> mip)) *
+                std::max(1, texture.m_size.y >> mip) * Internal::TexelSize;
+        }
+        return sizeInBytes;
+    }
+
+    uint32_t TextureStreamer::CalculateMipTail(const Math::Vector2Int& size, uint32_t mipCount, uint32_t mipTailSize)
+    {
+        uint32_t mip = 0;
+        while (mip + 1 < mipCount)
+        {
+            const int mipSize = std::max(1, std::max(size.x, size.y) >> mip);
+            if (static_cast<uint32_t>(mipSize) <= mipTailSize)
+            {
+                break;
+            }
+            ++mip;
+        }
+        return mip;
+    }
+
+    uint32_t TextureStreamer::CalculateWantedMip(const StreamingTexture& texture) const
+    {
+        if (texture.m_requestedScreenSize <= 0.0f)
+        {
+            return texture.m_mipTail;
+        }
+
+        // One texel per pixel: each mip halves the resolution needed.
+        const float textureSize = static_cast<float>(std::max(texture.m_size.x, texture.m_size.y));
+        const float ratio = std::max(1.0f, textureSize / texture.m_requestedScreenSize);
+        const uint32_t mip = static_cast<uint32_t>(std::floor(std::log2(ratio)));
+
+        return std::min(mip, texture.m_mipTail);
+    }
+
+    bool TextureStreamer::MakeResident(StreamingTexture& texture, const TextureMipChain& mipChain, uint32_t chainFirstMip, uint32_t firstMip)
+    {
+        const uint32_t chainMip = firstMip - chainFirstMip;
+
+        TextureDesc textureDesc = {};
+        textureDesc.m_textureType = TextureType::Texture2D;
+        textureDesc.m_dimensions = Math::Vector3Int(mipChain.GetMipSize(chainMip), 0);
+        textureDesc.m_mipCount = mipChain.GetMipCount() - chainMip;
+        textureDesc.m_format = ResourceFormat::R8G8B8A8_UNORM;
+        textureDesc.m_usage = ResourceUsage::Immutable;
+        textureDesc.m_bindFlags = TextureBind_ShaderResource;
+        textureDesc.m_cpuAccess = ResourceCPUAccess::None;
+        textureDesc.m_arrayCount = 1;
+        textureDesc.m_sampleCount = 1;
+        textureDesc.m_sampleQuality = 0;
+        textureDesc.m_initialData = mipChain.m_data.data() + mipChain.m_mipOffsets[chainMip];
+
+        auto newTexture = m_device->CreateTexture(textureDesc);
+        if (!newTexture)
+        {
+            DX_LOG(Error, "TextureStreamer", "Failed to create texture %s for mip %u.", texture.m_fileName.c_str(), firstMip);
+            return false;
+        }
+
+        ShaderResourceViewDesc srvDesc = {};
+        srvDesc.m_resource = newTexture;
+        srvDesc.m_viewFormat = textureDesc.m_format;
+        srvDesc.m_firstMip = 0;
+        srvDesc.m_mipCount = -1;
+        srvDesc.m_firstArray = 0;
+        srvDesc.m_arrayCount = 1; // Viewed as an array, like packed textures
+
+        auto newTextureView = m_device->CreateShaderResourceView(srvDesc);
+        if (!newTextureView)
+        {
+            DX_LOG(Error, "TextureStreamer", "Failed to create texture view %s for mip %u.", texture.m_fileName.c_str(), firstMip);
+            return false;
+        }
+
+        if (texture.m_residentMip != NotResident)
+        {
+            m_residentMemory -= CalculateSizeInBytes(texture, texture.m_residentMip);
+        }
+        m_residentMemory += CalculateSizeInBytes(texture, firstMip);
+
+        DX_LOG(Verbose, "TextureStreamer", "Texture %s mip %u resident (%dx%d). Resident memory: %llu KB.",
+            texture.m_fileName.c_str(), firstMip, textureDesc.m_dimensions.x, textureDesc.m_dimensions.y, m_residentMemory / 1024);
+
+        texture.m_residentMip = firstMip;
+        texture.m_texture = std::move(newTexture);
+        texture.m_textureView = std::move(newTextureView);
+        texture.m_arraySlice = 0;
+        texture.m_packedLocation.reset();
+        return true;
+    }
+
+    bool TextureStreamer::EvictForBudget(uint64_t bytesNeeded, const StreamingTexture* textureToSkip)
+    {
+        std::vector<StreamingTexture*> candidates;
+        for (auto& texture : m_textures)
+        {
+            if (&texture != textureToSkip &&
+                texture.m_mipTailChain &&
+                texture.m_residentMip < texture.m_wantedMip)
+            {
+                candidates.push_back(&texture);
+            }
+        }
+
+        // Least recently requested first
+        std::ranges::sort(candidates, [](const StreamingTexture* lhs, const StreamingTexture* rhs)
+            {
+                return lhs->m_lastRequestedFrame < rhs->m_lastRequestedFrame;
+            });
+
+        // Downgraded to the mip tail, the only mips in CPU memory. The wanted mip
+        // is at most the mip tail, they are read again if needed later.
+        for (auto* candidate : candidates)
+        {
+            if (m_residentMemory + m_pendingMemory + bytesNeeded <= m_desc.m_memoryBudgetInBytes)
+            {
+                break;
+            }
+            MakeResident(*candidate, *candidate->m_mipTailChain, candidate->m_mipTail, candidate->m_mipTail);
+        }
+
+        return m_residentMemory + m_pendingMemory + bytesNeeded <= m_desc.m_memoryBudgetInBytes;
+    }
+
+    void TextureStreamer::PackTexture(StreamingTexture& texture, const TextureMipChain& mipChain)
+    {
+        // The view and slice are set in Update(), once the array includes the texture.
+        // Until then the texture keeps its previous view, if any.
+        texture.m_packedLocation = m_textureArrayPacker.AddTexture(mipChain);
+    }
+} // namespace DX
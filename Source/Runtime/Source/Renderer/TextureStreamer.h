@@ -0,0 +1,192 @@
+#pragma once
+
+#include <Renderer/TextureArrayPacker.h>
+
+#include <GenericId/GenericId.h>
+#include <Math/Vector2.h>
+#include <Math/Color.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <future>
+#include <optional>
+
+namespace DX
+{
+    class Device;
+    class Texture;
+    class ShaderResourceView;
+    class Sampler;
+
+    using StreamingTextureId = GenericId<struct StreamingTextureIdTag>;
+
+    struct TextureStreamerDesc
+    {
+        // Maximum GPU memory used by all streamed textures, including the mips being read.
+        // Mip tails are always resident and can make the total go above the budget.
+        uint64_t m_memoryBudgetInBytes = 256 * 1024 * 1024;
+
+        // Mips with width and height less or equal than this size form the mip tail,
+        // which is uploaded as soon as the texture is decoded and never evicted.
+        uint32_t m_mipTailSize = 64;
+
+        // Maximum number of textures created or recreated, and of mip reads started,
+        // per frame to avoid hitches.
+        uint32_t m_maxUploadsPerFrame = 2;
+    };
+
+    // Full mip chain of a RGBA8 texture in CPU memory.
+    // Mips are stored contiguously from the biggest to the smallest,
+    // which is the layout TextureDesc::m_initialData expects.
+    struct TextureMipChain
+    {
+        Math::Vector2Int m_size; // Size of mip 0
+        std::vector<uint8_t> m_data;
+        std::vector<size_t> m_mipOffsets;
+
+        uint32_t GetMipCount() const { return static_cast<uint32_t>(m_mipOffsets.size()); }
+        Math::Vector2Int GetMipSize(uint32_t mip) const;
+
+        // Size in bytes of all mips starting from firstMip.
+        size_t GetSizeInBytes(uint32_t firstMip) const;
+    };
+
+    // Streams textures to the GPU based on how big they are on screen.
+    //
+    // Registering a texture returns immediately with a 1x1 fallback view while its mip tail
+    // is read in the asset manager's worker threads. Once read, the mip tail is uploaded and
+    // higher mips are uploaded on demand, depending on the screen size requested for the
+    // texture each frame. When the memory budget is exceeded, textures that have more mips
+    // resident than needed are downgraded to their mip tail, least recently requested first.
+    //
+    // Only the mip tail is kept in CPU memory. Higher mips are read again from the file
+    // each time they are uploaded and released right after. Cooked textures only read the
+    // mips needed, source files are decoded whole and their mip chain generated each time.
+    //
+    // Fallback colors and textures that fit entirely in the mip tail are never streamed,
+    // they are packed as slices of texture arrays shared with other textures of the same size.
+    // All views are Texture2D arrays, shaders sample them with the slice of GetArraySlice().
+    //
+    // All methods must be called from the render thread. Views are swapped in Update(), so
+    // the view and slice returned by GetShaderResourceView() and GetArraySlice() are stable
+    // during the frame.
+    class TextureStreamer
+    {
+    public:
+        TextureStreamer(Device* device, const TextureStreamerDesc& desc = {});
+        ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer&) = delete;
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        // Registers a texture to be streamed. The filename is relative to the assets folder.
+        // Registering the same filename returns the same id. An empty filename registers
+        // a constant 1x1 texture with the fallback color that is never streamed.
+        // The fallback texture is packed, its view is available after the next Update().
+        StreamingTextureId RegisterTexture(const std::string& fileName, const Math::Color& fallbackColor);
+
+        std::shared_ptr<ShaderResourceView> GetShaderResourceView(StreamingTextureId textureId) const;
+        uint32_t GetArraySlice(StreamingTextureId textureId) const;
+
+        // Linear sampler with wrap addressing for the streamed textures.
+        std::shared_ptr<Sampler> GetSampler() const { return m_sampler; }
+
+        // Indicates the size in pixels the texture covers on screen this frame.
+        // When requested several times in a frame the biggest size is used.
+        void RequestScreenSize(StreamingTextureId textureId, float screenSizeInPixels);
+
+        // Applies finished decodes, uploads the mips requested this frame
+        // and evicts mips to stay within the memory budget.
+        // Call once per frame before recording any command that uses the textures.
+        void Update();
+
+        // Memory of streamed textures and packed texture arrays.
+        uint64_t GetResidentMemory() const { return m_residentMemory + m_textureArrayPacker.GetMemoryUsage(); }
+
+        // Decodes a texture from its source file and generates its full mip chain,
+        // without using the cooked file. The filename is relative to the assets folder.
+        static std::shared_ptr<TextureMipChain> ImportTexture(const std::string& fileName);
+
+    private:
+        static constexpr uint32_t NotResident = ~0u;
+
+        // Mips read from a texture file.
+        struct DecodedMips
+        {
+            std::shared_ptr<TextureMipChain> m_mipChain; // Starts at m_firstMip, null when the read failed
+
+            // Size and mip count of the whole texture.
+            Math::Vector2Int m_size;
+            uint32_t m_mipCount = 0;
+            uint32_t m_firstMip = 0;
+        };
+
+        struct StreamingTexture
+        {
+            std::string m_fileName;
+
+            // Read of the file, the mip tail the first time and the mips above it after.
+            std::future<DecodedMips> m_pendingDecode;
+            uint32_t m_pendingMip = NotResident; // First mip to upload once decoded
+            uint64_t m_pendingSizeInBytes = 0; // Memory the upload adds, accounted while reading
+
+            // Mips from the mip tail, the only mips kept in CPU memory.
+            // Null until the mip tail is resident, for packed textures and when it failed to upload.
+            std::shared_ptr<TextureMipChain> m_mipTailChain;
+
+            // Size and mips of the whole texture, known once decoded.
+            Math::Vector2Int m_size;
+            uint32_t m_mipCount = 0;
+            uint32_t m_mipTail = 0;
+
+            uint32_t m_residentMip = NotResident; // First mip resident in GPU
+            uint32_t m_wantedMip = 0;
+            float m_requestedScreenSize = 0.0f; // Reset every frame
+            uint64_t m_lastRequestedFrame = 0;
+
+            std::shared_ptr<Texture> m_texture;
+            std::shared_ptr<ShaderResourceView> m_textureView;
+            uint32_t m_arraySlice = 0;
+
+            // Set while the view is the one of a packed texture array.
+            std::optional<PackedTextureLocation> m_packedLocation;
+        };
+
+        // Reads the mips of the mip tail of a texture, with mip tails of mipTailSize.
+        static DecodedMips DecodeMipTail(const std::string& fileName, uint32_t mipTailSize);
+
+        // Reads the mips [firstMip, endMip) of a texture.
+        static DecodedMips DecodeMips(const std::string& fileName, uint32_t firstMip, uint32_t endMip);
+
+        // Size in bytes of the mips of the texture starting from firstMip.
+        static uint64_t CalculateSizeInBytes(const StreamingTexture& texture, uint32_t firstMip);
+
+        // First mip of the mip tail of a texture of the size and mip count given.
+        static uint32_t CalculateMipTail(const Math::Vector2Int& size, uint32_t mipCount, uint32_t mipTailSize);
+        uint32_t CalculateWantedMip(const StreamingTexture& texture) const;
+
+        void StartDecode(StreamingTexture& texture, uint32_t firstMip);
+        bool FinishDecode(StreamingTexture& texture);
+
+        // Uploads the mips of the texture from firstMip, mipChain starts at mip chainFirstMip of the texture.
+        bool MakeResident(StreamingTexture& texture, const TextureMipChain& mipChain, uint32_t chainFirstMip, uint32_t firstMip);
+        bool EvictForBudget(uint64_t bytesNeeded, const StreamingTexture* textureToSkip);
+
+        void PackTexture(StreamingTexture& texture, const TextureMipChain& mipChain);
+
+        Device* m_device = nullptr;
+        TextureStreamerDesc m_desc;
+
+        std::vector<StreamingTexture> m_textures; // Index is id - 1
+        std::unordered_map<std::string, StreamingTextureId> m_textureIds;
+
+        TextureArrayPacker m_textureArrayPacker;
+        std::shared_ptr<Sampler> m_sampler;
+
+        uint64_t m_residentMemory = 0;
+        uint64_t m_pendingMemory = 0; // Memory of the mips being read to upgrade textures
+        uint64_t m_frameIndex = 0;
+    };
+} // namespace DX
@@ -0,0 +1,295 @@
+#include <Assets/AssetManager.h>
+#include <File/FileUtils.h>
+
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+#include <iterator>
+
+namespace UnitTest
+{
+    struct TestData
+    {
+        uintmax_t m_fileSize = 0;
+    };
+
+    // Asset type only used by the tests, its data is the size of the file.
+    class TestAsset : public DX::Asset<TestData>
+    {
+    public:
+        static inline const DX::AssetType AssetTypeId = 0x5E57A55E;
+
+        DX::AssetType GetAssetType() const override
+        {
+            return AssetTypeId;
+        }
+
+        size_t GetDataSizeInBytes() const override
+        {
+            return m_data ? static_cast<size_t>(m_data->m_fileSize) : 0;
+        }
+
+    protected:
+        friend class DX::AssetManager;
+
+        TestAsset(const std::string& fileName, std::shared_ptr<TestData> data)
+            : Asset<TestData>(fileName, std::move(data))
+        {
+        }
+    };
+
+    class AssetManagerTests
+    {
+    public:
+        AssetManagerTests()
+        {
+            TestLoadOnce();
+            TestLookupThroughput();
+            TestMemoryBudget();
+            TestDeduplication();
+        }
+
+    private:
+        void TestLoadOnce();
+        void TestLookupThroughput();
+        void TestMemoryBudget();
+        void TestDeduplication();
+
+        // Runs the function in ThreadCount threads at the same time.
+        template<typename Func>
+        void RunInThreads(Func func);
+
+        static constexpr int ThreadCount = 32;
+
+        const std::vector<std::string> m_fileNames = {
+            "Shaders/VertexShader.hlsl",
+            "Shaders/PixelShader.hlsl",
+            "Shaders/Tests/VertexShaderTest.hlsl",
+            "Shaders/Tests/PixelShaderTest.hlsl",
+            "Textures/Wall_Stone_AO.png",
+            "Textures/Wall_Stone_Height.png",
+            "Textures/Wall_Stone_Roughness.png",
+            "Models/Jack/Jack.fbx",
+            "Models/Lantern/Lantern.gltf",
+            "Models/DamagedHelmet/DamagedHelmet.gltf",
+        };
+
+        std::vector<std::shared_ptr<TestAsset>> m_loadedAssets;
+    };
+
+    void TestsAssetManager()
+    {
+        {
+            AssetManagerTests tests;
+        }
+
+        DX::AssetManager::Destroy();
+
+        DX_LOG(Info, "Test", " --------------------------");
+    }
+
+    template<typename Func>
+    void AssetManagerTests::RunInThreads(Func func)
+    {
+        std::atomic<int> readyThreads = 0;
+
+        std::vector<std::thread> threads;
+        threads.reserve(ThreadCount);
+        for (int threadIndex = 0; threadIndex < ThreadCount; ++threadIndex)
+        {
+            threads.emplace_back([&, threadIndex]()
+                {
+                    // Wait for all threads to be created so they start at the same time.
+                    ++readyThreads;
+                    while (readyThreads < ThreadCount)
+                    {
+                        std::this_thread::yield();
+                    }
+
+                    func(threadIndex);
+                });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    void AssetManagerTests::TestLoadOnce()
+    {
+        DX_LOG(Info, "Test", " ----- Testing AssetManager Load Once -----");
+
+        std::atomic<int> loadCount = 0;
+
+        DX::LoadDataFunc<TestAsset> loadTestData = [&loadCount](const std::string&, std::span<const uint8_t> fileData)
+            {
+                ++loadCount;
+
+                // Keep the load in flight for a while so other threads request it meanwhile.
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+                auto data = std::make_unique<TestData>();
+                data->m_fileSize = fileData.size();
+                return data;
+            };
+
+        RunInThreads([&](int threadIndex)
+            {
+                for (const auto& fileName : m_fileNames)
+                {
+                    // Half of the threads load synchronously and the other half asynchronously.
+                    std::shared_ptr<TestAsset> asset = (threadIndex % 2 == 0)
+                        ? DX::AssetManager::Get().LoadAssetAs<TestAsset>(fileName, loadTestData)
+                        : DX::AssetManager::Get().LoadAssetAsync<TestAsset>(fileName, loadTestData).Get();
+
+                    DX_ASSERT(asset != nullptr, "AssetManagerTests", "Failed to load asset %s.", fileName.c_str());
+                    DX_ASSERT(asset->GetFileName() == fileName, "AssetManagerTests", "Unexpected asset %s.", asset->GetFileName().c_str());
+                }
+            });
+
+        DX_ASSERT(loadCount == static_cast<int>(m_fileNames.size()), "AssetManagerTests",
+            "Assets loaded %d times, expected %zu.", loadCount.load(), m_fileNames.size());
+
+        for (const auto& fileName : m_fileNames)
+        {
+            m_loadedAssets.push_back(DX::AssetManager::Get().GetAssetAs<TestAsset>(DX::MakeAssetId(fileName)));
+        }
+    }
+
+    void AssetManagerTests::TestLookupThroughput()
+    {
+        DX_LOG(Info, "Test", " ----- Testing AssetManager Lookup Throughput -----");
+
+        static constexpr int LookupsPerThread = 100000;
+
+        std::vector<DX::AssetId> assetIds;
+        std::ranges::transform(m_fileNames, std::back_inserter(assetIds), DX::MakeAssetId);
+
+        std::atomic<int> failedLookups = 0;
+
+        const auto startTime = std::chrono::steady_clock::now();
+
+        RunInThreads([&](int threadIndex)
+            {
+                for (int i = 0; i < LookupsPerThread; ++i)
+                {
+                    const DX::AssetId assetId = assetIds[(threadIndex + i) % assetIds.size()];
+                    if (!DX::AssetManager::Get().GetAsset(assetId))
+                    {
+                        ++failedLookups;
+                    }
+                }
+            });
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+        DX_ASSERT(failedLookups == 0, "AssetManagerTests", "%d lookups failed.", failedLookups.load());
+
+        [[maybe_unused]] const double totalLookups = static_cast<double>(ThreadCount) * LookupsPerThread;
+        DX_LOG(Info, "Test", "%d threads did %.0f lookups in %.3f seconds (%.2f million lookups/sec).",
+            ThreadCount, totalLookups, elapsed.count(), totalLookups / elapsed.count() / 1000000.0);
+    }
+
+    void AssetManagerTests::TestMemoryBudget()
+    {
+        DX_LOG(Info, "Test", " ----- Testing AssetManager Memory Budget -----");
+
+        DX::AssetManager& assetManager = DX::AssetManager::Get();
+
+        [[maybe_unused]] const size_t memoryUsage = std::accumulate(m_loadedAssets.begin(), m_loadedAssets.end(), size_t{ 0 },
+            [](size_t total, const auto& asset) { return total + asset->GetDataSizeInBytes(); });
+
+        DX_ASSERT(assetManager.GetMemoryUsage() == memoryUsage, "AssetManagerTests",
+            "Memory usage is %zu bytes, expected %zu.", assetManager.GetMemoryUsage(), memoryUsage);
+        DX_ASSERT(assetManager.GetMemoryUsage(TestAsset::AssetTypeId) == memoryUsage, "AssetManagerTests",
+            "Memory usage of test assets is %zu bytes, expected %zu.", assetManager.GetMemoryUsage(TestAsset::AssetTypeId), memoryUsage);
+
+        // Assets referenced outside the manager are never evicted.
+        assetManager.SetMemoryBudget(0);
+        assetManager.Update();
+        DX_ASSERT(assetManager.GetMemoryUsage() == memoryUsage, "AssetManagerTests", "Referenced assets were evicted.");
+
+        // Once released, the least recently used assets are evicted first until within budget.
+        std::shared_ptr<TestAsset> lastAsset = m_loadedAssets.back();
+        m_loadedAssets.clear();
+        assetManager.GetAsset(lastAsset->GetAssetId());
+
+        assetManager.SetMemoryBudget(lastAsset->GetDataSizeInBytes());
+        assetManager.Update();
+        DX_ASSERT(assetManager.GetMemoryUsage() <= lastAsset->GetDataSizeInBytes(), "AssetManagerTests",
+            "Memory usage %zu bytes is over budget.", assetManager.GetMemoryUsage());
+        DX_ASSERT(assetManager.GetAsset(lastAsset->GetAssetId()) != nullptr, "AssetManagerTests", "Referenced asset was evicted.");
+
+        // Data still referenced outside the manager is not released.
+        const DX::AssetId lastAssetId = lastAsset->GetAssetId();
+        DX_ASSERT(!assetManager.ReleaseAssetData(lastAssetId) && lastAsset->GetData() != nullptr,
+            "AssetManagerTests", "Asset data released while still referenced.");
+
+        // Releasing the data once unreferenced removes the asset from the manager.
+        lastAsset.reset();
+        [[maybe_unused]] const bool released = assetManager.ReleaseAssetData(lastAssetId);
+        DX_ASSERT(released && !assetManager.GetAsset(lastAssetId), "AssetManagerTests", "Asset data was not released.");
+        DX_ASSERT(assetManager.GetMemoryUsage() == 0, "AssetManagerTests",
+            "Memory usage is %zu bytes after releasing all assets.", assetManager.GetMemoryUsage());
+
+        assetManager.SetMemoryBudget(DX::AssetManager::DefaultMemoryBudget);
+    }
+
+    void AssetManagerTests::TestDeduplication()
+    {
+        DX_LOG(Info, "Test", " ----- Testing AssetManager Deduplication -----");
+
+        DX::AssetManager& assetManager = DX::AssetManager::Get();
+
+        DX::LoadDataFunc<TestAsset> loadTestData = [](const std::string&, std::span<const uint8_t> fileData)
+            {
+                auto data = std::make_unique<TestData>();
+                data->m_fileSize = fileData.size();
+                return data;
+            };
+
+        // Two files with identical content.
+        const std::vector<std::string> fileNames = { "AssetManagerTests0.bin", "AssetManagerTests1.bin" };
+        const std::vector<uint8_t> fileData(1024, 0xDD);
+        for (const auto& fileName : fileNames)
+        {
+            DX::WriteFileAtomically(DX::GetAssetPath() / fileName, fileData);
+        }
+
+        std::shared_ptr<TestAsset> firstAsset = assetManager.LoadAssetAs<TestAsset>(fileNames[0], loadTestData);
+        std::shared_ptr<TestAsset> secondAsset = assetManager.LoadAssetAs<TestAsset>(fileNames[1], loadTestData);
+        DX_ASSERT(firstAsset && secondAsset && firstAsset->GetData() == secondAsset->GetData(),
+            "AssetManagerTests", "Assets with identical content don't share data.");
+
+        // Shared data is accounted once.
+        DX_ASSERT(assetManager.GetMemoryUsage() == fileData.size() && assetManager.GetDeduplicatedMemory() == fileData.size(),
+            "AssetManagerTests", "Memory usage is %zu bytes and deduplicated memory %zu bytes, expected %zu.",
+            assetManager.GetMemoryUsage(), assetManager.GetDeduplicatedMemory(), fileData.size());
+
+        // Releasing the asset that loaded the data keeps it accounted while the other asset uses it.
+        const DX::AssetId firstAssetId = firstAsset->GetAssetId();
+        firstAsset.reset();
+        assetManager.ReleaseAssetData(firstAssetId);
+        DX_ASSERT(assetManager.GetMemoryUsage() == fileData.size() && assetManager.GetDeduplicatedMemory() == 0,
+            "AssetManagerTests", "Memory usage is %zu bytes and deduplicated memory %zu bytes, expected %zu and 0.",
+            assetManager.GetMemoryUsage(), assetManager.GetDeduplicatedMemory(), fileData.size());
+
+        const DX::AssetId secondAssetId = secondAsset->GetAssetId();
+        secondAsset.reset();
+        assetManager.ReleaseAssetData(secondAssetId);
+        DX_ASSERT(assetManager.GetMemoryUsage() == 0, "AssetManagerTests",
+            "Memory usage is %zu bytes after releasing all assets.", assetManager.GetMemoryUsage());
+
+        for (const auto& fileName : fileNames)
+        {
+            std::filesystem::remove(DX::GetAssetPath() / fileName);
+        }
+    }
+}
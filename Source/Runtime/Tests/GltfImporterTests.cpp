@@ -0,0 +1,220 @@
+#include <Assets/GltfImporter.h>
+#include <Assets/MeshAsset.h>
+#include <File/FileUtils.h>
+
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <vector>
+#include <string>
+
+namespace UnitTest
+{
+    class GltfImporterTests
+    {
+    public:
+        GltfImporterTests()
+        {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(DX::GetAssetPath() / "Models"))
+            {
+                if (entry.is_regular_file() && entry.path().extension() == ".gltf")
+                {
+                    m_fileNames.push_back(std::filesystem::relative(entry.path(), DX::GetAssetPath()).generic_string());
+                }
+            }
+
+            TestImport();
+            TestInvalidAccessors();
+            TestImportPerformance();
+        }
+
+    private:
+        using ImportFunction = std::function<std::unique_ptr<DX::MeshData>(const std::string&)>;
+
+        void TestImport();
+        void TestInvalidAccessors();
+        void TestImportPerformance();
+
+        // Writes a gltf file with a triangle whose attributes use the accessor count given.
+        static void WriteTriangleGltf(const std::string& fileName, const std::string& accessorCount);
+
+        // Returns the average time in milliseconds to import the file.
+        double MeasureImportTime(const std::string& fileName, const ImportFunction& importFunction) const;
+
+        std::vector<std::string> m_fileNames;
+    };
+
+    void TestsGltfImporter()
+    {
+        {
+            GltfImporterTests tests;
+        }
+
+        DX_LOG(Info, "Test", " --------------------------");
+    }
+
+    void GltfImporterTests::TestImport()
+    {
+        DX_LOG(Info, "Test", " ----- Testing GltfImporter Import -----");
+
+        auto isNear = [](const auto& lhs, const auto& rhs, int componentCount)
+            {
+                for (int i = 0; i < componentCount; ++i)
+                {
+                    if (std::abs(lhs.data_[i] - rhs.data_[i]) > 1e-4f)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+
+        for (const auto& fileName : m_fileNames)
+        {
+            std::vector<std::string> dependencies;
+            const auto meshData = DX::ImportGltfMesh(fileName, &dependencies);
+            const auto assimpMeshData = DX::MeshAsset::ImportMeshWithAssimp(fileName);
+            DX_ASSERT(meshData != nullptr, "GltfImporterTests", "Failed to import %s.", fileName.c_str());
+            DX_ASSERT(assimpMeshData != nullptr, "GltfImporterTests", "Failed to import %s with assimp.", fileName.c_str());
+            DX_ASSERT(dependencies.size() >= 2 && dependencies.front() == fileName, "GltfImporterTests", "Dependencies of %s are missing.", fileName.c_str());
+
+            // Both importers must produce the same mesh, except the generated tangents which can differ slightly.
+            const size_t vertexCount = meshData->m_positions.size();
+            DX_ASSERT(vertexCount == assimpMeshData->m_positions.size(), "GltfImporterTests",
+                "%s has %zu vertices, %zu with assimp.", fileName.c_str(), vertexCount, assimpMeshData->m_positions.size());
+            DX_ASSERT(meshData->m_indices == assimpMeshData->m_indices, "GltfImporterTests", "%s indices are different.", fileName.c_str());
+            DX_ASSERT(meshData->m_textCoords.size() == vertexCount &&
+                meshData->m_normals.size() == vertexCount &&
+                meshData->m_tangents.size() == vertexCount &&
+                meshData->m_binormals.size() == vertexCount, "GltfImporterTests", "%s vertex attributes have different counts.", fileName.c_str());
+
+            [[maybe_unused]] int differentVertices = 0;
+            [[maybe_unused]] int differentTangents = 0;
+            for (size_t i = 0; i < vertexCount && vertexCount == assimpMeshData->m_positions.size(); ++i)
+            {
+                if (!isNear(meshData->m_positions[i], assimpMeshData->m_positions[i], 3) ||
+                    !isNear(meshData->m_textCoords[i], assimpMeshData->m_textCoords[i], 2) ||
+                    !isNear(meshData->m_normals[i], assimpMeshData->m_normals[i], 3))
+                {
+                    ++differentVertices;
+                }
+
+                const Math::Vector3 tangent(meshData->m_tangents[i]);
+                const Math::Vector3 assimpTangent(assimpMeshData->m_tangents[i]);
+                if (Math::Dot(tangent, assimpTangent) < 0.9f)
+                {
+                    ++differentTangents;
+                }
+            }
+            DX_ASSERT(differentVertices == 0, "GltfImporterTests", "%s has %d vertices different from assimp.", fileName.c_str(), differentVertices);
+
+            // Sub-meshes must match and their bounds contain their vertices.
+            DX_ASSERT(!meshData->m_subMeshes.empty() && meshData->m_subMeshes.size() == assimpMeshData->m_subMeshes.size(), "GltfImporterTests",
+                "%s has %zu sub-meshes, %zu with assimp.", fileName.c_str(), meshData->m_subMeshes.size(), assimpMeshData->m_subMeshes.size());
+            for (size_t i = 0; i < meshData->m_subMeshes.size() && i < assimpMeshData->m_subMeshes.size(); ++i)
+            {
+                [[maybe_unused]] const DX::SubMesh& subMesh = meshData->m_subMeshes[i];
+                [[maybe_unused]] const DX::SubMesh& assimpSubMesh = assimpMeshData->m_subMeshes[i];
+                DX_ASSERT(subMesh.m_indexOffset == assimpSubMesh.m_indexOffset &&
+                    subMesh.m_indexCount == assimpSubMesh.m_indexCount &&
+                    subMesh.m_vertexOffset == assimpSubMesh.m_vertexOffset &&
+                    subMesh.m_vertexCount == assimpSubMesh.m_vertexCount &&
+                    subMesh.m_materialIndex == assimpSubMesh.m_materialIndex, "GltfImporterTests", "%s sub-mesh %zu is different.", fileName.c_str(), i);
+                DX_ASSERT(isNear(subMesh.m_aabbMin, assimpSubMesh.m_aabbMin, 3) &&
+                    isNear(subMesh.m_aabbMax, assimpSubMesh.m_aabbMax, 3), "GltfImporterTests", "%s sub-mesh %zu bounds are different.", fileName.c_str(), i);
+
+                for (uint32_t vertex = subMesh.m_vertexOffset; vertex < subMesh.m_vertexOffset + subMesh.m_vertexCount && vertex < vertexCount; ++vertex)
+                {
+                    [[maybe_unused]] const Math::Vector3 position(meshData->m_positions[vertex]);
+                    DX_ASSERT((position - Math::Vector3(subMesh.m_sphereCenter)).Length() <= subMesh.m_sphereRadius * 1.0001f + 1e-5f,
+                        "GltfImporterTests", "%s sub-mesh %zu vertex %u is outside its bounding sphere.", fileName.c_str(), i, vertex);
+                }
+            }
+
+            DX_LOG(Info, "Test", "%s: %zu vertices, %zu indices, %zu sub-meshes, %d tangents differ from assimp by more than 25 degrees.",
+                fileName.c_str(), vertexCount, meshData->m_indices.size(), meshData->m_subMeshes.size(), differentTangents);
+        }
+    }
+
+    void GltfImporterTests::WriteTriangleGltf(const std::string& fileName, const std::string& accessorCount)
+    {
+        const std::string json = R"({
+            "asset": { "version": "2.0" },
+            "scene": 0,
+            "scenes": [ { "nodes": [ 0 ] } ],
+            "nodes": [ { "mesh": 0 } ],
+            "meshes": [ { "primitives": [ { "attributes": { "POSITION": 0, "NORMAL": 1, "TEXCOORD_0": 2 } } ] } ],
+            "buffers": [ { "uri": "GltfImporterTests.bin", "byteLength": 36 } ],
+            "bufferViews": [ { "buffer": 0, "byteLength": 36, "byteStride": 12 } ],
+            "accessors": [
+                { "bufferView": 0, "componentType": 5126, "type": "VEC3", "count": )" + accessorCount + R"( },
+                { "bufferView": 0, "componentType": 5126, "type": "VEC3", "count": )" + accessorCount + R"( },
+                { "bufferView": 0, "componentType": 5126, "type": "VEC2", "count": )" + accessorCount + R"( }
+            ]
+        })";
+
+        DX::WriteFileAtomically(DX::GetAssetPath() / fileName, std::span(reinterpret_cast<const uint8_t*>(json.data()), json.size()));
+    }
+
+    void GltfImporterTests::TestInvalidAccessors()
+    {
+        DX_LOG(Info, "Test", " ----- Testing GltfImporter Invalid Accessors -----");
+
+        const std::string fileName = "GltfImporterTests.gltf";
+        const std::vector<uint8_t> bufferData(36, 0);
+        DX::WriteFileAtomically(DX::GetAssetPath() / "GltfImporterTests.bin", bufferData);
+
+        // Three vertices fill the buffer view.
+        WriteTriangleGltf(fileName, "3");
+        [[maybe_unused]] const auto meshData = DX::ImportGltfMesh(fileName);
+        DX_ASSERT(meshData && meshData->m_positions.size() == 3, "GltfImporterTests", "Failed to import triangle.");
+
+        // One vertex more than the buffer view has.
+        WriteTriangleGltf(fileName, "4");
+        DX_ASSERT(!DX::ImportGltfMesh(fileName), "GltfImporterTests", "Accessors outside their buffer view imported.");
+
+        // Counts so big their end offset overflows and wraps around to inside the buffer view.
+        WriteTriangleGltf(fileName, "1537228672809129303");
+        DX_ASSERT(!DX::ImportGltfMesh(fileName), "GltfImporterTests", "Accessors with overflowing counts imported.");
+
+        std::filesystem::remove(DX::GetAssetPath() / fileName);
+        std::filesystem::remove(DX::GetAssetPath() / "GltfImporterTests.bin");
+    }
+
+    void GltfImporterTests::TestImportPerformance()
+    {
+        DX_LOG(Info, "Test", " ----- Testing GltfImporter Import Performance -----");
+
+        for (const auto& fileName : m_fileNames)
+        {
+            [[maybe_unused]] const double gltfImporterTime = MeasureImportTime(fileName,
+                [](const std::string& fileName) { return DX::ImportGltfMesh(fileName); });
+            [[maybe_unused]] const double assimpTime = MeasureImportTime(fileName,
+                [](const std::string& fileName) { return DX::MeshAsset::ImportMeshWithAssimp(fileName); });
+
+            DX_LOG(Info, "Test", "%s: GltfImporter %.2f ms, assimp %.2f ms (%.1fx faster)",
+                fileName.c_str(), gltfImporterTime, assimpTime, assimpTime / gltfImporterTime);
+        }
+    }
+
+    double GltfImporterTests::MeasureImportTime(const std::string& fileName, const ImportFunction& importFunction) const
+    {
+        static constexpr int ImportCount = 10;
+
+        // The first import reads the files from disk, the measured ones from the OS cache.
+        importFunction(fileName);
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < ImportCount; ++i)
+        {
+            [[maybe_unused]] const auto meshData = importFunction(fileName);
+            DX_ASSERT(meshData != nullptr, "GltfImporterTests", "Failed to import %s.", fileName.c_str());
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        return std::chrono::duration<double, std::milli>(end - start).count() / ImportCount;
+    }
+}
@@ -0,0 +1,155 @@
+#include <Renderer/PipelineLibrary.h>
+
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace UnitTest
+{
+    class PipelineLibraryTests
+    {
+    public:
+        PipelineLibraryTests()
+            : m_filePath(std::filesystem::temp_directory_path() / "PipelineLibraryTests.bin")
+        {
+            std::filesystem::remove(m_filePath);
+
+            TestSaveAndLoad();
+            TestInvalidFile();
+
+            std::filesystem::remove(m_filePath);
+        }
+
+    private:
+        void TestSaveAndLoad();
+        void TestInvalidFile();
+
+        // Variant of a pipeline like the scene's, with the features of the pixel shader.
+        static DX::PipelineObjectDesc CreateDesc(DX::ShaderPermutationKey permutationKey)
+        {
+            DX::PipelineObjectDesc desc;
+            desc.m_shaderFilenames[DX::ShaderType_Vertex] = "Shaders/VertexShader.hlsl";
+            desc.m_shaderFilenames[DX::ShaderType_Pixel] = "Shaders/PixelShader.hlsl";
+            desc.m_shaderFeatures[DX::ShaderType_Pixel] = {
+                DX::ShaderFeature{ 1 << 0, "EMISSIVE_MAP" },
+                DX::ShaderFeature{ 1 << 1, "NORMAL_MAP" },
+            };
+            desc.m_permutationKey = permutationKey;
+            desc.m_inputElements = {
+                DX::InputElement{ DX::InputSemantic::Position, 0, DX::ResourceFormat::R32G32B32_FLOAT, 0, 0 },
+                DX::InputElement{ DX::InputSemantic::TexCoord, 0, DX::ResourceFormat::R32G32_FLOAT, 0, 12 },
+            };
+            desc.m_blendState = {
+                .m_blendEnabled = false,
+                .m_colorWriteMask = DX::ColorWrite_All
+            };
+            desc.m_depthStencilState = {
+                .m_depthEnabled = true,
+                .m_depthTestFunc = DX::ComparisonFunction::Less,
+                .m_depthWriteEnabled = true,
+                .m_stencilEnabled = false
+            };
+            return desc;
+        }
+
+        static std::vector<DX::ShaderPermutationKey> GetPermutationKeys(const DX::PipelineLibrary& pipelineLibrary)
+        {
+            std::vector<DX::ShaderPermutationKey> permutationKeys;
+            for (const auto& entry : pipelineLibrary.GetEntries())
+            {
+                permutationKeys.push_back(entry.m_desc.m_permutationKey);
+            }
+            return permutationKeys;
+        }
+
+        std::filesystem::path m_filePath;
+    };
+
+    void TestsPipelineLibrary()
+    {
+        {
+            PipelineLibraryTests tests;
+        }
+
+        DX_LOG(Info, "Test", " --------------------------");
+    }
+
+    void PipelineLibraryTests::TestSaveAndLoad()
+    {
+        DX_LOG(Info, "Test", " ----- Testing PipelineLibrary Save And Load -----");
+
+        // First run, variants 3 and 1 drawn in the first frame and 2 later.
+        {
+            DX::PipelineLibrary pipelineLibrary(m_filePath);
+            DX_ASSERT(pipelineLibrary.GetEntries().empty(), "PipelineLibraryTests", "Library without file is not empty.");
+
+            pipelineLibrary.Record(CreateDesc(2), 10);
+            pipelineLibrary.Record(CreateDesc(3), 0);
+            pipelineLibrary.Record(CreateDesc(1), 0);
+            pipelineLibrary.Record(CreateDesc(2), 20);
+            DX_ASSERT(pipelineLibrary.GetEntries().size() == 3, "PipelineLibraryTests", "Descriptions recorded twice.");
+
+            [[maybe_unused]] const bool saved = pipelineLibrary.Save();
+            DX_ASSERT(saved, "PipelineLibraryTests", "Failed to save pipeline library.");
+        }
+
+        // Second run, the pipelines of the first frame come first, in the order recorded.
+        {
+            DX::PipelineLibrary pipelineLibrary(m_filePath);
+            DX_ASSERT(GetPermutationKeys(pipelineLibrary) == std::vector<DX::ShaderPermutationKey>({ 3, 1, 2 }),
+                "PipelineLibraryTests", "Pipelines not loaded in the order they were first drawn.");
+
+            [[maybe_unused]] const DX::PipelineObjectDesc& loadedDesc = pipelineLibrary.GetEntries().front().m_desc;
+            DX_ASSERT(DX::PipelineLibrary::HashDesc(loadedDesc) == DX::PipelineLibrary::HashDesc(CreateDesc(3)) &&
+                loadedDesc.m_shaderFeatures[DX::ShaderType_Pixel].size() == 2 &&
+                loadedDesc.m_inputElements.size() == 2 &&
+                loadedDesc.m_depthStencilState.m_depthTestFunc == DX::ComparisonFunction::Less,
+                "PipelineLibraryTests", "Pipeline description loaded is different than the one saved.");
+
+            // Variant 2 drawn in the first frame this time, the shaders of variant 1 changed.
+            pipelineLibrary.Record(CreateDesc(2), 0);
+            pipelineLibrary.Remove(CreateDesc(1));
+
+            DX::PipelineObjectDesc changedDesc = CreateDesc(4);
+            changedDesc.m_shaderFilenames[DX::ShaderType_Pixel] = "Shaders/OtherPixelShader.hlsl";
+            DX_ASSERT(!pipelineLibrary.Contains(changedDesc), "PipelineLibraryTests", "Pipeline with other shaders found in library.");
+            pipelineLibrary.Record(changedDesc, 5);
+
+            pipelineLibrary.Save();
+        }
+
+        {
+            DX::PipelineLibrary pipelineLibrary(m_filePath);
+            DX_ASSERT(GetPermutationKeys(pipelineLibrary) == std::vector<DX::ShaderPermutationKey>({ 3, 2, 4 }),
+                "PipelineLibraryTests", "Pipelines recorded in the second run not saved.");
+            DX_ASSERT(pipelineLibrary.Contains(CreateDesc(2)) && !pipelineLibrary.Contains(CreateDesc(1)),
+                "PipelineLibraryTests", "Pipeline removed still in library.");
+        }
+    }
+
+    void PipelineLibraryTests::TestInvalidFile()
+    {
+        DX_LOG(Info, "Test", " ----- Testing PipelineLibrary Invalid File -----");
+
+        // Truncated file, the pipelines fully read are kept.
+        {
+            const auto fileSize = std::filesystem::file_size(m_filePath);
+            std::filesystem::resize_file(m_filePath, fileSize - 4);
+
+            DX::PipelineLibrary pipelineLibrary(m_filePath);
+            DX_ASSERT(GetPermutationKeys(pipelineLibrary) == std::vector<DX::ShaderPermutationKey>({ 3, 2 }),
+                "PipelineLibraryTests", "Pipelines of truncated library not loaded.");
+        }
+
+        // Not a pipeline library.
+        {
+            std::ofstream(m_filePath, std::ios::binary) << "Not a pipeline library";
+
+            DX::PipelineLibrary pipelineLibrary(m_filePath);
+            DX_ASSERT(pipelineLibrary.GetEntries().empty(), "PipelineLibraryTests", "Pipelines loaded from invalid file.");
+        }
+    }
+} // namespace UnitTest
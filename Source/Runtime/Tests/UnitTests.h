@@ -0,0 +1,8 @@
+#pragma once
+
+namespace UnitTest
+{
+    void TestsAssetManager();
+    void TestsGltfImporter();
+    void TestsPipelineLibrary();
+}
@@ -0,0 +1,15 @@
+#include <UnitTests.h>
+
+int main()
+{
+    // Tests loading and looking up assets from many threads
+    UnitTest::TestsAssetManager();
+
+    // Tests importing gltf files natively and compares it with assimp
+    UnitTest::TestsGltfImporter();
+
+    // Tests saving the pipelines used and loading them by priority to warm them up
+    UnitTest::TestsPipelineLibrary();
+
+    return 0;
+}
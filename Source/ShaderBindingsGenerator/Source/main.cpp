@@ -0,0 +1,91 @@
+#include <RHI/Shader/ShaderCompiler/ShaderCompiler.h>
+#include <RHI/Shader/ShaderCompiler/ShaderBindingsGenerator.h>
+#include <File/FileUtils.h>
+#include <Log/Log.h>
+
+#include <cstdio>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::printf("Usage: ShaderBindingsGenerator OutputHeader BindingsName Stage:Shader...\n");
+        std::printf("Example: ShaderBindingsGenerator SceneShaderBindings.h SceneShaderBindings Vertex:Shaders/VertexShader.hlsl Pixel:Shaders/PixelShader.hlsl\n");
+    }
+
+    std::optional<DX::ShaderType> ParseShaderType(std::string_view stage)
+    {
+        for (int i = DX::ShaderType_Unknown + 1; i < DX::ShaderType_Count; ++i)
+        {
+            if (stage == DX::ShaderTypeStr(static_cast<DX::ShaderType>(i)))
+            {
+                return static_cast<DX::ShaderType>(i);
+            }
+        }
+        return std::nullopt;
+    }
+}
+
+// Generates the header with the bindings of a set of shaders (see ShaderBindings.h).
+// Shaders are relative to the assets folder and use "main" as entry point.
+int main(int argc, char* argv[])
+{
+    if (argc < 4)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    const std::filesystem::path outputHeader = argv[1];
+    const std::string bindingsName = argv[2];
+
+    std::vector<DX::ShaderReflection> shaders;
+    for (int i = 3; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        const size_t separator = argument.find(':');
+        const auto shaderType = (separator != std::string_view::npos)
+            ? ParseShaderType(argument.substr(0, separator))
+            : std::nullopt;
+        if (!shaderType.has_value())
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        DX::ShaderInfo shaderInfo = {};
+        shaderInfo.m_shaderType = *shaderType;
+        shaderInfo.m_name = argument.substr(separator + 1);
+        shaderInfo.m_entryPoint = "main";
+
+        auto shaderReflection = DX::ShaderCompiler::Reflect(shaderInfo);
+        if (!shaderReflection.has_value())
+        {
+            DX_LOG(Error, "Main", "Failed to reflect shader %s.", shaderInfo.m_name.c_str());
+            return 1;
+        }
+        shaders.push_back(std::move(*shaderReflection));
+    }
+
+    const auto header = DX::GenerateShaderBindingsHeader(bindingsName, shaders);
+    if (!header.has_value())
+    {
+        DX_LOG(Error, "Main", "Failed to generate shader bindings %s.", bindingsName.c_str());
+        return 1;
+    }
+
+    std::filesystem::create_directories(outputHeader.parent_path());
+    if (!DX::WriteFileAtomically(outputHeader, std::span(reinterpret_cast<const uint8_t*>(header->data()), header->size())))
+    {
+        DX_LOG(Error, "Main", "Failed to write %s.", outputHeader.string().c_str());
+        return 1;
+    }
+
+    DX_LOG(Info, "Main", "Generated %s.", outputHeader.string().c_str());
+    return 0;
+}
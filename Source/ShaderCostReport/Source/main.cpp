@@ -0,0 +1,210 @@
+#include <RHI/Shader/ShaderCompiler/ShaderCompiler.h>
+#include <RHI/Shader/ShaderCompiler/ShaderReport.h>
+#include <Log/Log.h>
+
+#include <charconv>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    // Exit code when a statistic increased more than the threshold.
+    constexpr int RegressionExitCode = 2;
+
+    constexpr double DefaultThresholdPercent = 10.0;
+
+    void PrintUsage()
+    {
+        std::printf("Usage:\n");
+        std::printf("  ShaderCostReport compile ReportFolder Stage:Shader[:Feature,Feature...]...\n");
+        std::printf("      Compiles all the variants of the shaders and writes their reports to the folder.\n");
+        std::printf("  ShaderCostReport diff BaseReportFolder NewReportFolder [--threshold Percent]\n");
+        std::printf("      Compares two report sets. Returns %d when a statistic of a variant increases\n", RegressionExitCode);
+        std::printf("      more than the threshold (%.0f%% by default).\n", DefaultThresholdPercent);
+        std::printf("Example: ShaderCostReport compile Reports Vertex:Shaders/VertexShader.hlsl Pixel:Shaders/PixelShader.hlsl:EMISSIVE_MAP,NORMAL_MAP\n");
+    }
+
+    std::optional<DX::ShaderType> ParseShaderType(std::string_view stage)
+    {
+        for (int i = DX::ShaderType_Unknown + 1; i < DX::ShaderType_Count; ++i)
+        {
+            if (stage == DX::ShaderTypeStr(static_cast<DX::ShaderType>(i)))
+            {
+                return static_cast<DX::ShaderType>(i);
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Parses "Stage:Shader[:Feature,Feature...]", each feature is a bit of the permutation key.
+    std::optional<DX::ShaderInfo> ParseShader(std::string_view argument)
+    {
+        const size_t stageSeparator = argument.find(':');
+        if (stageSeparator == std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+
+        const auto shaderType = ParseShaderType(argument.substr(0, stageSeparator));
+        if (!shaderType.has_value())
+        {
+            return std::nullopt;
+        }
+
+        std::string_view shaderName = argument.substr(stageSeparator + 1);
+        std::string_view features;
+        if (const size_t featuresSeparator = shaderName.find(':');
+            featuresSeparator != std::string_view::npos)
+        {
+            features = shaderName.substr(featuresSeparator + 1);
+            shaderName = shaderName.substr(0, featuresSeparator);
+        }
+
+        DX::ShaderInfo shaderInfo = {};
+        shaderInfo.m_shaderType = *shaderType;
+        shaderInfo.m_name = shaderName;
+        shaderInfo.m_entryPoint = "main";
+
+        while (!features.empty())
+        {
+            const size_t separator = features.find(',');
+            const std::string_view feature = features.substr(0, separator);
+            if (!feature.empty())
+            {
+                const auto bit = static_cast<DX::ShaderPermutationKey>(1u << shaderInfo.m_features.size());
+                shaderInfo.m_features.push_back({ bit, std::string(feature) });
+            }
+            features = (separator != std::string_view::npos) ? features.substr(separator + 1) : std::string_view();
+        }
+
+        return shaderInfo;
+    }
+
+    int Compile(const std::filesystem::path& reportFolder, const std::vector<DX::ShaderInfo>& shaders)
+    {
+        DX::ShaderCompiler::SetReportFolder(reportFolder);
+
+        int exitCode = 0;
+        for (const auto& shader : shaders)
+        {
+            const DX::ShaderPermutationKey variantCount = 1u << shader.m_features.size();
+            for (DX::ShaderPermutationKey permutationKey = 0; permutationKey < variantCount; ++permutationKey)
+            {
+                DX::ShaderInfo variant = shader;
+                variant.m_permutationKey = permutationKey;
+                if (!DX::ShaderCompiler::Compile(variant))
+                {
+                    DX_LOG(Error, "Main", "Failed to compile shader %s variant 0x%x.", shader.m_name.c_str(), permutationKey);
+                    exitCode = 1;
+                }
+            }
+        }
+
+        DX_LOG(Info, "Main", "Shader reports written to %s.", reportFolder.string().c_str());
+        return exitCode;
+    }
+
+    int Diff(const std::filesystem::path& baseReportFolder, const std::filesystem::path& newReportFolder, double thresholdPercent)
+    {
+        const auto baseReports = DX::LoadShaderReports(baseReportFolder);
+        const auto newReports = DX::LoadShaderReports(newReportFolder);
+        if (baseReports.empty() || newReports.empty())
+        {
+            DX_LOG(Error, "Main", "No shader reports to compare.");
+            return 1;
+        }
+
+        const auto diffs = DX::DiffShaderReports(baseReports, newReports);
+
+        uint32_t regressionCount = 0;
+        for (const auto& diff : diffs)
+        {
+            if (!diff.m_baseStatistics.has_value())
+            {
+                std::printf("%s: added\n", diff.m_id.c_str());
+                continue;
+            }
+            if (!diff.m_newStatistics.has_value())
+            {
+                std::printf("%s: removed\n", diff.m_id.c_str());
+                continue;
+            }
+
+            std::printf("%s:\n", diff.m_id.c_str());
+            for (const auto& statistic : DX::ShaderStatisticsList)
+            {
+                const uint32_t baseValue = (*diff.m_baseStatistics).*statistic.m_value;
+                const uint32_t newValue = (*diff.m_newStatistics).*statistic.m_value;
+                if (baseValue == newValue)
+                {
+                    continue;
+                }
+
+                // A statistic that was 0 is always a regression when it increases.
+                const double changePercent = (baseValue > 0)
+                    ? 100.0 * (static_cast<double>(newValue) - baseValue) / baseValue
+                    : 100.0;
+                const bool isRegression = newValue > baseValue && (baseValue == 0 || changePercent > thresholdPercent);
+                regressionCount += isRegression ? 1 : 0;
+
+                std::printf("    %s: %u -> %u (%+.1f%%)%s\n",
+                    statistic.m_name, baseValue, newValue, changePercent, isRegression ? " REGRESSION" : "");
+            }
+        }
+
+        std::printf("%zu variants compared, %zu changed, %u regressions over %.1f%%.\n",
+            newReports.size(), diffs.size(), regressionCount, thresholdPercent);
+        return (regressionCount > 0) ? RegressionExitCode : 0;
+    }
+}
+
+// Writes and compares shader cost reports (see ShaderReport.h), to find shader
+// changes that make shaders more expensive without running the application.
+// Shaders are relative to the assets folder and use "main" as entry point.
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    const std::string_view command = argv[1];
+    if (command == "compile" && argc >= 4)
+    {
+        std::vector<DX::ShaderInfo> shaders;
+        for (int i = 3; i < argc; ++i)
+        {
+            auto shaderInfo = ParseShader(argv[i]);
+            if (!shaderInfo.has_value())
+            {
+                PrintUsage();
+                return 1;
+            }
+            shaders.push_back(std::move(*shaderInfo));
+        }
+        return Compile(argv[2], shaders);
+    }
+    else if (command == "diff" && (argc == 4 || argc == 6))
+    {
+        double thresholdPercent = DefaultThresholdPercent;
+        if (argc == 6)
+        {
+            const std::string_view threshold = argv[5];
+            if (std::string_view(argv[4]) != "--threshold" ||
+                std::from_chars(threshold.data(), threshold.data() + threshold.size(), thresholdPercent).ec != std::errc())
+            {
+                PrintUsage();
+                return 1;
+            }
+        }
+        return Diff(argv[2], argv[3], thresholdPercent);
+    }
+
+    PrintUsage();
+    return 1;
+}